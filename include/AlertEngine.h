@@ -0,0 +1,171 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include "SystemMetrics.h"
+
+// Resource a rule is evaluated against
+enum class AlertMetric : uint8_t {
+    CPU,
+    RAM,
+    DISK
+};
+
+// What a rule looks at
+enum class AlertScope : uint8_t {
+    SYSTEM,     // System-wide usage
+    PROCESS     // Highest usage among processes with a matching name
+};
+
+// How the watched value is compared
+enum class AlertCondition : uint8_t {
+    LEVEL,      // Usage percentage
+    RATE        // Rate of change in percent per minute (e.g. memory leak detection)
+};
+
+// Alert rule definition
+//
+// Text form (one rule per ALERT_RULE= line in the configuration file):
+//   <scope> <metric> [rate] > <level> [clear <level>] [smooth <duration>]
+//                                     [for <duration>] [recover <duration>] [cooldown <duration>]
+//   scope:    system | process:<name>
+//   metric:   cpu | ram | disk
+//   rate:     compare the rate of change (percent per minute) instead of the level
+//   smooth:   EWMA time constant applied to the input before comparison
+//   duration: number with optional s/m/h suffix (seconds by default)
+// Examples:
+//   ALERT_RULE=process:java ram > 20 clear 15 for 60s cooldown 30m
+//   ALERT_RULE=system ram rate > 2 for 5m
+struct AlertRule {
+    // Timing left out of the rule text; MonitorConfig fills it in from the email settings
+    static constexpr int INHERIT_TIMING = -1;
+
+    AlertScope scope = AlertScope::SYSTEM;
+    AlertMetric metric = AlertMetric::CPU;
+    AlertCondition condition = AlertCondition::LEVEL;
+    std::string processName;          // PROCESS scope only
+    double triggerLevel = 80.0;       // Rule trips when value > triggerLevel
+    double clearLevel = 80.0;         // Rule clears when value <= clearLevel (hysteresis)
+    int smoothingSeconds = 0;         // EWMA time constant, 0 = raw samples
+    int durationSeconds = INHERIT_TIMING;          // Time above trigger before the alert fires
+    int recoveryDurationSeconds = INHERIT_TIMING;  // Time at or below clear level before recovery is reported
+    int cooldownSeconds = INHERIT_TIMING;          // Minimum time between two alerts of the same rule
+
+    std::string getName() const;
+    std::string toConfigString() const;
+    static bool parse(const std::string& text, AlertRule& rule, std::string& error);
+    static const char* metricName(AlertMetric metric);
+};
+
+// Alert event types produced by the engine
+enum class AlertEventType {
+    FIRED,      // Rule stayed above its trigger level for the configured duration
+    RECOVERED   // Fired rule stayed at or below its clear level for the recovery duration
+};
+
+// Alert event produced by AlertEngine::evaluate
+struct AlertEvent {
+    size_t ruleIndex;
+    AlertEventType type;
+    double value;
+    int activeSeconds;  // FIRED: time above trigger, RECOVERED: total alert duration
+};
+
+// Incrementally maintained input of one rule: EWMA-smoothed level and
+// EWMA-smoothed slope. O(1) per sample, no history is kept.
+struct MetricTracker {
+    double smoothed = 0.0;
+    double slopePerMinute = 0.0;
+    int64_t lastMs = 0;
+    bool initialized = false;
+
+    void update(double raw, int64_t nowMs, double smoothingSeconds);
+};
+
+// Rule engine evaluating many independent alert rules per monitoring cycle.
+// Each rule owns its state machine (NORMAL -> PENDING -> FIRING -> RECOVERING),
+// so one noisy resource no longer masks the recovery of another.
+class AlertEngine {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class RulePhase : uint8_t {
+        NORMAL,
+        PENDING,     // Above trigger, waiting for duration (or cooldown)
+        FIRING,      // Alert fired
+        RECOVERING   // Alert fired, back at or below clear level, waiting for recovery duration
+    };
+
+private:
+    // Compact per-rule data touched by the evaluation pass
+    struct CompiledRule {
+        int64_t durationMs;
+        int64_t recoveryMs;
+        int64_t cooldownMs;
+        float trigger;
+        float clear;
+        float smoothingSeconds;
+        uint32_t source;        // 0 = system, otherwise 1 + process slot
+        AlertMetric metric;
+        AlertCondition condition;
+    };
+
+    struct RuleState {
+        int64_t exceededSinceMs = 0;
+        int64_t normalSinceMs = 0;
+        int64_t firedAtMs = 0;
+        int64_t lastFiredMs = INT64_MIN / 2;
+        MetricTracker input;
+        float value = 0.0f;
+        RulePhase phase = RulePhase::NORMAL;
+        bool exceeded = false;
+    };
+
+    // Highest usage seen this cycle for one watched process name
+    struct ProcessSlot {
+        float values[3];
+    };
+
+    std::vector<AlertRule> rules;
+    std::vector<CompiledRule> compiled;
+    std::vector<RuleState> states;
+    std::vector<ProcessSlot> processSlots;
+    std::unordered_map<std::string, uint32_t> processSlotByName;
+    std::vector<AlertEvent> events;
+    std::string nameScratch;
+
+    static int64_t toMillis(Clock::time_point time);
+    static void normalizeProcessName(const std::string& name, std::string& out);
+
+public:
+    AlertEngine() = default;
+    explicit AlertEngine(const std::vector<AlertRule>& ruleSet);
+
+    // Replaces the rule set. State is kept for rules whose definition did not change.
+    void setRules(const std::vector<AlertRule>& ruleSet);
+
+    // Evaluates every rule against one snapshot in a single pass over the process list.
+    // Returned events are valid until the next call.
+    const std::vector<AlertEvent>& evaluate(const SystemUsage& systemUsage,
+                                            const std::vector<ProcessInfo>& processes,
+                                            Clock::time_point now = Clock::now());
+
+    // Rule inspection
+    size_t getRuleCount() const { return rules.size(); }
+    const AlertRule& getRule(size_t index) const { return rules[index]; }
+    RulePhase getPhase(size_t index) const { return states[index].phase; }
+    double getValue(size_t index) const { return states[index].value; }
+    bool isExceeded(size_t index) const { return states[index].exceeded; }
+
+    // True when at least one rule is currently above its trigger level (or inside its hysteresis band)
+    bool anyExceeded() const;
+    std::vector<std::string> getExceededRuleNames() const;
+
+    // Builds the system CPU/RAM/Disk rules equivalent to the classic threshold settings
+    static std::vector<AlertRule> createSystemRules(double cpuThreshold, double ramThreshold,
+                                                   double diskThreshold, int durationSeconds,
+                                                   int recoveryDurationSeconds, int cooldownSeconds);
+};
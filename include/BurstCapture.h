@@ -0,0 +1,104 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include "SystemMetrics.h"
+
+// High-resolution capture around a threshold crossing.
+//
+// When the system first goes over a threshold the normal cadence is too
+// coarse to see what spiked. A burst picks the top offending processes of
+// the triggering sample and then records system usage plus only those
+// processes every intervalMs for windowSeconds. Samples go into a buffer
+// sized for the whole window when the burst starts; the finished buffer is
+// formatted once for the log and the alert email. Outside a burst nothing is
+// sampled or stored.
+class BurstCapture {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Supported burst sampling periods
+    static constexpr int MIN_INTERVAL_MS = 100;
+    static constexpr int MAX_INTERVAL_MS = 1000;
+
+    // One watched process
+    struct Target {
+        DWORD pid = 0;
+        std::string name;
+    };
+
+    // Usage of one target in one sample
+    struct ProcessPoint {
+        float cpuPercent = 0.0f;
+        float ramPercent = 0.0f;
+        float diskPercent = 0.0f;
+        bool present = false;           // False once the process has exited
+    };
+
+    // One burst sample; points are in target order
+    struct Sample {
+        int64_t offsetMs = 0;           // Time since the burst started
+        SystemUsage systemUsage;
+        std::vector<ProcessPoint> points;
+    };
+
+private:
+    // Settings, applied to the next burst
+    int windowSeconds = 10;
+    int intervalMs = 200;
+    int topProcesses = 5;
+
+    // Current or last burst
+    bool active = false;
+    bool previousExceeded = false;
+    int burstWindowSeconds = 0;
+    int burstIntervalMs = 0;
+    size_t maxSamples = 0;
+    Clock::time_point startTime;
+    std::chrono::system_clock::time_point startWallTime;
+    std::string reason;
+    std::vector<Target> targets;
+    std::vector<DWORD> targetPids;
+    std::vector<Sample> samples;
+
+public:
+    BurstCapture() = default;
+    BurstCapture(int window, int interval, int top);
+
+    // Settings; 0 seconds disables bursts
+    void configure(int window, int interval, int top);
+    bool isEnabled() const { return windowSeconds > 0 && topProcesses > 0; }
+    int getWindowSeconds() const { return windowSeconds; }
+    int getIntervalMs() const { return intervalMs; }
+    int getTopProcesses() const { return topProcesses; }
+
+    // Feeds the threshold state of every normal cycle; true on the rising
+    // edge that should start a burst
+    bool onThresholdState(bool exceeded);
+
+    // Starts a burst on the top offenders of the triggering process list
+    void begin(const std::vector<ProcessInfo>& processes, const std::string& triggerReason,
+               Clock::time_point now = Clock::now());
+
+    // Adds one sample; processes holds the sampled targets in any order
+    void record(const SystemUsage& systemUsage, const std::vector<ProcessInfo>& processes,
+                Clock::time_point now = Clock::now());
+
+    // True once the window has elapsed
+    bool isComplete(Clock::time_point now = Clock::now()) const;
+
+    // Ends the burst; the buffer stays available for the report
+    void finish() { active = false; }
+
+    // Inspection
+    bool isActive() const { return active; }
+    std::chrono::milliseconds getBurstInterval() const { return std::chrono::milliseconds(burstIntervalMs); }
+    const std::vector<Target>& getTargets() const { return targets; }
+    const std::vector<DWORD>& getTargetPids() const { return targetPids; }
+    const std::vector<Sample>& getSamples() const { return samples; }
+
+    // Text block for the log file and alert emails
+    std::string formatReport() const;
+};
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <thread>
+#include <atomic>
+#include <unordered_map>
+#include <cstdint>
+#include "SystemMetrics.h"
+#include "Logger.h"
+
+// Columns of a columnar export block. CYCLE_* and SYSTEM_* hold one value
+// per cycle, the others one value per logged process row.
+enum class ExportColumn : uint8_t {
+    CYCLE_TIME,         // Milliseconds since the Unix epoch
+    CYCLE_ROWS,         // Process rows of the cycle
+    SYSTEM_CPU,
+    SYSTEM_RAM,
+    SYSTEM_DISK,
+    PID,
+    NAME,
+    CPU,
+    RAM,
+    DISK,
+    COUNT
+};
+
+// Encoding of a stored column, recorded in the block footer
+enum class ExportEncoding : uint8_t {
+    DELTA = 1,          // Differences of consecutive values, frame-of-reference bit-packed
+    PACKED = 2,         // Values minus the column minimum, bit-packed
+    DICTIONARY = 3,     // Block dictionary of strings, then bit-packed indices
+    FIXED_POINT = 4     // Hundredths, then PACKED
+};
+
+// Min/max statistics of one column of a block, in stored units
+// (milliseconds, PIDs, dictionary indices, hundredths of a percent)
+struct ExportColumnStats {
+    int64_t min = 0;
+    int64_t max = 0;
+};
+
+// One block of cycles stored column by column.
+//
+//   [u32 length] column segments... footer [u32 footer length] "SMCB"
+//
+// Timestamps are delta-encoded, PIDs and fixed-point usage values are
+// bit-packed at the width of their range, and names go through a
+// dictionary local to the block. The footer gives each column's offset,
+// length and min/max, so a reader can skip a block on its statistics and
+// read only the columns a query touches.
+class ColumnarBlockBuilder {
+public:
+    static constexpr size_t COLUMN_COUNT = static_cast<size_t>(ExportColumn::COUNT);
+
+private:
+    std::vector<int64_t> cycleTimes;
+    std::vector<int64_t> cycleRows;
+    std::vector<int64_t> systemValues[3];
+    std::vector<int64_t> pids;
+    std::vector<int64_t> nameIds;
+    std::vector<int64_t> processValues[3];
+    std::vector<std::string> names;
+    std::unordered_map<std::string, uint32_t> nameIndex;
+
+public:
+    // Adds the logged processes of one cycle
+    void addCycle(int64_t timestampMs, const SystemUsage& systemUsage, const std::vector<ProcessInfo>& processes);
+
+    // Appends the encoded block to out; the builder keeps its contents until clear()
+    void encode(std::string& out) const;
+    void clear();
+
+    size_t getCycleCount() const { return cycleTimes.size(); }
+    size_t getRowCount() const { return pids.size(); }
+
+    // Usage percentage as stored: hundredths, at least 0
+    static int64_t toFixedPoint(double percent);
+};
+
+// Background writer of the columnar export file (COLUMNAR_EXPORT_PATH).
+//
+// Fed the same filtered process list as the log file. The main loop queues
+// each cycle; the worker collects blockCycles cycles into a block, encodes
+// it and appends it to the file with one write. A block cut short by a
+// crash is removed when the file is reopened, so the file always ends on a
+// whole block.
+class ColumnarExportWriter {
+public:
+    static constexpr size_t QUEUE_LIMIT = 600;
+
+private:
+    struct Cycle {
+        int64_t timestampMs = 0;
+        SystemUsage systemUsage;
+        std::vector<ProcessInfo> processes;
+    };
+
+    std::string filePath;
+    BlockingQueue<Cycle> queue;
+    std::thread worker;
+    std::atomic<bool> running{false};
+    std::atomic<size_t> blockCycles{600};
+    std::atomic<uint64_t> rowCount{0};
+    std::atomic<uint64_t> blockCount{0};
+    std::atomic<uint64_t> bytesWritten{0};
+    std::atomic<uint64_t> droppedCycles{0};
+
+    // Worker thread state
+    ColumnarBlockBuilder builder;
+    std::ofstream file;
+    std::string encoded;
+
+    void workerThreadFunction();
+    void sealBlock();
+
+public:
+    ColumnarExportWriter() = default;
+    ~ColumnarExportWriter();
+
+    // Non-copyable
+    ColumnarExportWriter(const ColumnarExportWriter&) = delete;
+    ColumnarExportWriter& operator=(const ColumnarExportWriter&) = delete;
+
+    // Appends to the file (created with its header if missing); false if it cannot
+    // be opened or is not an export file
+    bool start(const std::string& path);
+
+    // Writes the queued cycles as a last, possibly short block, then joins the worker
+    void stop();
+    bool isRunning() const { return running; }
+
+    // Cycles per block; read by the worker, so it follows configuration reloads
+    void setBlockCycles(size_t cycles) { blockCycles = cycles > 0 ? cycles : 1; }
+
+    // Queues one cycle without blocking; dropped when the worker falls QUEUE_LIMIT cycles behind
+    void append(int64_t timestampMs, const SystemUsage& systemUsage, const std::vector<ProcessInfo>& processes);
+
+    const std::string& getFilePath() const { return filePath; }
+    uint64_t getRowCount() const { return rowCount; }
+    uint64_t getBlockCount() const { return blockCount; }
+    uint64_t getBytesWritten() const { return bytesWritten; }
+    uint64_t getDroppedCount() const { return droppedCycles; }
+    size_t getQueueSize() const { return queue.size(); }
+};
+
+// Bit of a column in ExportQuery::columns
+constexpr uint32_t exportColumnBit(ExportColumn column) {
+    return 1u << static_cast<uint32_t>(column);
+}
+
+// Rows wanted from an export: a time range, optionally one process name and
+// one usage column above a threshold
+struct ExportQuery {
+    int64_t fromMs = INT64_MIN;
+    int64_t toMs = INT64_MAX;
+    std::string name;                       // Exact process name; empty = every process
+    ExportColumn usageColumn = ExportColumn::CPU;
+    double above = -1.0;                    // Rows with usageColumn > above; negative = no usage condition
+    uint32_t columns = exportColumnBit(ExportColumn::CYCLE_TIME) | exportColumnBit(ExportColumn::PID) |
+                       exportColumnBit(ExportColumn::NAME) | exportColumnBit(ExportColumn::CPU) |
+                       exportColumnBit(ExportColumn::RAM) | exportColumnBit(ExportColumn::DISK);
+};
+
+// One matching row; only the columns asked for are filled in
+struct ExportRow {
+    int64_t timestampMs = 0;
+    DWORD pid = 0;
+    std::string name;
+    double cpu = 0.0;
+    double ram = 0.0;
+    double disk = 0.0;
+    double systemCpu = 0.0;
+    double systemRam = 0.0;
+    double systemDisk = 0.0;
+};
+
+// Reads an export file. open() reads only the block footers; scan() skips
+// blocks whose statistics rule the query out and reads, per remaining
+// block, just the columns the query and its conditions use.
+class ColumnarExportReader {
+private:
+    struct ColumnRef {
+        ExportEncoding encoding = ExportEncoding::PACKED;
+        uint64_t offset = 0;                // In the file
+        uint32_t length = 0;
+        ExportColumnStats stats;
+    };
+
+    struct BlockRef {
+        uint32_t cycleCount = 0;
+        uint32_t rowCount = 0;
+        ColumnRef columns[ColumnarBlockBuilder::COLUMN_COUNT];
+    };
+
+    std::string filePath;
+    std::vector<BlockRef> blocks;
+    bool truncated = false;
+    mutable uint64_t lastBytesRead = 0;
+    mutable size_t lastBlocksSkipped = 0;
+
+public:
+    // False if the file cannot be read or is not an export file
+    bool open(const std::string& path);
+
+    size_t getBlockCount() const { return blocks.size(); }
+    uint64_t getRowCount() const;
+    bool isTruncated() const { return truncated; }      // The file ended inside a block
+
+    // Matching rows, oldest first; false if a column could not be read or decoded
+    bool scan(const ExportQuery& query, std::vector<ExportRow>& rows) const;
+
+    // Work done by the last scan()
+    uint64_t getLastBytesRead() const { return lastBytesRead; }
+    size_t getLastBlocksSkipped() const { return lastBlocksSkipped; }
+};
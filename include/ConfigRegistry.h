@@ -0,0 +1,62 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+class MonitorConfig;
+
+// Value types understood by the configuration file parser
+enum class ConfigValueType : uint8_t {
+    INTEGER,    // Whole number within [minValue, maxValue]
+    NUMBER,     // Decimal number within [minValue, maxValue]
+    BOOLEAN,    // true/false, 1/0, yes/no, on/off
+    TEXT,       // Free text
+    CHOICE,     // One of the key's choices (name or index)
+    LIST,       // Comma-separated list
+    RULE        // Alert rule, repeatable
+};
+
+// Parsed value handed to a key's setter and returned by its getter
+struct ConfigValue {
+    double number = 0.0;              // INTEGER, NUMBER, CHOICE (index)
+    bool flag = false;                // BOOLEAN
+    std::string text;                 // TEXT, RULE
+    std::vector<std::string> items;   // LIST
+};
+
+// One configuration file key: name, type, validation range, setter, getter and help text
+struct ConfigKey {
+    const char* name;
+    ConfigValueType type;
+    double minValue;                  // INTEGER/NUMBER only
+    double maxValue;                  // INTEGER/NUMBER only
+    const char* const* choices;       // CHOICE only, index = enum value
+    size_t choiceCount;
+    bool (*set)(MonitorConfig& config, const ConfigValue& value, std::string& error);
+    void (*get)(const MonitorConfig& config, std::vector<ConfigValue>& values);
+    const char* help;
+};
+
+// Compile-time registry of every configuration file key.
+// Drives loading, saving, validation and the key list printed by --help.
+// Lookup goes through a case-insensitive perfect hash computed at compile time.
+class ConfigRegistry {
+public:
+    // Returns nullptr for unknown keys
+    static const ConfigKey* find(const std::string& name);
+
+    // Keys in save order
+    static const ConfigKey* begin();
+    static const ConfigKey* end();
+    static size_t size();
+
+    // Text <-> value conversion with validation against the key's type and range
+    static bool parseValue(const ConfigKey& key, const std::string& text, ConfigValue& value, std::string& error);
+    static std::string formatValue(const ConfigKey& key, const ConfigValue& value);
+    static bool checkValue(const ConfigKey& key, const ConfigValue& value, std::string& error);
+
+    // Short type/range description for help output, e.g. "integer 1000.." or "SIZE_BASED|DATE_BASED"
+    static std::string describeType(const ConfigKey& key);
+};
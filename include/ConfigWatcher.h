@@ -0,0 +1,66 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+#include "Configuration.h"
+
+// Watches the configuration file and republishes it when it changes.
+//
+// The file is re-read, re-parsed and validated on the watcher thread; command
+// line overrides are re-applied on top so they keep precedence over the file.
+// A valid result is published as an immutable snapshot with an atomic
+// shared_ptr swap, so the sampling loop picks it up with a single atomic load
+// and never blocks on parsing. Invalid edits are reported and ignored.
+//
+// Change detection: FindFirstChangeNotification on Windows, inotify on Linux,
+// modification time polling elsewhere. The parent directory is watched so
+// editors that save by rename are handled.
+class ConfigWatcher {
+private:
+    std::string filePath;
+    std::vector<std::string> commandLineArgs;
+
+    // A configuration and its generation, published together in one swap
+    struct Published {
+        MonitorConfig config;
+        uint64_t generation;
+    };
+
+    std::shared_ptr<const Published> published;     // Accessed only through std::atomic_load/atomic_store
+    std::string lastLoadedText;
+
+    std::thread watcherThread;
+    std::atomic<bool> running;
+
+    void watcherLoop();
+    void pollLoop();
+    void reload();
+
+public:
+    ConfigWatcher(const std::string& configFile, const MonitorConfig& initialConfig,
+                  int argc = 0, char* argv[] = nullptr);
+    ~ConfigWatcher();
+
+    // Non-copyable
+    ConfigWatcher(const ConfigWatcher&) = delete;
+    ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+
+    bool start();
+    void stop();
+
+    // Lock-free read of the current configuration. Hold the returned pointer
+    // for the duration of one monitoring cycle.
+    std::shared_ptr<const MonitorConfig> getSnapshot() const;
+
+    // Same, also returning the generation of that very snapshot
+    std::shared_ptr<const MonitorConfig> getSnapshot(uint64_t& snapshotGeneration) const;
+
+    // Incremented every time a new snapshot is published
+    uint64_t getGeneration() const;
+
+    const std::string& getFilePath() const { return filePath; }
+};
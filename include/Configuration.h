@@ -3,8 +3,12 @@
 #include <string>
 #include <memory>
 #include <vector>
+#include <iosfwd>
 #include "Logger.h"
 #include "EmailNotifier.h"
+#include "AlertEngine.h"
+#include "ProcessTiers.h"
+#include "StatsdSink.h"
 
 // Display mode enumeration
 enum class DisplayModeConfig {
@@ -21,7 +25,29 @@ protected:
     double ramThreshold = 80.0;
     double diskThreshold = 80.0;
     int monitorInterval = 5000;
+    int processScanThreads = 0;         // Threads collecting per-process metrics (0 = automatic)
+    double processHotCpuPercent = 0.5;  // CPU share that promotes a process to the hot tier
+    int processColdRefreshCycles = 10;  // Full refresh cadence of cold processes (1 = no tiering)
+    int burstWindowSeconds = 10;        // High-resolution capture after a threshold crossing (0 = off)
+    int burstIntervalMs = 200;          // Sampling period during a burst
+    int burstTopProcesses = 5;          // Offending processes followed during a burst
+    double selfCpuBudgetPercent = 1.0;  // Agent CPU share that raises the budget alarm (0 = off)
+    int selfRssBudgetMb = 50;           // Agent resident memory that raises the budget alarm (0 = off)
+    int metricHistoryProcesses = 5000;  // Per-process series kept in the usage history (0 = system only)
+    int historyArchiveProcesses = 100;  // Top processes written to the on-disk history each cycle
+    int historyArchiveDays = 31;        // Days of on-disk history kept (0 = keep all)
+    int metricsPort = 0;                // Loopback port of the Prometheus endpoint (0 = off)
+    int metricsTopProcesses = 20;       // Heaviest processes exported per scrape
+    int sharedSnapshotProcesses = 32;   // Process records in the shared-memory snapshot
+    StatsdFormat statsdFormat = StatsdFormat::STATSD;
+    int statsdFlushMs = 1000;           // Interval between StatsD sends
+    int statsdPacketBytes = 1432;       // Largest StatsD datagram
+    int statsdTopProcesses = 20;        // Busiest process names pushed per cycle
+    int columnarExportBlockCycles = 600; // Cycles per block of the columnar export
+    double alertHysteresis = 5.0;       // System rules clear at threshold - hysteresis
+    int alertSmoothingSeconds = 0;      // EWMA time constant for system rules (0 = raw samples)
     bool debugMode = false;
+    int displayRefreshMs = 1000;        // Frame budget of the top-style and compact displays
     DisplayModeConfig displayMode = DisplayModeConfig::TOP_STYLE; // Default to top-style
 
 public:
@@ -33,16 +59,66 @@ public:
     double getRamThreshold() const { return ramThreshold; }
     double getDiskThreshold() const { return diskThreshold; }
     int getMonitorInterval() const { return monitorInterval; }
+    int getProcessScanThreads() const { return processScanThreads; }
+    double getProcessHotCpuPercent() const { return processHotCpuPercent; }
+    int getProcessColdRefreshCycles() const { return processColdRefreshCycles; }
+    ProcessTierPolicy getProcessTierPolicy() const {
+        ProcessTierPolicy policy;
+        policy.setHotCpuPercent(processHotCpuPercent);
+        policy.setColdRefreshCycles(processColdRefreshCycles);
+        return policy;
+    }
+    int getBurstWindowSeconds() const { return burstWindowSeconds; }
+    int getBurstIntervalMs() const { return burstIntervalMs; }
+    int getBurstTopProcesses() const { return burstTopProcesses; }
+    double getSelfCpuBudgetPercent() const { return selfCpuBudgetPercent; }
+    int getSelfRssBudgetMb() const { return selfRssBudgetMb; }
+    int getMetricHistoryProcesses() const { return metricHistoryProcesses; }
+    int getHistoryArchiveProcesses() const { return historyArchiveProcesses; }
+    int getHistoryArchiveDays() const { return historyArchiveDays; }
+    int getMetricsPort() const { return metricsPort; }
+    int getMetricsTopProcesses() const { return metricsTopProcesses; }
+    int getSharedSnapshotProcesses() const { return sharedSnapshotProcesses; }
+    StatsdFormat getStatsdFormat() const { return statsdFormat; }
+    int getStatsdFlushMs() const { return statsdFlushMs; }
+    int getStatsdPacketBytes() const { return statsdPacketBytes; }
+    int getStatsdTopProcesses() const { return statsdTopProcesses; }
+    int getColumnarExportBlockCycles() const { return columnarExportBlockCycles; }
+    double getAlertHysteresis() const { return alertHysteresis; }
+    int getAlertSmoothingSeconds() const { return alertSmoothingSeconds; }
     bool isDebugMode() const { return debugMode; }
     DisplayModeConfig getDisplayMode() const { return displayMode; }
+    int getDisplayRefreshMs() const { return displayRefreshMs; }
 
     // Setters
     void setCpuThreshold(double value) { cpuThreshold = value; }
     void setRamThreshold(double value) { ramThreshold = value; }
     void setDiskThreshold(double value) { diskThreshold = value; }
     void setMonitorInterval(int value) { monitorInterval = value; }
+    void setProcessScanThreads(int value) { processScanThreads = value; }
+    void setProcessHotCpuPercent(double value) { processHotCpuPercent = value; }
+    void setProcessColdRefreshCycles(int value) { processColdRefreshCycles = value; }
+    void setBurstWindowSeconds(int value) { burstWindowSeconds = value; }
+    void setBurstIntervalMs(int value) { burstIntervalMs = value; }
+    void setBurstTopProcesses(int value) { burstTopProcesses = value; }
+    void setSelfCpuBudgetPercent(double value) { selfCpuBudgetPercent = value; }
+    void setSelfRssBudgetMb(int value) { selfRssBudgetMb = value; }
+    void setMetricHistoryProcesses(int value) { metricHistoryProcesses = value; }
+    void setHistoryArchiveProcesses(int value) { historyArchiveProcesses = value; }
+    void setHistoryArchiveDays(int value) { historyArchiveDays = value; }
+    void setMetricsPort(int value) { metricsPort = value; }
+    void setMetricsTopProcesses(int value) { metricsTopProcesses = value; }
+    void setSharedSnapshotProcesses(int value) { sharedSnapshotProcesses = value; }
+    void setStatsdFormat(StatsdFormat value) { statsdFormat = value; }
+    void setStatsdFlushMs(int value) { statsdFlushMs = value; }
+    void setStatsdPacketBytes(int value) { statsdPacketBytes = value; }
+    void setStatsdTopProcesses(int value) { statsdTopProcesses = value; }
+    void setColumnarExportBlockCycles(int value) { columnarExportBlockCycles = value; }
+    void setAlertHysteresis(double value) { alertHysteresis = value; }
+    void setAlertSmoothingSeconds(int value) { alertSmoothingSeconds = value; }
     void setDebugMode(bool value) { debugMode = value; }
     void setDisplayMode(DisplayModeConfig mode) { displayMode = mode; }
+    void setDisplayRefreshMs(int value) { displayRefreshMs = value; }
 
     // Virtual methods for extensibility
     virtual bool validate() const;
@@ -55,6 +131,20 @@ private:
     std::string logFilePath = "SystemMonitor.log";
     LogConfig logConfig;
     EmailConfig emailConfig;
+    std::vector<AlertRule> alertRules;   // Additional rules from ALERT_RULE entries
+    std::string traceFilePath;           // Chrome trace output (--trace); empty = tracing off
+    std::string procRoot = "/proc";      // procfs read by the Linux collector
+    std::string recordFilePath;          // Snapshot recording (--record); empty = off
+    std::string replayFilePath;          // Snapshot replay in place of collection (--replay); empty = live
+    double replaySpeed = 1.0;            // Replay pace relative to the recording; 0 = as fast as possible
+    std::string historyArchivePath;      // Directory of the on-disk usage history; empty = off
+    std::string sharedSnapshotName;      // Shared-memory segment for local readers; empty = off
+    std::string querySocketPath;         // Unix-domain socket of the query server; empty = off
+    std::string statsdAddress;           // host:port of the StatsD collector; empty = off
+    std::string columnarExportPath;      // Columnar export file for offline analysis; empty = off
+    int percentileQueryHours = 0;        // Percentile table to print instead of monitoring (--percentiles); 0 = none
+    bool jsonLinesOutput = false;        // One JSON object per cycle (--output jsonl)
+    std::string outputFilePath;          // Target of the JSON Lines (--output-file); empty or "-" = stdout
 
 public:
     MonitorConfig();
@@ -67,6 +157,20 @@ public:
     LogConfig& getLogConfig() { return logConfig; }
     const EmailConfig& getEmailConfig() const { return emailConfig; }
     EmailConfig& getEmailConfig() { return emailConfig; }
+    const std::vector<AlertRule>& getAlertRules() const { return alertRules; }
+    const std::string& getTraceFilePath() const { return traceFilePath; }
+    const std::string& getProcRoot() const { return procRoot; }
+    const std::string& getRecordFilePath() const { return recordFilePath; }
+    const std::string& getReplayFilePath() const { return replayFilePath; }
+    double getReplaySpeed() const { return replaySpeed; }
+    const std::string& getHistoryArchivePath() const { return historyArchivePath; }
+    const std::string& getSharedSnapshotName() const { return sharedSnapshotName; }
+    const std::string& getQuerySocketPath() const { return querySocketPath; }
+    const std::string& getStatsdAddress() const { return statsdAddress; }
+    const std::string& getColumnarExportPath() const { return columnarExportPath; }
+    int getPercentileQueryHours() const { return percentileQueryHours; }
+    bool isJsonLinesOutput() const { return jsonLinesOutput; }
+    const std::string& getOutputFilePath() const { return outputFilePath; }
 
     // Setters
     void setLogFilePath(const std::string& path) { 
@@ -75,6 +179,24 @@ public:
     }
     void setLogConfig(const LogConfig& config) { logConfig = config; }
     void setEmailConfig(const EmailConfig& config) { emailConfig = config; }
+    void addAlertRule(const AlertRule& rule) { alertRules.push_back(rule); }
+    void clearAlertRules() { alertRules.clear(); }
+    void setTraceFilePath(const std::string& path) { traceFilePath = path; }
+    void setProcRoot(const std::string& root) { procRoot = root; }
+    void setRecordFilePath(const std::string& path) { recordFilePath = path; }
+    void setReplayFilePath(const std::string& path) { replayFilePath = path; }
+    void setReplaySpeed(double speed) { replaySpeed = speed; }
+    void setHistoryArchivePath(const std::string& path) { historyArchivePath = path; }
+    void setSharedSnapshotName(const std::string& name) { sharedSnapshotName = name; }
+    void setQuerySocketPath(const std::string& path) { querySocketPath = path; }
+    void setStatsdAddress(const std::string& address) { statsdAddress = address; }
+    void setColumnarExportPath(const std::string& path) { columnarExportPath = path; }
+    void setPercentileQueryHours(int hours) { percentileQueryHours = hours; }
+    void setJsonLinesOutput(bool enabled) { jsonLinesOutput = enabled; }
+    void setOutputFilePath(const std::string& path) { outputFilePath = path; }
+
+    // System CPU/RAM/Disk rules derived from the thresholds plus the configured ALERT_RULE entries
+    std::vector<AlertRule> getEffectiveAlertRules() const;
 
     // Override virtual methods
     bool validate() const override;
@@ -97,7 +219,11 @@ public:
 class ConfigurationManager : public IConfigurationManager {
 private:
     MonitorConfig config;
+    std::vector<std::string> parseErrors;   // "file:line: message" entries from the last loadFromFile
+    bool quiet = false;                     // Silences parseCommandLine warnings
 
+    std::ostream& diagnostics() const;      // std::cerr, or a discarding stream when quiet
+    void reportParseError(const std::string& filename, int lineNumber, const std::string& message);
     double validateThreshold(const std::string& value, const std::string& paramName) const;
     bool isValidParameter(const std::string& param) const;
 
@@ -107,6 +233,7 @@ public:
 
     // IConfigurationManager interface implementation
     bool loadFromFile(const std::string& filename) override;
+    bool loadFromStream(std::istream& input, const std::string& sourceName);   // sourceName labels parse errors
     bool saveToFile(const std::string& filename) const override;
     bool parseCommandLine(int argc, char* argv[]) override;
     MonitorConfig& getConfig() override { return config; }
@@ -116,4 +243,8 @@ public:
     // Additional utility methods
     void resetToDefaults();
     bool validateConfiguration() const;
+    const std::vector<std::string>& getParseErrors() const { return parseErrors; }
+
+    // Reapplying arguments that were already reported once (config reloads) should not warn again
+    void setQuiet(bool enabled) { quiet = enabled; }
 };
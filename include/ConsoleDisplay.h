@@ -6,6 +6,7 @@
 #include <memory>
 #include <chrono>
 #include "SystemMetrics.h"
+#include "ScreenRenderer.h"
 
 // Console display modes
 enum class DisplayMode {
@@ -25,6 +26,7 @@ private:
     DisplayMode currentMode;
     
     // Display state
+    ScreenRenderer renderer;            // Differential output for the top-style view
     std::chrono::steady_clock::time_point startTime;
     size_t totalCycles;
     
@@ -68,7 +70,7 @@ public:
     void showCompactDisplay(const std::vector<ProcessInfo>& processes, 
                           const SystemUsage& systemUsage);
     
-    // Interactive controls
+    // Top-style frame sections (added to the current renderer frame)
     void showHeader(const SystemUsage& systemUsage, size_t processCount);
     void showColumnHeaders();
     void showProcessTable(const std::vector<ProcessInfo>& processes);
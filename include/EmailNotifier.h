@@ -8,6 +8,8 @@
 #include <thread>
 #include <atomic>
 #include <memory>
+#include <map>
+#include <cstdint>
 
 // Email configuration structure
 struct EmailConfig {
@@ -107,6 +109,7 @@ private:
     EmailConfig config;
     std::unique_ptr<IEmailSender> emailSender;
     AlertHistory alertHistory;
+    std::map<std::string, std::vector<std::string>> ruleAlertLogs;  // Log entries of currently firing rules
     
     // Thread-safe email queue
     std::queue<EmailMessage> emailQueue;
@@ -114,6 +117,7 @@ private:
     std::condition_variable queueCondition;
     std::thread emailWorkerThread;
     std::atomic<bool> running;
+    std::atomic<uint64_t> droppedEmails{0};    // Failed sends and messages discarded at stop
     
     // Alert state tracking
     std::mutex alertMutex;
@@ -121,9 +125,6 @@ private:
     void emailWorkerLoop();
     bool shouldSendAlert() const;
     bool shouldSendRecoveryAlert() const;
-    std::string generateAlertEmail(const std::vector<std::string>& logs) const;
-    std::string generateRecoveryEmail(const std::vector<std::string>& alertLogs, 
-                                     const std::vector<std::string>& recoveryLogs) const;
     std::string formatLogEntry(const std::string& logEntry) const;
     
 public:
@@ -145,9 +146,19 @@ public:
     void sendImmediateAlert(const std::string& subject, const std::string& message);
     bool testEmailConfiguration();
     
+    // Rule-based alerting (timing and cooldown are handled by AlertEngine)
+    void notifyRuleAlert(const std::string& ruleName, const std::string& currentLogEntry);
+    void notifyRuleRecovery(const std::string& ruleName, const std::string& currentLogEntry);
+    
+    // HTML bodies of the alert and recovery emails
+    std::string generateAlertEmail(const std::vector<std::string>& logs) const;
+    std::string generateRecoveryEmail(const std::vector<std::string>& alertLogs, 
+                                     const std::vector<std::string>& recoveryLogs) const;
+    
     // Queue management
     void queueEmail(const EmailMessage& message);
     size_t getQueueSize() const;
+    uint64_t getDroppedCount() const { return droppedEmails.load(); }
     
     // Lifecycle
     bool start();
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <thread>
+#include <atomic>
+#include <unordered_map>
+#include <cstdint>
+#include "SystemMetrics.h"
+#include "Logger.h"
+
+// One archived sample: CPU, RAM and disk of a series at one second
+struct ArchiveSample {
+    int64_t timestampMs = 0;            // Wall clock, whole seconds
+    float values[3] = {};
+};
+
+// Identity of an archived series; the system series has pid 0 and no name
+struct ArchiveSeries {
+    bool system = true;
+    DWORD pid = 0;
+    ULONGLONG startTime = 0;
+    std::string name;
+    int64_t firstMs = 0;                // Span covered by the archive
+    int64_t lastMs = 0;
+    uint64_t pointCount = 0;
+};
+
+// Gorilla-style encoder for the points of one series within one block.
+//
+// Timestamps are whole seconds stored as delta-of-delta, so a steady
+// sampling period costs one bit per point. Each value is XORed with the
+// previous value of its column: an unchanged value costs one bit, and a
+// changed one only the bits between the leading and trailing zeros of the
+// XOR, reusing the previous bit window when it fits. Values are snapped to
+// 1/128 of a percentage point before encoding; that keeps the low mantissa
+// bits zero, which is what makes the XORs of noisy percentages short.
+class HistoryChunk {
+public:
+    static constexpr size_t VALUE_COUNT = 3;
+
+private:
+    std::vector<uint8_t> bytes;
+    uint8_t freeBits = 0;               // Unused low bits of the last byte
+    uint32_t pointCount = 0;
+    uint32_t firstSecond = 0;
+    uint32_t lastSecond = 0;
+    int64_t lastDelta = 0;
+    uint32_t lastBits[VALUE_COUNT] = {};
+    uint8_t leading[VALUE_COUNT] = {};  // Bit window of the last stored XOR
+    uint8_t trailing[VALUE_COUNT] = {};
+
+    void writeBits(uint64_t value, int count);
+
+public:
+    // Adds one point; seconds must not decrease
+    void append(uint32_t second, const float values[VALUE_COUNT]);
+
+    const std::vector<uint8_t>& getBytes() const { return bytes; }
+    uint32_t getPointCount() const { return pointCount; }
+    uint32_t getFirstSecond() const { return firstSecond; }
+    uint32_t getLastSecond() const { return lastSecond; }
+
+    // Decodes pointCount points; false if the data ends early
+    static bool decode(const uint8_t* data, size_t size, uint32_t pointCount, std::vector<ArchiveSample>& out);
+
+    // Value as stored: the nearest multiple of 1/128
+    static float quantize(double value);
+};
+
+// Background writer of the on-disk usage history (HISTORY_ARCHIVE_PATH).
+//
+// The main loop queues each cycle; the worker thread keeps one open chunk
+// per series for the current block (BLOCK_SECONDS) and seals them all when
+// a sample falls into the next block. Sealed chunks are appended to the
+// day's data file and then described in the day's index file, so the index
+// never points at data that was not written. A killed agent loses the open
+// block only. Files are per UTC day (history-YYYYMMDD.dat/.idx), which keeps
+// retention a matter of deleting whole days, percentile sketches (.qsk) included.
+class HistoryArchiveWriter {
+public:
+    static constexpr uint32_t BLOCK_SECONDS = 3600;
+    static constexpr size_t QUEUE_LIMIT = 600;
+
+private:
+    struct Cycle {
+        int64_t timestampMs = 0;
+        SystemUsage systemUsage;
+        std::vector<ProcessInfo> processes;
+    };
+
+    struct SeriesKey {
+        DWORD pid;
+        ULONGLONG startTime;
+        bool operator==(const SeriesKey& other) const { return pid == other.pid && startTime == other.startTime; }
+    };
+
+    struct SeriesKeyHash {
+        size_t operator()(const SeriesKey& key) const {
+            return static_cast<size_t>((key.startTime * 0x9E3779B97F4A7C15ull) ^ key.pid);
+        }
+    };
+
+    struct OpenChunk {
+        std::string name;
+        HistoryChunk chunk;
+    };
+
+    std::string directory;
+    BlockingQueue<Cycle> queue;
+    std::thread worker;
+    std::atomic<bool> running{false};
+    std::atomic<size_t> maxProcesses{100};
+    std::atomic<int> retentionDays{31};
+    std::atomic<uint64_t> pointCount{0};
+    std::atomic<uint64_t> bytesWritten{0};
+    std::atomic<uint64_t> droppedCycles{0};
+
+    // Worker thread state
+    OpenChunk systemChunk;
+    std::unordered_map<SeriesKey, OpenChunk, SeriesKeyHash> processChunks;
+    uint32_t openBlock = UINT32_MAX;
+    uint32_t openDay = UINT32_MAX;
+    std::ofstream dataFile;
+    std::ofstream indexFile;
+    uint64_t dataOffset = 0;
+
+    void workerThreadFunction();
+    void write(const Cycle& cycle);
+    void sealBlock();
+    bool openSegment(uint32_t day);
+    void removeExpiredSegments(uint32_t today);
+
+public:
+    HistoryArchiveWriter() = default;
+    ~HistoryArchiveWriter();
+
+    // Non-copyable
+    HistoryArchiveWriter(const HistoryArchiveWriter&) = delete;
+    HistoryArchiveWriter& operator=(const HistoryArchiveWriter&) = delete;
+
+    // Creates the directory and starts the worker; false if the directory cannot be created
+    bool start(const std::string& archiveDirectory);
+
+    // Writes the queued cycles and the open block, then joins the worker
+    void stop();
+    bool isRunning() const { return running; }
+
+    // Processes archived per cycle (highest usage first) and whole days kept (0 = keep all)
+    void setMaxProcesses(size_t count) { maxProcesses = count; }
+    void setRetentionDays(int days) { retentionDays = days; }
+
+    // Queues one cycle without blocking; dropped when the worker falls QUEUE_LIMIT cycles behind
+    void append(int64_t timestampMs, const SystemUsage& systemUsage, const std::vector<ProcessInfo>& processes);
+
+    const std::string& getDirectory() const { return directory; }
+    uint64_t getPointCount() const { return pointCount; }
+    uint64_t getBytesWritten() const { return bytesWritten; }
+    uint64_t getDroppedCount() const { return droppedCycles; }
+    size_t getQueueSize() const { return queue.size(); }
+
+    // File name stem of a UTC day (days since the Unix epoch), e.g. "history-20261018"
+    static std::string segmentName(uint32_t day);
+};
+
+// Reads the archive back. open() loads every index file; queries read and
+// decode only the chunks that overlap the requested range.
+class HistoryArchiveReader {
+private:
+    struct ChunkRef {
+        size_t series;
+        size_t segment;
+        uint64_t offset;
+        uint32_t length;
+        uint32_t pointCount;
+        uint32_t firstSecond;
+        uint32_t lastSecond;
+    };
+
+    std::string directory;
+    std::vector<std::string> segments;  // Data file paths
+    std::vector<ArchiveSeries> series;
+    std::vector<ChunkRef> chunks;       // In index order: oldest block first
+    bool truncated = false;
+
+    size_t findSeries(bool system, DWORD pid, ULONGLONG startTime) const;
+    std::vector<ArchiveSample> query(size_t seriesIndex, int64_t fromMs, int64_t toMs) const;
+
+public:
+    // False if the directory holds no readable index
+    bool open(const std::string& archiveDirectory);
+
+    const std::vector<ArchiveSeries>& getSeries() const { return series; }
+    size_t getChunkCount() const { return chunks.size(); }
+    bool isTruncated() const { return truncated; }     // An index ended inside a record
+
+    // Samples in [fromMs, toMs], oldest first
+    std::vector<ArchiveSample> querySystem(int64_t fromMs, int64_t toMs) const;
+    std::vector<ArchiveSample> queryProcess(DWORD pid, ULONGLONG startTime, int64_t fromMs, int64_t toMs) const;
+};
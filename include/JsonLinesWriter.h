@@ -0,0 +1,84 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cstdio>
+#include "SystemMetrics.h"
+
+// JSON Lines output (--output jsonl): one object per cycle for pipelines that
+// would otherwise parse the ===Start/TOTALS: blocks of the text log.
+//
+//   {"timestamp_ms":1792324800123,"time":"2026-10-18T12:00:00.123Z",
+//    "system":{"cpu":85.00,"ram":72.50,"disk":12.00},
+//    "totals":{"cpu":40.25,"ram":61.00,"disk":3.10},
+//    "processes":[{"pid":4242,"ppid":4,"name":"java.exe","cpu":30.00,"ram":10.00,"disk":0.00},...]}
+//
+// Percentages keep the two decimals of the text log. The line is built in a
+// buffer the writer keeps, numbers go through std::to_chars and each process
+// name is escaped once per (PID, start time) and copied from then on, so a
+// steady process table formats without allocating.
+class JsonLinesWriter {
+public:
+    static constexpr uint32_t NAME_CACHE_SWEEP_CYCLES = 64;     // Cycles between removals of exited processes
+
+private:
+    struct NameKey {
+        DWORD pid;
+        ULONGLONG startTime;
+        bool operator==(const NameKey& other) const { return pid == other.pid && startTime == other.startTime; }
+    };
+    struct NameKeyHash {
+        size_t operator()(const NameKey& key) const {
+            return std::hash<ULONGLONG>()(key.startTime * 0x9E3779B97F4A7C15ULL ^ key.pid);
+        }
+    };
+    struct CachedName {
+        std::string name;               // Raw name, to catch a reused key with another name
+        std::string escaped;            // JSON string body, without the quotes
+        uint64_t lastCycle = 0;
+    };
+
+    FILE* file = nullptr;
+    bool ownsFile = false;
+    std::string path;
+    std::string line;
+    std::unordered_map<NameKey, CachedName, NameKeyHash> names;
+    uint64_t cycle = 0;
+    uint64_t linesWritten = 0;
+    uint64_t bytesWritten = 0;
+    uint64_t failedWrites = 0;
+
+    const std::string& escapedName(const ProcessInfo& process);
+
+public:
+    JsonLinesWriter() = default;
+    ~JsonLinesWriter();
+
+    // Non-copyable
+    JsonLinesWriter(const JsonLinesWriter&) = delete;
+    JsonLinesWriter& operator=(const JsonLinesWriter&) = delete;
+
+    // Appends to the file at path; "-" or an empty path writes to stdout
+    bool open(const std::string& filePath);
+    void close();
+    bool isOpen() const { return file != nullptr; }
+    bool isStdout() const { return file != nullptr && !ownsFile; }
+    const std::string& getPath() const { return path; }
+
+    // Builds the line of one cycle, newline included; valid until the next call
+    const std::string& format(int64_t timestampMs, const SystemUsage& systemUsage,
+                              const std::vector<ProcessInfo>& processes);
+
+    // Formats the cycle, writes it and flushes, so a reader sees whole lines as they happen
+    bool write(int64_t timestampMs, const SystemUsage& systemUsage, const std::vector<ProcessInfo>& processes);
+
+    uint64_t getLineCount() const { return linesWritten; }
+    uint64_t getBytesWritten() const { return bytesWritten; }
+    uint64_t getFailedCount() const { return failedWrites; }
+    size_t getCachedNameCount() const { return names.size(); }
+
+    // Appends text as the body of a JSON string: quote, backslash and control characters escaped
+    static void appendEscaped(std::string& out, const std::string& text);
+};
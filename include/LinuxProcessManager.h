@@ -0,0 +1,89 @@
+#pragma once
+
+#ifdef __linux__
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <chrono>
+#include "ProcessManager.h"
+#include "ProcReader.h"
+
+// Linux process manager reading /proc/[pid]/stat, statm and io.
+//
+// The procfs root is configurable (PROC_ROOT) so the agent can read a host
+// /proc bind-mounted into a container, or a generated fixture tree.
+//
+// Per-process files are read in batches through an IProcReader: io_uring
+// submissions when available, plain open/pread/close otherwise. CPU, RAM and
+// disk values use the same scales as WindowsProcessManager: CPU is the share
+// of all CPU time since the previous pass, disk is the I/O delta relative to
+// a 1 GB/s baseline.
+class LinuxProcessManager : public IProcessManager {
+private:
+    // Counters kept from the previous pass
+    struct ProcessSample {
+        uint64_t cpuTicks = 0;          // utime + stime
+        uint64_t ioBytes = 0;           // read_bytes + write_bytes
+        uint64_t startTime = 0;         // Detects PID reuse
+        bool hasIoBytes = false;
+    };
+
+    static constexpr size_t FILES_PER_PROCESS = 3;
+
+    std::shared_ptr<ISystemMonitor> systemMonitor;
+    std::string procRoot = "/proc";
+    ProcReadEngine readEngine = ProcReadEngine::AUTO;
+    std::unique_ptr<IProcReader> reader;
+    std::unordered_map<DWORD, ProcessSample> lastSamples;
+    uint64_t lastSystemTicks = 0;
+    bool systemTicksInitialized = false;
+    std::chrono::steady_clock::time_point lastScanTime;
+    bool hasLastScanTime = false;
+    bool initialized = false;
+    long pageSize = 4096;
+
+    // Burst sampling of a few processes, independent of the full-pass baselines
+    std::unordered_map<DWORD, ProcessSample> burstSamples;
+    uint64_t lastBurstSystemTicks = 0;
+    std::chrono::steady_clock::time_point lastBurstTime;
+    bool hasBurstBaseline = false;
+
+    // Reused between passes
+    std::vector<DWORD> pids;
+    std::vector<std::string> paths;
+    std::vector<const char*> pathPointers;
+    std::vector<ProcReadResult> results;
+
+    void listPids();
+    void buildPaths();
+    void replaceFailedReader();
+    bool readSystemTicks(uint64_t& ticks) const;
+    uint64_t readTotalMemory() const;
+
+public:
+    explicit LinuxProcessManager(std::shared_ptr<ISystemMonitor> monitor,
+                                 ProcReadEngine engine = ProcReadEngine::AUTO);
+    ~LinuxProcessManager() override;
+
+    // Delete copy constructor and assignment operator
+    LinuxProcessManager(const LinuxProcessManager&) = delete;
+    LinuxProcessManager& operator=(const LinuxProcessManager&) = delete;
+
+    // IProcessManager interface implementation
+    std::vector<ProcessInfo> getAllProcesses() override;
+    std::vector<ProcessInfo> getAggregatedProcessTree(const std::vector<ProcessInfo>& processes) override;
+    bool initialize() override;
+    void shutdown() override;
+    std::vector<ProcessInfo> sampleProcesses(const std::vector<DWORD>& pids) override;
+
+    // Linux-specific methods
+    bool isInitialized() const { return initialized; }
+    void setProcRoot(const std::string& root) override;
+    const std::string& getProcRoot() const { return procRoot; }
+    const char* getReadEngineName() const { return reader ? reader->getName() : "none"; }
+    uint64_t getSyscallCount() const { return reader ? reader->getSyscallCount() : 0; }
+};
+
+#endif
@@ -9,6 +9,7 @@
 #include <condition_variable>
 #include <thread>
 #include <atomic>
+#include <chrono>
 #include <functional>
 #include "SystemMetrics.h"
 
@@ -16,6 +17,7 @@
 enum class LogMessageType {
     DEBUG,
     PROCESS_INFO,
+    REPORT,         // Preformatted block for the process log (burst capture)
     SHUTDOWN
 };
 
@@ -77,6 +79,21 @@ public:
         return true;
     }
     
+    // Like pop(), but gives up after timeout; false on timeout or once shut down and drained
+    template<typename Rep, typename Period>
+    bool popFor(T& item, const std::chrono::duration<Rep, Period>& timeout) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait_for(lock, timeout, [this] { return !queue_.empty() || shutdown_; });
+        
+        if (queue_.empty()) {
+            return false;
+        }
+        
+        item = std::move(queue_.front());
+        queue_.pop();
+        return true;
+    }
+    
     void shutdown() {
         std::lock_guard<std::mutex> lock(mutex_);
         shutdown_ = true;
@@ -174,9 +191,11 @@ public:
     virtual void debug(const std::string& message) = 0;
     virtual void logProcesses(const std::vector<ProcessInfo>& processes, 
                              const SystemUsage& systemUsage) = 0;
+    virtual void logReport(const std::string& report) = 0;
     virtual bool rotateIfNeeded() = 0;
     virtual void shutdown() = 0;
     virtual size_t getQueueSize() const = 0;
+    virtual uint64_t getDroppedCount() const = 0;   // Messages lost to a full queue
 };
 
 // Asynchronous file logger with blocking queue
@@ -186,6 +205,7 @@ private:
     BlockingQueue<LogMessage> messageQueue;
     std::thread workerThread;
     std::atomic<bool> running{false};
+    std::atomic<uint64_t> droppedMessages{0};
     mutable std::ofstream debugLogStream;
     
     // Date tracking for rotation
@@ -198,6 +218,7 @@ private:
     void writeDebugMessage(const std::string& content);
     void writeProcessMessage(const std::vector<ProcessInfo>& processes, 
                            const SystemUsage& systemUsage);
+    void writeReportMessage(const std::string& report);
     
     // File operations (synchronous, called from worker thread)
     std::string getCurrentTimeString() const;
@@ -229,9 +250,11 @@ public:
     void debug(const std::string& message) override;
     void logProcesses(const std::vector<ProcessInfo>& processes, 
                      const SystemUsage& systemUsage) override;
+    void logReport(const std::string& report) override;
     bool rotateIfNeeded() override;
     void shutdown() override;
     size_t getQueueSize() const override { return messageQueue.size(); }
+    uint64_t getDroppedCount() const override { return droppedMessages.load(); }
 
     // Configuration management
     const LogConfig& getConfig() const { return config; }
@@ -239,6 +262,10 @@ public:
     
     // Status methods
     bool isRunning() const { return running; }
+
+    // Text of one process log entry, start to end banner
+    static std::string formatProcessBlock(const std::vector<ProcessInfo>& processes, const SystemUsage& systemUsage,
+                                          const std::string& formattedTime);
 };
 
 // Logger factory for creating different types of loggers
@@ -266,7 +293,9 @@ public:
     // Convenience methods
     void debug(const std::string& message);
     void logProcesses(const std::vector<ProcessInfo>& processes, const SystemUsage& systemUsage);
+    void logReport(const std::string& report);
     bool rotateIfNeeded();
     void shutdown();
     size_t getQueueSize() const;
+    uint64_t getDroppedCount() const;
 };
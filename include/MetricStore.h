@@ -0,0 +1,145 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+#include "SystemMetrics.h"
+
+// Embedded multi-resolution history of system and per-process usage.
+//
+// Every series keeps three fixed rings: raw samples at 1 s resolution and
+// per-minute and per-hour rollups holding the min, average and max of CPU,
+// RAM and disk. Rollups are updated on insert (running mean), so a query
+// never rescans raw samples. A slot is addressed by its bucket number modulo
+// the ring size and stamped with the bucket, so stale slots are recognised
+// without clearing them.
+//
+// Per-process series are keyed by (pid, start time), so a reused PID starts
+// a new series. Once maxProcessSeries series exist, the least recently
+// updated one (usually an exited process) is evicted and its rings reused.
+// Rings are allocated when a series is created and never grow, so memory
+// stays close to estimateMemoryBytes(maxProcessSeries). Not thread-safe: the
+// main loop records and reads.
+class MetricStore {
+public:
+    enum class Resolution : uint8_t {
+        SECOND,
+        MINUTE,
+        HOUR
+    };
+
+    // CPU, RAM and disk, in AlertMetric order
+    static constexpr size_t METRIC_COUNT = 3;
+
+    // Ring sizes of one series
+    struct Capacity {
+        uint32_t seconds;
+        uint32_t minutes;
+        uint32_t hours;
+    };
+    static constexpr Capacity SYSTEM_CAPACITY = { 3600, 1440, 168 };   // 1 h, 24 h, 7 days
+    static constexpr Capacity PROCESS_CAPACITY = { 60, 30, 24 };       // 1 min, 30 min, 24 h
+    static constexpr size_t DEFAULT_MAX_PROCESS_SERIES = 5000;
+
+    // One bucket of a series; raw seconds have min = avg = max
+    struct Point {
+        int64_t timestampMs = 0;        // Start of the bucket
+        uint32_t count = 0;             // Samples in the bucket
+        float min[METRIC_COUNT] = {};
+        float avg[METRIC_COUNT] = {};
+        float max[METRIC_COUNT] = {};
+    };
+
+private:
+    static constexpr uint32_t EMPTY_BUCKET = UINT32_MAX;
+
+    struct SecondSlot {
+        uint32_t bucket = EMPTY_BUCKET;
+        float value[METRIC_COUNT] = {};
+    };
+
+    struct RollupSlot {
+        uint32_t bucket = EMPTY_BUCKET;
+        uint32_t count = 0;
+        float min[METRIC_COUNT] = {};
+        float avg[METRIC_COUNT] = {};
+        float max[METRIC_COUNT] = {};
+    };
+
+    // Rings of one series
+    struct Series {
+        std::vector<SecondSlot> seconds;
+        std::vector<RollupSlot> minutes;
+        std::vector<RollupSlot> hours;
+        uint32_t lastSecond = EMPTY_BUCKET;     // Newest second bucket recorded
+
+        void allocate(const Capacity& capacity);
+        void clear();
+        void add(uint32_t second, const float values[METRIC_COUNT]);
+        void query(Resolution resolution, int64_t fromMs, int64_t toMs, std::vector<Point>& out) const;
+    };
+
+    struct ProcessKey {
+        DWORD pid;
+        ULONGLONG startTime;
+        bool operator==(const ProcessKey& other) const { return pid == other.pid && startTime == other.startTime; }
+    };
+
+    struct ProcessKeyHash {
+        size_t operator()(const ProcessKey& key) const {
+            return static_cast<size_t>((key.startTime * 0x9E3779B97F4A7C15ull) ^ key.pid);
+        }
+    };
+
+    static constexpr uint32_t NO_SERIES = UINT32_MAX;
+
+    // Pooled per-process series, linked in least recently updated order
+    struct ProcessSeries {
+        Series series;
+        ProcessKey key = { 0, 0 };
+        uint32_t previous = NO_SERIES;          // Towards the most recent
+        uint32_t next = NO_SERIES;              // Towards the least recent
+    };
+
+    Series systemSeries;
+    std::vector<ProcessSeries> processSeries;
+    std::unordered_map<ProcessKey, uint32_t, ProcessKeyHash> processIndex;
+    uint32_t mostRecent = NO_SERIES;
+    uint32_t leastRecent = NO_SERIES;
+    size_t maxProcessSeries = DEFAULT_MAX_PROCESS_SERIES;
+    uint64_t evictedCount = 0;
+
+    void unlink(uint32_t index);
+    void linkMostRecent(uint32_t index);
+    uint32_t acquireSeries(const ProcessKey& key);
+
+public:
+    MetricStore();
+
+    // Non-copyable (large pools)
+    MetricStore(const MetricStore&) = delete;
+    MetricStore& operator=(const MetricStore&) = delete;
+
+    // Caps the number of per-process series; lowering it evicts the least recent ones
+    void setMaxProcessSeries(size_t count);
+    size_t getMaxProcessSeries() const { return maxProcessSeries; }
+
+    // Records one cycle; timestamps are wall clock milliseconds
+    void recordSystem(int64_t timestampMs, const SystemUsage& systemUsage);
+    void recordProcesses(int64_t timestampMs, const std::vector<ProcessInfo>& processes);
+
+    // Buckets of [fromMs, toMs] that hold samples, oldest first
+    std::vector<Point> querySystem(Resolution resolution, int64_t fromMs, int64_t toMs) const;
+    std::vector<Point> queryProcess(DWORD pid, ULONGLONG startTime, Resolution resolution,
+                                    int64_t fromMs, int64_t toMs) const;
+
+    // Combines points into one (count-weighted average)
+    static Point summarize(const std::vector<Point>& points);
+
+    // Inspection
+    size_t getProcessSeriesCount() const { return processIndex.size(); }
+    uint64_t getEvictedCount() const { return evictedCount; }
+    size_t getMemoryBytes() const;
+    static size_t estimateMemoryBytes(size_t processSeriesCount);
+};
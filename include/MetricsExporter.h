@@ -0,0 +1,76 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "SystemMetrics.h"
+
+// Prometheus scrape endpoint (METRICS_PORT) on the loopback interface.
+//
+// The main loop renders the exposition once per cycle with render() and
+// hands it to publish(), which builds the complete HTTP response and swaps
+// it in as a shared immutable buffer. Every scrape of that cycle sends the
+// same buffer, so the cost of a scrape does not depend on the number of
+// processes and the collection path never waits for a scraper. The server
+// thread multiplexes non-blocking sockets with poll(), answers one request
+// per connection (Connection: close) and drops clients that stall for
+// CLIENT_TIMEOUT_MS or exceed MAX_CLIENTS.
+class MetricsExporter {
+public:
+    static constexpr size_t MAX_CLIENTS = 64;
+    static constexpr int CLIENT_TIMEOUT_MS = 5000;
+    static constexpr size_t MAX_REQUEST_BYTES = 8192;
+    static constexpr int POLL_INTERVAL_MS = 100;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Client {
+        intptr_t socket;
+        std::string request;
+        std::shared_ptr<const std::string> response;
+        size_t sent = 0;
+        Clock::time_point accepted;
+    };
+
+    intptr_t listenSocket = -1;
+    uint16_t port = 0;
+    std::thread worker;
+    std::atomic<bool> running{false};
+    mutable std::mutex responseMutex;
+    std::shared_ptr<const std::string> metricsResponse;     // Whole HTTP response of the latest cycle
+    std::atomic<uint64_t> scrapeCount{0};
+    std::atomic<uint64_t> rejectedCount{0};
+
+    void serverThreadFunction();
+    std::shared_ptr<const std::string> respond(const std::string& request);
+
+public:
+    MetricsExporter() = default;
+    ~MetricsExporter();
+
+    // Non-copyable
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    // Listens on 127.0.0.1:requestedPort (0 = any free port); false if the port cannot be bound
+    bool start(uint16_t requestedPort);
+    void stop();
+    bool isRunning() const { return running; }
+    uint16_t getPort() const { return port; }
+
+    // Replaces the exposition served to scrapers
+    void publish(const std::string& exposition);
+
+    // Prometheus text format: system gauges and the topProcesses heaviest processes
+    static std::string render(int64_t timestampMs, const SystemUsage& systemUsage,
+                              const std::vector<ProcessInfo>& processes, size_t topProcesses);
+
+    uint64_t getScrapeCount() const { return scrapeCount; }
+    uint64_t getRejectedCount() const { return rejectedCount; }     // Over MAX_CLIENTS, bad or stalled requests
+};
@@ -0,0 +1,105 @@
+#pragma once
+
+#ifdef __linux__
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+// Batched readers for small procfs files (/proc/[pid]/stat, statm, io).
+//
+// A reader owns a pool of fixed-size buffers, one per file of a batch.
+// readBatch() opens, reads and closes every file of the batch; results point
+// into the pool and stay valid until the next call. Each reader counts the
+// system calls it issues so engines can be compared per sample.
+
+// Collection engine selection
+enum class ProcReadEngine {
+    AUTO = 0,        // io_uring when the kernel allows it, pread otherwise
+    IO_URING = 1,    // io_uring only; creation fails when unavailable
+    PREAD = 2        // open/pread/close per file
+};
+
+// Result of one file read
+struct ProcReadResult {
+    const char* data = nullptr;
+    int length = -1;                  // Bytes read, negative errno on failure
+};
+
+// Abstract base class for procfs batch readers
+class IProcReader {
+protected:
+    static constexpr size_t SLOT_SIZE = 1024;     // Largest of stat/statm/io stays well below this
+
+    std::vector<char> buffers;                     // maxBatch() slots of SLOT_SIZE bytes
+    uint64_t syscallCount = 0;
+
+    char* slot(size_t index) { return buffers.data() + index * SLOT_SIZE; }
+
+    // open/pread/close of one file into slot(index)
+    void preadFile(const char* path, size_t index, ProcReadResult& result);
+
+public:
+    virtual ~IProcReader() = default;
+
+    // Reads count files (count <= maxBatch()); data is NUL-terminated
+    virtual void readBatch(const char* const* paths, size_t count, ProcReadResult* results) = 0;
+    virtual size_t maxBatch() const = 0;
+    virtual const char* getName() const = 0;
+
+    // False once the reader has failed for good; the failing batch is still
+    // served, later batches belong to another reader
+    virtual bool isUsable() const { return true; }
+
+    uint64_t getSyscallCount() const { return syscallCount; }
+};
+
+// Plain reader: three system calls per file
+class PreadProcReader : public IProcReader {
+public:
+    static constexpr size_t BATCH_SIZE = 192;
+
+    PreadProcReader();
+
+    void readBatch(const char* const* paths, size_t count, ProcReadResult* results) override;
+    size_t maxBatch() const override { return BATCH_SIZE; }
+    const char* getName() const override { return "pread"; }
+};
+
+// io_uring reader: one submission each for the opens, reads and closes of a
+// batch, reading into buffers registered with the ring
+class UringProcReader : public IProcReader {
+private:
+    struct Ring;
+    std::unique_ptr<Ring> ring;
+    std::vector<int> descriptors;
+
+    bool submitAndWait(unsigned count, int* results);
+    unsigned reapCompletions(unsigned count, int* results);
+
+    // Drops the ring after a failed submission and serves the batch with pread
+    void fallBack(const char* const* paths, size_t count, ProcReadResult* results);
+
+public:
+    static constexpr size_t BATCH_SIZE = 192;
+
+    UringProcReader();
+    ~UringProcReader() override;
+
+    // Sets up the ring; false when io_uring or a required opcode is unavailable
+    bool initialize();
+
+    void readBatch(const char* const* paths, size_t count, ProcReadResult* results) override;
+    size_t maxBatch() const override { return BATCH_SIZE; }
+    const char* getName() const override { return "io_uring"; }
+    bool isUsable() const override { return ring != nullptr; }
+};
+
+// Reader factory
+class ProcReaderFactory {
+public:
+    static std::unique_ptr<IProcReader> create(ProcReadEngine engine);
+};
+
+#endif
@@ -1,12 +1,18 @@
 #pragma once
 
+#ifdef _WIN32
 #include <windows.h>
+#endif
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <set>
 #include <memory>
+#include <chrono>
 #include "SystemMetrics.h"
 #include "SystemMonitor.h"
+#include "ThreadPool.h"
+#include "ProcessTiers.h"
 
 // Abstract base class for process management
 class IProcessManager {
@@ -16,14 +22,54 @@ public:
     virtual std::vector<ProcessInfo> getAggregatedProcessTree(const std::vector<ProcessInfo>& processes) = 0;
     virtual bool initialize() = 0;
     virtual void shutdown() = 0;
+
+    // Number of threads used to collect per-process metrics (0 = automatic, 1 = serial)
+    virtual void setScanThreads(int threads) { (void)threads; }
+    // Hot/cold sampling rates for per-process metrics
+    virtual void setTierPolicy(const ProcessTierPolicy& policy) { (void)policy; }
+    // procfs mount to read (Linux collector only)
+    virtual void setProcRoot(const std::string& root) { (void)root; }
+    // Samples only the given processes (burst capture). Names are not filled in; rates cover
+    // the time since the previous sampleProcesses call and leave full-pass baselines untouched.
+    virtual std::vector<ProcessInfo> sampleProcesses(const std::vector<DWORD>& pids);
 };
 
+#ifdef _WIN32
 // Concrete Windows process manager
 class WindowsProcessManager : public IProcessManager {
 private:
+    // Counters read for one process, kept as the baseline of the next pass
+    struct ProcessSample {
+        ULONGLONG cpuTime = 0;          // Kernel + user time, 100 ns units
+        ULONGLONG ioBytes = 0;          // Read + write transfer count
+        double ramPercent = 0.0;        // From the last full sample
+        TierState tierState;
+        bool hasCpuTime = false;
+        bool hasIoBytes = false;
+        bool fullSampled = false;       // Memory and I/O were read this pass
+    };
+
+    // Counters kept between burst samples of a few processes
+    struct BurstBaseline {
+        ULONGLONG cpuTime = 0;
+        ULONGLONG ioBytes = 0;
+        bool hasCpuTime = false;
+        bool hasIoBytes = false;
+    };
+
+    // Values shared read-only by all workers of one pass
+    struct ScanContext {
+        DWORDLONG totalPhysicalMemory = 0;
+        ULONGLONG systemTimeDelta = 0;  // Kernel + user delta since the last pass (0 = unknown)
+        DWORD processorCount = 1;
+        double elapsedSeconds = 1.0;    // Measured time since the last pass
+    };
+
+    // Processes handled per work-stealing chunk
+    static constexpr size_t SCAN_CHUNK_SIZE = 64;
+
     std::shared_ptr<ISystemMonitor> systemMonitor;
-    std::map<DWORD, ULONGLONG> lastIOBytes;
-    std::map<DWORD, FILETIME> lastProcessTimes;
+    std::unordered_map<DWORD, ProcessSample> lastSamples;
     bool initialized = false;
     
     // System timing for accurate CPU calculation
@@ -31,14 +77,31 @@ private:
     FILETIME lastSystemKernelTime;
     FILETIME lastSystemUserTime;
     bool systemTimesInitialized = false;
+    std::chrono::steady_clock::time_point lastScanTime;
+    bool hasLastScanTime = false;
+
+    // Parallel scan
+    int scanThreads = 0;
+    std::unique_ptr<ThreadPool> scanPool;
+
+    // Tiered sampling
+    ProcessTierPolicy tierPolicy;
+    size_t lastHotProcesses = 0;
+    size_t lastFullSamples = 0;
+
+    // Burst sampling
+    std::unordered_map<DWORD, BurstBaseline> burstBaselines;
+    ULONGLONG lastBurstSystemTime = 0;
+    std::chrono::steady_clock::time_point lastBurstTime;
+    bool hasBurstBaseline = false;
 
     // Helper methods
     std::string convertProcessNameToString(const TCHAR* name) const;
     std::map<DWORD, FILETIME> captureProcessCpuTimes() const;
-    bool calculateProcessMetrics(ProcessInfo& processInfo, HANDLE hProcess, 
-                                const std::map<DWORD, FILETIME>& lastTimes,
-                                const std::map<DWORD, FILETIME>& currentTimes,
-                                DWORDLONG totalPhysicalMemory);
+    bool calculateProcessMetrics(ProcessInfo& processInfo, HANDLE hProcess, const ScanContext& context,
+                                const ProcessSample* previous, ProcessSample& sample) const;
+    void scanRange(std::vector<ProcessInfo>& processes, std::vector<ProcessSample>& samples,
+                   const ScanContext& context, size_t begin, size_t end) const;
 
 public:
     explicit WindowsProcessManager(std::shared_ptr<ISystemMonitor> monitor);
@@ -53,11 +116,21 @@ public:
     std::vector<ProcessInfo> getAggregatedProcessTree(const std::vector<ProcessInfo>& processes) override;
     bool initialize() override;
     void shutdown() override;
+    void setScanThreads(int threads) override;
+    void setTierPolicy(const ProcessTierPolicy& policy) override { tierPolicy = policy; }
+    std::vector<ProcessInfo> sampleProcesses(const std::vector<DWORD>& pids) override;
+
+    // One collection pass; rates cover the time since the previous pass
+    std::vector<ProcessInfo> scanProcesses();
 
     // Windows-specific methods
     bool isInitialized() const { return initialized; }
+    size_t getScanThreadCount() const { return scanPool ? scanPool->size() : 0; }
+    size_t getLastHotProcessCount() const { return lastHotProcesses; }
+    size_t getLastFullSampleCount() const { return lastFullSamples; }
     void clearCache();
 };
+#endif
 
 // Process aggregator utility class
 class ProcessTreeAggregator {
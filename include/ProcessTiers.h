@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+
+// Hot/cold classification for tiered per-process sampling.
+//
+// Every process gets a cheap liveness and CPU time check each cycle. Hot
+// processes also get the full memory and I/O read every cycle; cold ones
+// only every coldRefreshCycles cycles. A process is promoted as soon as its
+// CPU share reaches hotCpuPercent and demoted after demoteAfterCycles quiet
+// cycles, so the per-cycle cost follows the number of active processes.
+
+enum class SamplingTier : uint8_t {
+    HOT = 0,
+    COLD = 1
+};
+
+// Per-process tier bookkeeping, carried from one cycle to the next
+struct TierState {
+    SamplingTier tier = SamplingTier::HOT;
+    uint16_t quietCycles = 0;          // Consecutive cycles without activity
+    uint16_t cyclesSinceFull = 0;      // Cycles since memory and I/O were last read
+};
+
+class ProcessTierPolicy {
+private:
+    double hotCpuPercent = 0.5;
+    int demoteAfterCycles = 3;
+    int coldRefreshCycles = 10;
+
+public:
+    ProcessTierPolicy() = default;
+    ProcessTierPolicy(double hotCpu, int demoteAfter, int coldRefresh)
+        : hotCpuPercent(hotCpu), demoteAfterCycles(demoteAfter), coldRefreshCycles(coldRefresh) {}
+
+    // Getters
+    double getHotCpuPercent() const { return hotCpuPercent; }
+    int getDemoteAfterCycles() const { return demoteAfterCycles; }
+    int getColdRefreshCycles() const { return coldRefreshCycles; }
+
+    // Setters
+    void setHotCpuPercent(double value) { hotCpuPercent = value; }
+    void setDemoteAfterCycles(int value) { demoteAfterCycles = value; }
+    void setColdRefreshCycles(int value) { coldRefreshCycles = value; }
+
+    // A refresh interval of one cycle reads every process in full
+    bool isEnabled() const { return coldRefreshCycles > 1; }
+
+    // Decides after the CPU time check whether memory and I/O are read this cycle
+    bool needsFullSample(const TierState& state, bool known, double cpuPercent) const;
+
+    // Tier state for the next cycle; active means CPU or I/O activity this cycle
+    TierState advance(const TierState& state, bool fullSampled, bool active) const;
+
+    bool isActive(double cpuPercent, double diskPercent) const {
+        return cpuPercent >= hotCpuPercent || diskPercent > 0.0;
+    }
+
+    bool operator==(const ProcessTierPolicy& other) const {
+        return hotCpuPercent == other.hotCpuPercent && demoteAfterCycles == other.demoteAfterCycles &&
+               coldRefreshCycles == other.coldRefreshCycles;
+    }
+    bool operator!=(const ProcessTierPolicy& other) const { return !(*this == other); }
+};
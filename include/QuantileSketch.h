@@ -0,0 +1,113 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include "SystemMetrics.h"
+
+// DDSketch quantile estimator with 1% relative accuracy.
+//
+// A value v > 0 lands in bucket ceil(log_gamma(v)) with gamma = 1.0202, so
+// every quantile is returned within 1% of a value that was actually added.
+// Buckets are a dense run of counters starting at `offset`; adding is a log
+// and an increment, and merging two sketches adds their counters, so hourly
+// sketches combine into daily or weekly ones without error growth. Values
+// below MIN_VALUE (idle CPU, negative readings) count as zero. Beyond
+// MAX_BUCKETS the lowest buckets are collapsed, which only affects the lowest
+// quantiles.
+class QuantileSketch {
+public:
+    static constexpr double RELATIVE_ACCURACY = 0.01;
+    static constexpr double MIN_VALUE = 1e-3;
+    static constexpr size_t MAX_BUCKETS = 2048;
+
+private:
+    std::vector<uint32_t> buckets;
+    int32_t offset = 0;                 // Bucket index of buckets[0]
+    uint64_t zeroCount = 0;
+    uint64_t count = 0;
+    double minValue = 0.0;
+    double maxValue = 0.0;
+    double sum = 0.0;
+
+    void addToBucket(int32_t index, uint64_t amount);
+
+public:
+    void add(double value);
+    void merge(const QuantileSketch& other);
+
+    // Value at quantile q in [0, 1]; 0 for an empty sketch
+    double quantile(double q) const;
+
+    uint64_t getCount() const { return count; }
+    double getMin() const { return minValue; }
+    double getMax() const { return maxValue; }
+    double getMean() const { return count > 0 ? sum / static_cast<double>(count) : 0.0; }
+    size_t getBucketCount() const { return buckets.size(); }
+
+    // Compact binary form (varint counters); deserialize advances position
+    void serialize(std::string& out) const;
+    bool deserialize(const std::vector<uint8_t>& data, size_t& position);
+};
+
+// CPU and RAM sketches of one series over a window
+struct PercentileSeries {
+    std::string name;                   // Process name; empty for the system totals
+    QuantileSketch cpu;
+    QuantileSketch ram;
+};
+
+// Merged sketches of a time window, as returned by PercentileStore::load
+struct PercentileWindow {
+    int64_t fromMs = 0;                 // First and last hour covered (hour starts)
+    int64_t toMs = 0;
+    uint32_t hourCount = 0;
+    PercentileSeries system;
+    std::vector<PercentileSeries> processes;
+};
+
+// Hourly CPU/RAM percentile sketches for the system and each process name.
+//
+// Each cycle adds the system usage and, per process name, the usage summed
+// over its instances, so a service is followed across restarts and PID
+// changes. When a cycle falls into the next hour the finished hour is
+// appended to the day's sketch file (history-YYYYMMDD.qsk, next to the
+// history archive) as one length-prefixed record; a record cut short by a
+// crash is skipped when reading. Queries merge the hours of a window.
+class PercentileStore {
+public:
+    static constexpr uint32_t HOUR_SECONDS = 3600;
+    static constexpr size_t MAX_PROCESS_NAMES = 2000;
+
+private:
+    std::string directory;              // Empty = not persisted
+    int64_t hourStartMs = -1;           // Hour being filled; -1 before the first cycle
+    PercentileSeries system;
+    std::vector<PercentileSeries> processes;
+    std::unordered_map<std::string, size_t> nameIndex;
+    std::unordered_map<std::string, std::pair<double, double>> cycleTotals;   // Reused per cycle
+    uint64_t hoursWritten = 0;
+
+public:
+    // Directory of the sketch files (the history archive directory)
+    void setDirectory(const std::string& path) { directory = path; }
+    bool isEnabled() const { return !directory.empty(); }
+
+    // Adds one cycle; writes the previous hour first when the hour changes
+    void record(int64_t timestampMs, const SystemUsage& systemUsage, const std::vector<ProcessInfo>& processes);
+
+    // Appends the hour being filled to its day file and starts a new one; false on a write error
+    bool flush();
+
+    // Current (unwritten) hour, for inspection
+    const PercentileSeries& getSystem() const { return system; }
+    const std::vector<PercentileSeries>& getProcesses() const { return processes; }
+    uint64_t getHoursWritten() const { return hoursWritten; }
+
+    // Merges the last `hours` hours present in the directory; false if none are found
+    static bool load(const std::string& path, uint32_t hours, PercentileWindow& window);
+
+    // p50/p95/p99 table: system first, then the `rows` processes with the highest CPU p95
+    static std::string formatTable(const PercentileWindow& window, size_t rows);
+};
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <unordered_map>
+#include <cstdint>
+#include "SystemMetrics.h"
+#include "MetricStore.h"
+
+// Message types of the query protocol; replies have the high bit set
+enum class QueryMessage : uint8_t {
+    TOP = 0x01,                 // uint8 metric (AlertMetric order), uint16 count
+    HISTORY = 0x02,             // uint32 pid, uint8 resolution (MetricStore order), uint32 seconds
+    SUBSCRIBE = 0x03,           // (no body)
+    UNSUBSCRIBE = 0x04,         // (no body)
+    TOP_RESULT = 0x81,          // int64 timestampMs, uint16 count, count x process record
+    HISTORY_RESULT = 0x82,      // uint32 pid, uint8 resolution, uint32 count, count x history point
+    SUBSCRIBED = 0x83,          // (no body); the first DELTA holds every process
+    DELTA = 0x84,               // Pushed every cycle, see QueryServer
+    UNSUBSCRIBED = 0x85,        // (no body)
+    REJECTED = 0xFF             // uint8 QueryError, uint16 length, message
+};
+
+enum class QueryError : uint8_t {
+    BAD_REQUEST = 1,
+    UNKNOWN_PID = 2,
+    NOT_READY = 3,              // No cycle published yet
+    BUSY = 4                    // Too many history requests waiting
+};
+
+// Local query endpoint (QUERY_SOCKET_PATH) on a Unix-domain socket.
+//
+// Every frame is a little-endian uint32 length followed by that many bytes:
+// uint8 QueryMessage, uint32 request id, body. Replies echo the request id;
+// pushed DELTA frames carry request id 0. Values are little-endian, percents
+// are float32 rounded to hundredths and names are a uint8 length followed
+// by the bytes.
+//   process record  uint32 pid, uint32 ppid, float cpu, ram, disk, name
+//   history point   int64 timestampMs, uint32 samples, float avg cpu, ram, disk,
+//                   float max cpu, ram, disk
+//   DELTA           int64 timestampMs, uint64 cycle, float cpu, ram, disk,
+//                   uint32 n, n x process record (new, or replaces the same pid),
+//                   uint32 n, n x (uint32 pid, float cpu, ram, disk) (changed usage),
+//                   uint32 n, n x uint32 pid (exited)
+//
+// publish() only hands the cycle's processes to the server thread, which
+// sorts them, diffs them against the previous cycle and encodes one DELTA
+// shared by every subscriber. MetricStore is owned by the main loop, so
+// HISTORY requests are queued and answered by answerHistoryRequests() once
+// per cycle. The server thread multiplexes clients with epoll on Linux and
+// poll()/WSAPoll elsewhere; a client whose unsent output passes
+// MAX_QUEUED_BYTES is disconnected rather than slowing the others.
+class QueryServer {
+public:
+    static constexpr size_t MAX_CLIENTS = 64;
+    static constexpr size_t MAX_REQUEST_BYTES = 64;
+    static constexpr size_t MAX_QUEUED_BYTES = 4 * 1024 * 1024;
+    static constexpr size_t MAX_PENDING_HISTORY = 256;
+    static constexpr int POLL_INTERVAL_MS = 100;
+
+    // A HISTORY request waiting for the main loop
+    struct HistoryRequest {
+        uint64_t client;
+        uint32_t requestId;
+        uint32_t pid;
+        MetricStore::Resolution resolution;
+        uint32_t seconds;
+    };
+
+private:
+    struct Entry {
+        uint32_t pid;
+        uint32_t ppid;
+        ULONGLONG startTime;
+        float usage[MetricStore::METRIC_COUNT];
+        std::string name;
+    };
+
+    struct Snapshot {
+        int64_t timestampMs = 0;
+        uint64_t cycle = 0;
+        float usage[MetricStore::METRIC_COUNT] = {};
+        std::vector<Entry> processes;           // Sorted by pid on the server thread
+    };
+
+    struct Client {
+        intptr_t socket;
+        std::string input;                      // Bytes of incomplete requests
+        std::deque<std::shared_ptr<const std::string>> output;
+        size_t sentOfFront = 0;
+        size_t queuedBytes = 0;
+        bool subscribed = false;
+        bool wantWrite = false;
+        bool closing = false;
+    };
+
+    class Poller;
+
+    std::string socketPath;
+    intptr_t listenSocket = -1;
+    std::unique_ptr<Poller> poller;
+    std::thread worker;
+    std::atomic<bool> running{false};
+
+    // Server thread only
+    std::unordered_map<uint64_t, Client> clients;
+    uint64_t nextClientId = 1;
+    std::shared_ptr<const Snapshot> current;
+
+    // Handed between the main loop and the server thread
+    std::mutex exchangeMutex;
+    std::shared_ptr<Snapshot> publishedSnapshot;
+    std::vector<HistoryRequest> pendingHistory;
+    std::vector<std::pair<uint64_t, std::shared_ptr<const std::string>>> historyReplies;
+    uint64_t publishCount = 0;
+
+    std::atomic<uint64_t> requestCount{0};
+    std::atomic<uint64_t> droppedCount{0};
+
+    void serverThreadFunction();
+    void acceptClients();
+    void readClient(uint64_t id, Client& client);
+    void handleRequest(uint64_t id, Client& client, const uint8_t* frame, size_t length);
+    void applySnapshot(std::shared_ptr<Snapshot> snapshot);
+    void enqueue(uint64_t id, Client& client, std::shared_ptr<const std::string> frame);
+    void flushClient(uint64_t id, Client& client);
+    void closeClient(uint64_t id);
+
+    static std::shared_ptr<const std::string> encodeTop(const Snapshot& snapshot, uint32_t requestId,
+                                                        size_t metric, size_t count);
+    static std::shared_ptr<const std::string> encodeDelta(const Snapshot* previous, const Snapshot& next);
+
+public:
+    QueryServer();
+    ~QueryServer();
+
+    // Non-copyable
+    QueryServer(const QueryServer&) = delete;
+    QueryServer& operator=(const QueryServer&) = delete;
+
+    // Listens on the socket file `path`, replacing a stale one; false on failure
+    bool start(const std::string& path);
+    void stop();
+    bool isRunning() const { return running; }
+
+    // Hands one cycle to the server thread; processes are per instance, before aggregation
+    void publish(int64_t timestampMs, const SystemUsage& systemUsage, const std::vector<ProcessInfo>& processes);
+
+    // Answers queued HISTORY requests from the main loop's store
+    void answerHistoryRequests(const MetricStore& metricStore, const std::vector<ProcessInfo>& processes,
+                               int64_t nowMs);
+
+    uint64_t getRequestCount() const { return requestCount; }
+    uint64_t getDroppedCount() const { return droppedCount; }      // Over MAX_CLIENTS, bad frames or slow readers
+};
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+
+// Differential full-screen renderer for the top-style and compact displays.
+//
+// A frame is built line by line, then present() compares it with the frame
+// currently on screen and writes only the changed spans of changed rows,
+// using ANSI/VT escape sequences collected into a single write. Windows
+// consoles get ENABLE_VIRTUAL_TERMINAL_PROCESSING; consoles without VT
+// support fall back to positioned console writes of the same spans.
+//
+// Redraws are throttled by a frame budget (minimum time between two frames)
+// instead of a fixed refresh gate.
+class ScreenRenderer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Console color attributes (Windows palette: bit 0 blue, 1 green, 2 red, 3 bright)
+    static constexpr uint8_t COLOR_DEFAULT = 7;
+
+private:
+    struct Row {
+        std::string text;
+        std::vector<uint8_t> colors;   // One attribute per character
+    };
+
+    // Changed part of one row
+    struct Span {
+        int row;
+        size_t begin;
+        size_t end;
+        bool clearToEnd;               // Row got shorter, erase the remainder
+    };
+
+    std::vector<Row> frontRows;        // What is on screen
+    std::vector<Row> backRows;         // Frame being built
+    size_t frontCount = 0;
+    size_t backCount = 0;
+    std::vector<Span> spans;
+    std::string output;
+
+    int screenWidth = 80;
+    int screenHeight = 25;
+    bool vtEnabled = false;
+    bool initialized = false;
+    bool fullRedraw = true;
+    bool cursorHidden = false;
+    bool memoryOnly = false;           // Keep the VT output instead of writing it
+
+    std::chrono::milliseconds frameBudget{1000};
+    Clock::time_point nextFrame;
+    size_t lastBytesWritten = 0;
+
+    void queryScreenSize();
+    void diffRows();
+    void writeSpansVT();
+    void writeSpansLegacy();
+    void writeOutput(const char* data, size_t length);
+
+public:
+    ScreenRenderer();
+    ~ScreenRenderer();
+
+    // Non-copyable
+    ScreenRenderer(const ScreenRenderer&) = delete;
+    ScreenRenderer& operator=(const ScreenRenderer&) = delete;
+
+    // Enables VT processing when available and hides the cursor
+    bool initialize();
+    // Restores the cursor and moves it below the last rendered frame
+    void shutdown();
+
+    // Frame construction
+    void beginFrame();
+    void addLine(const std::string& text = "", uint8_t color = COLOR_DEFAULT);
+    void append(const std::string& text, uint8_t color = COLOR_DEFAULT);   // Appends to the last line
+
+    // Writes the differences to the previous frame; returns bytes written
+    size_t present();
+
+    // Renders VT sequences for a fixed screen size into getLastOutput()
+    // instead of the console; calling it again with another size acts as a
+    // window resize. Used by tests.
+    void renderToMemory(int width, int height);
+    const std::string& getLastOutput() const { return output; }
+
+    // Forces a full redraw on the next present (mode change, foreign output)
+    void invalidate() { fullRedraw = true; }
+
+    // Frame budget
+    void setFrameBudget(std::chrono::milliseconds budget) { frameBudget = budget; }
+    bool isFrameDue(Clock::time_point now = Clock::now()) const { return fullRedraw || now >= nextFrame; }
+
+    // Status
+    bool isVirtualTerminal() const { return vtEnabled; }
+    int getWidth() const { return screenWidth; }
+    int getHeight() const { return screenHeight; }
+    size_t getLastBytesWritten() const { return lastBytesWritten; }
+};
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <string>
+#include <chrono>
+#include <cstdint>
+
+// Resource footprint of the SystemMonitor process itself
+struct SelfStats {
+    double cpuPercent = 0.0;            // Share of total machine CPU since the previous sample
+    uint64_t rssBytes = 0;              // Working set / resident set
+    uint32_t threadCount = 0;
+    uint32_t handleCount = 0;           // Open handles (Windows) or file descriptors (Linux)
+    size_t loggerQueueDepth = 0;
+    uint64_t loggerDropped = 0;
+    size_t emailQueueDepth = 0;
+    uint64_t emailDropped = 0;
+};
+
+// Samples the agent's own CPU, memory, threads and handles once per cycle
+// and checks them against a budget. Process counters come from the running
+// process only (no system-wide snapshot), except the Windows thread count,
+// which needs a toolhelp snapshot and is refreshed every
+// THREAD_REFRESH_SAMPLES samples. The budget alarm fires after
+// BUDGET_SAMPLES consecutive samples over budget and clears after the same
+// number under it, so one slow cycle does not raise it.
+class SelfMonitor {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr int BUDGET_SAMPLES = 3;
+    static constexpr int THREAD_REFRESH_SAMPLES = 10;
+
+    // Budget alarm transitions reported by sample()
+    enum class BudgetEvent {
+        NONE,
+        EXCEEDED,
+        RECOVERED
+    };
+
+private:
+    double cpuBudgetPercent = 1.0;      // 0 = no CPU budget
+    uint64_t rssBudgetBytes = 50ull * 1024 * 1024;   // 0 = no memory budget
+
+    SelfStats stats;
+    uint64_t lastCpuTime = 0;           // Process CPU time, microseconds
+    Clock::time_point lastSampleTime;
+    bool hasBaseline = false;
+    uint32_t processorCount = 1;
+    int samplesSinceThreadCount = 0;
+
+    bool overBudget = false;
+    int consecutiveOver = 0;
+    int consecutiveUnder = 0;
+
+    bool readProcessCounters(uint64_t& cpuTimeUs, SelfStats& counters, bool refreshThreads) const;
+
+public:
+    SelfMonitor();
+
+    // Budget; 0 disables the corresponding check
+    void setBudget(double cpuPercent, uint64_t rssBytes) {
+        cpuBudgetPercent = cpuPercent;
+        rssBudgetBytes = rssBytes;
+    }
+    double getCpuBudgetPercent() const { return cpuBudgetPercent; }
+    uint64_t getRssBudgetBytes() const { return rssBudgetBytes; }
+
+    // Queue figures are owned by the logger and email notifier; set them before sample()
+    void setQueueStats(size_t loggerDepth, uint64_t loggerDropped, size_t emailDepth, uint64_t emailDropped);
+
+    // Reads the process counters and evaluates the budget
+    BudgetEvent sample(Clock::time_point now = Clock::now());
+
+    // Budget evaluation of one set of stats (called by sample())
+    BudgetEvent evaluateBudget(const SelfStats& current);
+
+    const SelfStats& getStats() const { return stats; }
+    bool isOverBudget() const { return overBudget; }
+    bool exceedsBudget(const SelfStats& current) const;
+
+    // One-line summary for the display and logs
+    std::string formatSummary() const;
+};
@@ -0,0 +1,223 @@
+#pragma once
+
+// Header-only reader for the shared-memory snapshot (SHARED_SNAPSHOT_NAME).
+//
+// SystemMonitor writes the latest cycle into a named segment laid out as one
+// SharedSnapshotHeader followed by `capacity` SharedSnapshotProcess records.
+// Updates are guarded by a seqlock: the writer makes `sequence` odd, writes
+// the payload and makes it even again. A reader copies the payload between
+// two reads of `sequence` and keeps the copy only when both are the same even
+// value, so readers never block the writer or each other and a read costs no
+// system call once the segment is mapped. This file depends only on the
+// standard library and the platform mapping API so local tools can copy it.
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+static constexpr uint32_t SHARED_SNAPSHOT_MAGIC = 0x53534D53;      // "SMSS" in little-endian memory
+static constexpr uint16_t SHARED_SNAPSHOT_VERSION = 1;
+static constexpr size_t SHARED_SNAPSHOT_NAME_BYTES = 48;
+
+struct SharedSnapshotHeader {
+    uint32_t magic;                     // SHARED_SNAPSHOT_MAGIC
+    uint16_t version;                   // SHARED_SNAPSHOT_VERSION
+    uint16_t headerSize;                // sizeof(SharedSnapshotHeader)
+    uint32_t recordSize;                // sizeof(SharedSnapshotProcess)
+    uint32_t capacity;                  // Process records that follow the header
+    std::atomic<uint64_t> sequence;     // Odd while an update is in progress; 0 = nothing published yet
+
+    // Payload, consistent only when read between two equal even sequence values
+    int64_t timestampMs;                // Wall clock time of the cycle
+    uint64_t cycle;                     // Cycles published since the segment was created
+    double cpuPercent;
+    double ramPercent;
+    double diskPercent;
+    uint32_t totalProcesses;            // Processes seen in the cycle
+    uint32_t processCount;              // Records filled, heaviest first (<= capacity)
+};
+
+struct SharedSnapshotProcess {
+    uint32_t pid;
+    uint32_t parentPid;
+    double cpuPercent;
+    double ramPercent;
+    double diskPercent;
+    char name[SHARED_SNAPSHOT_NAME_BYTES];      // NUL-terminated, truncated to fit
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "The seqlock counter must be lock-free to live in shared memory");
+static_assert(sizeof(SharedSnapshotHeader) == 72, "Shared snapshot header layout changed; bump SHARED_SNAPSHOT_VERSION");
+static_assert(sizeof(SharedSnapshotProcess) == 80, "Shared snapshot record layout changed; bump SHARED_SNAPSHOT_VERSION");
+
+// One consistent copy of the published cycle
+struct SharedSnapshot {
+    uint64_t sequence = 0;
+    int64_t timestampMs = 0;
+    uint64_t cycle = 0;
+    double cpuPercent = 0.0;
+    double ramPercent = 0.0;
+    double diskPercent = 0.0;
+    uint32_t totalProcesses = 0;
+    std::vector<SharedSnapshotProcess> processes;
+};
+
+// Platform object name for a segment name: Local\<name> on Windows, /<name> elsewhere
+inline std::string sharedSnapshotObjectName(const std::string& name) {
+#ifdef _WIN32
+    return "Local\\" + name;
+#else
+    return "/" + name;
+#endif
+}
+
+inline size_t sharedSnapshotSegmentSize(uint32_t capacity) {
+    return sizeof(SharedSnapshotHeader) + static_cast<size_t>(capacity) * sizeof(SharedSnapshotProcess);
+}
+
+class SharedSnapshotReader {
+public:
+    static constexpr int DEFAULT_ATTEMPTS = 1000;
+
+private:
+    const SharedSnapshotHeader* header = nullptr;
+    size_t mappedSize = 0;
+    uint64_t lastSequence = 0;
+#ifdef _WIN32
+    HANDLE mapping = nullptr;
+#endif
+
+public:
+    SharedSnapshotReader() = default;
+    ~SharedSnapshotReader() { close(); }
+
+    // Non-copyable
+    SharedSnapshotReader(const SharedSnapshotReader&) = delete;
+    SharedSnapshotReader& operator=(const SharedSnapshotReader&) = delete;
+
+    // Maps the segment read-only; false if it does not exist or has another layout
+    bool open(const std::string& name) {
+        close();
+        std::string objectName = sharedSnapshotObjectName(name);
+#ifdef _WIN32
+        mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, objectName.c_str());
+        if (!mapping) return false;
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        MEMORY_BASIC_INFORMATION info;
+        if (!view || VirtualQuery(view, &info, sizeof(info)) == 0) {
+            if (view) UnmapViewOfFile(view);
+            close();
+            return false;
+        }
+        mappedSize = info.RegionSize;
+#else
+        int descriptor = shm_open(objectName.c_str(), O_RDONLY, 0);
+        if (descriptor < 0) return false;
+        struct stat status;
+        void* view = MAP_FAILED;
+        if (fstat(descriptor, &status) == 0 && static_cast<size_t>(status.st_size) >= sizeof(SharedSnapshotHeader)) {
+            mappedSize = static_cast<size_t>(status.st_size);
+            view = mmap(nullptr, mappedSize, PROT_READ, MAP_SHARED, descriptor, 0);
+        }
+        ::close(descriptor);
+        if (view == MAP_FAILED) {
+            mappedSize = 0;
+            return false;
+        }
+#endif
+        return attach(view, mappedSize);
+    }
+
+    void close() {
+        if (header) {
+#ifdef _WIN32
+            UnmapViewOfFile(header);
+#else
+            munmap(const_cast<SharedSnapshotHeader*>(header), mappedSize);
+#endif
+            header = nullptr;
+        }
+#ifdef _WIN32
+        if (mapping) {
+            CloseHandle(mapping);
+            mapping = nullptr;
+        }
+#endif
+        mappedSize = 0;
+        lastSequence = 0;
+    }
+
+    bool isOpen() const { return header != nullptr; }
+    uint32_t getCapacity() const { return header ? header->capacity : 0; }
+
+    // Copies the latest cycle; false if nothing is published yet or the writer kept
+    // updating for `attempts` tries. Buffers are reserved at open, so steady-state
+    // reads do not allocate.
+    bool read(SharedSnapshot& out, int attempts = DEFAULT_ATTEMPTS) {
+        if (!header) return false;
+        if (out.processes.capacity() < header->capacity) {
+            out.processes.reserve(header->capacity);
+        }
+        for (int attempt = 0; attempt < attempts; attempt++) {
+            uint64_t before = header->sequence.load(std::memory_order_acquire);
+            if (before == 0) return false;
+            if (before & 1) continue;
+
+            out.timestampMs = header->timestampMs;
+            out.cycle = header->cycle;
+            out.cpuPercent = header->cpuPercent;
+            out.ramPercent = header->ramPercent;
+            out.diskPercent = header->diskPercent;
+            out.totalProcesses = header->totalProcesses;
+            uint32_t count = header->processCount;
+            if (count > header->capacity) count = header->capacity;     // Torn value; the check below rejects it
+            out.processes.resize(count);
+            if (count > 0) {
+                std::memcpy(out.processes.data(), records(), count * sizeof(SharedSnapshotProcess));
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (header->sequence.load(std::memory_order_relaxed) == before) {
+                out.sequence = before;
+                lastSequence = before;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // True when a cycle newer than the last successful read has been published
+    bool hasUpdate() const {
+        return header && header->sequence.load(std::memory_order_acquire) != lastSequence;
+    }
+
+private:
+    bool attach(const void* view, size_t size) {
+        const SharedSnapshotHeader* candidate = static_cast<const SharedSnapshotHeader*>(view);
+        if (candidate->magic != SHARED_SNAPSHOT_MAGIC || candidate->version != SHARED_SNAPSHOT_VERSION ||
+            candidate->headerSize != sizeof(SharedSnapshotHeader) ||
+            candidate->recordSize != sizeof(SharedSnapshotProcess) ||
+            sharedSnapshotSegmentSize(candidate->capacity) > size) {
+            header = candidate;
+            close();
+            return false;
+        }
+        header = candidate;
+        return true;
+    }
+
+    const SharedSnapshotProcess* records() const {
+        return reinterpret_cast<const SharedSnapshotProcess*>(header + 1);
+    }
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "SystemMetrics.h"
+#include "SharedSnapshotReader.h"
+
+// Publishes each cycle into the shared-memory segment read by SharedSnapshotReader.
+//
+// The heaviest processes are staged into a private buffer first, so the
+// seqlock's odd window only covers copying the finished records into the
+// segment. The segment is created at start() and removed at stop(); readers
+// that still hold a mapping keep the last snapshot. A segment owned by a
+// running writer is never taken over: on POSIX the writer holds an advisory
+// lock on it, so only a segment left by a crashed run is replaced.
+class SharedSnapshotWriter {
+private:
+    SharedSnapshotHeader* header = nullptr;
+    size_t mappedSize = 0;
+    std::string objectName;
+    std::vector<SharedSnapshotProcess> staging;
+    uint64_t publishCount = 0;
+#ifdef _WIN32
+    HANDLE mapping = nullptr;
+#else
+    int descriptor = -1;                // Kept open for the ownership lock
+#endif
+
+public:
+    SharedSnapshotWriter() = default;
+    ~SharedSnapshotWriter();
+
+    // Non-copyable
+    SharedSnapshotWriter(const SharedSnapshotWriter&) = delete;
+    SharedSnapshotWriter& operator=(const SharedSnapshotWriter&) = delete;
+
+    // Creates the segment `name` with room for `capacity` processes; false on
+    // failure or when the segment already exists (on POSIX, unless its writer is gone)
+    bool start(const std::string& name, uint32_t capacity);
+    void stop();
+    bool isRunning() const { return header != nullptr; }
+
+    // Writes one cycle: system usage and the capacity heaviest processes
+    void publish(int64_t timestampMs, const SystemUsage& systemUsage, const std::vector<ProcessInfo>& processes);
+
+    uint64_t getPublishCount() const { return publishCount; }
+    uint32_t getCapacity() const { return header ? header->capacity : 0; }
+};
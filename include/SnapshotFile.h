@@ -0,0 +1,112 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <memory>
+#include <unordered_map>
+#include <cstdint>
+#include "SystemMetrics.h"
+#include "SystemMonitor.h"
+#include "ProcessManager.h"
+
+// One monitoring cycle as returned by the collectors, before aggregation
+struct SnapshotCycle {
+    int64_t timestampMs = 0;            // Wall clock, milliseconds since the Unix epoch
+    SystemUsage systemUsage;
+    std::vector<ProcessInfo> processes;
+};
+
+// Appends cycles to a snapshot file (--record).
+//
+// The file starts with an 8-byte magic and holds one record per cycle, so a
+// recording cut short by a crash stays readable up to its last complete
+// cycle. Integers are LEB128 varints (timestamps and PIDs delta-encoded),
+// usage values 32-bit floats, the precision the alert engine evaluates at.
+// Zero values are left out behind a per-process flag byte, and each process
+// name is written once and referenced by index afterwards.
+class SnapshotWriter {
+private:
+    std::ofstream file;
+    std::string filePath;
+    std::unordered_map<std::string, uint32_t> nameIds;
+    std::string buffer;                 // Encoded cycle, written with one call
+    int64_t lastTimestampMs = 0;
+    uint64_t cycleCount = 0;
+    uint64_t bytesWritten = 0;
+
+public:
+    SnapshotWriter() = default;
+    ~SnapshotWriter();
+
+    // Non-copyable
+    SnapshotWriter(const SnapshotWriter&) = delete;
+    SnapshotWriter& operator=(const SnapshotWriter&) = delete;
+
+    // Creates (truncates) the file and writes the header
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return file.is_open(); }
+
+    // Appends one cycle and flushes it to the file
+    bool writeCycle(int64_t timestampMs, const SystemUsage& systemUsage, const std::vector<ProcessInfo>& processes);
+
+    const std::string& getFilePath() const { return filePath; }
+    uint64_t getCycleCount() const { return cycleCount; }
+    uint64_t getBytesWritten() const { return bytesWritten; }
+};
+
+// Reads a snapshot file back one cycle at a time (--replay). The file is
+// loaded into memory whole, so replay speed is not bound by disk reads.
+class SnapshotReader {
+private:
+    std::vector<uint8_t> data;          // Whole file, loaded by open()
+    size_t position = 0;
+    std::vector<std::string> names;
+    SnapshotCycle current;
+    int64_t firstTimestampMs = 0;
+    uint64_t cycleCount = 0;
+    bool truncated = false;
+
+public:
+    // Loads the file; false when it cannot be read or is not a snapshot file
+    bool open(const std::string& path);
+
+    // Moves to the next cycle; false at the end of the recording
+    bool next();
+
+    // Cycle loaded by the last successful next()
+    const SnapshotCycle& getCurrent() const { return current; }
+    int64_t getFirstTimestampMs() const { return firstTimestampMs; }
+    uint64_t getCycleCount() const { return cycleCount; }
+    // True when the file ended inside a cycle (recording interrupted)
+    bool isTruncated() const { return truncated; }
+};
+
+// System monitor serving the usage of the current replayed cycle
+class ReplaySystemMonitor : public ISystemMonitor {
+private:
+    std::shared_ptr<SnapshotReader> reader;
+
+public:
+    explicit ReplaySystemMonitor(std::shared_ptr<SnapshotReader> snapshotReader);
+
+    SystemUsage getSystemUsage() override;
+    SystemMetrics getCurrentMetrics() const override;
+    bool initialize() override { return reader != nullptr; }
+    void shutdown() override {}
+};
+
+// Process manager serving the process list of the current replayed cycle
+class ReplayProcessManager : public IProcessManager {
+private:
+    std::shared_ptr<SnapshotReader> reader;
+
+public:
+    explicit ReplayProcessManager(std::shared_ptr<SnapshotReader> snapshotReader);
+
+    std::vector<ProcessInfo> getAllProcesses() override;
+    std::vector<ProcessInfo> getAggregatedProcessTree(const std::vector<ProcessInfo>& processes) override;
+    bool initialize() override { return reader != nullptr; }
+    void shutdown() override {}
+};
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include "TraceRecorder.h"
+
+// Log-linear latency histogram in microseconds (HDR style).
+//
+// Values below 64 us get one bucket each; above that every power of two is
+// split into 32 buckets, so any recorded value is reported within about 3%.
+// Buckets are fixed atomic counters: record() is wait-free apart from the
+// compare-and-swap on the maximum and never allocates, so timers can record
+// from any thread while another one reads percentiles.
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 5;
+    static constexpr uint64_t SUB_BUCKETS = 1ull << SUB_BUCKET_BITS;                 // 32 per octave
+    static constexpr uint64_t LINEAR_LIMIT = SUB_BUCKETS * 2;                        // 64 us
+    static constexpr int MAX_EXPONENT = 39;                                          // ~9 days
+    static constexpr size_t BUCKET_COUNT = LINEAR_LIMIT + (MAX_EXPONENT - SUB_BUCKET_BITS) * SUB_BUCKETS;
+
+private:
+    std::atomic<uint64_t> buckets[BUCKET_COUNT];
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> sum{0};
+    std::atomic<uint64_t> maxValue{0};
+
+public:
+    LatencyHistogram();
+
+    // Non-copyable (atomic counters)
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    static size_t bucketIndex(uint64_t micros);
+    static uint64_t bucketUpperBound(size_t index);     // Highest value counted in the bucket
+
+    void record(uint64_t micros);
+    void reset();
+
+    uint64_t getCount() const { return count.load(std::memory_order_relaxed); }
+    uint64_t getMax() const { return maxValue.load(std::memory_order_relaxed); }
+    double getMean() const;
+
+    // Smallest bucket bound with at least quantile of the recorded values at or below it
+    uint64_t getPercentile(double quantile) const;
+};
+
+// Stages of one monitoring cycle
+enum class CycleStage : uint8_t {
+    SYSTEM_USAGE = 0,
+    PROCESS_COLLECTION,
+    AGGREGATION,
+    ALERT_EVALUATION,
+    DISPLAY,
+    FILTERING,
+    LOGGING,
+    EMAIL,
+    HISTORY,            // Usage history update
+    EXPORT,             // Publishing to external collectors
+    BURST_SAMPLE,       // Burst ticks between full cycles
+    CYCLE_TOTAL,        // Whole full cycle
+    COUNT
+};
+
+// One histogram per cycle stage
+class StageProfiler {
+private:
+    LatencyHistogram histograms[static_cast<size_t>(CycleStage::COUNT)];
+
+public:
+    static const char* stageName(CycleStage stage);
+
+    void record(CycleStage stage, uint64_t micros) { histograms[static_cast<size_t>(stage)].record(micros); }
+    const LatencyHistogram& get(CycleStage stage) const { return histograms[static_cast<size_t>(stage)]; }
+    void reset();
+
+    // Table of count, p50, p99 and max per stage; stages never timed are left out
+    std::string formatTable() const;
+};
+
+// Records the lifetime of a scope into one stage, and into the trace when
+// tracing is on
+class ScopedStageTimer {
+private:
+    StageProfiler& profiler;
+    CycleStage stage;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    ScopedStageTimer(StageProfiler& stageProfiler, CycleStage timedStage)
+        : profiler(stageProfiler), stage(timedStage), start(std::chrono::steady_clock::now()) {}
+    ~ScopedStageTimer() {
+        auto end = std::chrono::steady_clock::now();
+        profiler.record(stage, static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()));
+        TraceRecorder& tracer = TraceRecorder::instance();
+        if (tracer.isEnabled()) {
+            tracer.complete(StageProfiler::stageName(stage), "cycle", start, end);
+        }
+    }
+
+    ScopedStageTimer(const ScopedStageTimer&) = delete;
+    ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "SystemMetrics.h"
+#include "Logger.h"
+
+// Line flavour of the StatsD sink
+enum class StatsdFormat : uint8_t {
+    STATSD,         // Plain StatsD; the process name is part of the metric name
+    DOGSTATSD       // DogStatsD; the process name is a tag
+};
+
+// StatsD/DogStatsD push sink (STATSD_ADDRESS) for hosts that cannot be scraped.
+//
+// Like the file logger, the main loop queues each cycle and a worker thread
+// does the rest: it writes gauge lines for the system and for the busiest
+// process names (instances summed) and packs them into datagrams of at most
+// maxPacketBytes. Every flush interval the pending datagrams go out over one
+// connected, non-blocking UDP socket, batched with sendmmsg() on Linux and
+// sent one by one elsewhere. Nothing waits on the network: cycles beyond
+// QUEUE_LIMIT, datagrams beyond MAX_PENDING_DATAGRAMS and datagrams the
+// socket buffer refuses are dropped and counted.
+class StatsdSink {
+public:
+    static constexpr size_t QUEUE_LIMIT = 64;
+    static constexpr size_t MAX_PENDING_DATAGRAMS = 4096;
+    static constexpr size_t SEND_BATCH = 64;
+    static constexpr size_t DEFAULT_PACKET_BYTES = 1432;    // Fits a 1500-byte MTU with IPv6 and tunnel headers
+    static constexpr size_t MIN_PACKET_BYTES = 512;
+    static constexpr size_t MAX_PACKET_BYTES = 65000;
+
+private:
+    struct Cycle {
+        int64_t timestampMs = 0;
+        SystemUsage systemUsage;
+        std::vector<ProcessInfo> processes;
+    };
+
+    intptr_t udpSocket = -1;
+    BlockingQueue<Cycle> queue;
+    std::thread worker;
+    std::atomic<bool> running{false};
+    std::atomic<StatsdFormat> format{StatsdFormat::STATSD};
+    std::atomic<int> flushIntervalMs{1000};
+    std::atomic<size_t> maxPacketBytes{DEFAULT_PACKET_BYTES};
+    std::atomic<size_t> topProcesses{20};
+    std::atomic<uint64_t> sentDatagrams{0};
+    std::atomic<uint64_t> droppedCycles{0};
+    std::atomic<uint64_t> droppedDatagrams{0};
+
+    // Worker thread state
+    std::vector<std::string> pending;       // Finished datagrams waiting for the flush
+    std::string datagram;                   // Datagram being filled
+    size_t packetBytes = DEFAULT_PACKET_BYTES;
+
+    void workerThreadFunction();
+    void writeCycle(const Cycle& cycle);
+    void addLine(const std::string& line);
+    void closeDatagram();
+    void flush();
+
+public:
+    StatsdSink() = default;
+    ~StatsdSink();
+
+    // Non-copyable
+    StatsdSink(const StatsdSink&) = delete;
+    StatsdSink& operator=(const StatsdSink&) = delete;
+
+    // Connects to "host:port" ("[v6]:port" for IPv6 literals); false if it cannot be resolved
+    bool start(const std::string& address);
+
+    // Sends what is queued and pending, then joins the worker
+    void stop();
+    bool isRunning() const { return running; }
+
+    // Read by the worker at each cycle, so they follow configuration reloads
+    void setFormat(StatsdFormat value) { format = value; }
+    void setFlushIntervalMs(int value) { flushIntervalMs = value; }
+    void setMaxPacketBytes(size_t value);
+    void setTopProcesses(size_t count) { topProcesses = count; }
+
+    // Queues one cycle without blocking; dropped when the worker falls QUEUE_LIMIT cycles behind
+    void append(int64_t timestampMs, const SystemUsage& systemUsage, const std::vector<ProcessInfo>& processes);
+
+    uint64_t getSentCount() const { return sentDatagrams; }
+    uint64_t getDroppedCycles() const { return droppedCycles; }
+    uint64_t getDroppedDatagrams() const { return droppedDatagrams; }
+    size_t getQueueSize() const { return queue.size(); }
+
+    // Process name as a metric-name segment (letters, digits, '-' and '_'; the rest
+    // becomes '_') or as a DogStatsD tag value (also keeps '.')
+    static std::string sanitize(const std::string& name, bool tagValue);
+};
@@ -1,6 +1,14 @@
 #pragma once
 
+#ifdef _WIN32
 #include <windows.h>
+#else
+#include <cstdint>
+// Windows integer types used by the metric classes
+typedef uint32_t DWORD;
+typedef uint64_t ULONGLONG;
+typedef uint64_t DWORDLONG;
+#endif
 #include <string>
 #include <memory>
 
@@ -90,6 +98,7 @@ private:
     double ramPercent = 0.0;
     double diskPercent = 0.0;
     ULONGLONG diskIoBytes = 0;
+    ULONGLONG startTime = 0;            // Creation time (FILETIME on Windows, ticks since boot on Linux)
 
 public:
     ProcessInfo() = default;
@@ -104,6 +113,8 @@ public:
     double getRamPercent() const { return ramPercent; }
     double getDiskPercent() const { return diskPercent; }
     ULONGLONG getDiskIoBytes() const { return diskIoBytes; }
+    // With the PID, identifies one process instance across PID reuse
+    ULONGLONG getStartTime() const { return startTime; }
 
     // Setters
     void setPid(DWORD value) { pid = value; }
@@ -113,6 +124,7 @@ public:
     void setRamPercent(double value) { ramPercent = value; }
     void setDiskPercent(double value) { diskPercent = value; }
     void setDiskIoBytes(ULONGLONG value) { diskIoBytes = value; }
+    void setStartTime(ULONGLONG value) { startTime = value; }
 
     // Utility methods
     bool hasSignificantUsage() const {
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <exception>
+#include <cstddef>
+#include <cstdint>
+
+// Small work-stealing thread pool for data-parallel loops.
+//
+// parallelFor() splits an index range into chunks and deals them round-robin
+// into one deque per participant. Each participant takes chunks from the back
+// of its own deque and, once that is empty, steals from the front of the
+// others, so a few slow items (hung processes, access checks) do not hold up
+// the whole pass. The calling thread participates as well; a pool of size 1
+// owns no threads and runs the loop inline.
+class ThreadPool {
+public:
+    using RangeFunction = std::function<void(size_t begin, size_t end)>;
+
+private:
+    struct Chunk {
+        size_t begin;
+        size_t end;
+        const RangeFunction* body;     // Owned by the parallelFor call that queued the chunk
+    };
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Chunk> chunks;
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;    // [0] belongs to the calling thread
+    std::vector<std::thread> workers;
+
+    std::mutex stateMutex;
+    std::condition_variable workAvailable;
+    std::condition_variable batchFinished;
+    uint64_t batchId = 0;
+    bool stopping = false;
+
+    std::mutex batchMutex;                             // One parallelFor at a time
+    std::atomic<size_t> pendingChunks{0};
+    std::exception_ptr firstError;
+
+    bool popLocal(size_t index, Chunk& chunk);
+    bool steal(size_t thief, Chunk& chunk);
+    void runChunks(size_t index);
+    void workerLoop(size_t index);
+
+public:
+    // threadCount counts the calling thread; 0 selects defaultThreadCount()
+    explicit ThreadPool(size_t threadCount = 0);
+    ~ThreadPool();
+
+    // Non-copyable
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Calls body on consecutive sub-ranges of [0, count) of at most chunkSize
+    // items and returns when all of them are done. The first exception thrown
+    // by body is rethrown here.
+    void parallelFor(size_t count, size_t chunkSize, const RangeFunction& body);
+
+    size_t size() const { return queues.size(); }
+
+    // Hardware threads, capped to keep the pool small on many-core hosts
+    static size_t defaultThreadCount();
+    static constexpr size_t MAX_DEFAULT_THREADS = 8;
+};
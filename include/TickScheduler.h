@@ -0,0 +1,67 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+// Drift-free sampling clock.
+//
+// Ticks fall on a fixed grid of absolute steady_clock deadlines
+// (start + k * interval), so collection time does not push later samples
+// back. A cycle that overruns one or more deadlines fires once, late, on the
+// most recent missed deadline and counts the others as missed instead of
+// queueing them. Jitter is the distance between a deadline and the moment
+// the waiting thread actually woke up.
+class TickScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Minimum supported interval
+    static constexpr int MIN_INTERVAL_MS = 100;
+
+    struct TickStats {
+        uint64_t ticks = 0;
+        uint64_t missedTicks = 0;                       // Deadlines skipped by overruns
+        std::chrono::microseconds lastJitter{0};
+        std::chrono::microseconds maxJitter{0};
+        double meanJitterUs = 0.0;
+    };
+
+private:
+    std::chrono::milliseconds interval;
+    Clock::time_point nextDeadline;
+    Clock::time_point lastDeadline;
+    bool started = false;
+    uint64_t lastMissed = 0;
+    TickStats stats;
+
+    std::mutex waitMutex;
+    std::condition_variable wakeCondition;
+    bool interrupted = false;
+
+public:
+    explicit TickScheduler(std::chrono::milliseconds tickInterval = std::chrono::milliseconds(5000));
+
+    // Non-copyable
+    TickScheduler(const TickScheduler&) = delete;
+    TickScheduler& operator=(const TickScheduler&) = delete;
+
+    // Anchors the grid; the first tick is due immediately
+    void start(Clock::time_point now = Clock::now());
+
+    // Changes the period; the next deadline is one new interval after the last tick
+    void setInterval(std::chrono::milliseconds tickInterval);
+    std::chrono::milliseconds getInterval() const { return interval; }
+
+    // Blocks until the next deadline; false when interrupted
+    bool waitForNextTick();
+
+    // Wakes a thread blocked in waitForNextTick (shutdown)
+    void interrupt();
+
+    // Statistics
+    const TickStats& getStats() const { return stats; }
+    uint64_t getLastMissed() const { return lastMissed; }
+    Clock::time_point getLastDeadline() const { return lastDeadline; }
+};
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Chrome Trace Event recorder for the agent's own threads.
+//
+// Tracing is opt-in (--trace FILE). Every thread that records gets its own
+// fixed ring of events on first use; the owning thread is the only writer and
+// the flusher the only reader, so recording is a couple of atomic loads and
+// stores with no lock and no allocation. flush() drains every ring into the
+// JSON file and is called once per monitoring cycle and at shutdown. When a
+// ring is full the event is dropped and counted rather than blocking the
+// recording thread. The output opens directly in Perfetto or chrome://tracing.
+//
+// Event and thread names are kept as pointers, so they must be string
+// literals or otherwise outlive the recorder.
+class TraceRecorder {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t DEFAULT_EVENTS_PER_THREAD = 4096;
+
+private:
+    struct Event {
+        const char* name = nullptr;
+        const char* category = nullptr;
+        int64_t timestampUs = 0;        // Since start()
+        int64_t durationUs = 0;
+        int64_t value = 0;              // Counter events
+        char phase = 'X';               // 'X' complete span, 'C' counter
+    };
+
+    // Single-producer, single-consumer ring owned by one thread
+    struct ThreadBuffer {
+        std::unique_ptr<Event[]> events;
+        std::atomic<size_t> head{0};    // Next slot to write (recording thread)
+        std::atomic<size_t> tail{0};    // Next slot to read (flusher)
+        uint32_t tid = 0;
+        const char* threadName = nullptr;  // Guarded by registryMutex
+        bool nameWritten = false;       // Guarded by fileMutex
+    };
+
+    const size_t capacity;
+    const uint64_t recorderId;          // Tells thread-local caches of different recorders apart
+
+    std::atomic<bool> enabled{false};
+    Clock::time_point origin;
+    std::atomic<uint64_t> droppedEvents{0};
+    uint64_t writtenEvents = 0;         // Guarded by fileMutex
+
+    std::mutex registryMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;    // Kept until destruction; threads may outlive a stop()
+
+    std::mutex fileMutex;
+    std::ofstream file;
+    std::string filePath;
+    bool firstEvent = true;
+
+    ThreadBuffer* localBuffer();
+    void push(const Event& event);
+    void writeEvent(const ThreadBuffer& buffer, const Event& event);
+    void writeThreadName(ThreadBuffer& buffer, const char* name);
+    void flushLocked();
+
+public:
+    explicit TraceRecorder(size_t eventsPerThread = DEFAULT_EVENTS_PER_THREAD);
+    ~TraceRecorder();
+
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    // Process-wide recorder used by the application
+    static TraceRecorder& instance();
+
+    // Opens the trace file and starts recording; false if the file cannot be created
+    bool start(const std::string& path);
+
+    // Stops recording, drains the rings and closes the JSON document
+    void stop();
+
+    bool isEnabled() const { return enabled.load(std::memory_order_acquire); }
+
+    // Names the calling thread in the timeline
+    void setThreadName(const char* name);
+
+    // One span on the calling thread
+    void complete(const char* name, const char* category, Clock::time_point begin, Clock::time_point end);
+
+    // One sample of a counter track (queue depths)
+    void counter(const char* name, int64_t value, Clock::time_point when = Clock::now());
+
+    // Writes the events recorded so far
+    void flush();
+
+    const std::string& getFilePath() const { return filePath; }
+    uint64_t getDroppedCount() const { return droppedEvents.load(std::memory_order_relaxed); }
+    uint64_t getWrittenCount();
+};
+
+// Records the lifetime of a scope as one span when tracing is on
+class TraceScope {
+private:
+    TraceRecorder& recorder;
+    const char* name;
+    const char* category;
+    bool active;
+    TraceRecorder::Clock::time_point begin;
+
+public:
+    TraceScope(const char* spanName, const char* spanCategory,
+               TraceRecorder& traceRecorder = TraceRecorder::instance())
+        : recorder(traceRecorder), name(spanName), category(spanCategory), active(traceRecorder.isEnabled()) {
+        if (active) {
+            begin = TraceRecorder::Clock::now();
+        }
+    }
+    ~TraceScope() {
+        if (active) {
+            recorder.complete(name, category, begin, TraceRecorder::Clock::now());
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+};
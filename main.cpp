@@ -16,40 +16,121 @@
 #include "include/SystemMonitor.h"
 #include "include/EmailNotifier.h"
 #include "include/SystemInfo.h"
+#include "include/AlertEngine.h"
+#include "include/ConfigWatcher.h"
+#include "include/ScreenRenderer.h"
+#include "include/TickScheduler.h"
+#include "include/BurstCapture.h"
+#include "include/SelfMonitor.h"
+#include "include/StageProfiler.h"
+#include "include/TraceRecorder.h"
+#include "include/SnapshotFile.h"
+#include "include/MetricStore.h"
+#include "include/HistoryArchive.h"
+#include "include/QuantileSketch.h"
+#include "include/MetricsExporter.h"
+#include "include/SharedSnapshotWriter.h"
+#include "include/QueryServer.h"
+#include "include/StatsdSink.h"
+#include "include/JsonLinesWriter.h"
+#include "include/ColumnarExport.h"
+#include <thread>
 
     // Global flag to control console output during top-style display
 bool g_suppressConsoleOutput = false;
 
+// True when --output jsonl goes to stdout. Checked before the configuration is
+// parsed, so that not even the first console message lands in the JSON stream.
+static bool jsonLinesToStdout(int argc, char* argv[]) {
+    bool jsonLines = false;
+    bool toStdout = true;
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], "--output") == 0) {
+            jsonLines = strcmp(argv[i + 1], "jsonl") == 0 || strcmp(argv[i + 1], "JSONL") == 0;
+        } else if (strcmp(argv[i], "--output-file") == 0) {
+            toStdout = strcmp(argv[i + 1], "-") == 0;
+        }
+    }
+    return jsonLines && toStdout;
+}
+
 // Application class for better organization
 class SystemMonitorApplication {
 private:
     std::unique_ptr<ConfigurationManager> configManager;
+    std::unique_ptr<ConfigWatcher> configWatcher;
     std::shared_ptr<ISystemMonitor> systemMonitor;
     std::unique_ptr<IProcessManager> processManager;
     std::unique_ptr<ILogger> logger;
     std::unique_ptr<EmailNotifier> emailNotifier;
+    AlertEngine alertEngine;
     bool isRunning = false;
     
     // Simple display variables
     HANDLE hConsole;
     std::chrono::steady_clock::time_point startTime;
-    std::chrono::steady_clock::time_point lastDisplayUpdate;
     int displayMode = 0; // 0 = line-by-line, 1 = top-style, 2 = compact
-    bool firstDisplay = true;
-    std::vector<ProcessInfo> lastProcesses;
+    ScreenRenderer screenRenderer;
+    TickScheduler tickScheduler;
+    
+    // Burst capture after a threshold crossing
+    BurstCapture burstCapture;
+    TickScheduler::Clock::time_point nextFullCycle;
+    std::vector<std::pair<std::string, std::string>> heldAlerts;   // Rule name, log entry
+    std::string burstReport;                                         // Attached to alerts of the episode
+    
+    // Footprint of the agent itself
+    SelfMonitor selfMonitor;
+    
+    // Latency of each stage of the monitoring cycle
+    StageProfiler stageProfiler;
+    bool showStageTimings = false;
+    
+    // Sample recording (--record) and replay of a recording in place of collection (--replay)
+    SnapshotWriter snapshotWriter;
+    std::shared_ptr<SnapshotReader> replayReader;
+    AlertEngine::Clock::time_point replayStart;
+    AlertEngine::Clock::time_point replayTime;      // Recorded time of the current cycle, for alert durations
+    
+    // System and per-process usage history
+    MetricStore metricStore;
+    int64_t historyTimestampMs = 0;                 // Time of the newest cycle in the history
+    HistoryArchiveWriter historyArchive;            // Compressed history on disk (HISTORY_ARCHIVE_PATH)
+    PercentileStore percentileStore;                // Hourly percentile sketches next to the archive
+    
+    // Prometheus scrape endpoint (METRICS_PORT)
+    MetricsExporter metricsExporter;
+    
+    // Latest cycle in shared memory for local readers (SHARED_SNAPSHOT_NAME)
+    SharedSnapshotWriter sharedSnapshot;
+    
+    // Local binary query endpoint (QUERY_SOCKET_PATH)
+    QueryServer queryServer;
+    
+    // StatsD/DogStatsD push over UDP (STATSD_ADDRESS)
+    StatsdSink statsdSink;
+    
+    // One JSON object per cycle (--output jsonl); on stdout, console messages move to stderr
+    JsonLinesWriter jsonLines;
+    std::streambuf* consoleBuffer = nullptr;        // std::cout's own buffer while it is redirected
+    
+    // Logged processes of every cycle, column by column, for offline analysis (COLUMNAR_EXPORT_PATH)
+    ColumnarExportWriter columnarExport;
 
     bool checkAdministratorPrivileges() const;
     void printStartupInfo() const;
     void initializeDisplay();
     void showTopStyleDisplay(const std::vector<ProcessInfo>& processes, const SystemUsage& systemUsage);
     void showCompactDisplay(const std::vector<ProcessInfo>& processes, const SystemUsage& systemUsage);
-    void clearScreen();
-    void setCursorPosition(int row, int col);
     void hideCursor();
     void showCursor();
-    bool shouldUpdateDisplay();
     bool checkForKeyPress();
     void handleKeyPress();
+    std::string buildDetailedLogEntry(const std::vector<ProcessInfo>& processes, const SystemUsage& systemUsage) const;
+    void finishBurst();
+    void sampleSelf(const MonitorConfig& config);
+    void applyStatsdSettings(const MonitorConfig& config);
+    bool waitForReplayCycle(double speed);
 
 public:
     SystemMonitorApplication();
@@ -68,7 +149,6 @@ SystemMonitorApplication::SystemMonitorApplication() {
     configManager = std::make_unique<ConfigurationManager>();
     hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
     startTime = std::chrono::steady_clock::now();
-    lastDisplayUpdate = std::chrono::steady_clock::now();
 }
 
 SystemMonitorApplication::~SystemMonitorApplication() {
@@ -76,6 +156,9 @@ SystemMonitorApplication::~SystemMonitorApplication() {
 }
 
 bool SystemMonitorApplication::initialize(int argc, char* argv[]) {
+    if (jsonLinesToStdout(argc, argv)) {
+        consoleBuffer = std::cout.rdbuf(std::cerr.rdbuf());
+    }
     std::cout << "SystemMonitor initializing..." << std::endl;
     
     // Setup termination handler
@@ -108,17 +191,154 @@ bool SystemMonitorApplication::initialize(int argc, char* argv[]) {
         return false;
     }
     
+    // Offline query of the archived percentile sketches
+    if (configManager->getConfig().getPercentileQueryHours() > 0) {
+        const std::string& archivePath = configManager->getConfig().getHistoryArchivePath();
+        PercentileWindow window;
+        if (archivePath.empty()) {
+            std::cerr << "--percentiles reads the history archive; set HISTORY_ARCHIVE_PATH in the configuration." << std::endl;
+        } else if (!PercentileStore::load(archivePath, static_cast<uint32_t>(configManager->getConfig().getPercentileQueryHours()), window)) {
+            std::cerr << "No percentile sketches found in " << archivePath << "." << std::endl;
+        } else {
+            std::cout << PercentileStore::formatTable(window, 25);
+        }
+        return false;
+    }
+    
     printStartupInfo();
     
-    // Initialize system monitor
-    systemMonitor = SystemMonitorFactory::createWindowsMonitor();
+    // Opt-in timeline of the agent's own threads; started before the workers so they are named
+    const std::string& traceFilePath = configManager->getConfig().getTraceFilePath();
+    if (!traceFilePath.empty()) {
+        if (TraceRecorder::instance().start(traceFilePath)) {
+            TraceRecorder::instance().setThreadName("Main loop");
+            std::cout << "Tracing to " << traceFilePath << " (Chrome trace format)" << std::endl;
+        } else {
+            std::cout << "Warning: Cannot create trace file " << traceFilePath << ". Tracing disabled." << std::endl;
+        }
+    }
+    
+    const std::string& recordFilePath = configManager->getConfig().getRecordFilePath();
+    if (!recordFilePath.empty()) {
+        if (snapshotWriter.open(recordFilePath)) {
+            std::cout << "Recording samples to " << recordFilePath << std::endl;
+        } else {
+            std::cout << "Warning: Cannot create recording " << recordFilePath << ". Recording disabled." << std::endl;
+        }
+    }
+    
+    if (configManager->getConfig().isJsonLinesOutput()) {
+        const std::string& outputFilePath = configManager->getConfig().getOutputFilePath();
+        if (!jsonLines.open(outputFilePath)) {
+            std::cout << "Warning: Cannot open " << outputFilePath << ". JSON Lines output disabled." << std::endl;
+        } else if (!jsonLines.isStdout()) {
+            std::cout << "Writing JSON Lines to " << outputFilePath << std::endl;
+        }
+    }
+    
+    // Build the alert rule set
+    alertEngine.setRules(configManager->getConfig().getEffectiveAlertRules());
+    // Recordings hold full cycles only, so a replay runs without bursts
+    burstCapture.configure(configManager->getConfig().getReplayFilePath().empty()
+                               ? configManager->getConfig().getBurstWindowSeconds() : 0,
+                           configManager->getConfig().getBurstIntervalMs(),
+                           configManager->getConfig().getBurstTopProcesses());
+    selfMonitor.setBudget(configManager->getConfig().getSelfCpuBudgetPercent(),
+                          static_cast<uint64_t>(configManager->getConfig().getSelfRssBudgetMb()) * 1024 * 1024);
+    metricStore.setMaxProcessSeries(static_cast<size_t>(configManager->getConfig().getMetricHistoryProcesses()));
+    
+    const std::string& historyArchivePath = configManager->getConfig().getHistoryArchivePath();
+    if (!historyArchivePath.empty()) {
+        historyArchive.setMaxProcesses(static_cast<size_t>(configManager->getConfig().getHistoryArchiveProcesses()));
+        historyArchive.setRetentionDays(configManager->getConfig().getHistoryArchiveDays());
+        if (historyArchive.start(historyArchivePath)) {
+            percentileStore.setDirectory(historyArchivePath);
+            std::cout << "Archiving usage history to " << historyArchivePath << std::endl;
+        } else {
+            std::cout << "Warning: Cannot create history directory " << historyArchivePath << ". Archive disabled." << std::endl;
+        }
+    }
+    
+    const std::string& columnarExportPath = configManager->getConfig().getColumnarExportPath();
+    if (!columnarExportPath.empty()) {
+        columnarExport.setBlockCycles(static_cast<size_t>(configManager->getConfig().getColumnarExportBlockCycles()));
+        if (columnarExport.start(columnarExportPath)) {
+            std::cout << "Exporting logged processes to " << columnarExportPath << std::endl;
+        } else {
+            std::cout << "Warning: Cannot open export file " << columnarExportPath << ". Columnar export disabled." << std::endl;
+        }
+    }
+    
+    int metricsPort = configManager->getConfig().getMetricsPort();
+    if (metricsPort > 0) {
+        if (metricsExporter.start(static_cast<uint16_t>(metricsPort))) {
+            std::cout << "Serving Prometheus metrics on http://127.0.0.1:" << metricsPort << "/metrics" << std::endl;
+        } else {
+            std::cout << "Warning: Cannot listen on port " << metricsPort << ". Metrics endpoint disabled." << std::endl;
+        }
+    }
+    
+    const std::string& sharedSnapshotName = configManager->getConfig().getSharedSnapshotName();
+    if (!sharedSnapshotName.empty()) {
+        if (sharedSnapshot.start(sharedSnapshotName,
+                                 static_cast<uint32_t>(configManager->getConfig().getSharedSnapshotProcesses()))) {
+            std::cout << "Publishing snapshots to shared memory " << sharedSnapshotName << std::endl;
+        } else {
+            std::cout << "Warning: Cannot create shared memory " << sharedSnapshotName << ". Snapshot disabled." << std::endl;
+        }
+    }
+    
+    const std::string& querySocketPath = configManager->getConfig().getQuerySocketPath();
+    if (!querySocketPath.empty()) {
+        if (queryServer.start(querySocketPath)) {
+            std::cout << "Answering queries on " << querySocketPath << std::endl;
+        } else {
+            std::cout << "Warning: Cannot listen on " << querySocketPath << ". Query server disabled." << std::endl;
+        }
+    }
+    
+    const std::string& statsdAddress = configManager->getConfig().getStatsdAddress();
+    if (!statsdAddress.empty()) {
+        applyStatsdSettings(configManager->getConfig());
+        if (statsdSink.start(statsdAddress)) {
+            std::cout << "Pushing StatsD metrics to " << statsdAddress << std::endl;
+        } else {
+            std::cout << "Warning: Cannot resolve StatsD address " << statsdAddress << ". StatsD disabled." << std::endl;
+        }
+    }
+    
+    // Initialize system monitor; a replay serves recorded cycles instead of live samples
+    const std::string& replayFilePath = configManager->getConfig().getReplayFilePath();
+    if (replayFilePath.empty()) {
+        systemMonitor = SystemMonitorFactory::createWindowsMonitor();
+    } else {
+        replayReader = std::make_shared<SnapshotReader>();
+        if (!replayReader->open(replayFilePath)) {
+            std::cerr << "Cannot read recording " << replayFilePath << "." << std::endl;
+            return false;
+        }
+        systemMonitor = std::make_shared<ReplaySystemMonitor>(replayReader);
+        std::cout << "Replaying " << replayFilePath << " at "
+                  << (configManager->getConfig().getReplaySpeed() > 0.0
+                      ? std::to_string(configManager->getConfig().getReplaySpeed()) + "x" : std::string("maximum"))
+                  << " speed" << std::endl;
+    }
     if (!systemMonitor || !systemMonitor->initialize()) {
         std::cerr << "Failed to initialize system monitor." << std::endl;
         return false;
     }
     
     // Initialize process manager
-    processManager = ProcessManagerFactory::createWindowsManager(systemMonitor);
+    if (replayReader) {
+        processManager = std::make_unique<ReplayProcessManager>(replayReader);
+    } else {
+        processManager = ProcessManagerFactory::createWindowsManager(systemMonitor);
+    }
+    if (processManager) {
+        processManager->setScanThreads(configManager->getConfig().getProcessScanThreads());
+        processManager->setTierPolicy(configManager->getConfig().getProcessTierPolicy());
+        processManager->setProcRoot(configManager->getConfig().getProcRoot());
+    }
     if (!processManager || !processManager->initialize()) {
         std::cerr << "Failed to initialize process manager." << std::endl;
         return false;
@@ -164,6 +384,10 @@ bool SystemMonitorApplication::initialize(int argc, char* argv[]) {
         }
     }
     
+    // Watch the configuration file for changes (command line overrides stay in effect)
+    configWatcher = std::make_unique<ConfigWatcher>("config\\SystemMonitor.cfg", configManager->getConfig(), argc, argv);
+    configWatcher->start();
+    
     isRunning = true;
     return true;
 }
@@ -190,34 +414,121 @@ void SystemMonitorApplication::run() {
             break;
     }
     if (displayMode != 3) {
-        std::cout << "Press 'q' to quit, 't' to toggle display mode." << std::endl;
+        std::cout << "Press 'q' to quit, 't' to toggle display mode, 's' for stage timings." << std::endl;
         Sleep(2000); // Give user time to read the message
     } else {
         std::cout << "Silence mode: Output will be shown only when thresholds are exceeded." << std::endl;
-        std::cout << "Press 'q' to quit, 't' to toggle display mode." << std::endl;
+        std::cout << "Press 'q' to quit, 't' to toggle display mode, 's' for stage timings." << std::endl;
         Sleep(3000); // Give user more time to read silence mode message
     }
     
     unsigned int monitorCount = 0;
-    const auto& config = configManager->getConfig();
+    uint64_t configGeneration = configWatcher->getGeneration();
+    
+    // Samples fall on absolute deadlines; collection time does not stretch the period
+    tickScheduler.setInterval(std::chrono::milliseconds(configManager->getConfig().getMonitorInterval()));
+    tickScheduler.start();
     
     while (isRunning) {
+        if (replayReader) {
+            if (!waitForReplayCycle(configWatcher->getSnapshot()->getReplaySpeed())) {
+                break;
+            }
+        } else if (!tickScheduler.waitForNextTick()) {
+            break;
+        }
+        if (tickScheduler.getLastMissed() > 0) {
+            LoggerManager::getInstance().debug("Sampling cycle overran: " + std::to_string(tickScheduler.getLastMissed()) +
+                                               " tick(s) skipped");
+        }
+        
         try {
+            // Pick up a reloaded configuration; the snapshot stays valid for the whole cycle
+            // and comes with its own generation, so the two cannot disagree
+            uint64_t latestGeneration = 0;
+            std::shared_ptr<const MonitorConfig> configSnapshot = configWatcher->getSnapshot(latestGeneration);
+            const MonitorConfig& config = *configSnapshot;
+            if (latestGeneration != configGeneration) {
+                configGeneration = latestGeneration;
+                alertEngine.setRules(config.getEffectiveAlertRules());
+                screenRenderer.setFrameBudget(std::chrono::milliseconds(config.getDisplayRefreshMs()));
+                processManager->setScanThreads(config.getProcessScanThreads());
+                processManager->setTierPolicy(config.getProcessTierPolicy());
+                processManager->setProcRoot(config.getProcRoot());
+                burstCapture.configure(replayReader ? 0 : config.getBurstWindowSeconds(), config.getBurstIntervalMs(),
+                                       config.getBurstTopProcesses());
+                selfMonitor.setBudget(config.getSelfCpuBudgetPercent(),
+                                      static_cast<uint64_t>(config.getSelfRssBudgetMb()) * 1024 * 1024);
+                metricStore.setMaxProcessSeries(static_cast<size_t>(config.getMetricHistoryProcesses()));
+                historyArchive.setMaxProcesses(static_cast<size_t>(config.getHistoryArchiveProcesses()));
+                historyArchive.setRetentionDays(config.getHistoryArchiveDays());
+                columnarExport.setBlockCycles(static_cast<size_t>(config.getColumnarExportBlockCycles()));
+                applyStatsdSettings(config);
+                if (!burstCapture.isActive()) {
+                    tickScheduler.setInterval(std::chrono::milliseconds(config.getMonitorInterval()));
+                }
+                if (emailNotifier) {
+                    emailNotifier->setConfig(config.getEmailConfig());
+                }
+            }
+            
             // Check for keyboard input
             if (checkForKeyPress()) {
                 handleKeyPress();
             }
             
+            // During a burst, ticks between full cycles only sample the top offenders
+            TickScheduler::Clock::time_point tickTime = tickScheduler.getLastDeadline();
+            bool fullCycle = tickTime >= nextFullCycle;
+            if (burstCapture.isActive() && !fullCycle) {
+                ScopedStageTimer burstTimer(stageProfiler, CycleStage::BURST_SAMPLE);
+                burstCapture.record(systemMonitor->getSystemUsage(),
+                                    processManager->sampleProcesses(burstCapture.getTargetPids()));
+                if (burstCapture.isComplete()) {
+                    finishBurst();
+                    tickScheduler.setInterval(std::chrono::milliseconds(config.getMonitorInterval()));
+                }
+                continue;
+            }
+            nextFullCycle = tickTime + std::chrono::milliseconds(config.getMonitorInterval());
+            
+            // Agent footprint over the previous cycle, burst ticks included
+            sampleSelf(config);
+            ScopedStageTimer cycleTimer(stageProfiler, CycleStage::CYCLE_TOTAL);
+            
+            // Wall clock time of the cycle (the recorded time during a replay)
+            int64_t cycleTimestampMs = replayReader ? replayReader->getCurrent().timestampMs
+                : std::chrono::duration_cast<std::chrono::milliseconds>(
+                      std::chrono::system_clock::now().time_since_epoch()).count();
+            
             // Get system usage
-            SystemUsage systemUsage = systemMonitor->getSystemUsage();
+            SystemUsage systemUsage;
+            {
+                ScopedStageTimer timer(stageProfiler, CycleStage::SYSTEM_USAGE);
+                systemUsage = systemMonitor->getSystemUsage();
+            }
             
             // Get all processes
-            std::vector<ProcessInfo> processes = processManager->getAllProcesses();
-            
-            // Calculate system disk I/O by aggregating process values
+            std::vector<ProcessInfo> processes;
             double totalDiskActivity = 0.0;
-            for (const auto& process : processes) {
-                totalDiskActivity += process.getDiskPercent();
+            {
+                ScopedStageTimer timer(stageProfiler, CycleStage::PROCESS_COLLECTION);
+                processes = processManager->getAllProcesses();
+                
+                // Calculate system disk I/O by aggregating process values
+                for (const auto& process : processes) {
+                    totalDiskActivity += process.getDiskPercent();
+                }
+            }
+            
+            // Collector output of the cycle, before aggregation
+            if (snapshotWriter.isOpen()) {
+                TraceScope scope("Snapshot record", "cycle");
+                if (!snapshotWriter.writeCycle(cycleTimestampMs, systemUsage, processes)) {
+                    LoggerManager::getInstance().debug("Cannot write to recording " + snapshotWriter.getFilePath() +
+                                                       "; recording stopped");
+                    snapshotWriter.close();
+                }
             }
             
             // Create corrected system usage with aggregated disk I/O
@@ -225,194 +536,271 @@ void SystemMonitorApplication::run() {
                                            systemUsage.getRamPercent(), 
                                            totalDiskActivity);
             
+            // Usage history in memory and on disk, per process instance before aggregation
+            {
+                ScopedStageTimer timer(stageProfiler, CycleStage::HISTORY);
+                metricStore.recordSystem(cycleTimestampMs, correctedSystemUsage);
+                metricStore.recordProcesses(cycleTimestampMs, processes);
+                historyTimestampMs = cycleTimestampMs;
+                historyArchive.append(cycleTimestampMs, correctedSystemUsage, processes);
+                if (percentileStore.isEnabled()) {
+                    percentileStore.record(cycleTimestampMs, correctedSystemUsage, processes);
+                }
+            }
+            
             // Aggregate process tree
-            std::vector<ProcessInfo> aggregatedProcesses = processManager->getAggregatedProcessTree(processes);
+            std::vector<ProcessInfo> aggregatedProcesses;
+            {
+                ScopedStageTimer timer(stageProfiler, CycleStage::AGGREGATION);
+                aggregatedProcesses = processManager->getAggregatedProcessTree(processes);
+            }
+            
+            // Rendered once here; every scrape until the next cycle is served this buffer
+            if (metricsExporter.isRunning()) {
+                ScopedStageTimer timer(stageProfiler, CycleStage::EXPORT);
+                metricsExporter.publish(MetricsExporter::render(cycleTimestampMs, correctedSystemUsage, aggregatedProcesses,
+                                                                static_cast<size_t>(config.getMetricsTopProcesses())));
+            }
+            if (sharedSnapshot.isRunning()) {
+                ScopedStageTimer timer(stageProfiler, CycleStage::EXPORT);
+                sharedSnapshot.publish(cycleTimestampMs, correctedSystemUsage, aggregatedProcesses);
+            }
+            if (queryServer.isRunning()) {
+                // Per instance, like the history the PID queries read
+                ScopedStageTimer timer(stageProfiler, CycleStage::EXPORT);
+                queryServer.publish(cycleTimestampMs, correctedSystemUsage, processes);
+                queryServer.answerHistoryRequests(metricStore, processes, cycleTimestampMs);
+            }
+            if (statsdSink.isRunning()) {
+                ScopedStageTimer timer(stageProfiler, CycleStage::EXPORT);
+                statsdSink.append(cycleTimestampMs, correctedSystemUsage, processes);
+            }
             
-            // Display using simple system - only update every 2 seconds to reduce flashing
-            bool systemExceedsThresholds = 
-                systemUsage.getCpuPercent() > config.getCpuThreshold() ||
-                systemUsage.getRamPercent() > config.getRamThreshold() ||
-                systemUsage.getDiskPercent() > config.getDiskThreshold();
+            // Evaluate every alert rule against this snapshot
+            const std::vector<AlertEvent>* evaluatedEvents = nullptr;
+            {
+                ScopedStageTimer timer(stageProfiler, CycleStage::ALERT_EVALUATION);
+                evaluatedEvents = &alertEngine.evaluate(correctedSystemUsage, aggregatedProcesses,
+                                                        replayReader ? replayTime : AlertEngine::Clock::now());
+            }
+            const auto& alertEvents = *evaluatedEvents;
+            bool systemExceedsThresholds = alertEngine.anyExceeded();
             
-            if (displayMode == 1) {
-                g_suppressConsoleOutput = true; // Suppress console output during top-style display
-                if (shouldUpdateDisplay() || firstDisplay) {
-                    showTopStyleDisplay(aggregatedProcesses, correctedSystemUsage);
+            // Follow the top offenders at high resolution after the first crossing
+            if (burstCapture.isActive()) {
+                burstCapture.record(correctedSystemUsage, processes);
+                if (burstCapture.isComplete()) {
+                    finishBurst();
+                    tickScheduler.setInterval(std::chrono::milliseconds(config.getMonitorInterval()));
                 }
-            } else if (displayMode == 2) {
-                g_suppressConsoleOutput = true; // Suppress console output during compact display
-                if (shouldUpdateDisplay() || firstDisplay) {
-                    showCompactDisplay(aggregatedProcesses, correctedSystemUsage);
+            } else if (burstCapture.onThresholdState(systemExceedsThresholds)) {
+                std::string trigger;
+                for (const auto& ruleName : alertEngine.getExceededRuleNames()) {
+                    trigger += (trigger.empty() ? "" : ", ") + ruleName;
                 }
-            } else if (displayMode == 3) {
-                g_suppressConsoleOutput = false; // Allow console output in silence mode when needed
-                // Silence mode - only show output when thresholds are exceeded
-                if (systemExceedsThresholds) {
-                    // Get current time for the alert
-                    auto now = std::chrono::system_clock::now();
-                    std::time_t now_c = std::chrono::system_clock::to_time_t(now);
-                    std::tm tm;
-                    localtime_s(&tm, &now_c);
-                    char timeStr[32];
-                    std::strftime(timeStr, sizeof(timeStr), "%H:%M:%S", &tm);
+                burstCapture.begin(processes, trigger);
+                burstCapture.record(correctedSystemUsage, processes);
+                processManager->sampleProcesses(burstCapture.getTargetPids());   // Baseline of the first burst sample
+                tickScheduler.setInterval(burstCapture.getBurstInterval());
+                burstReport.clear();
+                LoggerManager::getInstance().debug("Burst capture started: " + std::to_string(burstCapture.getTargets().size()) +
+                                                   " processes every " + std::to_string(burstCapture.getBurstInterval().count()) +
+                                                   " ms for " + std::to_string(burstCapture.getWindowSeconds()) + " s");
+            }
+            if (!systemExceedsThresholds && !burstCapture.isActive()) {
+                burstReport.clear();
+            }
+            
+            // Redraw top-style/compact displays once per frame budget (DISPLAY_REFRESH_MS)
+            
+            {
+                ScopedStageTimer timer(stageProfiler, CycleStage::DISPLAY);
+                if (displayMode == 1) {
+                    g_suppressConsoleOutput = true; // Suppress console output during top-style display
+                    if (screenRenderer.isFrameDue()) {
+                        showTopStyleDisplay(aggregatedProcesses, correctedSystemUsage);
+                    }
+                } else if (displayMode == 2) {
+                    g_suppressConsoleOutput = true; // Suppress console output during compact display
+                    if (screenRenderer.isFrameDue()) {
+                        showCompactDisplay(aggregatedProcesses, correctedSystemUsage);
+                    }
+                } else if (displayMode == 3) {
+                    g_suppressConsoleOutput = false; // Allow console output in silence mode when needed
+                    // Silence mode - only show output when thresholds are exceeded
+                    if (systemExceedsThresholds) {
+                        // Get current time for the alert
+                        auto now = std::chrono::system_clock::now();
+                        std::time_t now_c = std::chrono::system_clock::to_time_t(now);
+                        std::tm tm;
+                        localtime_s(&tm, &now_c);
+                        char timeStr[32];
+                        std::strftime(timeStr, sizeof(timeStr), "%H:%M:%S", &tm);
                     
-                    std::cout << "[" << timeStr << "] THRESHOLD EXCEEDED - CPU: " 
-                              << std::fixed << std::setprecision(1) << correctedSystemUsage.getCpuPercent() 
-                              << "% (>" << config.getCpuThreshold() << "%) RAM: " 
-                              << correctedSystemUsage.getRamPercent() << "% (>" << config.getRamThreshold() 
-                              << "%) Disk: " << correctedSystemUsage.getDiskPercent() << "% (>" 
-                              << config.getDiskThreshold() << "%)" << std::endl;
+                        std::cout << "[" << timeStr << "] THRESHOLD EXCEEDED - CPU: " 
+                                  << std::fixed << std::setprecision(1) << correctedSystemUsage.getCpuPercent() 
+                                  << "% (>" << config.getCpuThreshold() << "%) RAM: " 
+                                  << correctedSystemUsage.getRamPercent() << "% (>" << config.getRamThreshold() 
+                                  << "%) Disk: " << correctedSystemUsage.getDiskPercent() << "% (>" 
+                                  << config.getDiskThreshold() << "%)" << std::endl;
                     
-                    // Show top 5 resource-consuming processes
-                    std::vector<ProcessInfo> topProcesses = aggregatedProcesses;
-                    std::sort(topProcesses.begin(), topProcesses.end(), 
-                              [](const ProcessInfo& a, const ProcessInfo& b) {
-                                  return (a.getCpuPercent() + a.getRamPercent() + a.getDiskPercent()) > 
-                                         (b.getCpuPercent() + b.getRamPercent() + b.getDiskPercent());
-                              });
+                        // Show which rules tripped
+                        std::cout << "    Rules: ";
+                        std::vector<std::string> exceededRules = alertEngine.getExceededRuleNames();
+                        for (size_t i = 0; i < exceededRules.size(); ++i) {
+                            if (i > 0) std::cout << ", ";
+                            std::cout << exceededRules[i];
+                        }
+                        std::cout << std::endl;
                     
-                    std::cout << "    Top processes: ";
-                    for (size_t i = 0; i < std::min<size_t>(3, topProcesses.size()); ++i) {
-                        const auto& proc = topProcesses[i];
-                        if (i > 0) std::cout << ", ";
-                        std::cout << proc.getName() << "[" << proc.getPid() << "] "
-                                  << "(" << std::fixed << std::setprecision(1) 
-                                  << proc.getCpuPercent() << "% CPU)";
+                        // Show top 5 resource-consuming processes
+                        std::vector<ProcessInfo> topProcesses = aggregatedProcesses;
+                        std::sort(topProcesses.begin(), topProcesses.end(), 
+                                  [](const ProcessInfo& a, const ProcessInfo& b) {
+                                      return (a.getCpuPercent() + a.getRamPercent() + a.getDiskPercent()) > 
+                                             (b.getCpuPercent() + b.getRamPercent() + b.getDiskPercent());
+                                  });
+                    
+                        std::cout << "    Top processes: ";
+                        for (size_t i = 0; i < std::min<size_t>(3, topProcesses.size()); ++i) {
+                            const auto& proc = topProcesses[i];
+                            if (i > 0) std::cout << ", ";
+                            std::cout << proc.getName() << "[" << proc.getPid() << "] "
+                                      << "(" << std::fixed << std::setprecision(1) 
+                                      << proc.getCpuPercent() << "% CPU)";
+                        }
+                        std::cout << std::endl;
                     }
-                    std::cout << std::endl;
+                } else {
+                    g_suppressConsoleOutput = false; // Allow console output in line-by-line mode
+                    // Line-by-line display
+                    std::cout << "[" << monitorCount << "] CPU: " << correctedSystemUsage.getCpuPercent() 
+                              << "% RAM: " << correctedSystemUsage.getRamPercent() 
+                              << "% Processes: " << aggregatedProcesses.size() << std::endl;
                 }
-            } else {
-                g_suppressConsoleOutput = false; // Allow console output in line-by-line mode
-                // Line-by-line display
-                std::cout << "[" << monitorCount << "] CPU: " << correctedSystemUsage.getCpuPercent() 
-                          << "% RAM: " << correctedSystemUsage.getRamPercent() 
-                          << "% Processes: " << aggregatedProcesses.size() << std::endl;
             }
             
-            // Log processes when system resources exceed thresholds
-            if (systemExceedsThresholds || config.isDebugMode()) {
-                // When system exceeds thresholds, log all processes consuming resources
-                std::vector<ProcessInfo> processesToLog;
-                
+            // Collect processes that are actively consuming resources (not idle)
+            std::vector<ProcessInfo> processesToLog;
+            if (systemExceedsThresholds || config.isDebugMode() || !alertEvents.empty() || jsonLines.isOpen() ||
+                columnarExport.isRunning()) {
+                ScopedStageTimer timer(stageProfiler, CycleStage::FILTERING);
                 for (const auto& process : aggregatedProcesses) {
-                    // Log processes that are actively consuming resources (not idle)
                     if (process.getCpuPercent() > 0.1 || 
                         process.getRamPercent() > 0.1 || 
                         process.getDiskPercent() > 0.1) {
                         processesToLog.push_back(process);
                     }
                 }
-                
-                // Log all active processes when system thresholds are exceeded
+            }
+            
+            // Log processes when system resources exceed thresholds
+            if (systemExceedsThresholds || config.isDebugMode()) {
+                ScopedStageTimer timer(stageProfiler, CycleStage::LOGGING);
                 LoggerManager::getInstance().logProcesses(processesToLog, correctedSystemUsage);
-                
-                // Email alerting for threshold violations
-                if (emailNotifier && systemExceedsThresholds) {
-                    // Generate detailed log entry for email alert (same format as logger)
-                    std::ostringstream detailedLogEntry;
-                    
-                    // Calculate process usage totals
-                    double totalProcessCpu = 0.0;
-                    double totalProcessRam = 0.0;
-                    double totalProcessDisk = 0.0;
-                    
-                    for (const auto& process : processesToLog) {
-                        totalProcessCpu += process.getCpuPercent();
-                        totalProcessRam += process.getRamPercent();
-                        totalProcessDisk += process.getDiskPercent();
-                    }
-                    
-                    // Calculate "unaccounted" usage (system overhead, kernel, cache, etc.)
-                    double unaccountedCpu = correctedSystemUsage.getCpuPercent() - totalProcessCpu;
-                    double unaccountedRam = correctedSystemUsage.getRamPercent() - totalProcessRam;
-                    double unaccountedDisk = correctedSystemUsage.getDiskPercent() - totalProcessDisk;
-                    if (unaccountedCpu < 0) unaccountedCpu = 0.0;
-                    if (unaccountedRam < 0) unaccountedRam = 0.0;
-                    if (unaccountedDisk < 0) unaccountedDisk = 0.0;
-                    
-                    // Get current time
-                    auto now = std::chrono::system_clock::now();
-                    std::time_t now_c = std::chrono::system_clock::to_time_t(now);
-                    std::tm tm;
-                    localtime_s(&tm, &now_c);
-                    char timeStr[32];
-                    std::strftime(timeStr, sizeof(timeStr), "%d-%m-%Y %H:%M:%S", &tm);
-                    
-                    // Create the detailed log entry in the same format as the logger
-                    detailedLogEntry << "===Start " << timeStr 
-                        << " [System CPU " << std::fixed << std::setprecision(2) << correctedSystemUsage.getCpuPercent()
-                        << "%] [System RAM " << std::fixed << std::setprecision(2) << correctedSystemUsage.getRamPercent()
-                        << "%] [System Disk " << std::fixed << std::setprecision(2) << correctedSystemUsage.getDiskPercent() 
-                        << "%]===\n";
-                    
-                    // System analysis lines
-                    detailedLogEntry << "SYSTEM ANALYSIS: CPU: Processes=" << std::fixed << std::setprecision(2) << totalProcessCpu 
-                        << "% + System/Kernel=" << std::fixed << std::setprecision(2) << unaccountedCpu 
-                        << "% = Total=" << std::fixed << std::setprecision(2) << correctedSystemUsage.getCpuPercent() << "%\n";
-                    detailedLogEntry << "SYSTEM ANALYSIS: RAM: Processes=" << std::fixed << std::setprecision(2) << totalProcessRam 
-                        << "% + System/Kernel=" << std::fixed << std::setprecision(2) << unaccountedRam 
-                        << "% = Total=" << std::fixed << std::setprecision(2) << correctedSystemUsage.getRamPercent() << "%\n";
-                    detailedLogEntry << "SYSTEM ANALYSIS: DISK: Processes=" << std::fixed << std::setprecision(2) << totalProcessDisk 
-                        << "% + System/Kernel=" << std::fixed << std::setprecision(2) << unaccountedDisk 
-                        << "% = Total=" << std::fixed << std::setprecision(2) << correctedSystemUsage.getDiskPercent() << "%\n";
-                    
-                    // Individual process entries
-                    for (const auto& process : processesToLog) {
-                        detailedLogEntry << timeStr << ", " 
-                            << process.getName() << ", " 
-                            << process.getPid() 
-                            << ", [CPU " << std::fixed << std::setprecision(2) << process.getCpuPercent()
-                            << "%] [RAM " << std::fixed << std::setprecision(2) << process.getRamPercent()
-                            << "%] [Disk " << std::fixed << std::setprecision(2) << process.getDiskPercent() 
-                            << "%]\n";
-                    }
-                    
-                    // Resource totals
-                    detailedLogEntry << "TOTALS: [Process CPU " << std::fixed << std::setprecision(2) << totalProcessCpu
-                        << "%] [Process RAM " << std::fixed << std::setprecision(2) << totalProcessRam
-                        << "%] [Process Disk " << std::fixed << std::setprecision(2) << totalProcessDisk << "%]\n";
-                    
-                    if (unaccountedRam > 5.0) { // Show significant system overhead
-                        detailedLogEntry << "SYSTEM OVERHEAD: [CPU " << std::fixed << std::setprecision(2) << unaccountedCpu
-                            << "%] [RAM " << std::fixed << std::setprecision(2) << unaccountedRam
-                            << "%] [Disk " << std::fixed << std::setprecision(2) << unaccountedDisk << "%] (Kernel/Cache/Buffers)\n";
+            }
+            
+            // Every cycle, whether or not a threshold is exceeded
+            if (jsonLines.isOpen()) {
+                ScopedStageTimer timer(stageProfiler, CycleStage::LOGGING);
+                jsonLines.write(cycleTimestampMs, correctedSystemUsage, processesToLog);
+            }
+            if (columnarExport.isRunning()) {
+                ScopedStageTimer timer(stageProfiler, CycleStage::EXPORT);
+                columnarExport.append(cycleTimestampMs, correctedSystemUsage, processesToLog);
+            }
+            
+            // Email alerting for rule state transitions
+            if (emailNotifier && !alertEvents.empty()) {
+                ScopedStageTimer timer(stageProfiler, CycleStage::EMAIL);
+                std::string detailedLogEntry = buildDetailedLogEntry(processesToLog, correctedSystemUsage);
+                for (const auto& event : alertEvents) {
+                    std::string ruleName = alertEngine.getRule(event.ruleIndex).getName();
+                    if (event.type == AlertEventType::FIRED) {
+                        // Alerts are held until the burst buffer is complete, then sent with it attached
+                        if (burstCapture.isActive()) {
+                            heldAlerts.emplace_back(ruleName, detailedLogEntry);
+                        } else if (!burstReport.empty()) {
+                            emailNotifier->notifyRuleAlert(ruleName, detailedLogEntry + "\n" + burstReport);
+                        } else {
+                            emailNotifier->notifyRuleAlert(ruleName, detailedLogEntry);
+                        }
+                    } else {
+                        emailNotifier->notifyRuleRecovery(ruleName, detailedLogEntry);
                     }
-                    
-                    // End banner
-                    detailedLogEntry << "===End  " << timeStr 
-                        << " [System CPU " << std::fixed << std::setprecision(2) << correctedSystemUsage.getCpuPercent()
-                        << "%] [System RAM " << std::fixed << std::setprecision(2) << correctedSystemUsage.getRamPercent()
-                        << "%] [System Disk " << std::fixed << std::setprecision(2) << correctedSystemUsage.getDiskPercent() 
-                        << "%]===";
-                    
-                    emailNotifier->checkThresholds(true, detailedLogEntry.str());
                 }
-            } else if (emailNotifier) {
-                // Reset email alert state when thresholds are no longer exceeded
-                emailNotifier->checkThresholds(false, "");
             }
             
             monitorCount++;
             
-            // Sleep for the configured interval
-            Sleep(config.getMonitorInterval());
+            if (TraceRecorder::instance().isEnabled()) {
+                TraceRecorder::instance().flush();
+            }
             
         } catch (const std::exception& e) {
             LoggerManager::getInstance().debug("Exception in main loop: " + std::string(e.what()));
-            Sleep(1000); // Brief pause on error
         } catch (...) {
             LoggerManager::getInstance().debug("Unknown exception in main loop");
-            Sleep(1000); // Brief pause on error
         }
     }
 }
 
 void SystemMonitorApplication::shutdown() {
     isRunning = false;
+    tickScheduler.interrupt();
+    
+    // Sampling clock summary
+    const TickScheduler::TickStats& tickStats = tickScheduler.getStats();
+    if (tickStats.ticks > 0) {
+        std::ostringstream summary;
+        summary << "Sampling ticks: " << tickStats.ticks << ", missed: " << tickStats.missedTicks
+                << ", jitter mean/max: " << std::fixed << std::setprecision(2) << tickStats.meanJitterUs / 1000.0
+                << "/" << tickStats.maxJitter.count() / 1000.0 << " ms";
+        LoggerManager::getInstance().debug(summary.str());
+        LoggerManager::getInstance().debug("Final footprint: " + selfMonitor.formatSummary());
+        LoggerManager::getInstance().debug("Stage latency:\n" + stageProfiler.formatTable());
+        LoggerManager::getInstance().debug("Usage history: " + std::to_string(metricStore.getProcessSeriesCount()) +
+                                           " process series, " + std::to_string(metricStore.getMemoryBytes() / 1024) +
+                                           " KB, " + std::to_string(metricStore.getEvictedCount()) + " evicted");
+    }
     
-    // Restore cursor visibility
+    // Write out a burst cut short by shutdown, with any alerts it was holding
+    if (burstCapture.isActive()) {
+        finishBurst();
+    }
+    
+    // Restore cursor visibility below the last frame
+    screenRenderer.shutdown();
     showCursor();
     
+    if (metricsExporter.isRunning()) {
+        metricsExporter.stop();
+        LoggerManager::getInstance().debug("Metrics endpoint: " + std::to_string(metricsExporter.getScrapeCount()) +
+                                           " scrapes, " + std::to_string(metricsExporter.getRejectedCount()) + " rejected");
+    }
+    
+    if (statsdSink.isRunning()) {
+        statsdSink.stop();
+        LoggerManager::getInstance().debug("StatsD: " + std::to_string(statsdSink.getSentCount()) + " datagrams sent, " +
+                                           std::to_string(statsdSink.getDroppedDatagrams()) + " datagrams and " +
+                                           std::to_string(statsdSink.getDroppedCycles()) + " cycles dropped");
+    }
+    if (queryServer.isRunning()) {
+        queryServer.stop();
+        LoggerManager::getInstance().debug("Query server: " + std::to_string(queryServer.getRequestCount()) +
+                                           " requests, " + std::to_string(queryServer.getDroppedCount()) + " clients dropped");
+    }
+    if (sharedSnapshot.isRunning()) {
+        LoggerManager::getInstance().debug("Shared snapshot: " + std::to_string(sharedSnapshot.getPublishCount()) +
+                                           " cycles published");
+        sharedSnapshot.stop();
+    }
+    
+    // Stop watching the configuration file
+    if (configWatcher) {
+        configWatcher->stop();
+    }
+    
     // Shutdown email notifier
     if (emailNotifier) {
         emailNotifier->stop();
@@ -426,12 +814,55 @@ void SystemMonitorApplication::shutdown() {
         systemMonitor->shutdown();
     }
     
-    // Shutdown the async logger
-    if (logger) {
-        logger->shutdown();
+    // Write out the open history block and hour of sketches while the logger can still report errors
+    if (percentileStore.isEnabled() && !percentileStore.flush()) {
+        LoggerManager::getInstance().debug("Cannot write percentile sketches to " + historyArchive.getDirectory());
+    }
+    if (columnarExport.isRunning()) {
+        columnarExport.stop();
+        LoggerManager::getInstance().debug("Columnar export: " + std::to_string(columnarExport.getRowCount()) + " rows in " +
+                                           std::to_string(columnarExport.getBlockCount()) + " blocks, " +
+                                           std::to_string(columnarExport.getBytesWritten() / 1024) + " KB written, " +
+                                           std::to_string(columnarExport.getDroppedCount()) + " cycles dropped");
+    }
+    if (historyArchive.isRunning()) {
+        historyArchive.stop();
+        LoggerManager::getInstance().debug("History archive: " + std::to_string(historyArchive.getPointCount()) +
+                                           " points, " + std::to_string(historyArchive.getBytesWritten() / 1024) +
+                                           " KB written, " + std::to_string(historyArchive.getDroppedCount()) +
+                                           " cycles dropped");
+    }
+    
+    if (jsonLines.isOpen()) {
+        LoggerManager::getInstance().debug("JSON Lines: " + std::to_string(jsonLines.getLineCount()) + " cycles, " +
+                                           std::to_string(jsonLines.getBytesWritten() / 1024) + " KB written, " +
+                                           std::to_string(jsonLines.getFailedCount()) + " writes failed");
+        jsonLines.close();
+    }
+    
+    if (snapshotWriter.isOpen()) {
+        snapshotWriter.close();
+        std::cout << "Recorded " << snapshotWriter.getCycleCount() << " cycles (" << snapshotWriter.getBytesWritten() / 1024
+                  << " KB) to " << snapshotWriter.getFilePath() << "." << std::endl;
+    }
+    
+    // Drain the async logger after the last summary above; the logger owned by
+    // the manager records its final trace events before the trace is closed
+    LoggerManager::getInstance().shutdown();
+    
+    // Close the trace after the worker threads have recorded their last events
+    TraceRecorder& tracer = TraceRecorder::instance();
+    if (tracer.isEnabled()) {
+        tracer.stop();
+        std::cout << "Trace written to " << tracer.getFilePath() << " (" << tracer.getWrittenCount()
+                  << " events, " << tracer.getDroppedCount() << " dropped)." << std::endl;
     }
     
     std::cout << "SystemMonitor shutdown completed." << std::endl;
+    if (consoleBuffer) {
+        std::cout.rdbuf(consoleBuffer);
+        consoleBuffer = nullptr;
+    }
 }
 
 bool SystemMonitorApplication::checkAdministratorPrivileges() const {
@@ -514,6 +945,12 @@ void SystemMonitorApplication::printStartupInfo() const {
                   << "s, Cooldown: " << emailConfig.cooldownMinutes << "m)";
     }
     std::cout << std::endl;
+    
+    // Alert rules
+    std::cout << "Alert rules: 3 system + " << config.getAlertRules().size() << " custom" << std::endl;
+    for (const auto& rule : config.getAlertRules()) {
+        std::cout << "  " << rule.toConfigString() << std::endl;
+    }
 }
 
 void SystemMonitorApplication::initializeDisplay() {
@@ -533,36 +970,20 @@ void SystemMonitorApplication::initializeDisplay() {
             displayMode = 3; // Silence mode
             break;
     }
+    // The screen renderer draws on stdout, which the JSON Lines own
+    if (jsonLines.isStdout() && (displayMode == 1 || displayMode == 2)) {
+        displayMode = 0;
+    }
+    
+    // Differential renderer for top-style and compact modes
+    screenRenderer.initialize();
+    screenRenderer.setFrameBudget(std::chrono::milliseconds(configManager->getConfig().getDisplayRefreshMs()));
     
     if (displayMode == 1 || displayMode == 2) {
         hideCursor(); // Hide cursor for cleaner display in top-style and compact modes
     }
 }
 
-void SystemMonitorApplication::clearScreen() {
-    COORD coordScreen = { 0, 0 };
-    DWORD cCharsWritten;
-    CONSOLE_SCREEN_BUFFER_INFO csbi;
-    DWORD dwConSize;
-    
-    if (!GetConsoleScreenBufferInfo(hConsole, &csbi)) {
-        return;
-    }
-    
-    dwConSize = csbi.dwSize.X * csbi.dwSize.Y;
-    
-    FillConsoleOutputCharacter(hConsole, ' ', dwConSize, coordScreen, &cCharsWritten);
-    FillConsoleOutputAttribute(hConsole, csbi.wAttributes, dwConSize, coordScreen, &cCharsWritten);
-    SetConsoleCursorPosition(hConsole, coordScreen);
-}
-
-void SystemMonitorApplication::setCursorPosition(int row, int col) {
-    COORD coord;
-    coord.X = col;
-    coord.Y = row;
-    SetConsoleCursorPosition(hConsole, coord);
-}
-
 void SystemMonitorApplication::hideCursor() {
     CONSOLE_CURSOR_INFO cursorInfo;
     GetConsoleCursorInfo(hConsole, &cursorInfo);
@@ -577,45 +998,70 @@ void SystemMonitorApplication::showCursor() {
     SetConsoleCursorInfo(hConsole, &cursorInfo);
 }
 
-bool SystemMonitorApplication::shouldUpdateDisplay() {
+void SystemMonitorApplication::showTopStyleDisplay(const std::vector<ProcessInfo>& processes, const SystemUsage& systemUsage) {
+    TraceScope frameTrace("Display frame", "display");
     auto now = std::chrono::steady_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - lastDisplayUpdate).count();
+    auto uptime = std::chrono::duration_cast<std::chrono::seconds>(now - startTime).count();
     
-    // Update display every 2 seconds instead of every monitoring cycle
-    if (elapsed >= 2000) {
-        lastDisplayUpdate = now;
-        return true;
+    // Build the frame; the renderer only writes what changed since the last one
+    screenRenderer.beginFrame();
+    std::ostringstream line;
+    
+    // Header information
+    line << "SystemMonitor - Uptime: " << std::setw(4) << uptime << "s | Processes: " << std::setw(3) << processes.size();
+    line << " | Tick jitter: " << std::fixed << std::setprecision(1) << std::setw(5)
+         << tickScheduler.getStats().lastJitter.count() / 1000.0 << "ms";
+    if (tickScheduler.getStats().missedTicks > 0) {
+        line << " (missed " << tickScheduler.getStats().missedTicks << ")";
     }
-    return false;
-}
-
-void SystemMonitorApplication::showTopStyleDisplay(const std::vector<ProcessInfo>& processes, const SystemUsage& systemUsage) {
-    // Only clear screen on first display or mode change
-    if (firstDisplay) {
-        clearScreen();
-        firstDisplay = false;
+    if (burstCapture.isActive()) {
+        line << " | BURST " << burstCapture.getSamples().size() << " samples";
     }
+    screenRenderer.addLine(line.str());
+    screenRenderer.addLine(selfMonitor.formatSummary());
     
-    // Always go to top of screen for updates
-    setCursorPosition(0, 0);
+    line.str("");
+    line << "CPU: " << std::fixed << std::setprecision(1) << std::setw(5) << systemUsage.getCpuPercent() << "%";
+    line << " | RAM: " << std::fixed << std::setprecision(1) << std::setw(5) << systemUsage.getRamPercent() << "%";
+    line << " | Disk: " << std::fixed << std::setprecision(1) << std::setw(5) << systemUsage.getDiskPercent() << "%";
+    screenRenderer.addLine(line.str());
     
-    auto now = std::chrono::steady_clock::now();
-    auto uptime = std::chrono::duration_cast<std::chrono::seconds>(now - startTime).count();
+    // Last hour from the per-minute history
+    MetricStore::Point lastHour = MetricStore::summarize(metricStore.querySystem(
+        MetricStore::Resolution::MINUTE, historyTimestampMs - 3600 * 1000, historyTimestampMs));
+    if (lastHour.count > 0) {
+        line.str("");
+        line << "1h avg/max  CPU: " << std::fixed << std::setprecision(1) << lastHour.avg[0] << "/" << lastHour.max[0]
+             << "% | RAM: " << lastHour.avg[1] << "/" << lastHour.max[1]
+             << "% | Disk: " << lastHour.avg[2] << "/" << lastHour.max[2] << "%";
+        screenRenderer.addLine(line.str());
+    }
     
-    // Header information (always update for real-time data)
-    std::cout << "SystemMonitor - Uptime: " << std::setw(4) << uptime << "s | Processes: " << std::setw(3) << processes.size();
-    // Clear rest of line to remove any leftover characters
-    std::cout << std::string(20, ' ') << "\n";
+    screenRenderer.addLine(std::string(80, '-'));
     
-    std::cout << "CPU: " << std::fixed << std::setprecision(1) << std::setw(5) << systemUsage.getCpuPercent() << "%";
-    std::cout << " | RAM: " << std::fixed << std::setprecision(1) << std::setw(5) << systemUsage.getRamPercent() << "%";
-    std::cout << " | Disk: " << std::fixed << std::setprecision(1) << std::setw(5) << systemUsage.getDiskPercent() << "%";
-    std::cout << std::string(20, ' ') << "\n"; // Clear rest of line
+    // Stage latency table in place of the process list
+    if (showStageTimings) {
+        size_t rows = 0;
+        std::istringstream table(stageProfiler.formatTable());
+        std::string tableLine;
+        while (std::getline(table, tableLine) && rows < 22) {
+            screenRenderer.addLine(tableLine);
+            rows++;
+        }
+        for (; rows < 22; ++rows) {
+            screenRenderer.addLine();
+        }
+        screenRenderer.addLine(std::string(80, '-'));
+        screenRenderer.addLine("Controls: [q]uit [t]oggle display mode [s]tage timings");
+        screenRenderer.present();
+        return;
+    }
     
-    std::cout << std::string(80, '-') << "\n";
-    std::cout << std::setw(8) << "PID" << std::setw(20) << "Process Name" 
-              << std::setw(8) << "CPU%" << std::setw(8) << "RAM%" << std::setw(8) << "Disk%" << "\n";
-    std::cout << std::string(80, '-') << "\n";
+    line.str("");
+    line << std::setw(8) << "PID" << std::setw(20) << "Process Name" 
+         << std::setw(8) << "CPU%" << std::setw(8) << "RAM%" << std::setw(8) << "Disk%";
+    screenRenderer.addLine(line.str());
+    screenRenderer.addLine(std::string(80, '-'));
     
     // Sort processes by CPU usage
     std::vector<ProcessInfo> sortedProcesses = processes;
@@ -633,46 +1079,41 @@ void SystemMonitorApplication::showTopStyleDisplay(const std::vector<ProcessInfo
             name = name.substr(0, 16) + "...";
         }
         
-        std::cout << std::setw(8) << process.getPid()
-                  << std::setw(20) << name
-                  << std::setw(7) << std::fixed << std::setprecision(1) << process.getCpuPercent() << "%"
-                  << std::setw(7) << std::fixed << std::setprecision(1) << process.getRamPercent() << "%"
-                  << std::setw(7) << std::fixed << std::setprecision(1) << process.getDiskPercent() << "%";
-        std::cout << std::string(15, ' ') << "\n"; // Clear rest of line
+        line.str("");
+        line << std::setw(8) << process.getPid()
+             << std::setw(20) << name
+             << std::setw(7) << std::fixed << std::setprecision(1) << process.getCpuPercent() << "%"
+             << std::setw(7) << std::fixed << std::setprecision(1) << process.getRamPercent() << "%"
+             << std::setw(7) << std::fixed << std::setprecision(1) << process.getDiskPercent() << "%";
+        screenRenderer.addLine(line.str());
     }
     
-    // Fill remaining lines with spaces to clear old content
+    // Keep the footer at a fixed row
     for (size_t i = maxToShow; i < 20; ++i) {
-        std::cout << std::string(80, ' ') << "\n";
+        screenRenderer.addLine();
     }
     
-    std::cout << std::string(80, '-') << "\n";
-    std::cout << "Controls: [q]uit [t]oggle display mode" << std::string(30, ' ') << "\n";
+    screenRenderer.addLine(std::string(80, '-'));
+    screenRenderer.addLine("Controls: [q]uit [t]oggle display mode [s]tage timings");
     
-    // Flush output to ensure immediate display
-    std::cout.flush();
+    screenRenderer.present();
 }
 
 void SystemMonitorApplication::showCompactDisplay(const std::vector<ProcessInfo>& processes, const SystemUsage& systemUsage) {
-    // Only clear screen on first display or mode change
-    if (firstDisplay) {
-        clearScreen();
-        firstDisplay = false;
-    }
-    
-    // Always go to top of screen for updates
-    setCursorPosition(0, 0);
-    
+    TraceScope frameTrace("Display frame", "display");
     auto now = std::chrono::steady_clock::now();
     auto uptime = std::chrono::duration_cast<std::chrono::seconds>(now - startTime).count();
     
+    screenRenderer.beginFrame();
+    std::ostringstream line;
+    
     // Compact header - single line with all key info
-    std::cout << "SystemMonitor [" << std::setw(4) << uptime << "s] CPU:" 
-              << std::fixed << std::setprecision(1) << std::setw(5) << systemUsage.getCpuPercent() << "% RAM:"
-              << std::fixed << std::setprecision(1) << std::setw(5) << systemUsage.getRamPercent() << "% Disk:"
-              << std::fixed << std::setprecision(1) << std::setw(5) << systemUsage.getDiskPercent() << "% Proc:"
-              << std::setw(3) << processes.size();
-    std::cout << std::string(15, ' ') << "\n"; // Clear rest of line
+    line << "SystemMonitor [" << std::setw(4) << uptime << "s] CPU:" 
+         << std::fixed << std::setprecision(1) << std::setw(5) << systemUsage.getCpuPercent() << "% RAM:"
+         << std::fixed << std::setprecision(1) << std::setw(5) << systemUsage.getRamPercent() << "% Disk:"
+         << std::fixed << std::setprecision(1) << std::setw(5) << systemUsage.getDiskPercent() << "% Proc:"
+         << std::setw(3) << processes.size();
+    screenRenderer.addLine(line.str());
     
     // Sort processes by total resource usage (CPU + RAM + Disk)
     std::vector<ProcessInfo> sortedProcesses = processes;
@@ -684,7 +1125,7 @@ void SystemMonitorApplication::showCompactDisplay(const std::vector<ProcessInfo>
               });
     
     // Compact process list - only show processes using significant resources
-    std::cout << "Top Resource Consumers:" << std::string(40, ' ') << "\n";
+    screenRenderer.addLine("Top Resource Consumers:");
     int lineCount = 0;
     const int maxLines = 10; // Limit to 10 lines for compact view
     
@@ -699,18 +1140,19 @@ void SystemMonitorApplication::showCompactDisplay(const std::vector<ProcessInfo>
             }
             
             // Compact format: name[pid] C:x.x% R:x.x% D:x.x%
-            std::cout << std::setw(13) << name << "[" << std::setw(5) << process.getPid() << "] "
-                      << "C:" << std::fixed << std::setprecision(1) << std::setw(4) << process.getCpuPercent() << "% "
-                      << "R:" << std::fixed << std::setprecision(1) << std::setw(4) << process.getRamPercent() << "% "
-                      << "D:" << std::fixed << std::setprecision(1) << std::setw(4) << process.getDiskPercent() << "%";
-            std::cout << std::string(20, ' ') << "\n"; // Clear rest of line
+            line.str("");
+            line << std::setw(13) << name << "[" << std::setw(5) << process.getPid() << "] "
+                 << "C:" << std::fixed << std::setprecision(1) << std::setw(4) << process.getCpuPercent() << "% "
+                 << "R:" << std::fixed << std::setprecision(1) << std::setw(4) << process.getRamPercent() << "% "
+                 << "D:" << std::fixed << std::setprecision(1) << std::setw(4) << process.getDiskPercent() << "%";
+            screenRenderer.addLine(line.str());
             lineCount++;
         }
     }
     
-    // Fill remaining lines with spaces if needed
+    // Keep the summary at a fixed row
     for (int i = lineCount; i < maxLines; ++i) {
-        std::cout << std::string(70, ' ') << "\n";
+        screenRenderer.addLine();
     }
     
     // Calculate system resource distribution
@@ -729,22 +1171,177 @@ void SystemMonitorApplication::showCompactDisplay(const std::vector<ProcessInfo>
     if (systemDisk < 0) systemDisk = 0.0;
     
     // Compact resource summary
-    std::cout << "Resource Split: Processes[C:" << std::fixed << std::setprecision(1) << totalProcessCpu 
-              << "% R:" << totalProcessRam << "% D:" << totalProcessDisk << "%] System[C:" 
-              << systemCpu << "% R:" << systemRam << "% D:" << systemDisk << "%]";
-    std::cout << std::string(5, ' ') << "\n"; // Clear rest of line
+    line.str("");
+    line << "Resource Split: Processes[C:" << std::fixed << std::setprecision(1) << totalProcessCpu 
+         << "% R:" << totalProcessRam << "% D:" << totalProcessDisk << "%] System[C:" 
+         << systemCpu << "% R:" << systemRam << "% D:" << systemDisk << "%]";
+    screenRenderer.addLine(line.str());
     
     // Compact status and controls
-    std::cout << "Status: " << (systemUsage.getCpuPercent() > 80 || systemUsage.getRamPercent() > 80 ? "HIGH LOAD" : "Normal")
-              << " | Controls: [q]uit [t]oggle mode" << std::string(20, ' ') << "\n";
+    line.str("");
+    line << "Status: " << (systemUsage.getCpuPercent() > 80 || systemUsage.getRamPercent() > 80 ? "HIGH LOAD" : "Normal")
+         << " | Controls: [q]uit [t]oggle mode";
+    screenRenderer.addLine(line.str());
     
-    // Fill remaining screen with blank lines
-    for (int i = 0; i < 5; ++i) {
-        std::cout << std::string(70, ' ') << "\n";
+    screenRenderer.present();
+}
+
+void SystemMonitorApplication::sampleSelf(const MonitorConfig& config) {
+    selfMonitor.setQueueStats(LoggerManager::getInstance().getQueueSize(), LoggerManager::getInstance().getDroppedCount(),
+                              emailNotifier ? emailNotifier->getQueueSize() : 0,
+                              emailNotifier ? emailNotifier->getDroppedCount() : 0);
+    TraceRecorder::instance().counter("Log queue", static_cast<int64_t>(selfMonitor.getStats().loggerQueueDepth));
+    TraceRecorder::instance().counter("Email queue", static_cast<int64_t>(selfMonitor.getStats().emailQueueDepth));
+    SelfMonitor::BudgetEvent budgetEvent = selfMonitor.sample();
+    
+    if (budgetEvent == SelfMonitor::BudgetEvent::EXCEEDED) {
+        std::ostringstream message;
+        message << "SystemMonitor exceeded its resource budget (CPU " << std::fixed << std::setprecision(2)
+                << selfMonitor.getCpuBudgetPercent() << "%, RSS " << config.getSelfRssBudgetMb() << " MB): "
+                << selfMonitor.formatSummary();
+        LoggerManager::getInstance().debug(message.str());
+        if (emailNotifier) {
+            emailNotifier->sendImmediateAlert("SystemMonitor resource budget exceeded", message.str());
+        }
+    } else if (budgetEvent == SelfMonitor::BudgetEvent::RECOVERED) {
+        LoggerManager::getInstance().debug("SystemMonitor back within its resource budget: " + selfMonitor.formatSummary());
+    } else if (config.isDebugMode()) {
+        LoggerManager::getInstance().debug(selfMonitor.formatSummary());
+    }
+}
+
+void SystemMonitorApplication::applyStatsdSettings(const MonitorConfig& config) {
+    statsdSink.setFormat(config.getStatsdFormat());
+    statsdSink.setFlushIntervalMs(config.getStatsdFlushMs());
+    statsdSink.setMaxPacketBytes(static_cast<size_t>(config.getStatsdPacketBytes()));
+    statsdSink.setTopProcesses(static_cast<size_t>(config.getStatsdTopProcesses()));
+}
+
+bool SystemMonitorApplication::waitForReplayCycle(double speed) {
+    if (!replayReader->next()) {
+        double elapsedSeconds = replayReader->getCycleCount() > 0
+            ? std::chrono::duration<double>(AlertEngine::Clock::now() - replayStart).count() : 0.0;
+        double recordedSeconds = (replayReader->getCurrent().timestampMs - replayReader->getFirstTimestampMs()) / 1000.0;
+        std::ostringstream summary;
+        summary << "Replay finished: " << replayReader->getCycleCount() << " cycles covering " << std::fixed
+                << std::setprecision(1) << recordedSeconds << " s of recording in " << elapsedSeconds << " s ("
+                << (elapsedSeconds > 0.0 ? replayReader->getCycleCount() / elapsedSeconds : 0.0) << " cycles/s)"
+                << (replayReader->isTruncated() ? "; the recording ends in an incomplete cycle" : "");
+        std::cout << summary.str() << std::endl;
+        LoggerManager::getInstance().debug(summary.str());
+        return false;
     }
     
-    // Flush output to ensure immediate display
-    std::cout.flush();
+    // Alert durations run on recorded time; the wall clock is paced by the speed factor
+    AlertEngine::Clock::time_point now = AlertEngine::Clock::now();
+    if (replayReader->getCycleCount() == 1) {
+        replayStart = now;
+    }
+    std::chrono::milliseconds recordedOffset(replayReader->getCurrent().timestampMs - replayReader->getFirstTimestampMs());
+    replayTime = replayStart + recordedOffset;
+    if (speed > 0.0) {
+        std::this_thread::sleep_until(replayStart + std::chrono::duration_cast<AlertEngine::Clock::duration>(
+                                          std::chrono::duration<double, std::milli>(recordedOffset.count() / speed)));
+    }
+    return isRunning;
+}
+
+void SystemMonitorApplication::finishBurst() {
+    burstCapture.finish();
+    burstReport = burstCapture.formatReport();
+    LoggerManager::getInstance().logReport(burstReport);
+    
+    if (emailNotifier) {
+        for (const auto& alert : heldAlerts) {
+            emailNotifier->notifyRuleAlert(alert.first, alert.second + "\n" + burstReport);
+        }
+    }
+    heldAlerts.clear();
+}
+
+std::string SystemMonitorApplication::buildDetailedLogEntry(const std::vector<ProcessInfo>& processes,
+                                                           const SystemUsage& systemUsage) const {
+    // Generate detailed log entry for email alert (same format as logger)
+    std::ostringstream detailedLogEntry;
+    
+    // Calculate process usage totals
+    double totalProcessCpu = 0.0;
+    double totalProcessRam = 0.0;
+    double totalProcessDisk = 0.0;
+    
+    for (const auto& process : processes) {
+        totalProcessCpu += process.getCpuPercent();
+        totalProcessRam += process.getRamPercent();
+        totalProcessDisk += process.getDiskPercent();
+    }
+    
+    // Calculate "unaccounted" usage (system overhead, kernel, cache, etc.)
+    double unaccountedCpu = systemUsage.getCpuPercent() - totalProcessCpu;
+    double unaccountedRam = systemUsage.getRamPercent() - totalProcessRam;
+    double unaccountedDisk = systemUsage.getDiskPercent() - totalProcessDisk;
+    if (unaccountedCpu < 0) unaccountedCpu = 0.0;
+    if (unaccountedRam < 0) unaccountedRam = 0.0;
+    if (unaccountedDisk < 0) unaccountedDisk = 0.0;
+    
+    // Get current time
+    auto now = std::chrono::system_clock::now();
+    std::time_t now_c = std::chrono::system_clock::to_time_t(now);
+    std::tm tm;
+    localtime_s(&tm, &now_c);
+    char timeStr[32];
+    std::strftime(timeStr, sizeof(timeStr), "%d-%m-%Y %H:%M:%S", &tm);
+    
+    // Create the detailed log entry in the same format as the logger
+    detailedLogEntry << "===Start " << timeStr 
+        << " [System CPU " << std::fixed << std::setprecision(2) << systemUsage.getCpuPercent()
+        << "%] [System RAM " << std::fixed << std::setprecision(2) << systemUsage.getRamPercent()
+        << "%] [System Disk " << std::fixed << std::setprecision(2) << systemUsage.getDiskPercent() 
+        << "%]===\n";
+    
+    // System analysis lines
+    detailedLogEntry << "SYSTEM ANALYSIS: CPU: Processes=" << std::fixed << std::setprecision(2) << totalProcessCpu 
+        << "% + System/Kernel=" << std::fixed << std::setprecision(2) << unaccountedCpu 
+        << "% = Total=" << std::fixed << std::setprecision(2) << systemUsage.getCpuPercent() << "%\n";
+    detailedLogEntry << "SYSTEM ANALYSIS: RAM: Processes=" << std::fixed << std::setprecision(2) << totalProcessRam 
+        << "% + System/Kernel=" << std::fixed << std::setprecision(2) << unaccountedRam 
+        << "% = Total=" << std::fixed << std::setprecision(2) << systemUsage.getRamPercent() << "%\n";
+    detailedLogEntry << "SYSTEM ANALYSIS: DISK: Processes=" << std::fixed << std::setprecision(2) << totalProcessDisk 
+        << "% + System/Kernel=" << std::fixed << std::setprecision(2) << unaccountedDisk 
+        << "% = Total=" << std::fixed << std::setprecision(2) << systemUsage.getDiskPercent() << "%\n";
+    
+    // Individual process entries
+    for (const auto& process : processes) {
+        detailedLogEntry << timeStr << ", " 
+            << process.getName() << ", " 
+            << process.getPid() 
+            << ", [CPU " << std::fixed << std::setprecision(2) << process.getCpuPercent()
+            << "%] [RAM " << std::fixed << std::setprecision(2) << process.getRamPercent()
+            << "%] [Disk " << std::fixed << std::setprecision(2) << process.getDiskPercent() 
+            << "%]\n";
+    }
+    
+    // Resource totals
+    detailedLogEntry << "TOTALS: [Process CPU " << std::fixed << std::setprecision(2) << totalProcessCpu
+        << "%] [Process RAM " << std::fixed << std::setprecision(2) << totalProcessRam
+        << "%] [Process Disk " << std::fixed << std::setprecision(2) << totalProcessDisk << "%]\n";
+    
+    if (unaccountedRam > 5.0) { // Show significant system overhead
+        detailedLogEntry << "SYSTEM OVERHEAD: [CPU " << std::fixed << std::setprecision(2) << unaccountedCpu
+            << "%] [RAM " << std::fixed << std::setprecision(2) << unaccountedRam
+            << "%] [Disk " << std::fixed << std::setprecision(2) << unaccountedDisk << "%] (Kernel/Cache/Buffers)\n";
+    }
+    
+    // Footprint of the agent itself
+    detailedLogEntry << "AGENT: " << selfMonitor.formatSummary() << "\n";
+    
+    // End banner
+    detailedLogEntry << "===End  " << timeStr 
+        << " [System CPU " << std::fixed << std::setprecision(2) << systemUsage.getCpuPercent()
+        << "%] [System RAM " << std::fixed << std::setprecision(2) << systemUsage.getRamPercent()
+        << "%] [System Disk " << std::fixed << std::setprecision(2) << systemUsage.getDiskPercent() 
+        << "%]===";
+    
+    return detailedLogEntry.str();
 }
 
 bool SystemMonitorApplication::checkForKeyPress() {
@@ -759,10 +1356,17 @@ void SystemMonitorApplication::handleKeyPress() {
             showCursor(); // Show cursor before exiting
             isRunning = false;
             break;
+        case 's':
+            showStageTimings = !showStageTimings; // Top-style mode: stage latency table instead of processes
+            screenRenderer.invalidate();
+            break;
         case 't':
             displayMode = (displayMode + 1) % 4; // Cycle through 0, 1, 2, 3 (line, top, compact, silence)
+            if (jsonLines.isStdout() && (displayMode == 1 || displayMode == 2)) {
+                displayMode = 3;                  // No table views while stdout carries JSON Lines
+            }
             g_suppressConsoleOutput = (displayMode == 1 || displayMode == 2); // Set based on new mode
-            firstDisplay = true; // Force screen clear on mode change
+            screenRenderer.invalidate(); // Force full redraw on mode change
             if (displayMode == 1 || displayMode == 2) {
                 hideCursor();
             } else {
@@ -0,0 +1,404 @@
+#include "../include/AlertEngine.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <map>
+#include <sstream>
+
+// AlertRule implementation
+const char* AlertRule::metricName(AlertMetric metric) {
+    switch (metric) {
+        case AlertMetric::CPU: return "cpu";
+        case AlertMetric::RAM: return "ram";
+        case AlertMetric::DISK: return "disk";
+    }
+    return "cpu";
+}
+
+std::string AlertRule::getName() const {
+    std::string name = (scope == AlertScope::SYSTEM) ? "system" : processName;
+    std::string metricStr = metricName(metric);
+    std::transform(metricStr.begin(), metricStr.end(), metricStr.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    std::ostringstream out;
+    if (condition == AlertCondition::RATE) {
+        out << name << " " << metricStr << " rising > " << triggerLevel << "%/min";
+    } else {
+        out << name << " " << metricStr << " > " << triggerLevel << "%";
+    }
+    return out.str();
+}
+
+std::string AlertRule::toConfigString() const {
+    std::ostringstream out;
+    if (scope == AlertScope::SYSTEM) {
+        out << "system";
+    } else {
+        out << "process:" << processName;
+    }
+    out << " " << metricName(metric);
+    if (condition == AlertCondition::RATE) {
+        out << " rate";
+    }
+    out << " > " << triggerLevel;
+    if (clearLevel != triggerLevel) {
+        out << " clear " << clearLevel;
+    }
+    if (smoothingSeconds > 0) {
+        out << " smooth " << smoothingSeconds << "s";
+    }
+    // An explicit 0 is written out; only inherited timings are omitted
+    if (durationSeconds != INHERIT_TIMING) {
+        out << " for " << durationSeconds << "s";
+    }
+    if (recoveryDurationSeconds != INHERIT_TIMING) {
+        out << " recover " << recoveryDurationSeconds << "s";
+    }
+    if (cooldownSeconds != INHERIT_TIMING) {
+        out << " cooldown " << cooldownSeconds << "s";
+    }
+    return out.str();
+}
+
+static bool parseRuleDuration(const std::string& token, int& seconds) {
+    if (token.empty()) return false;
+    char* end = nullptr;
+    double value = std::strtod(token.c_str(), &end);
+    if (end == token.c_str() || value < 0) return false;
+
+    std::string suffix(end);
+    if (suffix.empty() || suffix == "s") {
+        seconds = static_cast<int>(value);
+    } else if (suffix == "m") {
+        seconds = static_cast<int>(value * 60);
+    } else if (suffix == "h") {
+        seconds = static_cast<int>(value * 3600);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static bool parseRuleLevel(const std::string& token, double& level) {
+    char* end = nullptr;
+    level = std::strtod(token.c_str(), &end);
+    if (end == token.c_str()) return false;
+    if (*end == '%') ++end;
+    return *end == '\0' && level >= 0.0 && level <= 100.0;
+}
+
+bool AlertRule::parse(const std::string& text, AlertRule& rule, std::string& error) {
+    std::istringstream in(text);
+    std::vector<std::string> tokens;
+    std::string token;
+    while (in >> token) {
+        std::string lower = token;
+        std::transform(lower.begin(), lower.end(), lower.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        tokens.push_back(lower);
+    }
+
+    if (tokens.size() < 4) {
+        error = "expected '<scope> <metric> [rate] > <level>'";
+        return false;
+    }
+
+    AlertRule parsed;
+
+    // Scope
+    if (tokens[0] == "system") {
+        parsed.scope = AlertScope::SYSTEM;
+    } else if (tokens[0].compare(0, 8, "process:") == 0 && tokens[0].size() > 8) {
+        parsed.scope = AlertScope::PROCESS;
+        parsed.processName = tokens[0].substr(8);
+    } else {
+        error = "unknown scope '" + tokens[0] + "' (use system or process:<name>)";
+        return false;
+    }
+
+    // Metric
+    if (tokens[1] == "cpu") {
+        parsed.metric = AlertMetric::CPU;
+    } else if (tokens[1] == "ram") {
+        parsed.metric = AlertMetric::RAM;
+    } else if (tokens[1] == "disk") {
+        parsed.metric = AlertMetric::DISK;
+    } else {
+        error = "unknown metric '" + tokens[1] + "' (use cpu, ram or disk)";
+        return false;
+    }
+
+    size_t next = 2;
+    if (tokens[next] == "rate") {
+        parsed.condition = AlertCondition::RATE;
+        next++;
+    }
+    if (next + 1 >= tokens.size() || tokens[next] != ">") {
+        error = "expected '>' after metric";
+        return false;
+    }
+    if (!parseRuleLevel(tokens[next + 1], parsed.triggerLevel)) {
+        error = "invalid trigger level '" + tokens[next + 1] + "'";
+        return false;
+    }
+    parsed.clearLevel = parsed.triggerLevel;
+
+    // Optional modifiers
+    for (size_t i = next + 2; i < tokens.size(); i += 2) {
+        if (i + 1 >= tokens.size()) {
+            error = "missing value after '" + tokens[i] + "'";
+            return false;
+        }
+        const std::string& keyword = tokens[i];
+        const std::string& value = tokens[i + 1];
+        bool ok = false;
+        if (keyword == "clear") {
+            ok = parseRuleLevel(value, parsed.clearLevel) && parsed.clearLevel <= parsed.triggerLevel;
+        } else if (keyword == "smooth") {
+            ok = parseRuleDuration(value, parsed.smoothingSeconds);
+        } else if (keyword == "for") {
+            ok = parseRuleDuration(value, parsed.durationSeconds);
+        } else if (keyword == "recover") {
+            ok = parseRuleDuration(value, parsed.recoveryDurationSeconds);
+        } else if (keyword == "cooldown") {
+            ok = parseRuleDuration(value, parsed.cooldownSeconds);
+        } else {
+            error = "unknown keyword '" + keyword + "'";
+            return false;
+        }
+        if (!ok) {
+            error = "invalid value '" + value + "' for '" + keyword + "'";
+            return false;
+        }
+    }
+
+    rule = parsed;
+    return true;
+}
+
+// MetricTracker implementation
+void MetricTracker::update(double raw, int64_t nowMs, double smoothingSeconds) {
+    if (!initialized) {
+        smoothed = raw;
+        slopePerMinute = 0.0;
+        lastMs = nowMs;
+        initialized = true;
+        return;
+    }
+
+    double dt = (nowMs - lastMs) / 1000.0;
+    if (dt <= 0.0) return;
+    lastMs = nowMs;
+
+    // Time-constant EWMA stays correct when sampling intervals vary
+    double alpha = smoothingSeconds > 0.0 ? 1.0 - std::exp(-dt / smoothingSeconds) : 1.0;
+    double previous = smoothed;
+    smoothed += alpha * (raw - smoothed);
+
+    // Slope is smoothed over at least a minute so single-sample jumps do not dominate
+    double instantSlope = (smoothed - previous) * 60.0 / dt;
+    double slopeTau = std::max(smoothingSeconds, 60.0);
+    double beta = 1.0 - std::exp(-dt / slopeTau);
+    slopePerMinute += beta * (instantSlope - slopePerMinute);
+}
+
+// AlertEngine implementation
+AlertEngine::AlertEngine(const std::vector<AlertRule>& ruleSet) {
+    setRules(ruleSet);
+}
+
+int64_t AlertEngine::toMillis(Clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
+}
+
+void AlertEngine::normalizeProcessName(const std::string& name, std::string& out) {
+    out.assign(name);
+    for (auto& c : out) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    if (out.size() > 4 && out.compare(out.size() - 4, 4, ".exe") == 0) {
+        out.resize(out.size() - 4);
+    }
+}
+
+void AlertEngine::setRules(const std::vector<AlertRule>& ruleSet) {
+    // Carry state over for rules that survive a reconfiguration unchanged. Identical
+    // rules are told apart by occurrence, so the n-th copy keeps the n-th copy's state
+    std::map<std::pair<std::string, size_t>, RuleState> previousStates;
+    std::unordered_map<std::string, size_t> occurrences;
+    for (size_t i = 0; i < rules.size(); ++i) {
+        std::string key = rules[i].toConfigString();
+        size_t occurrence = occurrences[key]++;
+        previousStates[{ std::move(key), occurrence }] = states[i];
+    }
+    occurrences.clear();
+
+    rules = ruleSet;
+    compiled.clear();
+    states.clear();
+    processSlots.clear();
+    processSlotByName.clear();
+    compiled.reserve(rules.size());
+    states.reserve(rules.size());
+
+    for (const auto& rule : rules) {
+        CompiledRule entry;
+        // Timings still set to INHERIT_TIMING count as 0
+        entry.durationMs = static_cast<int64_t>(std::max(0, rule.durationSeconds)) * 1000;
+        entry.recoveryMs = static_cast<int64_t>(std::max(0, rule.recoveryDurationSeconds)) * 1000;
+        entry.cooldownMs = static_cast<int64_t>(std::max(0, rule.cooldownSeconds)) * 1000;
+        entry.trigger = static_cast<float>(rule.triggerLevel);
+        entry.clear = static_cast<float>(std::min(rule.clearLevel, rule.triggerLevel));
+        entry.smoothingSeconds = static_cast<float>(rule.smoothingSeconds);
+        entry.metric = rule.metric;
+        entry.condition = rule.condition;
+        entry.source = 0;
+
+        if (rule.scope == AlertScope::PROCESS) {
+            normalizeProcessName(rule.processName, nameScratch);
+            auto it = processSlotByName.find(nameScratch);
+            if (it == processSlotByName.end()) {
+                it = processSlotByName.emplace(nameScratch, static_cast<uint32_t>(processSlots.size())).first;
+                processSlots.push_back(ProcessSlot{{0.0f, 0.0f, 0.0f}});
+            }
+            entry.source = it->second + 1;
+        }
+        compiled.push_back(entry);
+
+        std::string key = rule.toConfigString();
+        size_t occurrence = occurrences[key]++;
+        auto previous = previousStates.find({ std::move(key), occurrence });
+        states.push_back(previous != previousStates.end() ? previous->second : RuleState());
+    }
+}
+
+const std::vector<AlertEvent>& AlertEngine::evaluate(const SystemUsage& systemUsage,
+                                                     const std::vector<ProcessInfo>& processes,
+                                                     Clock::time_point now) {
+    events.clear();
+    const int64_t nowMs = toMillis(now);
+
+    // Gather the per-process values in one pass over the snapshot
+    if (!processSlots.empty()) {
+        for (auto& slot : processSlots) {
+            slot.values[0] = slot.values[1] = slot.values[2] = 0.0f;
+        }
+        for (const auto& process : processes) {
+            normalizeProcessName(process.getName(), nameScratch);
+            auto it = processSlotByName.find(nameScratch);
+            if (it == processSlotByName.end()) continue;
+
+            ProcessSlot& slot = processSlots[it->second];
+            slot.values[0] = std::max(slot.values[0], static_cast<float>(process.getCpuPercent()));
+            slot.values[1] = std::max(slot.values[1], static_cast<float>(process.getRamPercent()));
+            slot.values[2] = std::max(slot.values[2], static_cast<float>(process.getDiskPercent()));
+        }
+    }
+
+    const float systemValues[3] = {
+        static_cast<float>(systemUsage.getCpuPercent()),
+        static_cast<float>(systemUsage.getRamPercent()),
+        static_cast<float>(systemUsage.getDiskPercent())
+    };
+
+    // Advance every rule state machine
+    for (size_t i = 0; i < compiled.size(); ++i) {
+        const CompiledRule& rule = compiled[i];
+        RuleState& state = states[i];
+        const size_t metricIndex = static_cast<size_t>(rule.metric);
+        const float raw = (rule.source == 0) ? systemValues[metricIndex]
+                                             : processSlots[rule.source - 1].values[metricIndex];
+        state.input.update(raw, nowMs, rule.smoothingSeconds);
+        const float value = static_cast<float>(rule.condition == AlertCondition::RATE
+                                               ? state.input.slopePerMinute
+                                               : state.input.smoothed);
+        state.value = value;
+
+        // Schmitt trigger: trip above trigger level, release at or below clear level
+        if (!state.exceeded && value > rule.trigger) {
+            state.exceeded = true;
+        } else if (state.exceeded && value <= rule.clear) {
+            state.exceeded = false;
+        }
+
+        switch (state.phase) {
+            case RulePhase::NORMAL:
+                if (state.exceeded) {
+                    state.phase = RulePhase::PENDING;
+                    state.exceededSinceMs = nowMs;
+                }
+                break;
+
+            case RulePhase::PENDING:
+                if (!state.exceeded) {
+                    state.phase = RulePhase::NORMAL;
+                } else if (nowMs - state.exceededSinceMs >= rule.durationMs &&
+                           nowMs - state.lastFiredMs >= rule.cooldownMs) {
+                    state.phase = RulePhase::FIRING;
+                    state.firedAtMs = nowMs;
+                    state.lastFiredMs = nowMs;
+                    events.push_back({i, AlertEventType::FIRED, value,
+                                      static_cast<int>((nowMs - state.exceededSinceMs) / 1000)});
+                }
+                break;
+
+            case RulePhase::FIRING:
+                if (!state.exceeded) {
+                    state.phase = RulePhase::RECOVERING;
+                    state.normalSinceMs = nowMs;
+                }
+                break;
+
+            case RulePhase::RECOVERING:
+                if (state.exceeded) {
+                    state.phase = RulePhase::FIRING;
+                } else if (nowMs - state.normalSinceMs >= rule.recoveryMs) {
+                    state.phase = RulePhase::NORMAL;
+                    events.push_back({i, AlertEventType::RECOVERED, value,
+                                      static_cast<int>((nowMs - state.firedAtMs) / 1000)});
+                }
+                break;
+        }
+    }
+
+    return events;
+}
+
+bool AlertEngine::anyExceeded() const {
+    for (const auto& state : states) {
+        if (state.exceeded) return true;
+    }
+    return false;
+}
+
+std::vector<std::string> AlertEngine::getExceededRuleNames() const {
+    std::vector<std::string> names;
+    for (size_t i = 0; i < states.size(); ++i) {
+        if (states[i].exceeded) {
+            names.push_back(rules[i].getName());
+        }
+    }
+    return names;
+}
+
+std::vector<AlertRule> AlertEngine::createSystemRules(double cpuThreshold, double ramThreshold,
+                                                      double diskThreshold, int durationSeconds,
+                                                      int recoveryDurationSeconds, int cooldownSeconds) {
+    std::vector<AlertRule> systemRules;
+    const double levels[3] = {cpuThreshold, ramThreshold, diskThreshold};
+    const AlertMetric metrics[3] = {AlertMetric::CPU, AlertMetric::RAM, AlertMetric::DISK};
+
+    for (int i = 0; i < 3; ++i) {
+        AlertRule rule;
+        rule.scope = AlertScope::SYSTEM;
+        rule.metric = metrics[i];
+        rule.triggerLevel = levels[i];
+        rule.clearLevel = levels[i];
+        rule.durationSeconds = durationSeconds;
+        rule.recoveryDurationSeconds = recoveryDurationSeconds;
+        rule.cooldownSeconds = cooldownSeconds;
+        systemRules.push_back(rule);
+    }
+    return systemRules;
+}
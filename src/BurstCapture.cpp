@@ -0,0 +1,163 @@
+#include "../include/BurstCapture.h"
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+#include <ctime>
+
+namespace {
+
+constexpr int MAX_WINDOW_SECONDS = 300;
+constexpr int MAX_TOP_PROCESSES = 50;
+
+double offsetSeconds(int64_t offsetMs) {
+    return static_cast<double>(offsetMs) / 1000.0;
+}
+
+} // namespace
+
+BurstCapture::BurstCapture(int window, int interval, int top) {
+    configure(window, interval, top);
+}
+
+void BurstCapture::configure(int window, int interval, int top) {
+    windowSeconds = std::max(0, std::min(window, MAX_WINDOW_SECONDS));
+    intervalMs = std::max(MIN_INTERVAL_MS, std::min(interval, MAX_INTERVAL_MS));
+    topProcesses = std::max(0, std::min(top, MAX_TOP_PROCESSES));
+}
+
+bool BurstCapture::onThresholdState(bool exceeded) {
+    bool risingEdge = exceeded && !previousExceeded;
+    previousExceeded = exceeded;
+    return risingEdge && isEnabled() && !active;
+}
+
+void BurstCapture::begin(const std::vector<ProcessInfo>& processes, const std::string& triggerReason,
+                         Clock::time_point now) {
+    // Top offenders by combined usage, the same ranking as the silence mode summary
+    std::vector<const ProcessInfo*> ranked;
+    ranked.reserve(processes.size());
+    for (const auto& process : processes) {
+        ranked.push_back(&process);
+    }
+    size_t count = std::min<size_t>(static_cast<size_t>(topProcesses), ranked.size());
+    std::partial_sort(ranked.begin(), ranked.begin() + count, ranked.end(),
+                      [](const ProcessInfo* a, const ProcessInfo* b) {
+                          return (a->getCpuPercent() + a->getRamPercent() + a->getDiskPercent()) >
+                                 (b->getCpuPercent() + b->getRamPercent() + b->getDiskPercent());
+                      });
+
+    targets.clear();
+    targetPids.clear();
+    for (size_t i = 0; i < count; i++) {
+        targets.push_back({ ranked[i]->getPid(), ranked[i]->getName() });
+        targetPids.push_back(ranked[i]->getPid());
+    }
+
+    // Settings are frozen for the duration of the burst
+    burstWindowSeconds = windowSeconds;
+    burstIntervalMs = intervalMs;
+    maxSamples = static_cast<size_t>(burstWindowSeconds) * 1000 / burstIntervalMs + 2;
+    samples.clear();
+    samples.reserve(maxSamples);
+
+    reason = triggerReason;
+    startTime = now;
+    startWallTime = std::chrono::system_clock::now();
+    active = true;
+}
+
+void BurstCapture::record(const SystemUsage& systemUsage, const std::vector<ProcessInfo>& processes,
+                          Clock::time_point now) {
+    // The buffer never grows past the size reserved for the window
+    if (!active || samples.size() >= maxSamples) {
+        return;
+    }
+
+    Sample sample;
+    sample.offsetMs = std::chrono::duration_cast<std::chrono::milliseconds>(now - startTime).count();
+    sample.systemUsage = systemUsage;
+    sample.points.resize(targets.size());
+    for (const auto& process : processes) {
+        for (size_t i = 0; i < targets.size(); i++) {
+            if (targets[i].pid == process.getPid()) {
+                ProcessPoint& point = sample.points[i];
+                point.cpuPercent = static_cast<float>(process.getCpuPercent());
+                point.ramPercent = static_cast<float>(process.getRamPercent());
+                point.diskPercent = static_cast<float>(process.getDiskPercent());
+                point.present = true;
+                break;
+            }
+        }
+    }
+    samples.push_back(std::move(sample));
+}
+
+bool BurstCapture::isComplete(Clock::time_point now) const {
+    return !active || now - startTime >= std::chrono::seconds(burstWindowSeconds);
+}
+
+std::string BurstCapture::formatReport() const {
+    std::ostringstream report;
+    report << std::fixed << std::setprecision(2);
+
+    std::time_t start_c = std::chrono::system_clock::to_time_t(startWallTime);
+    std::tm tm;
+#ifdef _WIN32
+    localtime_s(&tm, &start_c);
+#else
+    localtime_r(&start_c, &tm);
+#endif
+    char timeStr[32];
+    std::strftime(timeStr, sizeof(timeStr), "%d-%m-%Y %H:%M:%S", &tm);
+
+    report << "===Burst " << timeStr << " [" << reason << "] [" << samples.size()
+           << " samples every " << burstIntervalMs << " ms" << (active ? ", in progress" : "") << "]===\n";
+
+    for (const auto& sample : samples) {
+        double offset = offsetSeconds(sample.offsetMs);
+        report << "+" << std::setprecision(3) << offset << std::setprecision(2) << "s, System"
+               << ", [CPU " << sample.systemUsage.getCpuPercent()
+               << "%] [RAM " << sample.systemUsage.getRamPercent()
+               << "%] [Disk " << sample.systemUsage.getDiskPercent() << "%]\n";
+        for (size_t i = 0; i < targets.size(); i++) {
+            const ProcessPoint& point = sample.points[i];
+            if (!point.present) {
+                continue;
+            }
+            report << "+" << std::setprecision(3) << offset << std::setprecision(2) << "s, "
+                   << targets[i].name << ", " << targets[i].pid
+                   << ", [CPU " << point.cpuPercent << "%] [RAM " << point.ramPercent
+                   << "%] [Disk " << point.diskPercent << "%]\n";
+        }
+    }
+
+    // Peak of each target over the window
+    for (size_t i = 0; i < targets.size(); i++) {
+        ProcessPoint peak;
+        int64_t peakCpuOffset = 0;
+        for (const auto& sample : samples) {
+            const ProcessPoint& point = sample.points[i];
+            if (!point.present) {
+                continue;
+            }
+            if (!peak.present || point.cpuPercent > peak.cpuPercent) {
+                peak.cpuPercent = point.cpuPercent;
+                peakCpuOffset = sample.offsetMs;
+            }
+            peak.ramPercent = std::max(peak.ramPercent, point.ramPercent);
+            peak.diskPercent = std::max(peak.diskPercent, point.diskPercent);
+            peak.present = true;
+        }
+        if (peak.present) {
+            report << "PEAK: " << targets[i].name << ", " << targets[i].pid
+                   << ", [CPU " << peak.cpuPercent << "% at +" << std::setprecision(3)
+                   << offsetSeconds(peakCpuOffset) << std::setprecision(2) << "s] [RAM "
+                   << peak.ramPercent << "%] [Disk " << peak.diskPercent << "%]\n";
+        } else {
+            report << "PEAK: " << targets[i].name << ", " << targets[i].pid << ", exited\n";
+        }
+    }
+
+    report << "===End burst===\n";
+    return report.str();
+}
@@ -0,0 +1,688 @@
+#include "../include/ColumnarExport.h"
+#include "../include/TraceRecorder.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+
+namespace {
+
+const char FILE_MAGIC[8] = { 'S', 'M', 'C', 'O', 'L', 'X', '\x01', '\n' };
+const char BLOCK_MAGIC[4] = { 'S', 'M', 'C', 'B' };
+const size_t BLOCK_TRAILER_BYTES = 8;           // Footer length and block magic
+
+void putVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+void putSigned(std::string& out, int64_t value) {
+    putVarint(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+void putU32(std::string& out, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+uint32_t getU32(const uint8_t* data) {
+    return static_cast<uint32_t>(data[0]) | static_cast<uint32_t>(data[1]) << 8 |
+           static_cast<uint32_t>(data[2]) << 16 | static_cast<uint32_t>(data[3]) << 24;
+}
+
+int bitWidth(uint64_t range) {
+    int width = 0;
+    while (range > 0) {
+        width++;
+        range >>= 1;
+    }
+    return width;
+}
+
+// Values LSB first, width bits each, continuing across byte boundaries
+void packBits(std::string& out, const std::vector<uint64_t>& values, int width) {
+    if (width == 0) {
+        return;
+    }
+    size_t begin = out.size();
+    out.append((values.size() * static_cast<size_t>(width) + 7) / 8, '\0');
+    uint64_t bitPosition = 0;
+    for (uint64_t value : values) {
+        int written = 0;
+        while (written < width) {
+            size_t byte = begin + static_cast<size_t>(bitPosition >> 3);
+            int shift = static_cast<int>(bitPosition & 7);
+            int take = std::min(width - written, 8 - shift);
+            out[byte] = static_cast<char>(static_cast<uint8_t>(out[byte]) |
+                                          ((value >> written) & ((1u << take) - 1)) << shift);
+            written += take;
+            bitPosition += static_cast<uint64_t>(take);
+        }
+    }
+}
+
+uint64_t unpackBits(const uint8_t* data, uint64_t bitPosition, int width) {
+    uint64_t value = 0;
+    int filled = 0;
+    while (filled < width) {
+        uint8_t byte = data[bitPosition >> 3];
+        int shift = static_cast<int>(bitPosition & 7);
+        int take = std::min(width - filled, 8 - shift);
+        value |= static_cast<uint64_t>((byte >> shift) & ((1u << take) - 1)) << filled;
+        filled += take;
+        bitPosition += static_cast<uint64_t>(take);
+    }
+    return value;
+}
+
+// Frame-of-reference bit-packing: the minimum as a signed varint, then every
+// value minus the minimum at the width of the range
+void putPacked(std::string& out, const std::vector<int64_t>& values, size_t first) {
+    int64_t reference = 0;
+    int64_t highest = 0;
+    if (first < values.size()) {
+        auto range = std::minmax_element(values.begin() + static_cast<std::ptrdiff_t>(first), values.end());
+        reference = *range.first;
+        highest = *range.second;
+    }
+    int width = bitWidth(static_cast<uint64_t>(highest) - static_cast<uint64_t>(reference));
+    std::vector<uint64_t> offsets;
+    offsets.reserve(values.size() - std::min(first, values.size()));
+    for (size_t i = first; i < values.size(); i++) {
+        offsets.push_back(static_cast<uint64_t>(values[i]) - static_cast<uint64_t>(reference));
+    }
+    putSigned(out, reference);
+    out.push_back(static_cast<char>(width));
+    packBits(out, offsets, width);
+}
+
+// Integer column: value count, then the values as the encoding stores them
+void putIntegers(std::string& out, const std::vector<int64_t>& values, ExportEncoding encoding) {
+    putVarint(out, values.size());
+    if (encoding != ExportEncoding::DELTA) {
+        putPacked(out, values, 0);
+        return;
+    }
+    std::vector<int64_t> deltas;
+    deltas.reserve(values.size());
+    for (size_t i = 0; i < values.size(); i++) {
+        deltas.push_back(i == 0 ? values[0] : static_cast<int64_t>(static_cast<uint64_t>(values[i]) -
+                                                                     static_cast<uint64_t>(values[i - 1])));
+    }
+    putSigned(out, deltas.empty() ? 0 : deltas[0]);
+    putPacked(out, deltas, 1);
+}
+
+ExportColumnStats statsOf(const std::vector<int64_t>& values) {
+    ExportColumnStats stats;
+    if (!values.empty()) {
+        auto range = std::minmax_element(values.begin(), values.end());
+        stats.min = *range.first;
+        stats.max = *range.second;
+    }
+    return stats;
+}
+
+class Decoder {
+private:
+    const uint8_t* data;
+    size_t size;
+    size_t position = 0;
+
+public:
+    Decoder(const uint8_t* bytes, size_t length) : data(bytes), size(length) {}
+
+    size_t remaining() const { return size - position; }
+    const uint8_t* current() const { return data + position; }
+
+    bool getByte(uint8_t& value) {
+        if (position >= size) {
+            return false;
+        }
+        value = data[position++];
+        return true;
+    }
+
+    bool getVarint(uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t byte;
+            if (!getByte(byte)) {
+                return false;
+            }
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool getSigned(int64_t& value) {
+        uint64_t encoded;
+        if (!getVarint(encoded)) {
+            return false;
+        }
+        value = static_cast<int64_t>((encoded >> 1) ^ (~(encoded & 1) + 1));
+        return true;
+    }
+
+    bool skip(size_t count) {
+        if (count > remaining()) {
+            return false;
+        }
+        position += count;
+        return true;
+    }
+
+    // count frame-of-reference values appended to out
+    bool getPacked(size_t count, std::vector<int64_t>& out) {
+        int64_t reference;
+        uint8_t width;
+        if (!getSigned(reference) || !getByte(width) || width > 64) {
+            return false;
+        }
+        uint64_t bits = static_cast<uint64_t>(count) * width;
+        if ((bits + 7) / 8 > remaining()) {
+            return false;
+        }
+        const uint8_t* packed = current();
+        for (size_t i = 0; i < count; i++) {
+            out.push_back(static_cast<int64_t>(static_cast<uint64_t>(reference) +
+                                               unpackBits(packed, static_cast<uint64_t>(i) * width, width)));
+        }
+        return skip(static_cast<size_t>((bits + 7) / 8));
+    }
+};
+
+bool decodeIntegers(const std::vector<uint8_t>& segment, ExportEncoding encoding, size_t expected,
+                    std::vector<int64_t>& out) {
+    Decoder decoder(segment.data(), segment.size());
+    uint64_t count;
+    if (!decoder.getVarint(count) || count != expected) {
+        return false;
+    }
+    out.clear();
+    out.reserve(expected);
+    if (encoding != ExportEncoding::DELTA) {
+        return decoder.getPacked(expected, out);
+    }
+    int64_t first;
+    if (!decoder.getSigned(first)) {
+        return false;
+    }
+    out.push_back(first);
+    if (!decoder.getPacked(expected > 0 ? expected - 1 : 0, out)) {
+        return false;
+    }
+    for (size_t i = 1; i < out.size(); i++) {
+        out[i] = static_cast<int64_t>(static_cast<uint64_t>(out[i - 1]) + static_cast<uint64_t>(out[i]));
+    }
+    if (expected == 0) {
+        out.clear();
+    }
+    return true;
+}
+
+bool decodeDictionary(const std::vector<uint8_t>& segment, size_t expected, std::vector<std::string>& names,
+                      std::vector<int64_t>& ids) {
+    Decoder decoder(segment.data(), segment.size());
+    uint64_t nameCount;
+    if (!decoder.getVarint(nameCount) || nameCount > segment.size()) {
+        return false;
+    }
+    names.clear();
+    for (uint64_t i = 0; i < nameCount; i++) {
+        uint64_t length;
+        if (!decoder.getVarint(length) || length > decoder.remaining()) {
+            return false;
+        }
+        names.emplace_back(reinterpret_cast<const char*>(decoder.current()), static_cast<size_t>(length));
+        decoder.skip(static_cast<size_t>(length));
+    }
+    uint64_t count;
+    if (!decoder.getVarint(count) || count != expected) {
+        return false;
+    }
+    ids.clear();
+    ids.reserve(expected);
+    if (!decoder.getPacked(expected, ids)) {
+        return false;
+    }
+    for (int64_t id : ids) {
+        if (id < 0 || static_cast<uint64_t>(id) >= nameCount) {
+            return false;
+        }
+    }
+    return true;
+}
+
+struct BlockFooter {
+    uint32_t cycleCount = 0;
+    uint32_t rowCount = 0;
+    struct Column {
+        ExportEncoding encoding = ExportEncoding::PACKED;
+        uint64_t offset = 0;            // From the first byte after the block length
+        uint32_t length = 0;
+        ExportColumnStats stats;
+    } columns[ColumnarBlockBuilder::COLUMN_COUNT];
+};
+
+bool parseFooter(const uint8_t* data, size_t size, size_t segmentBytes, BlockFooter& footer) {
+    Decoder decoder(data, size);
+    uint64_t cycles, rows;
+    if (!decoder.getVarint(cycles) || !decoder.getVarint(rows) || cycles > UINT32_MAX || rows > UINT32_MAX) {
+        return false;
+    }
+    footer.cycleCount = static_cast<uint32_t>(cycles);
+    footer.rowCount = static_cast<uint32_t>(rows);
+    for (auto& column : footer.columns) {
+        uint8_t encoding;
+        uint64_t offset, length;
+        if (!decoder.getByte(encoding) || encoding < static_cast<uint8_t>(ExportEncoding::DELTA) ||
+            encoding > static_cast<uint8_t>(ExportEncoding::FIXED_POINT) || !decoder.getVarint(offset) ||
+            !decoder.getVarint(length) || offset > segmentBytes || length > segmentBytes - offset ||
+            !decoder.getSigned(column.stats.min) || !decoder.getSigned(column.stats.max)) {
+            return false;
+        }
+        column.encoding = static_cast<ExportEncoding>(encoding);
+        column.offset = offset;
+        column.length = static_cast<uint32_t>(length);
+    }
+    return true;
+}
+
+// Walks the blocks of an open export file from just after the magic; calls
+// visit(blockStart, footer) for each whole block and returns the end of the
+// last one. The file ends there unless a block was cut short.
+template<typename Visit>
+uint64_t walkBlocks(std::ifstream& in, uint64_t fileSize, Visit visit) {
+    uint64_t position = sizeof(FILE_MAGIC);
+    std::vector<uint8_t> footerBytes;
+    while (fileSize - position >= 4 + BLOCK_TRAILER_BYTES) {
+        uint8_t header[4];
+        in.seekg(static_cast<std::streamoff>(position));
+        if (!in.read(reinterpret_cast<char*>(header), sizeof(header))) {
+            break;
+        }
+        uint64_t length = getU32(header);
+        if (length < BLOCK_TRAILER_BYTES || length > fileSize - position - 4) {
+            break;
+        }
+        uint8_t trailer[BLOCK_TRAILER_BYTES];
+        in.seekg(static_cast<std::streamoff>(position + 4 + length - BLOCK_TRAILER_BYTES));
+        if (!in.read(reinterpret_cast<char*>(trailer), sizeof(trailer)) ||
+            std::memcmp(trailer + 4, BLOCK_MAGIC, sizeof(BLOCK_MAGIC)) != 0) {
+            break;
+        }
+        uint64_t footerLength = getU32(trailer);
+        if (footerLength > length - BLOCK_TRAILER_BYTES) {
+            break;
+        }
+        uint64_t segmentBytes = length - BLOCK_TRAILER_BYTES - footerLength;
+        footerBytes.resize(static_cast<size_t>(footerLength));
+        in.seekg(static_cast<std::streamoff>(position + 4 + segmentBytes));
+        BlockFooter footer;
+        if (!in.read(reinterpret_cast<char*>(footerBytes.data()), static_cast<std::streamsize>(footerLength)) ||
+            !parseFooter(footerBytes.data(), footerBytes.size(), static_cast<size_t>(segmentBytes), footer)) {
+            break;
+        }
+        visit(position, footer);
+        position += 4 + length;
+    }
+    in.clear();
+    return position;
+}
+
+bool readMagic(std::ifstream& in) {
+    char magic[sizeof(FILE_MAGIC)];
+    in.seekg(0);
+    return in.read(magic, sizeof(magic)) && std::memcmp(magic, FILE_MAGIC, sizeof(FILE_MAGIC)) == 0;
+}
+
+bool isPerRow(ExportColumn column) {
+    return column >= ExportColumn::PID;
+}
+
+} // namespace
+
+// ColumnarBlockBuilder implementation
+int64_t ColumnarBlockBuilder::toFixedPoint(double percent) {
+    if (!(percent > 0.0)) {
+        return 0;                       // Also NaN
+    }
+    return std::llround(std::min(percent, 1e12) * 100.0);
+}
+
+void ColumnarBlockBuilder::addCycle(int64_t timestampMs, const SystemUsage& systemUsage,
+                                   const std::vector<ProcessInfo>& processes) {
+    cycleTimes.push_back(timestampMs);
+    cycleRows.push_back(static_cast<int64_t>(processes.size()));
+    systemValues[0].push_back(toFixedPoint(systemUsage.getCpuPercent()));
+    systemValues[1].push_back(toFixedPoint(systemUsage.getRamPercent()));
+    systemValues[2].push_back(toFixedPoint(systemUsage.getDiskPercent()));
+    for (const auto& process : processes) {
+        pids.push_back(static_cast<int64_t>(process.getPid()));
+        auto inserted = nameIndex.emplace(process.getName(), static_cast<uint32_t>(names.size()));
+        if (inserted.second) {
+            names.push_back(process.getName());
+        }
+        nameIds.push_back(static_cast<int64_t>(inserted.first->second));
+        processValues[0].push_back(toFixedPoint(process.getCpuPercent()));
+        processValues[1].push_back(toFixedPoint(process.getRamPercent()));
+        processValues[2].push_back(toFixedPoint(process.getDiskPercent()));
+    }
+}
+
+void ColumnarBlockBuilder::encode(std::string& out) const {
+    size_t lengthAt = out.size();
+    putU32(out, 0);
+    size_t segmentsStart = out.size();
+
+    std::string footer;
+    putVarint(footer, cycleTimes.size());
+    putVarint(footer, pids.size());
+    auto addColumn = [&](ExportEncoding encoding, const std::vector<int64_t>& values) {
+        size_t begin = out.size();
+        if (encoding == ExportEncoding::DICTIONARY) {
+            putVarint(out, names.size());
+            for (const auto& name : names) {
+                putVarint(out, name.size());
+                out += name;
+            }
+            putVarint(out, values.size());
+            putPacked(out, values, 0);
+        } else {
+            putIntegers(out, values, encoding);
+        }
+        ExportColumnStats stats = statsOf(values);
+        footer.push_back(static_cast<char>(encoding));
+        putVarint(footer, begin - segmentsStart);
+        putVarint(footer, out.size() - begin);
+        putSigned(footer, stats.min);
+        putSigned(footer, stats.max);
+    };
+    // In ExportColumn order
+    addColumn(ExportEncoding::DELTA, cycleTimes);
+    addColumn(ExportEncoding::PACKED, cycleRows);
+    for (const auto& values : systemValues) {
+        addColumn(ExportEncoding::FIXED_POINT, values);
+    }
+    addColumn(ExportEncoding::PACKED, pids);
+    addColumn(ExportEncoding::DICTIONARY, nameIds);
+    for (const auto& values : processValues) {
+        addColumn(ExportEncoding::FIXED_POINT, values);
+    }
+
+    out += footer;
+    putU32(out, static_cast<uint32_t>(footer.size()));
+    out.append(BLOCK_MAGIC, sizeof(BLOCK_MAGIC));
+    uint32_t length = static_cast<uint32_t>(out.size() - segmentsStart);
+    for (int i = 0; i < 4; i++) {
+        out[lengthAt + static_cast<size_t>(i)] = static_cast<char>((length >> (8 * i)) & 0xFF);
+    }
+}
+
+void ColumnarBlockBuilder::clear() {
+    cycleTimes.clear();
+    cycleRows.clear();
+    pids.clear();
+    nameIds.clear();
+    for (size_t i = 0; i < 3; i++) {
+        systemValues[i].clear();
+        processValues[i].clear();
+    }
+    names.clear();
+    nameIndex.clear();
+}
+
+// ColumnarExportWriter implementation
+ColumnarExportWriter::~ColumnarExportWriter() {
+    stop();
+}
+
+bool ColumnarExportWriter::start(const std::string& path) {
+    if (running || worker.joinable()) {
+        return false;
+    }
+    std::error_code error;
+    uintmax_t size = std::filesystem::exists(path, error) ? std::filesystem::file_size(path, error) : 0;
+    if (size < sizeof(FILE_MAGIC)) {
+        std::ofstream fresh(path, std::ios::binary | std::ios::trunc);
+        if (!fresh.write(FILE_MAGIC, sizeof(FILE_MAGIC))) {
+            return false;
+        }
+        bytesWritten += sizeof(FILE_MAGIC);
+    } else {
+        // Reopening after a restart: cut a block left half-written by a crash
+        std::ifstream existing(path, std::ios::binary);
+        if (!existing || !readMagic(existing)) {
+            return false;
+        }
+        uint64_t end = walkBlocks(existing, size, [](uint64_t, const BlockFooter&) {});
+        existing.close();
+        if (end < size) {
+            // Appending after the torn block would hide every later block from readers
+            std::filesystem::resize_file(path, end, error);
+            if (error) {
+                return false;
+            }
+        }
+    }
+    file.open(path, std::ios::binary | std::ios::app);
+    if (!file.is_open()) {
+        return false;
+    }
+    filePath = path;
+    running = true;
+    worker = std::thread(&ColumnarExportWriter::workerThreadFunction, this);
+    return true;
+}
+
+void ColumnarExportWriter::stop() {
+    if (!running) {
+        return;
+    }
+    running = false;
+    queue.shutdown();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void ColumnarExportWriter::append(int64_t timestampMs, const SystemUsage& systemUsage,
+                                  const std::vector<ProcessInfo>& processes) {
+    if (!running) {
+        return;
+    }
+    if (queue.size() >= QUEUE_LIMIT) {
+        droppedCycles++;
+        return;
+    }
+    Cycle cycle;
+    cycle.timestampMs = timestampMs;
+    cycle.systemUsage = systemUsage;
+    cycle.processes = processes;
+    queue.push(std::move(cycle));
+}
+
+void ColumnarExportWriter::workerThreadFunction() {
+    TraceRecorder::instance().setThreadName("Columnar export");
+    Cycle cycle;
+    while (queue.pop(cycle)) {
+        builder.addCycle(cycle.timestampMs, cycle.systemUsage, cycle.processes);
+        if (builder.getCycleCount() >= blockCycles) {
+            sealBlock();
+        }
+    }
+    sealBlock();
+    file.close();
+}
+
+void ColumnarExportWriter::sealBlock() {
+    if (builder.getCycleCount() == 0) {
+        return;
+    }
+    TraceScope scope("Export block", "export");
+    encoded.clear();
+    builder.encode(encoded);
+    uint64_t rows = builder.getRowCount();
+    builder.clear();
+
+    file.write(encoded.data(), static_cast<std::streamsize>(encoded.size()));
+    file.flush();
+    if (!file.good()) {
+        // The next start() cuts whatever part of the block reached the disk
+        LoggerManager::getInstance().debug("Columnar export: write failed to " + filePath + "; block dropped");
+        file.clear();
+        return;
+    }
+    rowCount += rows;
+    blockCount++;
+    bytesWritten += encoded.size();
+}
+
+// ColumnarExportReader implementation
+bool ColumnarExportReader::open(const std::string& path) {
+    blocks.clear();
+    truncated = false;
+    std::error_code error;
+    uintmax_t size = std::filesystem::file_size(path, error);
+    std::ifstream in(path, std::ios::binary);
+    if (error || !in || !readMagic(in)) {
+        return false;
+    }
+    uint64_t end = walkBlocks(in, size, [this](uint64_t blockStart, const BlockFooter& footer) {
+        BlockRef block;
+        block.cycleCount = footer.cycleCount;
+        block.rowCount = footer.rowCount;
+        for (size_t i = 0; i < ColumnarBlockBuilder::COLUMN_COUNT; i++) {
+            block.columns[i].encoding = footer.columns[i].encoding;
+            block.columns[i].offset = blockStart + 4 + footer.columns[i].offset;
+            block.columns[i].length = footer.columns[i].length;
+            block.columns[i].stats = footer.columns[i].stats;
+        }
+        blocks.push_back(block);
+    });
+    truncated = end < size;
+    filePath = path;
+    return true;
+}
+
+uint64_t ColumnarExportReader::getRowCount() const {
+    uint64_t rows = 0;
+    for (const auto& block : blocks) {
+        rows += block.rowCount;
+    }
+    return rows;
+}
+
+bool ColumnarExportReader::scan(const ExportQuery& query, std::vector<ExportRow>& rows) const {
+    lastBytesRead = 0;
+    lastBlocksSkipped = 0;
+    std::ifstream in(filePath, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+
+    const bool byTime = query.fromMs != INT64_MIN || query.toMs != INT64_MAX;
+    const bool byName = !query.name.empty();
+    const bool byUsage = query.above >= 0.0;
+    const size_t usageIndex = static_cast<size_t>(query.usageColumn);
+    uint32_t needed = query.columns | exportColumnBit(ExportColumn::CYCLE_ROWS);
+    if (byTime) needed |= exportColumnBit(ExportColumn::CYCLE_TIME);
+    if (byName) needed |= exportColumnBit(ExportColumn::NAME);
+    if (byUsage) needed |= exportColumnBit(query.usageColumn);
+
+    std::vector<uint8_t> segment;
+    std::vector<int64_t> values[ColumnarBlockBuilder::COLUMN_COUNT];
+    std::vector<std::string> names;
+    auto has = [&query](ExportColumn column) { return (query.columns & exportColumnBit(column)) != 0; };
+    auto percent = [&values](ExportColumn column, size_t index) {
+        return values[static_cast<size_t>(column)][index] / 100.0;
+    };
+    auto readColumn = [&](const ColumnRef& column) {
+        segment.resize(column.length);
+        in.seekg(static_cast<std::streamoff>(column.offset));
+        lastBytesRead += column.length;
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(segment.data()),
+                                         static_cast<std::streamsize>(column.length)));
+    };
+
+    for (const auto& block : blocks) {
+        const ExportColumnStats& times = block.columns[static_cast<size_t>(ExportColumn::CYCLE_TIME)].stats;
+        if (block.rowCount == 0 || (byTime && (times.max < query.fromMs || times.min > query.toMs)) ||
+            (byUsage && block.columns[usageIndex].stats.max / 100.0 <= query.above)) {
+            lastBlocksSkipped++;
+            continue;
+        }
+
+        // Name first: a block whose dictionary lacks the name needs no other column
+        int64_t wantedId = -1;
+        if (needed & exportColumnBit(ExportColumn::NAME)) {
+            const ColumnRef& column = block.columns[static_cast<size_t>(ExportColumn::NAME)];
+            if (column.encoding != ExportEncoding::DICTIONARY || !readColumn(column) ||
+                !decodeDictionary(segment, block.rowCount, names, values[static_cast<size_t>(ExportColumn::NAME)])) {
+                return false;
+            }
+            if (byName) {
+                auto found = std::find(names.begin(), names.end(), query.name);
+                if (found == names.end()) {
+                    lastBlocksSkipped++;
+                    continue;
+                }
+                wantedId = found - names.begin();
+            }
+        }
+        for (size_t i = 0; i < ColumnarBlockBuilder::COLUMN_COUNT; i++) {
+            ExportColumn kind = static_cast<ExportColumn>(i);
+            if (kind == ExportColumn::NAME || !(needed & exportColumnBit(kind))) {
+                continue;
+            }
+            const ColumnRef& column = block.columns[i];
+            if (column.encoding == ExportEncoding::DICTIONARY || !readColumn(column) ||
+                !decodeIntegers(segment, column.encoding, isPerRow(kind) ? block.rowCount : block.cycleCount,
+                                values[i])) {
+                return false;
+            }
+        }
+
+        const std::vector<int64_t>& cycleRows = values[static_cast<size_t>(ExportColumn::CYCLE_ROWS)];
+        size_t row = 0;
+        for (size_t cycle = 0; cycle < block.cycleCount; cycle++) {
+            size_t rowEnd = row + static_cast<size_t>(cycleRows[cycle]);
+            if (cycleRows[cycle] < 0 || rowEnd > block.rowCount) {
+                return false;
+            }
+            int64_t timestampMs = (needed & exportColumnBit(ExportColumn::CYCLE_TIME))
+                                      ? values[static_cast<size_t>(ExportColumn::CYCLE_TIME)][cycle] : 0;
+            if ((byTime && (timestampMs < query.fromMs || timestampMs > query.toMs)) ||
+                (byUsage && !isPerRow(query.usageColumn) && values[usageIndex][cycle] / 100.0 <= query.above)) {
+                row = rowEnd;
+                continue;
+            }
+            for (; row < rowEnd; row++) {
+                if ((byName && values[static_cast<size_t>(ExportColumn::NAME)][row] != wantedId) ||
+                    (byUsage && isPerRow(query.usageColumn) && values[usageIndex][row] / 100.0 <= query.above)) {
+                    continue;
+                }
+                ExportRow out;
+                if (has(ExportColumn::CYCLE_TIME)) out.timestampMs = timestampMs;
+                if (has(ExportColumn::PID)) out.pid = static_cast<DWORD>(values[static_cast<size_t>(ExportColumn::PID)][row]);
+                if (has(ExportColumn::NAME)) out.name = names[static_cast<size_t>(values[static_cast<size_t>(ExportColumn::NAME)][row])];
+                if (has(ExportColumn::CPU)) out.cpu = percent(ExportColumn::CPU, row);
+                if (has(ExportColumn::RAM)) out.ram = percent(ExportColumn::RAM, row);
+                if (has(ExportColumn::DISK)) out.disk = percent(ExportColumn::DISK, row);
+                if (has(ExportColumn::SYSTEM_CPU)) out.systemCpu = percent(ExportColumn::SYSTEM_CPU, cycle);
+                if (has(ExportColumn::SYSTEM_RAM)) out.systemRam = percent(ExportColumn::SYSTEM_RAM, cycle);
+                if (has(ExportColumn::SYSTEM_DISK)) out.systemDisk = percent(ExportColumn::SYSTEM_DISK, cycle);
+                rows.push_back(std::move(out));
+            }
+        }
+    }
+    return true;
+}
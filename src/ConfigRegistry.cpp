@@ -0,0 +1,565 @@
+#include "../include/ConfigRegistry.h"
+#include "../include/Configuration.h"
+#include <sstream>
+#include <cstdlib>
+#include <cerrno>
+#include <cmath>
+
+namespace {
+
+constexpr double INT_LIMIT = 2147483647.0;
+
+constexpr const char* DISPLAY_MODES[] = { "LINE_BY_LINE", "TOP_STYLE", "COMPACT", "SILENCE" };
+constexpr const char* ROTATION_STRATEGIES[] = { "SIZE_BASED", "DATE_BASED", "COMBINED" };
+constexpr const char* DATE_FREQUENCIES[] = { "DAILY", "HOURLY", "WEEKLY" };
+constexpr const char* STATSD_FORMATS[] = { "STATSD", "DOGSTATSD" };
+
+// Getter helpers
+ConfigValue numberValue(double number) {
+    ConfigValue value;
+    value.number = number;
+    return value;
+}
+
+ConfigValue flagValue(bool flag) {
+    ConfigValue value;
+    value.flag = flag;
+    return value;
+}
+
+ConfigValue textValue(const std::string& text) {
+    ConfigValue value;
+    value.text = text;
+    return value;
+}
+
+// Registry table, in the order keys are written by saveToFile.
+// Values reaching a setter have already been parsed and range checked.
+constexpr ConfigKey CONFIG_KEYS[] = {
+    // System monitoring
+    { "CPU_THRESHOLD", ConfigValueType::NUMBER, 0.0, 100.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.setCpuThreshold(v.number); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(numberValue(c.getCpuThreshold())); },
+      "System CPU alert threshold (%)" },
+    { "RAM_THRESHOLD", ConfigValueType::NUMBER, 0.0, 100.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.setRamThreshold(v.number); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(numberValue(c.getRamThreshold())); },
+      "System RAM alert threshold (%)" },
+    { "DISK_THRESHOLD", ConfigValueType::NUMBER, 0.0, 100.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.setDiskThreshold(v.number); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(numberValue(c.getDiskThreshold())); },
+      "System disk activity alert threshold (%)" },
+    { "MONITOR_INTERVAL", ConfigValueType::INTEGER, 100.0, INT_LIMIT, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.setMonitorInterval(static_cast<int>(v.number)); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(numberValue(c.getMonitorInterval())); },
+      "Sampling period in milliseconds, on fixed deadlines (minimum 100)" },
+    { "PROCESS_SCAN_THREADS", ConfigValueType::INTEGER, 0.0, 64.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.setProcessScanThreads(static_cast<int>(v.number)); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(numberValue(c.getProcessScanThreads())); },
+      "Threads collecting per-process metrics (0 = automatic, 1 = serial)" },
+    { "PROCESS_HOT_CPU_PERCENT", ConfigValueType::NUMBER, 0.0, 100.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.setProcessHotCpuPercent(v.number); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(numberValue(c.getProcessHotCpuPercent())); },
+      "CPU share (%) that promotes a process to full sampling every cycle" },
+    { "PROCESS_COLD_REFRESH_CYCLES", ConfigValueType::INTEGER, 1.0, 65535.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.setProcessColdRefreshCycles(static_cast<int>(v.number)); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(numberValue(c.getProcessColdRefreshCycles())); },
+      "Cycles between full memory/I/O reads of idle processes (1 = every cycle)" },
+    { "PROC_ROOT", ConfigValueType::TEXT, 0.0, 0.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string& error) {
+          if (v.text.empty()) {
+              error = "proc root must not be empty";
+              return false;
+          }
+          c.setProcRoot(v.text);
+          return true;
+      },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(textValue(c.getProcRoot())); },
+      "procfs mount read by the Linux collector (e.g. a host /proc bind-mounted into a container)" },
+    { "BURST_WINDOW_SECONDS", ConfigValueType::INTEGER, 0.0, 300.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.setBurstWindowSeconds(static_cast<int>(v.number)); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(numberValue(c.getBurstWindowSeconds())); },
+      "Seconds of high-resolution capture after a threshold crossing (0 = off)" },
+    { "BURST_INTERVAL_MS", ConfigValueType::INTEGER, 100.0, 1000.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.setBurstIntervalMs(static_cast<int>(v.number)); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(numberValue(c.getBurstIntervalMs())); },
+      "Sampling period in milliseconds during a burst capture" },
+    { "BURST_TOP_PROCESSES", ConfigValueType::INTEGER, 1.0, 50.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.setBurstTopProcesses(static_cast<int>(v.number)); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(numberValue(c.getBurstTopProcesses())); },
+      "Top offending processes followed during a burst capture" },
+    { "SELF_CPU_BUDGET_PERCENT", ConfigValueType::NUMBER, 0.0, 100.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.setSelfCpuBudgetPercent(v.number); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(numberValue(c.getSelfCpuBudgetPercent())); },
+      "SystemMonitor's own CPU share (%) that raises the budget alarm (0 = off)" },
+    { "SELF_RSS_BUDGET_MB", ConfigValueType::INTEGER, 0.0, 1048576.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.setSelfRssBudgetMb(static_cast<int>(v.number)); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(numberValue(c.getSelfRssBudgetMb())); },
+      "SystemMonitor's own resident memory (MB) that raises the budget alarm (0 = off)" },
+    { "METRIC_HISTORY_PROCESSES", ConfigValueType::INTEGER, 0.0, 1000000.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.setMetricHistoryProcesses(static_cast<int>(v.number)); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(numberValue(c.getMetricHistoryProcesses())); },
+      "Processes kept in the in-memory usage history, about 3.5 KB each (0 = system history only)" },
+    { "HISTORY_ARCHIVE_PATH", ConfigValueType::TEXT, 0.0, 0.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.setHistoryArchivePath(v.text); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(textValue(c.getHistoryArchivePath())); },
+      "Directory of the compressed on-disk usage history (empty = off)" },
+    { "HISTORY_ARCHIVE_PROCESSES", ConfigValueType::INTEGER, 0.0, 10000.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.setHistoryArchiveProcesses(static_cast<int>(v.number)); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(numberValue(c.getHistoryArchiveProcesses())); },
+      "Heaviest processes written to the on-disk history each cycle (0 = system only)" },
+    { "HISTORY_ARCHIVE_DAYS", ConfigValueType::INTEGER, 0.0, 36500.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.setHistoryArchiveDays(static_cast<int>(v.number)); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(numberValue(c.getHistoryArchiveDays())); },
+      "Days of on-disk usage history kept (0 = keep everything)" },
+    { "METRICS_PORT", ConfigValueType::INTEGER, 0.0, 65535.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.setMetricsPort(static_cast<int>(v.number)); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(numberValue(c.getMetricsPort())); },
+      "Port of the Prometheus /metrics endpoint on 127.0.0.1 (0 = off)" },
+    { "METRICS_TOP_PROCESSES", ConfigValueType::INTEGER, 0.0, 10000.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.setMetricsTopProcesses(static_cast<int>(v.number)); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(numberValue(c.getMetricsTopProcesses())); },
+      "Heaviest processes exported on /metrics (0 = system gauges only)" },
+    { "SHARED_SNAPSHOT_NAME", ConfigValueType::TEXT, 0.0, 0.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.setSharedSnapshotName(v.text); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(textValue(c.getSharedSnapshotName())); },
+      "Shared-memory segment holding the latest cycle for local readers (empty = off)" },
+    { "SHARED_SNAPSHOT_PROCESSES", ConfigValueType::INTEGER, 0.0, 4096.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.setSharedSnapshotProcesses(static_cast<int>(v.number)); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(numberValue(c.getSharedSnapshotProcesses())); },
+      "Heaviest processes kept in the shared-memory snapshot" },
+    { "QUERY_SOCKET_PATH", ConfigValueType::TEXT, 0.0, 0.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.setQuerySocketPath(v.text); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(textValue(c.getQuerySocketPath())); },
+      "Unix-domain socket answering top-N, history and subscription queries (empty = off)" },
+    { "STATSD_ADDRESS", ConfigValueType::TEXT, 0.0, 0.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.setStatsdAddress(v.text); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(textValue(c.getStatsdAddress())); },
+      "host:port of the StatsD collector metrics are pushed to over UDP (empty = off)" },
+    { "STATSD_FORMAT", ConfigValueType::CHOICE, 0.0, 0.0, STATSD_FORMATS, 2,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.setStatsdFormat(static_cast<StatsdFormat>(static_cast<int>(v.number))); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(numberValue(static_cast<int>(c.getStatsdFormat()))); },
+      "StatsD line flavour; DOGSTATSD tags lines with the process name" },
+    { "STATSD_FLUSH_MS", ConfigValueType::INTEGER, 50.0, 60000.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.setStatsdFlushMs(static_cast<int>(v.number)); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(numberValue(c.getStatsdFlushMs())); },
+      "Milliseconds between StatsD sends" },
+    { "STATSD_PACKET_BYTES", ConfigValueType::INTEGER, 512.0, 65000.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.setStatsdPacketBytes(static_cast<int>(v.number)); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(numberValue(c.getStatsdPacketBytes())); },
+      "Largest StatsD datagram; keep it under the path MTU" },
+    { "STATSD_TOP_PROCESSES", ConfigValueType::INTEGER, 0.0, 10000.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.setStatsdTopProcesses(static_cast<int>(v.number)); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(numberValue(c.getStatsdTopProcesses())); },
+      "Busiest process names pushed to StatsD per cycle (0 = system gauges only)" },
+    { "COLUMNAR_EXPORT_PATH", ConfigValueType::TEXT, 0.0, 0.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.setColumnarExportPath(v.text); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(textValue(c.getColumnarExportPath())); },
+      "File the logged processes of every cycle are appended to, column by column (empty = off)" },
+    { "COLUMNAR_EXPORT_BLOCK_CYCLES", ConfigValueType::INTEGER, 10.0, 86400.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.setColumnarExportBlockCycles(static_cast<int>(v.number)); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(numberValue(c.getColumnarExportBlockCycles())); },
+      "Cycles per columnar export block; each block carries min/max statistics for skipping" },
+
+    // Logging
+    { "LOG_PATH", ConfigValueType::TEXT, 0.0, 0.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string& error) {
+          if (v.text.empty()) {
+              error = "log path must not be empty";
+              return false;
+          }
+          c.setLogFilePath(v.text);
+          return true;
+      },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(textValue(c.getLogFilePath())); },
+      "Log file path" },
+    { "DEBUG_MODE", ConfigValueType::BOOLEAN, 0.0, 0.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.setDebugMode(v.flag); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(flagValue(c.isDebugMode())); },
+      "Log every cycle, not only when thresholds are exceeded" },
+    { "LOG_MAX_SIZE_MB", ConfigValueType::INTEGER, 1.0, INT_LIMIT, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.getLogConfig().setMaxFileSizeMB(static_cast<size_t>(v.number)); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(numberValue(static_cast<double>(c.getLogConfig().getMaxFileSizeMB()))); },
+      "Rotate the log when it reaches this size" },
+    { "LOG_MAX_BACKUPS", ConfigValueType::INTEGER, 0.0, INT_LIMIT, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.getLogConfig().setMaxBackupFiles(static_cast<int>(v.number)); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(numberValue(c.getLogConfig().getMaxBackupFiles())); },
+      "Number of rotated log files to keep" },
+    { "LOG_ROTATION_ENABLED", ConfigValueType::BOOLEAN, 0.0, 0.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.getLogConfig().setRotationEnabled(v.flag); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(flagValue(c.getLogConfig().isRotationEnabled())); },
+      "Enable log rotation" },
+    { "LOG_ROTATION_STRATEGY", ConfigValueType::CHOICE, 0.0, 0.0, ROTATION_STRATEGIES, 3,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.getLogConfig().setRotationStrategy(static_cast<LogRotationStrategy>(static_cast<int>(v.number))); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(numberValue(static_cast<int>(c.getLogConfig().getRotationStrategy()))); },
+      "When to rotate the log" },
+    { "LOG_DATE_FREQUENCY", ConfigValueType::CHOICE, 0.0, 0.0, DATE_FREQUENCIES, 3,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.getLogConfig().setDateFrequency(static_cast<DateRotationFrequency>(static_cast<int>(v.number))); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(numberValue(static_cast<int>(c.getLogConfig().getDateFrequency()))); },
+      "Date-based rotation period" },
+    { "LOG_DATE_FORMAT", ConfigValueType::TEXT, 0.0, 0.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.getLogConfig().setDateFormat(v.text); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(textValue(c.getLogConfig().getDateFormat())); },
+      "strftime format of the date in rotated file names" },
+    { "LOG_KEEP_DATE_IN_FILENAME", ConfigValueType::BOOLEAN, 0.0, 0.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.getLogConfig().setKeepDateInFilename(v.flag); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(flagValue(c.getLogConfig().shouldKeepDateInFilename())); },
+      "Include the date in the active log file name" },
+
+    // Display
+    { "DISPLAY_MODE", ConfigValueType::CHOICE, 0.0, 0.0, DISPLAY_MODES, 4,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.setDisplayMode(static_cast<DisplayModeConfig>(static_cast<int>(v.number))); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(numberValue(static_cast<int>(c.getDisplayMode()))); },
+      "Console display mode" },
+    { "DISPLAY_REFRESH_MS", ConfigValueType::INTEGER, 100.0, INT_LIMIT, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.setDisplayRefreshMs(static_cast<int>(v.number)); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(numberValue(c.getDisplayRefreshMs())); },
+      "Minimum time between two redraws of the top-style and compact displays" },
+
+    // Email
+    { "EMAIL_ENABLED", ConfigValueType::BOOLEAN, 0.0, 0.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.getEmailConfig().enableEmailAlerts = v.flag; return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(flagValue(c.getEmailConfig().enableEmailAlerts)); },
+      "Send email alerts" },
+    { "EMAIL_SMTP_SERVER", ConfigValueType::TEXT, 0.0, 0.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.getEmailConfig().smtpServer = v.text; return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(textValue(c.getEmailConfig().smtpServer)); },
+      "SMTP server host name" },
+    { "EMAIL_SMTP_PORT", ConfigValueType::INTEGER, 1.0, 65535.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.getEmailConfig().smtpPort = static_cast<int>(v.number); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(numberValue(c.getEmailConfig().smtpPort)); },
+      "SMTP server port" },
+    { "EMAIL_SENDER", ConfigValueType::TEXT, 0.0, 0.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.getEmailConfig().senderEmail = v.text; return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(textValue(c.getEmailConfig().senderEmail)); },
+      "Sender address, also used as SMTP user name" },
+    { "EMAIL_PASSWORD", ConfigValueType::TEXT, 0.0, 0.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.getEmailConfig().senderPassword = v.text; return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(textValue(c.getEmailConfig().senderPassword)); },
+      "SMTP password (app password for Gmail)" },
+    { "EMAIL_SENDER_NAME", ConfigValueType::TEXT, 0.0, 0.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.getEmailConfig().senderName = v.text; return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(textValue(c.getEmailConfig().senderName)); },
+      "Sender display name" },
+    { "EMAIL_RECIPIENTS", ConfigValueType::LIST, 0.0, 0.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.getEmailConfig().recipients = v.items; return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) {
+          ConfigValue value;
+          value.items = c.getEmailConfig().recipients;
+          out.push_back(value);
+      },
+      "Comma-separated recipient addresses" },
+    { "EMAIL_USE_TLS", ConfigValueType::BOOLEAN, 0.0, 0.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.getEmailConfig().useTLS = v.flag; return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(flagValue(c.getEmailConfig().useTLS)); },
+      "Use STARTTLS" },
+    { "EMAIL_USE_SSL", ConfigValueType::BOOLEAN, 0.0, 0.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.getEmailConfig().useSSL = v.flag; return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(flagValue(c.getEmailConfig().useSSL)); },
+      "Use implicit SSL" },
+    { "EMAIL_TIMEOUT_SECONDS", ConfigValueType::INTEGER, 1.0, INT_LIMIT, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.getEmailConfig().timeoutSeconds = static_cast<int>(v.number); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(numberValue(c.getEmailConfig().timeoutSeconds)); },
+      "SMTP connection timeout" },
+    { "EMAIL_ALERT_DURATION_SECONDS", ConfigValueType::INTEGER, 1.0, INT_LIMIT, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.getEmailConfig().alertDurationSeconds = static_cast<int>(v.number); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(numberValue(c.getEmailConfig().alertDurationSeconds)); },
+      "Time above a threshold before an alert is sent" },
+    { "EMAIL_COOLDOWN_MINUTES", ConfigValueType::INTEGER, 1.0, INT_LIMIT, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.getEmailConfig().cooldownMinutes = static_cast<int>(v.number); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(numberValue(c.getEmailConfig().cooldownMinutes)); },
+      "Minimum time between two alerts of the same rule" },
+    { "EMAIL_SEND_RECOVERY_ALERTS", ConfigValueType::BOOLEAN, 0.0, 0.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.getEmailConfig().sendRecoveryAlerts = v.flag; return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(flagValue(c.getEmailConfig().sendRecoveryAlerts)); },
+      "Send an email when an alert recovers" },
+    { "EMAIL_RECOVERY_DURATION_SECONDS", ConfigValueType::INTEGER, 1.0, INT_LIMIT, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.getEmailConfig().recoveryDurationSeconds = static_cast<int>(v.number); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(numberValue(c.getEmailConfig().recoveryDurationSeconds)); },
+      "Time back to normal before recovery is reported" },
+    { "EMAIL_SUBJECT_ALERT", ConfigValueType::TEXT, 0.0, 0.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.getEmailConfig().subjectAlert = v.text; return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(textValue(c.getEmailConfig().subjectAlert)); },
+      "Subject of alert emails" },
+    { "EMAIL_SUBJECT_RECOVER", ConfigValueType::TEXT, 0.0, 0.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.getEmailConfig().subjectRecover = v.text; return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(textValue(c.getEmailConfig().subjectRecover)); },
+      "Subject of recovery emails" },
+
+    // Alert rules
+    { "ALERT_HYSTERESIS", ConfigValueType::NUMBER, 0.0, 100.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.setAlertHysteresis(v.number); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(numberValue(c.getAlertHysteresis())); },
+      "System rules clear at threshold minus this value" },
+    { "ALERT_SMOOTHING_SECONDS", ConfigValueType::INTEGER, 0.0, INT_LIMIT, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string&) { c.setAlertSmoothingSeconds(static_cast<int>(v.number)); return true; },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) { out.push_back(numberValue(c.getAlertSmoothingSeconds())); },
+      "EWMA time constant applied to system usage (0 = off)" },
+    { "ALERT_RULE", ConfigValueType::RULE, 0.0, 0.0, nullptr, 0,
+      [](MonitorConfig& c, const ConfigValue& v, std::string& error) {
+          AlertRule rule;
+          if (!AlertRule::parse(v.text, rule, error)) {
+              return false;
+          }
+          c.addAlertRule(rule);
+          return true;
+      },
+      [](const MonitorConfig& c, std::vector<ConfigValue>& out) {
+          for (const auto& rule : c.getAlertRules()) {
+              out.push_back(textValue(rule.toConfigString()));
+          }
+      },
+      "Additional alert rule (repeatable), see the template for the syntax" },
+};
+
+constexpr size_t KEY_COUNT = sizeof(CONFIG_KEYS) / sizeof(CONFIG_KEYS[0]);
+
+// Perfect hash: case-insensitive FNV-1a with a seed searched at compile time
+// so that every key lands in its own slot.
+constexpr size_t HASH_SLOTS = 256;
+static_assert(KEY_COUNT < 255 && KEY_COUNT <= HASH_SLOTS, "Configuration key table too large for the hash");
+
+constexpr char upperAscii(char c) {
+    return (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+}
+
+constexpr uint32_t hashKey(const char* text, size_t length, uint32_t seed) {
+    uint32_t hash = 2166136261u ^ seed;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= static_cast<uint8_t>(upperAscii(text[i]));
+        hash *= 16777619u;
+    }
+    return hash ^ (hash >> 15);
+}
+
+constexpr size_t textLength(const char* text) {
+    size_t length = 0;
+    while (text[length] != '\0') length++;
+    return length;
+}
+
+constexpr bool seedIsPerfect(uint32_t seed) {
+    bool used[HASH_SLOTS] = {};
+    for (size_t i = 0; i < KEY_COUNT; i++) {
+        size_t slot = hashKey(CONFIG_KEYS[i].name, textLength(CONFIG_KEYS[i].name), seed) % HASH_SLOTS;
+        if (used[slot]) return false;
+        used[slot] = true;
+    }
+    return true;
+}
+
+constexpr uint32_t findPerfectSeed() {
+    for (uint32_t seed = 1; seed < 100000; seed++) {
+        if (seedIsPerfect(seed)) return seed;
+    }
+    return 0;
+}
+
+constexpr uint32_t HASH_SEED = findPerfectSeed();
+static_assert(HASH_SEED != 0, "No perfect hash seed found for the configuration keys");
+
+// Slot -> key index + 1 (0 = empty)
+struct SlotTable {
+    uint8_t slots[HASH_SLOTS];
+};
+
+constexpr SlotTable buildSlotTable() {
+    SlotTable table = {};
+    for (size_t i = 0; i < KEY_COUNT; i++) {
+        size_t slot = hashKey(CONFIG_KEYS[i].name, textLength(CONFIG_KEYS[i].name), HASH_SEED) % HASH_SLOTS;
+        table.slots[slot] = static_cast<uint8_t>(i + 1);
+    }
+    return table;
+}
+
+constexpr SlotTable SLOT_TABLE = buildSlotTable();
+
+bool equalsIgnoreCase(const std::string& text, const char* name) {
+    size_t length = textLength(name);
+    if (text.size() != length) return false;
+    for (size_t i = 0; i < length; i++) {
+        if (upperAscii(text[i]) != name[i]) return false;
+    }
+    return true;
+}
+
+std::string trim(const std::string& text) {
+    size_t first = text.find_first_not_of(" \t");
+    if (first == std::string::npos) return "";
+    size_t last = text.find_last_not_of(" \t");
+    return text.substr(first, last - first + 1);
+}
+
+std::string formatNumber(double number) {
+    std::ostringstream stream;
+    stream << number;
+    return stream.str();
+}
+
+} // namespace
+
+const ConfigKey* ConfigRegistry::find(const std::string& name) {
+    size_t slot = hashKey(name.data(), name.size(), HASH_SEED) % HASH_SLOTS;
+    uint8_t entry = SLOT_TABLE.slots[slot];
+    if (entry == 0) {
+        return nullptr;
+    }
+    const ConfigKey* key = &CONFIG_KEYS[entry - 1];
+    return equalsIgnoreCase(name, key->name) ? key : nullptr;
+}
+
+const ConfigKey* ConfigRegistry::begin() {
+    return CONFIG_KEYS;
+}
+
+const ConfigKey* ConfigRegistry::end() {
+    return CONFIG_KEYS + KEY_COUNT;
+}
+
+size_t ConfigRegistry::size() {
+    return KEY_COUNT;
+}
+
+bool ConfigRegistry::parseValue(const ConfigKey& key, const std::string& text, ConfigValue& value, std::string& error) {
+    value = ConfigValue();
+
+    switch (key.type) {
+        case ConfigValueType::INTEGER:
+        case ConfigValueType::NUMBER: {
+            const char* begin = text.c_str();
+            char* end = nullptr;
+            errno = 0;
+            double number = std::strtod(begin, &end);
+            if (text.empty() || end == begin || *end != '\0' || errno == ERANGE) {
+                error = "expected a number, got '" + text + "'";
+                return false;
+            }
+            if (key.type == ConfigValueType::INTEGER && number != std::floor(number)) {
+                error = "expected a whole number, got '" + text + "'";
+                return false;
+            }
+            value.number = number;
+            return checkValue(key, value, error);
+        }
+
+        case ConfigValueType::BOOLEAN:
+            if (equalsIgnoreCase(text, "TRUE") || text == "1" || equalsIgnoreCase(text, "YES") || equalsIgnoreCase(text, "ON")) {
+                value.flag = true;
+                return true;
+            }
+            if (equalsIgnoreCase(text, "FALSE") || text == "0" || equalsIgnoreCase(text, "NO") || equalsIgnoreCase(text, "OFF")) {
+                value.flag = false;
+                return true;
+            }
+            error = "expected true or false, got '" + text + "'";
+            return false;
+
+        case ConfigValueType::CHOICE:
+            for (size_t i = 0; i < key.choiceCount; i++) {
+                if (equalsIgnoreCase(text, key.choices[i]) || text == std::to_string(i)) {
+                    value.number = static_cast<double>(i);
+                    return true;
+                }
+            }
+            error = "expected " + describeType(key) + ", got '" + text + "'";
+            return false;
+
+        case ConfigValueType::LIST: {
+            size_t start = 0;
+            while (start <= text.size()) {
+                size_t comma = text.find(',', start);
+                if (comma == std::string::npos) comma = text.size();
+                std::string item = trim(text.substr(start, comma - start));
+                if (!item.empty()) {
+                    value.items.push_back(item);
+                }
+                start = comma + 1;
+            }
+            return true;
+        }
+
+        case ConfigValueType::TEXT:
+        case ConfigValueType::RULE:
+            value.text = text;
+            return true;
+    }
+    return false;
+}
+
+std::string ConfigRegistry::formatValue(const ConfigKey& key, const ConfigValue& value) {
+    switch (key.type) {
+        case ConfigValueType::INTEGER:
+            return std::to_string(static_cast<long long>(value.number));
+        case ConfigValueType::NUMBER:
+            return formatNumber(value.number);
+        case ConfigValueType::BOOLEAN:
+            return value.flag ? "true" : "false";
+        case ConfigValueType::CHOICE: {
+            size_t index = static_cast<size_t>(value.number);
+            return index < key.choiceCount ? key.choices[index] : formatNumber(value.number);
+        }
+        case ConfigValueType::LIST: {
+            std::string joined;
+            for (size_t i = 0; i < value.items.size(); ++i) {
+                if (i > 0) joined += ",";
+                joined += value.items[i];
+            }
+            return joined;
+        }
+        case ConfigValueType::TEXT:
+        case ConfigValueType::RULE:
+            return value.text;
+    }
+    return "";
+}
+
+bool ConfigRegistry::checkValue(const ConfigKey& key, const ConfigValue& value, std::string& error) {
+    switch (key.type) {
+        case ConfigValueType::INTEGER:
+        case ConfigValueType::NUMBER:
+            if (value.number < key.minValue || value.number > key.maxValue) {
+                error = formatNumber(value.number) + " is out of range (" + describeType(key) + ")";
+                return false;
+            }
+            return true;
+        case ConfigValueType::CHOICE:
+            if (value.number < 0 || value.number >= static_cast<double>(key.choiceCount)) {
+                error = "invalid choice " + formatNumber(value.number);
+                return false;
+            }
+            return true;
+        default:
+            return true;
+    }
+}
+
+std::string ConfigRegistry::describeType(const ConfigKey& key) {
+    switch (key.type) {
+        case ConfigValueType::INTEGER:
+        case ConfigValueType::NUMBER: {
+            std::string description = key.type == ConfigValueType::INTEGER ? "integer " : "number ";
+            description += formatNumber(key.minValue) + "..";
+            if (key.maxValue < INT_LIMIT) {
+                description += formatNumber(key.maxValue);
+            }
+            return description;
+        }
+        case ConfigValueType::BOOLEAN:
+            return "true|false";
+        case ConfigValueType::CHOICE: {
+            std::string description;
+            for (size_t i = 0; i < key.choiceCount; i++) {
+                if (i > 0) description += "|";
+                description += key.choices[i];
+            }
+            return description;
+        }
+        case ConfigValueType::LIST:
+            return "list";
+        case ConfigValueType::TEXT:
+            return "text";
+        case ConfigValueType::RULE:
+            return "rule";
+    }
+    return "";
+}
@@ -0,0 +1,212 @@
+#include "../include/ConfigWatcher.h"
+#include "../include/Logger.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <chrono>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// How long a blocking wait may last before the stop flag is checked again
+const int WATCH_TIMEOUT_MS = 500;
+// Interval of the modification time fallback
+const int POLL_INTERVAL_MS = 1000;
+// Editors often write a file in several steps; let them finish before reading
+const int SETTLE_DELAY_MS = 100;
+
+bool readFileText(const std::string& path, std::string& text) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    text = contents.str();
+    return true;
+}
+
+std::string watchDirectory(const std::string& path) {
+    std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    return parent.empty() ? std::string(".") : parent.string();
+}
+
+} // namespace
+
+ConfigWatcher::ConfigWatcher(const std::string& configFile, const MonitorConfig& initialConfig,
+                             int argc, char* argv[])
+    : filePath(configFile), running(false) {
+    for (int i = 0; i < argc && argv; i++) {
+        commandLineArgs.push_back(argv[i]);
+    }
+    std::atomic_store(&published, std::make_shared<const Published>(Published{ initialConfig, 0 }));
+    readFileText(filePath, lastLoadedText);
+}
+
+ConfigWatcher::~ConfigWatcher() {
+    stop();
+}
+
+bool ConfigWatcher::start() {
+    if (running.load()) {
+        return true;
+    }
+    running.store(true);
+    watcherThread = std::thread(&ConfigWatcher::watcherLoop, this);
+    return true;
+}
+
+void ConfigWatcher::stop() {
+    if (!running.exchange(false)) {
+        return;
+    }
+    if (watcherThread.joinable()) {
+        watcherThread.join();
+    }
+}
+
+std::shared_ptr<const MonitorConfig> ConfigWatcher::getSnapshot() const {
+    uint64_t snapshotGeneration;
+    return getSnapshot(snapshotGeneration);
+}
+
+std::shared_ptr<const MonitorConfig> ConfigWatcher::getSnapshot(uint64_t& snapshotGeneration) const {
+    std::shared_ptr<const Published> current = std::atomic_load_explicit(&published, std::memory_order_acquire);
+    snapshotGeneration = current->generation;
+    // Aliasing constructor: the returned pointer keeps the whole publication alive
+    return std::shared_ptr<const MonitorConfig>(current, &current->config);
+}
+
+uint64_t ConfigWatcher::getGeneration() const {
+    return std::atomic_load_explicit(&published, std::memory_order_acquire)->generation;
+}
+
+void ConfigWatcher::watcherLoop() {
+    std::string directory = watchDirectory(filePath);
+
+#ifdef _WIN32
+    HANDLE changeHandle = FindFirstChangeNotificationA(directory.c_str(), FALSE,
+        FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE);
+    if (changeHandle == INVALID_HANDLE_VALUE) {
+        pollLoop();
+        return;
+    }
+
+    while (running.load()) {
+        DWORD result = WaitForSingleObject(changeHandle, WATCH_TIMEOUT_MS);
+        if (result == WAIT_OBJECT_0) {
+            Sleep(SETTLE_DELAY_MS);
+            reload();
+            if (!FindNextChangeNotification(changeHandle)) {
+                break;
+            }
+        } else if (result != WAIT_TIMEOUT) {
+            break;
+        }
+    }
+    FindCloseChangeNotification(changeHandle);
+    if (running.load()) {
+        pollLoop();
+    }
+#elif defined(__linux__)
+    int inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd < 0 ||
+        inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0) {
+        if (inotifyFd >= 0) close(inotifyFd);
+        pollLoop();
+        return;
+    }
+
+    alignas(struct inotify_event) char buffer[4096];
+    while (running.load()) {
+        struct pollfd descriptor = { inotifyFd, POLLIN, 0 };
+        int ready = poll(&descriptor, 1, WATCH_TIMEOUT_MS);
+        if (ready < 0) {
+            break;
+        }
+        if (ready == 0) {
+            continue;
+        }
+
+        // Drain every pending event; the directory may report several per save
+        while (read(inotifyFd, buffer, sizeof(buffer)) > 0) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(SETTLE_DELAY_MS));
+        reload();
+    }
+    close(inotifyFd);
+    if (running.load()) {
+        pollLoop();
+    }
+#else
+    (void)directory;
+    pollLoop();
+#endif
+}
+
+void ConfigWatcher::pollLoop() {
+    std::error_code error;
+    auto lastWriteTime = std::filesystem::last_write_time(filePath, error);
+
+    while (running.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(POLL_INTERVAL_MS));
+
+        auto writeTime = std::filesystem::last_write_time(filePath, error);
+        if (!error && writeTime != lastWriteTime) {
+            lastWriteTime = writeTime;
+            reload();
+        }
+    }
+}
+
+void ConfigWatcher::reload() {
+    // Directory notifications also fire for unrelated files; skip unchanged content
+    std::string text;
+    if (!readFileText(filePath, text) || text == lastLoadedText) {
+        return;
+    }
+    lastLoadedText = text;
+
+    ConfigurationManager manager;
+    if (!manager.loadFromFile(filePath)) {
+        return;
+    }
+    if (!manager.getParseErrors().empty()) {
+        LoggerManager::getInstance().debug("Configuration reload rejected: " + manager.getParseErrors().front());
+        return;
+    }
+
+    // Command line arguments keep precedence over the file; their warnings were
+    // printed at startup, so reapply them quietly
+    if (!commandLineArgs.empty()) {
+        manager.setQuiet(true);
+        std::vector<std::string> args = commandLineArgs;
+        std::vector<char*> argv;
+        for (auto& arg : args) {
+            argv.push_back(&arg[0]);
+        }
+        argv.push_back(nullptr);
+        manager.parseCommandLine(static_cast<int>(args.size()), argv.data());
+    }
+
+    if (!manager.validateConfiguration()) {
+        LoggerManager::getInstance().debug("Configuration reload rejected: invalid settings in " + filePath);
+        return;
+    }
+
+    // Only this thread publishes, so the generation can be derived from the current one
+    uint64_t nextGeneration = getGeneration() + 1;
+    std::atomic_store_explicit(&published,
+                               std::make_shared<const Published>(Published{ manager.getConfig(), nextGeneration }),
+                               std::memory_order_release);
+    LoggerManager::getInstance().debug("Configuration reloaded from " + filePath +
+                                       " (generation " + std::to_string(nextGeneration) + ")");
+}
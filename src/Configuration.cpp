@@ -1,8 +1,11 @@
 #include "../include/Configuration.h"
+#include "../include/ConfigRegistry.h"
 #include <iostream>
+#include <iomanip>
 #include <fstream>
 #include <string.h>
 #include <algorithm>
+#include <cctype>
 #include <vector>
 #include <algorithm> // For std::find
 
@@ -11,7 +14,29 @@ bool BaseConfig::validate() const {
     return cpuThreshold >= 0 && cpuThreshold <= 100 &&
            ramThreshold >= 0 && ramThreshold <= 100 &&
            diskThreshold >= 0 && diskThreshold <= 100 &&
-           monitorInterval >= 1000;
+           alertHysteresis >= 0 && alertHysteresis <= 100 &&
+           alertSmoothingSeconds >= 0 &&
+           displayRefreshMs >= 100 &&
+           processScanThreads >= 0 &&
+           processHotCpuPercent >= 0 && processHotCpuPercent <= 100 &&
+           processColdRefreshCycles >= 1 &&
+           burstWindowSeconds >= 0 && burstWindowSeconds <= 300 &&
+           burstIntervalMs >= 100 && burstIntervalMs <= 1000 &&
+           burstTopProcesses >= 1 && burstTopProcesses <= 50 &&
+           selfCpuBudgetPercent >= 0 && selfCpuBudgetPercent <= 100 &&
+           selfRssBudgetMb >= 0 &&
+           metricHistoryProcesses >= 0 &&
+           historyArchiveProcesses >= 0 &&
+           historyArchiveDays >= 0 &&
+           metricsPort >= 0 && metricsPort <= 65535 &&
+           metricsTopProcesses >= 0 &&
+           sharedSnapshotProcesses >= 0 &&
+           statsdFlushMs > 0 &&
+           statsdPacketBytes >= static_cast<int>(StatsdSink::MIN_PACKET_BYTES) &&
+           statsdPacketBytes <= static_cast<int>(StatsdSink::MAX_PACKET_BYTES) &&
+           statsdTopProcesses >= 0 &&
+           columnarExportBlockCycles > 0 &&
+           monitorInterval >= 100;
 }
 
 void BaseConfig::setDefaults() {
@@ -19,7 +44,29 @@ void BaseConfig::setDefaults() {
     ramThreshold = 80.0;
     diskThreshold = 80.0;
     monitorInterval = 5000;
+    processScanThreads = 0;
+    processHotCpuPercent = 0.5;
+    processColdRefreshCycles = 10;
+    burstWindowSeconds = 10;
+    burstIntervalMs = 200;
+    burstTopProcesses = 5;
+    selfCpuBudgetPercent = 1.0;
+    selfRssBudgetMb = 50;
+    metricHistoryProcesses = 5000;
+    historyArchiveProcesses = 100;
+    historyArchiveDays = 31;
+    metricsPort = 0;
+    metricsTopProcesses = 20;
+    sharedSnapshotProcesses = 32;
+    statsdFormat = StatsdFormat::STATSD;
+    statsdFlushMs = 1000;
+    statsdPacketBytes = 1432;
+    statsdTopProcesses = 20;
+    columnarExportBlockCycles = 600;
+    alertHysteresis = 5.0;
+    alertSmoothingSeconds = 0;
     debugMode = false;
+    displayRefreshMs = 1000;
     displayMode = DisplayModeConfig::TOP_STYLE;
 }
 
@@ -40,13 +87,51 @@ MonitorConfig::MonitorConfig(const LogConfig& logCfg, const EmailConfig& emailCf
 }
 
 bool MonitorConfig::validate() const {
-    return BaseConfig::validate() && !logFilePath.empty();
+    return BaseConfig::validate() && !logFilePath.empty() && !procRoot.empty() && replaySpeed >= 0.0;
 }
 
 void MonitorConfig::setDefaults() {
     BaseConfig::setDefaults();
     logFilePath = "SystemMonitor.log";
     logConfig = LogConfig();
+    alertRules.clear();
+    traceFilePath.clear();
+    procRoot = "/proc";
+    recordFilePath.clear();
+    replayFilePath.clear();
+    replaySpeed = 1.0;
+    historyArchivePath.clear();
+    sharedSnapshotName.clear();
+    querySocketPath.clear();
+    statsdAddress.clear();
+    percentileQueryHours = 0;
+}
+
+std::vector<AlertRule> MonitorConfig::getEffectiveAlertRules() const {
+    std::vector<AlertRule> rules = AlertEngine::createSystemRules(
+        cpuThreshold, ramThreshold, diskThreshold,
+        emailConfig.alertDurationSeconds,
+        emailConfig.recoveryDurationSeconds,
+        emailConfig.cooldownMinutes * 60);
+    for (auto& rule : rules) {
+        rule.clearLevel = std::max(0.0, rule.triggerLevel - alertHysteresis);
+        rule.smoothingSeconds = alertSmoothingSeconds;
+    }
+
+    // Custom rules inherit the email timing unless they specify their own, 0 included
+    for (AlertRule rule : alertRules) {
+        if (rule.durationSeconds == AlertRule::INHERIT_TIMING) {
+            rule.durationSeconds = emailConfig.alertDurationSeconds;
+        }
+        if (rule.recoveryDurationSeconds == AlertRule::INHERIT_TIMING) {
+            rule.recoveryDurationSeconds = emailConfig.recoveryDurationSeconds;
+        }
+        if (rule.cooldownSeconds == AlertRule::INHERIT_TIMING) {
+            rule.cooldownSeconds = emailConfig.cooldownMinutes * 60;
+        }
+        rules.push_back(rule);
+    }
+    return rules;
 }
 
 // ConfigurationManager implementation
@@ -56,16 +141,22 @@ ConfigurationManager::ConfigurationManager() {
 
 ConfigurationManager::ConfigurationManager(const MonitorConfig& initialConfig) : config(initialConfig) {}
 
+std::ostream& ConfigurationManager::diagnostics() const {
+    // A stream without a buffer swallows everything written to it
+    static thread_local std::ostream discard(nullptr);
+    return quiet ? discard : std::cerr;
+}
+
 double ConfigurationManager::validateThreshold(const std::string& value, const std::string& paramName) const {
     try {
         double val = std::stod(value);
         if (val < 0.0 || val > 100.0) {
-            std::cerr << "Error: " << paramName << " threshold must be between 0 and 100. Using default value." << std::endl;
+            diagnostics() << "Error: " << paramName << " threshold must be between 0 and 100. Using default value." << std::endl;
             return 80.0;
         }
         return val;
     } catch (const std::exception& e) {
-        std::cerr << "Error parsing " << paramName << " value '" << value << "': " << e.what() << std::endl;
+        diagnostics() << "Error parsing " << paramName << " value '" << value << "': " << e.what() << std::endl;
         return 80.0;
     }
 }
@@ -76,7 +167,9 @@ bool ConfigurationManager::isValidParameter(const std::string& param) const {
         "--help", "-h", "--interval", "--debug",
         "--log-size", "--log-backups", "--log-rotation",
         "--log-strategy", "--log-frequency", "--log-date-format",
-        "--display", "--mode"
+        "--display", "--mode", "--alert-rule", "--trace",
+        "--record", "--replay", "--speed", "--percentiles",
+        "--output", "--output-file"
     };
     
     return std::find(validParams.begin(), validParams.end(), param) != validParams.end();
@@ -87,11 +180,27 @@ bool ConfigurationManager::loadFromFile(const std::string& filename) {
     if (!configFile.is_open()) {
         return false;
     }
+    return loadFromStream(configFile, filename);
+}
+
+bool ConfigurationManager::loadFromStream(std::istream& configFile, const std::string& filename) {
+    parseErrors.clear();
+    config.clearAlertRules();
 
     std::string line;
+    int lineNumber = 0;
     while (std::getline(configFile, line)) {
+        lineNumber++;
+
+        // Skip blank lines and comments
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#' || line[first] == ';') continue;
+
         size_t pos = line.find("=");
-        if (pos == std::string::npos) continue;
+        if (pos == std::string::npos) {
+            reportParseError(filename, lineNumber, "expected KEY=VALUE");
+            continue;
+        }
 
         std::string key = line.substr(0, pos);
         std::string value = line.substr(pos + 1);
@@ -100,170 +209,32 @@ bool ConfigurationManager::loadFromFile(const std::string& filename) {
         key.erase(0, key.find_first_not_of(" \t"));
         key.erase(key.find_last_not_of(" \t") + 1);
         value.erase(0, value.find_first_not_of(" \t"));
-        value.erase(value.find_last_not_of(" \t") + 1);
-
-        // Parse configuration values
-        if (key == "CPU_THRESHOLD") {
-            config.setCpuThreshold(validateThreshold(value, "CPU"));
-        } else if (key == "RAM_THRESHOLD") {
-            config.setRamThreshold(validateThreshold(value, "RAM"));
-        } else if (key == "DISK_THRESHOLD") {
-            config.setDiskThreshold(validateThreshold(value, "Disk"));
-        } else if (key == "MONITOR_INTERVAL") {
-            try {
-                int interval = std::stoi(value);
-                if (interval >= 1000) {
-                    config.setMonitorInterval(interval);
-                }
-            } catch (...) {
-                // Ignore parsing errors
-            }
-        } else if (key == "LOG_PATH") {
-            config.setLogFilePath(value);
-        } else if (key == "DEBUG_MODE") {
-            config.setDebugMode(value == "true" || value == "1");
-        } else if (key == "LOG_MAX_SIZE_MB") {
-            try {
-                int size = std::stoi(value);
-                if (size > 0) {
-                    config.getLogConfig().setMaxFileSizeMB(size);
-                }
-            } catch (...) {
-                // Ignore parsing errors
-            }
-        } else if (key == "LOG_MAX_BACKUPS") {
-            try {
-                int backups = std::stoi(value);
-                if (backups >= 0) {
-                    config.getLogConfig().setMaxBackupFiles(backups);
-                }
-            } catch (...) {
-                // Ignore parsing errors
-            }
-        } else if (key == "LOG_ROTATION_ENABLED") {
-            config.getLogConfig().setRotationEnabled(value == "true" || value == "1");
-        } else if (key == "LOG_ROTATION_STRATEGY") {
-            if (value == "SIZE_BASED") {
-                config.getLogConfig().setRotationStrategy(LogRotationStrategy::SIZE_BASED);
-            } else if (value == "DATE_BASED") {
-                config.getLogConfig().setRotationStrategy(LogRotationStrategy::DATE_BASED);
-            } else if (value == "COMBINED") {
-                config.getLogConfig().setRotationStrategy(LogRotationStrategy::COMBINED);
-            }
-        } else if (key == "LOG_DATE_FREQUENCY") {
-            if (value == "DAILY") {
-                config.getLogConfig().setDateFrequency(DateRotationFrequency::DAILY);
-            } else if (value == "HOURLY") {
-                config.getLogConfig().setDateFrequency(DateRotationFrequency::HOURLY);
-            } else if (value == "WEEKLY") {
-                config.getLogConfig().setDateFrequency(DateRotationFrequency::WEEKLY);
-            }
-        } else if (key == "LOG_DATE_FORMAT") {
-            config.getLogConfig().setDateFormat(value);
-        } else if (key == "LOG_KEEP_DATE_IN_FILENAME") {
-            config.getLogConfig().setKeepDateInFilename(value == "true" || value == "1");
-        } else if (key == "DISPLAY_MODE") {
-            if (value == "LINE_BY_LINE" || value == "0") {
-                config.setDisplayMode(DisplayModeConfig::LINE_BY_LINE);
-            } else if (value == "TOP_STYLE" || value == "1") {
-                config.setDisplayMode(DisplayModeConfig::TOP_STYLE);
-            } else if (value == "COMPACT" || value == "2") {
-                config.setDisplayMode(DisplayModeConfig::COMPACT);
-            } else if (value == "SILENCE" || value == "3") {
-                config.setDisplayMode(DisplayModeConfig::SILENCE);
-            }
+        value.erase(value.find_last_not_of(" \t\r") + 1);
+
+        const ConfigKey* entry = ConfigRegistry::find(key);
+        if (!entry) {
+            reportParseError(filename, lineNumber, "unknown key '" + key + "'");
+            continue;
         }
-        // Email configuration
-        else if (key == "EMAIL_ENABLED") {
-            config.getEmailConfig().enableEmailAlerts = (value == "true" || value == "1");			
-
-        }else if (key == "EMAIL_SUBJECT_ALERT") {
-            config.getEmailConfig().subjectAlert = value;
-        }else if (key == "EMAIL_SUBJECT_RECOVER") {
-            config.getEmailConfig().subjectRecover = value;
-        } else if (key == "EMAIL_SMTP_SERVER") {
-            config.getEmailConfig().smtpServer = value;
-        } else if (key == "EMAIL_SMTP_PORT") {
-            try {
-                int port = std::stoi(value);
-                if (port > 0 && port <= 65535) {
-                    config.getEmailConfig().smtpPort = port;
-                }
-            } catch (...) {
-                // Ignore parsing errors
-            }
-        } else if (key == "EMAIL_SENDER") {
-            config.getEmailConfig().senderEmail = value;
-        } else if (key == "EMAIL_PASSWORD") {
-            config.getEmailConfig().senderPassword = value;
-        } else if (key == "EMAIL_SENDER_NAME") {
-            config.getEmailConfig().senderName = value;
-        } else if (key == "EMAIL_RECIPIENTS") {
-            // Parse comma-separated email list
-            config.getEmailConfig().recipients.clear();
-            std::string::size_type start = 0;
-            std::string::size_type end = value.find(',');
-            while (end != std::string::npos) {
-                std::string email = value.substr(start, end - start);
-                // Trim whitespace
-                email.erase(0, email.find_first_not_of(" \t"));
-                email.erase(email.find_last_not_of(" \t") + 1);
-                if (!email.empty()) {
-                    config.getEmailConfig().recipients.push_back(email);
-                }
-                start = end + 1;
-                end = value.find(',', start);
-            }
-            // Add last email
-            std::string email = value.substr(start);
-            email.erase(0, email.find_first_not_of(" \t"));
-            email.erase(email.find_last_not_of(" \t") + 1);
-            if (!email.empty()) {
-                config.getEmailConfig().recipients.push_back(email);
-            }
-        } else if (key == "EMAIL_USE_TLS") {
-            config.getEmailConfig().useTLS = (value == "true" || value == "1");
-        } else if (key == "EMAIL_USE_SSL") {
-            config.getEmailConfig().useSSL = (value == "true" || value == "1");
-        } else if (key == "EMAIL_TIMEOUT_SECONDS") {
-            try {
-                int timeout = std::stoi(value);
-                if (timeout > 0) {
-                    config.getEmailConfig().timeoutSeconds = timeout;
-                }
-            } catch (...) {
-                // Ignore parsing errors
-            }
-        } else if (key == "EMAIL_ALERT_DURATION_SECONDS") {
-            try {
-                int duration = std::stoi(value);
-                if (duration > 0) {
-                    config.getEmailConfig().alertDurationSeconds = duration;
-                }
-            } catch (...) {
-                // Ignore parsing errors
-            }
-        } else if (key == "EMAIL_COOLDOWN_MINUTES") {
-            try {
-                int cooldown = std::stoi(value);
-                if (cooldown > 0) {
-                    config.getEmailConfig().cooldownMinutes = cooldown;
-                }
-            } catch (...) {
-                // Ignore parsing errors
+
+        // Strip inline comments ("300  # five minutes"); free text keeps '#', passwords may contain it
+        if (entry->type != ConfigValueType::TEXT) {
+            size_t comment = value.find('#');
+            while (comment != std::string::npos && comment > 0 && value[comment - 1] != ' ' && value[comment - 1] != '\t') {
+                comment = value.find('#', comment + 1);
             }
-        } else if (key == "EMAIL_SEND_RECOVERY_ALERTS") {
-            config.getEmailConfig().sendRecoveryAlerts = (value == "true" || value == "1");
-        } else if (key == "EMAIL_RECOVERY_DURATION_SECONDS") {
-            try {
-                int duration = std::stoi(value);
-                if (duration > 0) {
-                    config.getEmailConfig().recoveryDurationSeconds = duration;
-                }
-            } catch (...) {
-                // Ignore parsing errors
+            if (comment != std::string::npos) {
+                value.erase(comment);
+                value.erase(value.find_last_not_of(" \t") + 1);
             }
         }
+
+        ConfigValue parsed;
+        std::string error;
+        if (!ConfigRegistry::parseValue(*entry, value, parsed, error) ||
+            !entry->set(config, parsed, error)) {
+            reportParseError(filename, lineNumber, std::string(entry->name) + ": " + error);
+        }
     }
 
     return true;
@@ -275,100 +246,31 @@ bool ConfigurationManager::saveToFile(const std::string& filename) const {
         return false;
     }
 
-    configFile << "CPU_THRESHOLD=" << config.getCpuThreshold() << std::endl;
-    configFile << "RAM_THRESHOLD=" << config.getRamThreshold() << std::endl;
-    configFile << "DISK_THRESHOLD=" << config.getDiskThreshold() << std::endl;
-    configFile << "MONITOR_INTERVAL=" << config.getMonitorInterval() << std::endl;
-    configFile << "LOG_PATH=" << config.getLogFilePath() << std::endl;
-    configFile << "DEBUG_MODE=" << (config.isDebugMode() ? "true" : "false") << std::endl;
-    configFile << "LOG_MAX_SIZE_MB=" << config.getLogConfig().getMaxFileSizeMB() << std::endl;
-    configFile << "LOG_MAX_BACKUPS=" << config.getLogConfig().getMaxBackupFiles() << std::endl;
-    configFile << "LOG_ROTATION_ENABLED=" << (config.getLogConfig().isRotationEnabled() ? "true" : "false") << std::endl;
-    
-    // Date-based rotation settings
-    configFile << "LOG_ROTATION_STRATEGY=";
-    switch (config.getLogConfig().getRotationStrategy()) {
-        case LogRotationStrategy::SIZE_BASED:
-            configFile << "SIZE_BASED";
-            break;
-        case LogRotationStrategy::DATE_BASED:
-            configFile << "DATE_BASED";
-            break;
-        case LogRotationStrategy::COMBINED:
-            configFile << "COMBINED";
-            break;
-    }
-    configFile << std::endl;
-    
-    configFile << "LOG_DATE_FREQUENCY=";
-    switch (config.getLogConfig().getDateFrequency()) {
-        case DateRotationFrequency::DAILY:
-            configFile << "DAILY";
-            break;
-        case DateRotationFrequency::HOURLY:
-            configFile << "HOURLY";
-            break;
-        case DateRotationFrequency::WEEKLY:
-            configFile << "WEEKLY";
-            break;
-    }
-    configFile << std::endl;
-    
-    configFile << "LOG_DATE_FORMAT=" << config.getLogConfig().getDateFormat() << std::endl;
-    configFile << "LOG_KEEP_DATE_IN_FILENAME=" << (config.getLogConfig().shouldKeepDateInFilename() ? "true" : "false") << std::endl;
-    
-    // Display mode setting
-    configFile << "DISPLAY_MODE=";
-    switch (config.getDisplayMode()) {
-        case DisplayModeConfig::LINE_BY_LINE:
-            configFile << "LINE_BY_LINE";
-            break;
-        case DisplayModeConfig::TOP_STYLE:
-            configFile << "TOP_STYLE";
-            break;
-        case DisplayModeConfig::COMPACT:
-            configFile << "COMPACT";
-            break;
-        case DisplayModeConfig::SILENCE:
-            configFile << "SILENCE";
-            break;
-    }
-    configFile << std::endl;
-
-    // Email configuration
-    configFile << "EMAIL_ENABLED=" << (config.getEmailConfig().enableEmailAlerts ? "true" : "false") << std::endl;
-    configFile << "EMAIL_SMTP_SERVER=" << config.getEmailConfig().smtpServer << std::endl;
-    configFile << "EMAIL_SMTP_PORT=" << config.getEmailConfig().smtpPort << std::endl;
-    configFile << "EMAIL_SENDER=" << config.getEmailConfig().senderEmail << std::endl;
-    configFile << "EMAIL_PASSWORD=" << config.getEmailConfig().senderPassword << std::endl;
-    configFile << "EMAIL_SENDER_NAME=" << config.getEmailConfig().senderName << std::endl;
-    
-    // Recipients as comma-separated list
-    configFile << "EMAIL_RECIPIENTS=";
-    for (size_t i = 0; i < config.getEmailConfig().recipients.size(); ++i) {
-        if (i > 0) configFile << ",";
-        configFile << config.getEmailConfig().recipients[i];
+    std::vector<ConfigValue> values;
+    for (const ConfigKey* key = ConfigRegistry::begin(); key != ConfigRegistry::end(); ++key) {
+        values.clear();
+        key->get(config, values);
+        for (const auto& value : values) {
+            configFile << key->name << "=" << ConfigRegistry::formatValue(*key, value) << std::endl;
+        }
     }
-    configFile << std::endl;
-    
-    configFile << "EMAIL_USE_TLS=" << (config.getEmailConfig().useTLS ? "true" : "false") << std::endl;
-    configFile << "EMAIL_USE_SSL=" << (config.getEmailConfig().useSSL ? "true" : "false") << std::endl;
-    configFile << "EMAIL_TIMEOUT_SECONDS=" << config.getEmailConfig().timeoutSeconds << std::endl;
-    configFile << "EMAIL_ALERT_DURATION_SECONDS=" << config.getEmailConfig().alertDurationSeconds << std::endl;
-    configFile << "EMAIL_COOLDOWN_MINUTES=" << config.getEmailConfig().cooldownMinutes << std::endl;
-    configFile << "EMAIL_SEND_RECOVERY_ALERTS=" << (config.getEmailConfig().sendRecoveryAlerts ? "true" : "false") << std::endl;
-    configFile << "EMAIL_RECOVERY_DURATION_SECONDS=" << config.getEmailConfig().recoveryDurationSeconds << std::endl;
 
     return configFile.good();
 }
 
+void ConfigurationManager::reportParseError(const std::string& filename, int lineNumber, const std::string& message) {
+    std::string error = filename + ":" + std::to_string(lineNumber) + ": " + message;
+    std::cerr << "Configuration error: " << error << std::endl;
+    parseErrors.push_back(error);
+}
+
 bool ConfigurationManager::parseCommandLine(int argc, char* argv[]) {
     for (int i = 1; i < argc; i++) {
         std::string arg = argv[i];
         
         if (arg[0] == '-') {
             if (!isValidParameter(arg)) {
-                std::cerr << "Warning: Unknown parameter '" << arg << "'" << std::endl;
+                diagnostics() << "Warning: Unknown parameter '" << arg << "'" << std::endl;
                 continue;
             }
         }
@@ -388,11 +290,11 @@ bool ConfigurationManager::parseCommandLine(int argc, char* argv[]) {
             } else if (arg == "--interval") {
                 try {
                     int interval = std::stoi(value);
-                    if (interval >= 1000) {
+                    if (interval >= 100) {
                         config.setMonitorInterval(interval);
                     }
                 } catch (...) {
-                    std::cerr << "Invalid interval value: " << value << std::endl;
+                    diagnostics() << "Invalid interval value: " << value << std::endl;
                 }
                 i++;
             } else if (arg == "--log-size") {
@@ -402,7 +304,7 @@ bool ConfigurationManager::parseCommandLine(int argc, char* argv[]) {
                         config.getLogConfig().setMaxFileSizeMB(size);
                     }
                 } catch (...) {
-                    std::cerr << "Invalid log size value: " << value << std::endl;
+                    diagnostics() << "Invalid log size value: " << value << std::endl;
                 }
                 i++;
             } else if (arg == "--log-backups") {
@@ -412,7 +314,7 @@ bool ConfigurationManager::parseCommandLine(int argc, char* argv[]) {
                         config.getLogConfig().setMaxBackupFiles(backups);
                     }
                 } catch (...) {
-                    std::cerr << "Invalid log backups value: " << value << std::endl;
+                    diagnostics() << "Invalid log backups value: " << value << std::endl;
                 }
                 i++;
             } else if (arg == "--log-strategy") {
@@ -423,7 +325,7 @@ bool ConfigurationManager::parseCommandLine(int argc, char* argv[]) {
                 } else if (value == "COMBINED") {
                     config.getLogConfig().setRotationStrategy(LogRotationStrategy::COMBINED);
                 } else {
-                    std::cerr << "Invalid rotation strategy: " << value << std::endl;
+                    diagnostics() << "Invalid rotation strategy: " << value << std::endl;
                 }
                 i++;
             } else if (arg == "--log-frequency") {
@@ -434,9 +336,80 @@ bool ConfigurationManager::parseCommandLine(int argc, char* argv[]) {
                 } else if (value == "WEEKLY") {
                     config.getLogConfig().setDateFrequency(DateRotationFrequency::WEEKLY);
                 } else {
-                    std::cerr << "Invalid date frequency: " << value << std::endl;
+                    diagnostics() << "Invalid date frequency: " << value << std::endl;
+                }
+                i++;
+            } else if (arg == "--alert-rule") {
+                AlertRule rule;
+                std::string error;
+                if (AlertRule::parse(value, rule, error)) {
+                    config.addAlertRule(rule);
+                } else {
+                    diagnostics() << "Invalid alert rule '" << value << "': " << error << std::endl;
+                }
+                i++;
+            } else if (arg == "--trace") {
+                config.setTraceFilePath(value);
+                i++;
+            } else if (arg == "--record") {
+                config.setRecordFilePath(value);
+                i++;
+            } else if (arg == "--replay") {
+                config.setReplayFilePath(value);
+                i++;
+            } else if (arg == "--speed") {
+                // "100x", "100" or "max"; "max" is checked before the x suffix is stripped
+                std::string speed = value;
+                std::transform(speed.begin(), speed.end(), speed.begin(),
+                               [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+                bool unthrottled = speed == "max";
+                if (!unthrottled && !speed.empty() && speed.back() == 'x') {
+                    speed.pop_back();
+                }
+                try {
+                    double factor = unthrottled ? 0.0 : std::stod(speed);
+                    if (factor >= 0.0) {
+                        config.setReplaySpeed(factor);
+                    } else {
+                        diagnostics() << "Invalid replay speed: " << value << std::endl;
+                    }
+                } catch (...) {
+                    diagnostics() << "Invalid replay speed: " << value << std::endl;
                 }
                 i++;
+            } else if (arg == "--percentiles") {
+                // "24h", "7d" or a number of hours
+                std::string window = value;
+                int unit = 1;
+                if (!window.empty() && (window.back() == 'd' || window.back() == 'D')) {
+                    unit = 24;
+                    window.pop_back();
+                } else if (!window.empty() && (window.back() == 'h' || window.back() == 'H')) {
+                    window.pop_back();
+                }
+                try {
+                    int count = std::stoi(window);
+                    if (count > 0 && count <= 365 * 24 / unit) {
+                        config.setPercentileQueryHours(count * unit);
+                    } else {
+                        diagnostics() << "Invalid percentile window: " << value << std::endl;
+                    }
+                } catch (...) {
+                    diagnostics() << "Invalid percentile window: " << value << std::endl;
+                }
+                i++;
+            } else if (arg == "--output") {
+                if (value == "jsonl" || value == "JSONL") {
+                    config.setJsonLinesOutput(true);
+                } else if (value == "text" || value == "TEXT") {
+                    config.setJsonLinesOutput(false);
+                } else {
+                    diagnostics() << "Invalid output format: " << value << ". Use: text or jsonl" << std::endl;
+                }
+                i++;
+            } else if (arg == "--output-file") {
+                config.setOutputFilePath(value);
+                i++;
             } else if (arg == "--log-date-format") {
                 config.getLogConfig().setDateFormat(value);
                 i++;
@@ -450,7 +423,7 @@ bool ConfigurationManager::parseCommandLine(int argc, char* argv[]) {
                 } else if (value == "silence" || value == "SILENCE" || value == "3") {
                     config.setDisplayMode(DisplayModeConfig::SILENCE);
                 } else {
-                    std::cerr << "Invalid display mode: " << value << ". Use: line, top, compact, or silence" << std::endl;
+                    diagnostics() << "Invalid display mode: " << value << ". Use: line, top, compact, or silence" << std::endl;
                 }
                 i++;
             }
@@ -474,7 +447,7 @@ void ConfigurationManager::printUsage() const {
               << "  --cpu PERCENT        CPU threshold percentage (default: 80.0)\n"
               << "  --ram PERCENT        RAM threshold percentage (default: 80.0)\n"
               << "  --disk PERCENT       Disk threshold percentage (default: 80.0)\n"
-              << "  --interval MS        Monitoring interval in milliseconds (default: 5000)\n"
+              << "  --interval MS        Monitoring interval in milliseconds (default: 5000, minimum: 100)\n"
               << "  --display MODE       Display mode: line, top, compact, silence (default: top)\n"
               << "  --mode MODE          Alias for --display\n"
               << "  --debug              Enable debug logging\n"
@@ -488,6 +461,25 @@ void ConfigurationManager::printUsage() const {
               << "  --log-date-format FMT Date format for filenames (default: %Y%m%d)\n"
               << "  --help, -h           Display this help message\n"
               << "\n"
+              << "Alert Rules:\n"
+              << "  --alert-rule RULE    Add an alert rule (repeatable), e.g.\n"
+              << "                       \"process:java ram > 20 clear 15 for 60s cooldown 30m\"\n"
+              << "\n"
+              << "Diagnostics:\n"
+              << "  --trace FILE         Record the agent's own activity as a Chrome trace (open in Perfetto)\n"
+              << "  --record FILE        Save the collected samples of every cycle to FILE\n"
+              << "  --replay FILE        Feed a recording through aggregation, logging and alerts instead of\n"
+              << "                       collecting live samples\n"
+              << "  --speed FACTOR       Replay pace, e.g. 100x; max = as fast as possible (default: 1x)\n"
+              << "  --percentiles WINDOW Print CPU/RAM p50/p95/p99 per process over the last WINDOW of the\n"
+              << "                       history archive (e.g. 24h, 7d) and exit\n"
+              << "\n"
+              << "Output:\n"
+              << "  --output FORMAT      Cycle output: text (the log file, default) or jsonl (also one JSON\n"
+              << "                       object per cycle with system usage and the logged processes)\n"
+              << "  --output-file FILE   Append the JSON Lines to FILE; - = stdout (default), in which case\n"
+              << "                       console messages go to stderr\n"
+              << "\n"
               << "Display Modes:\n"
               << "  line                 Traditional line-by-line output\n"
               << "  top                  Interactive table display like Linux top (default)\n"
@@ -497,8 +489,28 @@ void ConfigurationManager::printUsage() const {
               << "Examples:\n"
               << "  SystemMonitor --display top\n"
               << "  SystemMonitor --mode line --debug\n"
+              << "  SystemMonitor --replay incident.snap --speed 100x --mode silence\n"
+              << "  SystemMonitor --percentiles 7d\n"
+              << "  SystemMonitor --output jsonl --mode silence | jq .system.cpu\n"
               << "  SystemMonitor --log-strategy DATE_BASED --log-frequency DAILY\n"
-              << "  SystemMonitor --log-strategy COMBINED --log-frequency HOURLY\n";
+              << "  SystemMonitor --log-strategy COMBINED --log-frequency HOURLY\n"
+              << "  SystemMonitor --alert-rule \"system cpu > 90 clear 80 for 2m\"\n"
+              << "\n"
+              << "Configuration File Keys (config\\SystemMonitor.cfg):\n";
+
+    // Key list and defaults come from the registry
+    MonitorConfig defaults;
+    std::vector<ConfigValue> values;
+    for (const ConfigKey* key = ConfigRegistry::begin(); key != ConfigRegistry::end(); ++key) {
+        values.clear();
+        key->get(defaults, values);
+        std::cout << "  " << std::left << std::setw(33) << key->name
+                  << std::setw(39) << ConfigRegistry::describeType(*key) << key->help;
+        if (!values.empty() && key->type != ConfigValueType::TEXT && key->type != ConfigValueType::LIST) {
+            std::cout << " (default: " << ConfigRegistry::formatValue(*key, values[0]) << ")";
+        }
+        std::cout << "\n";
+    }
 }
 
 void ConfigurationManager::resetToDefaults() {
@@ -506,5 +518,18 @@ void ConfigurationManager::resetToDefaults() {
 }
 
 bool ConfigurationManager::validateConfiguration() const {
-    return config.validate();
+    bool valid = true;
+    std::vector<ConfigValue> values;
+    for (const ConfigKey* key = ConfigRegistry::begin(); key != ConfigRegistry::end(); ++key) {
+        values.clear();
+        key->get(config, values);
+        for (const auto& value : values) {
+            std::string error;
+            if (!ConfigRegistry::checkValue(*key, value, error)) {
+                std::cerr << "Invalid " << key->name << ": " << error << std::endl;
+                valid = false;
+            }
+        }
+    }
+    return valid && config.validate();
 }
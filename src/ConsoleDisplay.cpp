@@ -148,9 +148,8 @@ void ConsoleDisplay::showTopStyleDisplay(const std::vector<ProcessInfo>& process
         return;
     }
     
-    // Clear screen and move to top
-    clearScreen();
-    setCursorPosition(0, 0);
+    getConsoleSize();
+    renderer.beginFrame();
     
     // Make a copy for sorting
     std::vector<ProcessInfo> sortedProcesses = processes;
@@ -175,6 +174,9 @@ void ConsoleDisplay::showTopStyleDisplay(const std::vector<ProcessInfo>& process
     // Show footer
     showFooter();
     
+    // Write only the cells that changed since the previous refresh
+    renderer.present();
+    
     // Update statistics
     updateStats();
 }
@@ -241,67 +243,60 @@ void ConsoleDisplay::showHeader(const SystemUsage& systemUsage, size_t processCo
     auto now = std::chrono::steady_clock::now();
     auto uptime = std::chrono::duration_cast<std::chrono::seconds>(now - startTime);
     
-    setTextColor(COLOR_HEADER);
-    std::cout << "System Monitor - Uptime: " << uptime.count() << "s, Processes: " << processCount 
-              << ", Cycles: " << totalCycles << std::endl;
-    
-    std::cout << "CPU: ";
-    setTextColor(systemUsage.getCpuPercent() > 80 ? COLOR_HIGH_CPU : COLOR_GOOD);
-    std::cout << formatPercentage(systemUsage.getCpuPercent(), 5);
-    
-    setTextColor(COLOR_HEADER);
-    std::cout << "  RAM: ";
-    setTextColor(systemUsage.getRamPercent() > 80 ? COLOR_HIGH_RAM : COLOR_GOOD);
-    std::cout << formatPercentage(systemUsage.getRamPercent(), 5);
+    std::stringstream ss;
+    ss << "System Monitor - Uptime: " << uptime.count() << "s, Processes: " << processCount 
+       << ", Cycles: " << totalCycles;
+    renderer.addLine(ss.str(), COLOR_HEADER);
     
-    setTextColor(COLOR_HEADER);
-    std::cout << "  Disk I/O: ";
-    setTextColor(systemUsage.getDiskPercent() > 50 ? COLOR_WARNING : COLOR_GOOD);
-    std::cout << formatPercentage(systemUsage.getDiskPercent(), 5) << std::endl;
+    renderer.addLine("CPU: ", COLOR_HEADER);
+    renderer.append(formatPercentage(systemUsage.getCpuPercent(), 5),
+                    systemUsage.getCpuPercent() > 80 ? COLOR_HIGH_CPU : COLOR_GOOD);
+    renderer.append("  RAM: ", COLOR_HEADER);
+    renderer.append(formatPercentage(systemUsage.getRamPercent(), 5),
+                    systemUsage.getRamPercent() > 80 ? COLOR_HIGH_RAM : COLOR_GOOD);
+    renderer.append("  Disk I/O: ", COLOR_HEADER);
+    renderer.append(formatPercentage(systemUsage.getDiskPercent(), 5),
+                    systemUsage.getDiskPercent() > 50 ? COLOR_WARNING : COLOR_GOOD);
     
-    setTextColor(COLOR_NORMAL);
-    std::cout << std::endl;
+    renderer.addLine();
 }
 
 void ConsoleDisplay::showColumnHeaders() {
-    setTextColor(COLOR_HEADER);
-    std::cout << std::left 
-              << std::setw(8) << "PID"
-              << std::setw(25) << "Process Name"
-              << std::setw(8) << "CPU%"
-              << std::setw(8) << "RAM%"
-              << std::setw(8) << "Disk%" << std::endl;
-    
-    std::cout << std::string(consoleWidth - 1, '-') << std::endl;
-    setTextColor(COLOR_NORMAL);
+    std::stringstream ss;
+    ss << std::left 
+       << std::setw(8) << "PID"
+       << std::setw(25) << "Process Name"
+       << std::setw(8) << "CPU%"
+       << std::setw(8) << "RAM%"
+       << std::setw(8) << "Disk%";
+    renderer.addLine(ss.str(), COLOR_HEADER);
+    renderer.addLine(std::string(consoleWidth - 1, '-'), COLOR_HEADER);
 }
 
 void ConsoleDisplay::showProcessTable(const std::vector<ProcessInfo>& processes) {
     for (const auto& proc : processes) {
         // Color coding based on usage
+        int color = COLOR_NORMAL;
         if (proc.getCpuPercent() > 50) {
-            setTextColor(COLOR_HIGH_CPU);
+            color = COLOR_HIGH_CPU;
         } else if (proc.getRamPercent() > 30) {
-            setTextColor(COLOR_HIGH_RAM);
-        } else {
-            setTextColor(COLOR_NORMAL);
+            color = COLOR_HIGH_RAM;
         }
         
-        std::cout << std::left 
-                  << std::setw(8) << proc.getPid()
-                  << std::setw(25) << truncateString(proc.getName(), 24)
-                  << std::setw(8) << std::fixed << std::setprecision(1) << proc.getCpuPercent() << "%"
-                  << std::setw(8) << std::fixed << std::setprecision(1) << proc.getRamPercent() << "%"
-                  << std::setw(8) << std::fixed << std::setprecision(1) << proc.getDiskPercent() << "%" << std::endl;
+        std::stringstream ss;
+        ss << std::left 
+           << std::setw(8) << proc.getPid()
+           << std::setw(25) << truncateString(proc.getName(), 24)
+           << std::setw(8) << std::fixed << std::setprecision(1) << proc.getCpuPercent() << "%"
+           << std::setw(8) << std::fixed << std::setprecision(1) << proc.getRamPercent() << "%"
+           << std::setw(8) << std::fixed << std::setprecision(1) << proc.getDiskPercent() << "%";
+        renderer.addLine(ss.str(), static_cast<uint8_t>(color));
     }
-    setTextColor(COLOR_NORMAL);
 }
 
 void ConsoleDisplay::showFooter() {
-    setTextColor(COLOR_HEADER);
-    std::cout << std::string(consoleWidth - 1, '-') << std::endl;
-    std::cout << "Press 'q' to quit, 'h' for help, 'c' for CPU sort, 'm' for RAM sort, 'd' for disk sort" << std::endl;
-    setTextColor(COLOR_NORMAL);
+    renderer.addLine(std::string(consoleWidth - 1, '-'), COLOR_HEADER);
+    renderer.addLine("Press 'q' to quit, 'h' for help, 'c' for CPU sort, 'm' for RAM sort, 'd' for disk sort", COLOR_HEADER);
 }
 
 void ConsoleDisplay::showHelp() {
@@ -321,6 +316,7 @@ void ConsoleDisplay::showHelp() {
     std::cout << std::endl;
     std::cout << "Press any key to continue..." << std::endl;
     _getch();
+    renderer.invalidate();
 }
 
 void ConsoleDisplay::updateStats() {
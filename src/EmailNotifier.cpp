@@ -1,6 +1,7 @@
 #include <condition_variable>
 #include "../include/EmailNotifier.h"
 #include "../include/SystemInfo.h"
+#include "../include/TraceRecorder.h"
 #include <iostream>
 #include <sstream>
 #include <iomanip>
@@ -410,6 +411,7 @@ void EmailNotifier::setConfig(const EmailConfig& emailConfig) {
 }
 
 void EmailNotifier::emailWorkerLoop() {
+    TraceRecorder::instance().setThreadName("Email worker");
     while (running.load()) {
         std::unique_lock<std::mutex> lock(queueMutex);
         
@@ -424,16 +426,26 @@ void EmailNotifier::emailWorkerLoop() {
             emailQueue.pop();
             lock.unlock();
 
+            // Copy the settings so a concurrent setConfig() cannot change them mid-send
+            EmailConfig sendConfig;
+            {
+                std::lock_guard<std::mutex> alertLock(alertMutex);
+                sendConfig = config;
+            }
+
             try {
-                if (config.isValid()) {
-                    bool success = emailSender->sendEmail(message, config);
+                if (sendConfig.isValid()) {
+                    TraceScope trace("Email send", "email");
+                    bool success = emailSender->sendEmail(message, sendConfig);
                     if (!success) {
+                        droppedEmails++;
                         std::cerr << "Failed to send email: " << message.subject << std::endl;
                     } else {
                         std::cout << "Email sent successfully: " << message.subject << std::endl;
                     }
                 }
             } catch (const std::exception& e) {
+                droppedEmails++;
                 std::cerr << "Exception while sending email: " << e.what() << std::endl;
             }
         }
@@ -911,6 +923,42 @@ void EmailNotifier::sendImmediateAlert(const std::string& subject, const std::st
     queueEmail(alert);
 }
 
+void EmailNotifier::notifyRuleAlert(const std::string& ruleName, const std::string& currentLogEntry) {
+    std::lock_guard<std::mutex> lock(alertMutex);
+    if (!isEnabled()) return;
+    
+    std::vector<std::string>& logs = ruleAlertLogs[ruleName];
+    logs.clear();
+    if (!currentLogEntry.empty()) {
+        logs.push_back(currentLogEntry);
+    }
+    
+    std::string subject = config.subjectAlert + " [" + ruleName + "]";
+    EmailMessage alert(subject, generateAlertEmail(logs), config.recipients, true);
+    queueEmail(alert);
+}
+
+void EmailNotifier::notifyRuleRecovery(const std::string& ruleName, const std::string& currentLogEntry) {
+    std::lock_guard<std::mutex> lock(alertMutex);
+    auto it = ruleAlertLogs.find(ruleName);
+    std::vector<std::string> alertLogs;
+    if (it != ruleAlertLogs.end()) {
+        alertLogs = std::move(it->second);
+        ruleAlertLogs.erase(it);
+    }
+    
+    if (!isEnabled() || !config.sendRecoveryAlerts) return;
+    
+    std::vector<std::string> recoveryLogs;
+    if (!currentLogEntry.empty()) {
+        recoveryLogs.push_back(currentLogEntry);
+    }
+    
+    std::string subject = config.subjectRecover + " [" + ruleName + "]";
+    EmailMessage recovery(subject, generateRecoveryEmail(alertLogs, recoveryLogs), config.recipients, true);
+    queueEmail(recovery);
+}
+
 bool EmailNotifier::testEmailConfiguration() {
     if (!config.isValid()) {
         std::cerr << "Email configuration is invalid<br>";
@@ -950,6 +998,10 @@ void EmailNotifier::stop() {
     if (emailWorkerThread.joinable()) {
         emailWorkerThread.join();
     }
+    
+    // Whatever is still queued will not be sent
+    std::lock_guard<std::mutex> lock(queueMutex);
+    droppedEmails += emailQueue.size();
 }
 
 std::chrono::system_clock::time_point EmailNotifier::getLastAlertTime() const {
@@ -0,0 +1,730 @@
+#include "../include/HistoryArchive.h"
+#include "../include/TraceRecorder.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+
+namespace {
+
+const char DATA_MAGIC[8] = { 'S', 'M', 'H', 'D', 'A', 'T', '\x01', '\n' };
+const char INDEX_MAGIC[8] = { 'S', 'M', 'H', 'I', 'D', 'X', '\x01', '\n' };
+const uint32_t SECONDS_PER_DAY = 86400;
+
+// No XOR window stored yet: no leading zero count reaches it
+const uint8_t NO_WINDOW = 33;
+
+uint32_t floatBits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+float bitsFloat(uint32_t bits) {
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+int leadingZeros(uint32_t value) {
+    int count = 0;
+    for (uint32_t mask = 0x80000000u; mask != 0 && !(value & mask); mask >>= 1) {
+        count++;
+    }
+    return count;
+}
+
+int trailingZeros(uint32_t value) {
+    int count = 0;
+    for (uint32_t mask = 1; mask != 0 && !(value & mask); mask <<= 1) {
+        count++;
+    }
+    return count;
+}
+
+// Delta-of-delta buckets: control prefix, then the value in `bits` bits
+struct DeltaBucket {
+    uint32_t prefix;
+    int prefixBits;
+    int bits;
+};
+const DeltaBucket DELTA_BUCKETS[] = {
+    { 0x2, 2, 7 },      // '10'   -63..64
+    { 0x6, 3, 9 },      // '110'  -255..256
+    { 0xE, 4, 12 },     // '1110' -2047..2048
+};
+
+class BitReader {
+private:
+    const uint8_t* data;
+    size_t size;
+    size_t position = 0;                // In bits
+
+public:
+    BitReader(const uint8_t* bytes, size_t length) : data(bytes), size(length) {}
+
+    bool read(int count, uint64_t& value) {
+        if (position + static_cast<size_t>(count) > size * 8) {
+            return false;
+        }
+        value = 0;
+        for (int i = 0; i < count; i++, position++) {
+            value = (value << 1) | ((data[position / 8] >> (7 - position % 8)) & 1);
+        }
+        return true;
+    }
+
+    bool readBit(bool& bit) {
+        uint64_t value;
+        if (!read(1, value)) {
+            return false;
+        }
+        bit = value != 0;
+        return true;
+    }
+};
+
+void putVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+bool getVarint(const std::vector<uint8_t>& data, size_t& position, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (position >= data.size()) {
+            return false;
+        }
+        uint8_t byte = data[position++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// One chunk as described by the index
+struct IndexRecord {
+    bool system = true;
+    DWORD pid = 0;
+    ULONGLONG startTime = 0;
+    std::string name;
+    uint32_t firstSecond = 0;
+    uint32_t lastSecond = 0;
+    uint32_t pointCount = 0;
+    uint64_t offset = 0;
+    uint32_t length = 0;
+};
+
+void putRecord(std::string& out, const IndexRecord& record) {
+    out.push_back(record.system ? 0 : 1);
+    putVarint(out, record.pid);
+    putVarint(out, record.startTime);
+    putVarint(out, record.name.size());
+    out.append(record.name);
+    putVarint(out, record.firstSecond);
+    putVarint(out, record.lastSecond - record.firstSecond);
+    putVarint(out, record.pointCount);
+    putVarint(out, record.offset);
+    putVarint(out, record.length);
+}
+
+bool getRecord(const std::vector<uint8_t>& data, size_t& position, IndexRecord& record) {
+    if (position >= data.size() || data[position] > 1) {
+        return false;
+    }
+    record.system = data[position++] == 0;
+    uint64_t pid, startTime, nameLength, firstSecond, span, pointCount, offset, length;
+    if (!getVarint(data, position, pid) || !getVarint(data, position, startTime) ||
+        !getVarint(data, position, nameLength) || data.size() - position < nameLength) {
+        return false;
+    }
+    record.name.assign(reinterpret_cast<const char*>(data.data() + position), static_cast<size_t>(nameLength));
+    position += static_cast<size_t>(nameLength);
+    if (!getVarint(data, position, firstSecond) || !getVarint(data, position, span) ||
+        !getVarint(data, position, pointCount) || !getVarint(data, position, offset) ||
+        !getVarint(data, position, length)) {
+        return false;
+    }
+    record.pid = static_cast<DWORD>(pid);
+    record.startTime = startTime;
+    record.firstSecond = static_cast<uint32_t>(firstSecond);
+    record.lastSecond = static_cast<uint32_t>(firstSecond + span);
+    record.pointCount = static_cast<uint32_t>(pointCount);
+    record.offset = offset;
+    record.length = static_cast<uint32_t>(length);
+    return true;
+}
+
+// Parses an index file; returns the end of its last complete record (0 if the header is wrong)
+size_t readIndex(const std::string& path, std::vector<IndexRecord>& records) {
+    std::ifstream in(path, std::ios::binary);
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (data.size() < sizeof(INDEX_MAGIC) || std::memcmp(data.data(), INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0) {
+        return 0;
+    }
+    size_t position = sizeof(INDEX_MAGIC);
+    size_t complete = position;
+    IndexRecord record;
+    while (getRecord(data, position, record)) {
+        records.push_back(record);
+        complete = position;
+    }
+    return complete;
+}
+
+// Days since the Unix epoch <-> civil date (proleptic Gregorian)
+void civilFromDays(int64_t days, int& year, unsigned& month, unsigned& day) {
+    days += 719468;
+    int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    unsigned dayOfEra = static_cast<unsigned>(days - era * 146097);
+    unsigned yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    unsigned dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    unsigned shiftedMonth = (5 * dayOfYear + 2) / 153;
+    day = dayOfYear - (153 * shiftedMonth + 2) / 5 + 1;
+    month = shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9;
+    year = static_cast<int>(yearOfEra + era * 400) + (month <= 2 ? 1 : 0);
+}
+
+int64_t daysFromCivil(int year, unsigned month, unsigned day) {
+    year -= month <= 2 ? 1 : 0;
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    unsigned yearOfEra = static_cast<unsigned>(year - era * 400);
+    unsigned dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + static_cast<int64_t>(dayOfEra) - 719468;
+}
+
+// Day of a "history-YYYYMMDD.ext" file name (chunks, index, percentile sketches); -1 for other names
+int64_t segmentDay(const std::string& fileName) {
+    if (fileName.size() != 20 || fileName.compare(0, 8, "history-") != 0 ||
+        (fileName.compare(16, 4, ".dat") != 0 && fileName.compare(16, 4, ".idx") != 0 &&
+         fileName.compare(16, 4, ".qsk") != 0)) {
+        return -1;
+    }
+    for (size_t i = 8; i < 16; i++) {
+        if (fileName[i] < '0' || fileName[i] > '9') {
+            return -1;
+        }
+    }
+    int year = std::stoi(fileName.substr(8, 4));
+    unsigned month = static_cast<unsigned>(std::stoi(fileName.substr(12, 2)));
+    unsigned day = static_cast<unsigned>(std::stoi(fileName.substr(14, 2)));
+    if (month < 1 || month > 12 || day < 1 || day > 31) {
+        return -1;
+    }
+    return daysFromCivil(year, month, day);
+}
+
+} // namespace
+
+// HistoryChunk implementation
+void HistoryChunk::writeBits(uint64_t value, int count) {
+    while (count > 0) {
+        if (freeBits == 0) {
+            bytes.push_back(0);
+            freeBits = 8;
+        }
+        int take = std::min<int>(count, freeBits);
+        uint8_t part = static_cast<uint8_t>((value >> (count - take)) & ((1u << take) - 1));
+        bytes.back() |= static_cast<uint8_t>(part << (freeBits - take));
+        freeBits = static_cast<uint8_t>(freeBits - take);
+        count -= take;
+    }
+}
+
+float HistoryChunk::quantize(double value) {
+    return static_cast<float>(std::round(value * 128.0) / 128.0);
+}
+
+void HistoryChunk::append(uint32_t second, const float values[VALUE_COUNT]) {
+    if (pointCount == 0) {
+        firstSecond = second;
+        writeBits(second, 32);
+        for (size_t v = 0; v < VALUE_COUNT; v++) {
+            lastBits[v] = floatBits(quantize(values[v]));
+            leading[v] = NO_WINDOW;
+            trailing[v] = 0;
+            writeBits(lastBits[v], 32);
+        }
+        lastSecond = second;
+        pointCount = 1;
+        return;
+    }
+
+    // Timestamp: delta of the delta to the previous point
+    int64_t delta = static_cast<int64_t>(second) - lastSecond;
+    int64_t deltaOfDelta = delta - lastDelta;
+    lastDelta = delta;
+    lastSecond = second;
+    if (deltaOfDelta == 0) {
+        writeBits(0, 1);
+    } else {
+        bool stored = false;
+        for (const auto& bucket : DELTA_BUCKETS) {
+            int64_t bias = (int64_t(1) << (bucket.bits - 1)) - 1;
+            if (deltaOfDelta >= -bias && deltaOfDelta <= bias + 1) {
+                writeBits(bucket.prefix, bucket.prefixBits);
+                writeBits(static_cast<uint64_t>(deltaOfDelta + bias), bucket.bits);
+                stored = true;
+                break;
+            }
+        }
+        if (!stored) {
+            writeBits(0xF, 4);
+            writeBits(static_cast<uint32_t>(static_cast<int32_t>(deltaOfDelta)), 32);
+        }
+    }
+
+    // Values: XOR with the previous value of the column
+    for (size_t v = 0; v < VALUE_COUNT; v++) {
+        uint32_t bits = floatBits(quantize(values[v]));
+        uint32_t xorBits = bits ^ lastBits[v];
+        lastBits[v] = bits;
+        if (xorBits == 0) {
+            writeBits(0, 1);
+            continue;
+        }
+        int lead = leadingZeros(xorBits);
+        int trail = trailingZeros(xorBits);
+        if (leading[v] != NO_WINDOW && lead >= leading[v] && trail >= trailing[v]) {
+            writeBits(0x2, 2);
+            writeBits(xorBits >> trailing[v], 32 - leading[v] - trailing[v]);
+        } else {
+            int length = 32 - lead - trail;
+            writeBits(0x3, 2);
+            writeBits(static_cast<uint64_t>(lead), 5);
+            writeBits(static_cast<uint64_t>(length - 1), 5);
+            writeBits(xorBits >> trail, length);
+            leading[v] = static_cast<uint8_t>(lead);
+            trailing[v] = static_cast<uint8_t>(trail);
+        }
+    }
+    pointCount++;
+}
+
+bool HistoryChunk::decode(const uint8_t* data, size_t size, uint32_t count, std::vector<ArchiveSample>& out) {
+    BitReader reader(data, size);
+    uint64_t value;
+    uint32_t second = 0;
+    int64_t delta = 0;
+    uint32_t bits[VALUE_COUNT] = {};
+    int lead[VALUE_COUNT] = {};
+    int trail[VALUE_COUNT] = {};
+
+    for (uint32_t point = 0; point < count; point++) {
+        if (point == 0) {
+            if (!reader.read(32, value)) {
+                return false;
+            }
+            second = static_cast<uint32_t>(value);
+            for (size_t v = 0; v < VALUE_COUNT; v++) {
+                if (!reader.read(32, value)) {
+                    return false;
+                }
+                bits[v] = static_cast<uint32_t>(value);
+            }
+        } else {
+            // Control bits: count the leading ones of the timestamp prefix
+            int ones = 0;
+            bool bit = true;
+            while (ones < 4) {
+                if (!reader.readBit(bit)) {
+                    return false;
+                }
+                if (!bit) {
+                    break;
+                }
+                ones++;
+            }
+            int64_t deltaOfDelta = 0;
+            if (ones == 4) {
+                if (!reader.read(32, value)) {
+                    return false;
+                }
+                deltaOfDelta = static_cast<int32_t>(static_cast<uint32_t>(value));
+            } else if (ones > 0) {
+                const DeltaBucket& bucket = DELTA_BUCKETS[ones - 1];
+                if (!reader.read(bucket.bits, value)) {
+                    return false;
+                }
+                deltaOfDelta = static_cast<int64_t>(value) - ((int64_t(1) << (bucket.bits - 1)) - 1);
+            }
+            delta += deltaOfDelta;
+            second = static_cast<uint32_t>(second + delta);
+
+            for (size_t v = 0; v < VALUE_COUNT; v++) {
+                if (!reader.readBit(bit)) {
+                    return false;
+                }
+                if (!bit) {
+                    continue;
+                }
+                if (!reader.readBit(bit)) {
+                    return false;
+                }
+                if (bit) {
+                    uint64_t storedLead, storedLength;
+                    if (!reader.read(5, storedLead) || !reader.read(5, storedLength)) {
+                        return false;
+                    }
+                    lead[v] = static_cast<int>(storedLead);
+                    trail[v] = 32 - lead[v] - static_cast<int>(storedLength + 1);
+                    if (trail[v] < 0) {
+                        return false;
+                    }
+                }
+                if (!reader.read(32 - lead[v] - trail[v], value)) {
+                    return false;
+                }
+                bits[v] ^= static_cast<uint32_t>(value << trail[v]);
+            }
+        }
+
+        ArchiveSample sample;
+        sample.timestampMs = static_cast<int64_t>(second) * 1000;
+        for (size_t v = 0; v < VALUE_COUNT; v++) {
+            sample.values[v] = bitsFloat(bits[v]);
+        }
+        out.push_back(sample);
+    }
+    return true;
+}
+
+// HistoryArchiveWriter implementation
+HistoryArchiveWriter::~HistoryArchiveWriter() {
+    stop();
+}
+
+bool HistoryArchiveWriter::start(const std::string& archiveDirectory) {
+    if (running || worker.joinable()) {
+        return false;
+    }
+    std::error_code error;
+    std::filesystem::create_directories(archiveDirectory, error);
+    if (!std::filesystem::is_directory(archiveDirectory, error)) {
+        return false;
+    }
+    directory = archiveDirectory;
+    running = true;
+    worker = std::thread(&HistoryArchiveWriter::workerThreadFunction, this);
+    return true;
+}
+
+void HistoryArchiveWriter::stop() {
+    if (!running) {
+        return;
+    }
+    running = false;
+    queue.shutdown();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void HistoryArchiveWriter::append(int64_t timestampMs, const SystemUsage& systemUsage,
+                                  const std::vector<ProcessInfo>& processes) {
+    if (!running) {
+        return;
+    }
+    if (queue.size() >= QUEUE_LIMIT) {
+        droppedCycles++;
+        return;
+    }
+
+    // Heaviest processes first; the rest of the cycle is not archived
+    Cycle cycle;
+    cycle.timestampMs = timestampMs;
+    cycle.systemUsage = systemUsage;
+    size_t keep = std::min(processes.size(), maxProcesses.load());
+    cycle.processes.resize(keep);
+    std::partial_sort_copy(processes.begin(), processes.end(), cycle.processes.begin(), cycle.processes.end(),
+                           [](const ProcessInfo& a, const ProcessInfo& b) {
+                               return a.getCpuPercent() + a.getRamPercent() + a.getDiskPercent() >
+                                      b.getCpuPercent() + b.getRamPercent() + b.getDiskPercent();
+                           });
+    queue.push(std::move(cycle));
+}
+
+void HistoryArchiveWriter::workerThreadFunction() {
+    TraceRecorder::instance().setThreadName("History archive");
+    Cycle cycle;
+    while (queue.pop(cycle)) {
+        write(cycle);
+    }
+    sealBlock();
+    dataFile.close();
+    indexFile.close();
+}
+
+void HistoryArchiveWriter::write(const Cycle& cycle) {
+    if (cycle.timestampMs < 0) {
+        return;
+    }
+    uint32_t second = static_cast<uint32_t>(cycle.timestampMs / 1000);
+    uint32_t block = second / BLOCK_SECONDS;
+    if (block != openBlock) {
+        sealBlock();
+        openBlock = block;
+    }
+
+    // One point per series and second; a clock stepped back waits for time to catch up
+    auto add = [second](HistoryChunk& chunk, const float values[HistoryChunk::VALUE_COUNT]) {
+        if (chunk.getPointCount() > 0 && second <= chunk.getLastSecond()) {
+            return false;
+        }
+        chunk.append(second, values);
+        return true;
+    };
+
+    uint64_t added = 0;
+    const float systemValues[HistoryChunk::VALUE_COUNT] = {
+        static_cast<float>(cycle.systemUsage.getCpuPercent()),
+        static_cast<float>(cycle.systemUsage.getRamPercent()),
+        static_cast<float>(cycle.systemUsage.getDiskPercent())
+    };
+    added += add(systemChunk.chunk, systemValues) ? 1 : 0;
+    for (const auto& process : cycle.processes) {
+        OpenChunk& open = processChunks[SeriesKey{ process.getPid(), process.getStartTime() }];
+        if (open.chunk.getPointCount() == 0) {
+            open.name = process.getName();
+        }
+        const float values[HistoryChunk::VALUE_COUNT] = {
+            static_cast<float>(process.getCpuPercent()),
+            static_cast<float>(process.getRamPercent()),
+            static_cast<float>(process.getDiskPercent())
+        };
+        added += add(open.chunk, values) ? 1 : 0;
+    }
+    pointCount += added;
+}
+
+void HistoryArchiveWriter::sealBlock() {
+    if (openBlock == UINT32_MAX || (systemChunk.chunk.getPointCount() == 0 && processChunks.empty())) {
+        return;
+    }
+    TraceScope scope("Archive block", "history");
+
+    uint32_t day = static_cast<uint32_t>(static_cast<uint64_t>(openBlock) * BLOCK_SECONDS / SECONDS_PER_DAY);
+    if ((day != openDay || !dataFile.is_open()) && !openSegment(day)) {
+        LoggerManager::getInstance().debug("History archive: cannot open " + directory + "/" + segmentName(day) +
+                                           ".*; block dropped");
+        systemChunk = OpenChunk();
+        processChunks.clear();
+        return;
+    }
+
+    // Data first, then the index records that point at it
+    std::string data;
+    std::string index;
+    auto add = [&](bool system, DWORD pid, ULONGLONG startTime, const OpenChunk& open) {
+        if (open.chunk.getPointCount() == 0) {
+            return;
+        }
+        IndexRecord record;
+        record.system = system;
+        record.pid = pid;
+        record.startTime = startTime;
+        record.name = open.name;
+        record.firstSecond = open.chunk.getFirstSecond();
+        record.lastSecond = open.chunk.getLastSecond();
+        record.pointCount = open.chunk.getPointCount();
+        record.offset = dataOffset + data.size();
+        record.length = static_cast<uint32_t>(open.chunk.getBytes().size());
+        putRecord(index, record);
+        data.append(open.chunk.getBytes().begin(), open.chunk.getBytes().end());
+    };
+    add(true, 0, 0, systemChunk);
+    for (const auto& entry : processChunks) {
+        add(false, entry.first.pid, entry.first.startTime, entry.second);
+    }
+    systemChunk = OpenChunk();
+    processChunks.clear();
+
+    dataFile.write(data.data(), static_cast<std::streamsize>(data.size()));
+    dataFile.flush();
+    if (!dataFile.good()) {
+        LoggerManager::getInstance().debug("History archive: write failed in " + directory + "; block dropped");
+        dataFile.close();
+        indexFile.close();
+        return;
+    }
+    dataOffset += data.size();
+    indexFile.write(index.data(), static_cast<std::streamsize>(index.size()));
+    indexFile.flush();
+    bytesWritten += data.size() + index.size();
+}
+
+bool HistoryArchiveWriter::openSegment(uint32_t day) {
+    dataFile.close();
+    indexFile.close();
+    std::filesystem::path stem = std::filesystem::path(directory) / segmentName(day);
+    std::string dataPath = stem.string() + ".dat";
+    std::string indexPath = stem.string() + ".idx";
+    std::error_code error;
+
+    // Reopening a day after a restart: cut an index record left half-written by a crash
+    std::vector<IndexRecord> records;
+    size_t indexEnd = std::filesystem::exists(indexPath, error) ? readIndex(indexPath, records) : 0;
+    if (indexEnd == 0) {
+        std::ofstream fresh(indexPath, std::ios::binary | std::ios::trunc);
+        fresh.write(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+        bytesWritten += sizeof(INDEX_MAGIC);
+    } else if (indexEnd < std::filesystem::file_size(indexPath, error)) {
+        std::filesystem::resize_file(indexPath, indexEnd, error);
+    }
+
+    uintmax_t dataSize = std::filesystem::exists(dataPath, error) ? std::filesystem::file_size(dataPath, error) : 0;
+    dataFile.open(dataPath, std::ios::binary | std::ios::app);
+    if (dataSize < sizeof(DATA_MAGIC)) {
+        dataFile.write(DATA_MAGIC, sizeof(DATA_MAGIC));
+        bytesWritten += sizeof(DATA_MAGIC);
+        dataSize += sizeof(DATA_MAGIC);
+    }
+    dataOffset = dataSize;
+    indexFile.open(indexPath, std::ios::binary | std::ios::app);
+    if (!dataFile.is_open() || !indexFile.is_open()) {
+        dataFile.close();
+        indexFile.close();
+        return false;
+    }
+    openDay = day;
+    removeExpiredSegments(day);
+    return true;
+}
+
+void HistoryArchiveWriter::removeExpiredSegments(uint32_t today) {
+    int days = retentionDays;
+    if (days <= 0) {
+        return;
+    }
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        int64_t day = segmentDay(entry.path().filename().string());
+        if (day >= 0 && day <= static_cast<int64_t>(today) - days) {
+            std::filesystem::remove(entry.path(), error);
+        }
+    }
+}
+
+std::string HistoryArchiveWriter::segmentName(uint32_t day) {
+    int year;
+    unsigned month, dayOfMonth;
+    civilFromDays(day, year, month, dayOfMonth);
+    char name[32];
+    snprintf(name, sizeof(name), "history-%04d%02u%02u", year, month, dayOfMonth);
+    return name;
+}
+
+// HistoryArchiveReader implementation
+bool HistoryArchiveReader::open(const std::string& archiveDirectory) {
+    directory = archiveDirectory;
+    segments.clear();
+    series.clear();
+    chunks.clear();
+    truncated = false;
+
+    // Day files sort by name in date order
+    std::vector<std::filesystem::path> indexFiles;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        std::string fileName = entry.path().filename().string();
+        if (segmentDay(fileName) >= 0 && entry.path().extension() == ".idx") {
+            indexFiles.push_back(entry.path());
+        }
+    }
+    std::sort(indexFiles.begin(), indexFiles.end());
+
+    bool readable = false;
+    for (const auto& indexPath : indexFiles) {
+        std::vector<IndexRecord> records;
+        size_t end = readIndex(indexPath.string(), records);
+        if (end == 0) {
+            continue;
+        }
+        readable = true;
+        if (end < std::filesystem::file_size(indexPath, error)) {
+            truncated = true;
+        }
+        std::filesystem::path dataPath = indexPath;
+        dataPath.replace_extension(".dat");
+        size_t segment = segments.size();
+        segments.push_back(dataPath.string());
+
+        for (const auto& record : records) {
+            size_t seriesIndex = findSeries(record.system, record.pid, record.startTime);
+            if (seriesIndex == series.size()) {
+                ArchiveSeries entry;
+                entry.system = record.system;
+                entry.pid = record.pid;
+                entry.startTime = record.startTime;
+                entry.name = record.name;
+                entry.firstMs = static_cast<int64_t>(record.firstSecond) * 1000;
+                entry.lastMs = static_cast<int64_t>(record.lastSecond) * 1000;
+                series.push_back(entry);
+            }
+            ArchiveSeries& entry = series[seriesIndex];
+            entry.firstMs = std::min<int64_t>(entry.firstMs, static_cast<int64_t>(record.firstSecond) * 1000);
+            entry.lastMs = std::max<int64_t>(entry.lastMs, static_cast<int64_t>(record.lastSecond) * 1000);
+            entry.pointCount += record.pointCount;
+            chunks.push_back(ChunkRef{ seriesIndex, segment, record.offset, record.length, record.pointCount,
+                                       record.firstSecond, record.lastSecond });
+        }
+    }
+    return readable;
+}
+
+size_t HistoryArchiveReader::findSeries(bool system, DWORD pid, ULONGLONG startTime) const {
+    for (size_t i = 0; i < series.size(); i++) {
+        if (series[i].system == system && series[i].pid == pid && series[i].startTime == startTime) {
+            return i;
+        }
+    }
+    return series.size();
+}
+
+std::vector<ArchiveSample> HistoryArchiveReader::query(size_t seriesIndex, int64_t fromMs, int64_t toMs) const {
+    std::vector<ArchiveSample> samples;
+    std::vector<uint8_t> buffer;
+    std::vector<ArchiveSample> decoded;
+    for (const auto& chunk : chunks) {
+        if (chunk.series != seriesIndex || static_cast<int64_t>(chunk.lastSecond) * 1000 < fromMs ||
+            static_cast<int64_t>(chunk.firstSecond) * 1000 > toMs) {
+            continue;
+        }
+        std::ifstream in(segments[chunk.segment], std::ios::binary);
+        buffer.resize(chunk.length);
+        in.seekg(static_cast<std::streamoff>(chunk.offset));
+        if (!in.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()))) {
+            continue;
+        }
+        decoded.clear();
+        if (!HistoryChunk::decode(buffer.data(), buffer.size(), chunk.pointCount, decoded)) {
+            continue;
+        }
+        for (const auto& sample : decoded) {
+            if (sample.timestampMs >= fromMs && sample.timestampMs <= toMs) {
+                samples.push_back(sample);
+            }
+        }
+    }
+    std::stable_sort(samples.begin(), samples.end(), [](const ArchiveSample& a, const ArchiveSample& b) {
+        return a.timestampMs < b.timestampMs;
+    });
+    return samples;
+}
+
+std::vector<ArchiveSample> HistoryArchiveReader::querySystem(int64_t fromMs, int64_t toMs) const {
+    return query(findSeries(true, 0, 0), fromMs, toMs);
+}
+
+std::vector<ArchiveSample> HistoryArchiveReader::queryProcess(DWORD pid, ULONGLONG startTime,
+                                                              int64_t fromMs, int64_t toMs) const {
+    return query(findSeries(false, pid, startTime), fromMs, toMs);
+}
@@ -0,0 +1,236 @@
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#endif
+#include "../include/JsonLinesWriter.h"
+#include "../include/TraceRecorder.h"
+#include <charconv>
+#include <cmath>
+
+namespace {
+
+void appendInteger(std::string& out, int64_t value) {
+    char text[24];
+    std::to_chars_result result = std::to_chars(text, text + sizeof(text), value);
+    out.append(text, static_cast<size_t>(result.ptr - text));
+}
+
+// Two decimals like the text log; JSON has no NaN or infinity
+void appendPercent(std::string& out, double value) {
+    if (!std::isfinite(value)) {
+        out += "null";
+        return;
+    }
+    char text[64];
+    std::to_chars_result result = std::to_chars(text, text + sizeof(text), value, std::chars_format::fixed, 2);
+    if (result.ec != std::errc()) {
+        result = std::to_chars(text, text + sizeof(text), value);     // Too wide for fixed notation
+    }
+    out.append(text, static_cast<size_t>(result.ptr - text));
+}
+
+void appendDigits(std::string& out, int64_t value, int width) {
+    char text[8];
+    for (int i = width - 1; i >= 0; i--) {
+        text[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+    out.append(text, static_cast<size_t>(width));
+}
+
+// ISO 8601 UTC with milliseconds, from the days-to-civil conversion of the
+// proleptic Gregorian calendar; no gmtime() or locale involved
+void appendUtcTime(std::string& out, int64_t timestampMs) {
+    int64_t millis = timestampMs % 1000;
+    int64_t seconds = timestampMs / 1000;
+    if (millis < 0) {
+        millis += 1000;
+        seconds--;
+    }
+    int64_t days = seconds / 86400;
+    int64_t secondOfDay = seconds % 86400;
+    if (secondOfDay < 0) {
+        secondOfDay += 86400;
+        days--;
+    }
+    days += 719468;
+    int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    int64_t dayOfEra = days - era * 146097;
+    int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    int64_t monthIndex = (5 * dayOfYear + 2) / 153;
+    int64_t day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+    int64_t month = monthIndex < 10 ? monthIndex + 3 : monthIndex - 9;
+    int64_t year = yearOfEra + era * 400 + (month <= 2 ? 1 : 0);
+
+    out += '"';
+    appendDigits(out, year, 4);
+    out += '-';
+    appendDigits(out, month, 2);
+    out += '-';
+    appendDigits(out, day, 2);
+    out += 'T';
+    appendDigits(out, secondOfDay / 3600, 2);
+    out += ':';
+    appendDigits(out, secondOfDay / 60 % 60, 2);
+    out += ':';
+    appendDigits(out, secondOfDay % 60, 2);
+    out += '.';
+    appendDigits(out, millis, 3);
+    out += "Z\"";
+}
+
+void appendUsage(std::string& out, double cpu, double ram, double disk) {
+    out += "{\"cpu\":";
+    appendPercent(out, cpu);
+    out += ",\"ram\":";
+    appendPercent(out, ram);
+    out += ",\"disk\":";
+    appendPercent(out, disk);
+    out += '}';
+}
+
+} // namespace
+
+JsonLinesWriter::~JsonLinesWriter() {
+    close();
+}
+
+bool JsonLinesWriter::open(const std::string& filePath) {
+    close();
+    if (filePath.empty() || filePath == "-") {
+#ifdef _WIN32
+        // Lines end in \n on every platform
+        _setmode(_fileno(stdout), _O_BINARY);
+#endif
+        file = stdout;
+        ownsFile = false;
+        path = "-";
+        return true;
+    }
+    file = std::fopen(filePath.c_str(), "ab");
+    if (!file) {
+        return false;
+    }
+    ownsFile = true;
+    path = filePath;
+    return true;
+}
+
+void JsonLinesWriter::close() {
+    if (!file) {
+        return;
+    }
+    if (ownsFile) {
+        std::fclose(file);
+    } else {
+        std::fflush(file);
+    }
+    file = nullptr;
+    ownsFile = false;
+}
+
+const std::string& JsonLinesWriter::escapedName(const ProcessInfo& process) {
+    CachedName& cached = names[NameKey{ process.getPid(), process.getStartTime() }];
+    if (cached.lastCycle == 0 || cached.name != process.getName()) {
+        cached.name = process.getName();
+        cached.escaped.clear();
+        appendEscaped(cached.escaped, cached.name);
+    }
+    cached.lastCycle = cycle;
+    return cached.escaped;
+}
+
+const std::string& JsonLinesWriter::format(int64_t timestampMs, const SystemUsage& systemUsage,
+                                           const std::vector<ProcessInfo>& processes) {
+    cycle++;
+    if (cycle % NAME_CACHE_SWEEP_CYCLES == 0) {
+        for (auto it = names.begin(); it != names.end();) {
+            if (it->second.lastCycle + NAME_CACHE_SWEEP_CYCLES < cycle) {
+                it = names.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    double totalCpu = 0.0;
+    double totalRam = 0.0;
+    double totalDisk = 0.0;
+    for (const auto& process : processes) {
+        totalCpu += process.getCpuPercent();
+        totalRam += process.getRamPercent();
+        totalDisk += process.getDiskPercent();
+    }
+
+    // clear() keeps the capacity of earlier cycles
+    line.clear();
+    line += "{\"timestamp_ms\":";
+    appendInteger(line, timestampMs);
+    line += ",\"time\":";
+    appendUtcTime(line, timestampMs);
+    line += ",\"system\":";
+    appendUsage(line, systemUsage.getCpuPercent(), systemUsage.getRamPercent(), systemUsage.getDiskPercent());
+    line += ",\"totals\":";
+    appendUsage(line, totalCpu, totalRam, totalDisk);
+    line += ",\"processes\":[";
+    bool first = true;
+    for (const auto& process : processes) {
+        line += first ? "{\"pid\":" : ",{\"pid\":";
+        first = false;
+        appendInteger(line, process.getPid());
+        line += ",\"ppid\":";
+        appendInteger(line, process.getPpid());
+        line += ",\"name\":\"";
+        line += escapedName(process);
+        line += "\",\"cpu\":";
+        appendPercent(line, process.getCpuPercent());
+        line += ",\"ram\":";
+        appendPercent(line, process.getRamPercent());
+        line += ",\"disk\":";
+        appendPercent(line, process.getDiskPercent());
+        line += '}';
+    }
+    line += "]}\n";
+    return line;
+}
+
+bool JsonLinesWriter::write(int64_t timestampMs, const SystemUsage& systemUsage,
+                            const std::vector<ProcessInfo>& processes) {
+    if (!file) {
+        return false;
+    }
+    TraceScope scope("JSON Lines write", "export");
+    const std::string& text = format(timestampMs, systemUsage, processes);
+    if (std::fwrite(text.data(), 1, text.size(), file) != text.size() || std::fflush(file) != 0) {
+        failedWrites++;
+        return false;
+    }
+    linesWritten++;
+    bytesWritten += text.size();
+    return true;
+}
+
+void JsonLinesWriter::appendEscaped(std::string& out, const std::string& text) {
+    static const char HEX[] = "0123456789abcdef";
+    for (char c : text) {
+        unsigned char byte = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (byte < 0x20) {
+            switch (c) {
+                case '\n': out += "\\n"; break;
+                case '\r': out += "\\r"; break;
+                case '\t': out += "\\t"; break;
+                default:
+                    out += "\\u00";
+                    out += HEX[byte >> 4];
+                    out += HEX[byte & 0x0F];
+                    break;
+            }
+        } else {
+            out += c;
+        }
+    }
+}
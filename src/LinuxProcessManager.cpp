@@ -0,0 +1,356 @@
+#include "../include/LinuxProcessManager.h"
+
+#ifdef __linux__
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <dirent.h>
+#include <unistd.h>
+
+namespace {
+
+// Parses the fields used from /proc/[pid]/stat; comm may contain spaces and parentheses
+bool parseStat(const char* data, std::string& name, DWORD& ppid, uint64_t& cpuTicks, uint64_t& startTime) {
+    const char* open = std::strchr(data, '(');
+    const char* close = std::strrchr(data, ')');
+    if (!open || !close || close < open) {
+        return false;
+    }
+    name.assign(open + 1, close);
+
+    // Field 3 (state) follows the closing parenthesis
+    const char* cursor = close + 1;
+    uint64_t utime = 0, stime = 0;
+    for (int field = 3; field <= 22 && *cursor; field++) {
+        while (*cursor == ' ') cursor++;
+        char* end = nullptr;
+        switch (field) {
+            case 4: ppid = static_cast<DWORD>(std::strtoul(cursor, &end, 10)); break;
+            case 14: utime = std::strtoull(cursor, &end, 10); break;
+            case 15: stime = std::strtoull(cursor, &end, 10); break;
+            case 22: startTime = std::strtoull(cursor, &end, 10); break;
+            default: break;
+        }
+        while (*cursor && *cursor != ' ') cursor++;
+    }
+    cpuTicks = utime + stime;
+    return true;
+}
+
+// Second field of /proc/[pid]/statm: resident pages
+bool parseStatm(const char* data, uint64_t& residentPages) {
+    char* end = nullptr;
+    std::strtoull(data, &end, 10);
+    if (end == data) {
+        return false;
+    }
+    residentPages = std::strtoull(end, nullptr, 10);
+    return true;
+}
+
+// read_bytes + write_bytes of /proc/[pid]/io
+bool parseIo(const char* data, uint64_t& ioBytes) {
+    const char* readBytes = std::strstr(data, "\nread_bytes:");
+    const char* writeBytes = std::strstr(data, "\nwrite_bytes:");
+    if (!readBytes || !writeBytes) {
+        return false;
+    }
+    ioBytes = std::strtoull(readBytes + 12, nullptr, 10) + std::strtoull(writeBytes + 13, nullptr, 10);
+    return true;
+}
+
+bool readSmallFile(const std::string& path, char* buffer, size_t size) {
+    FILE* file = std::fopen(path.c_str(), "r");
+    if (!file) {
+        return false;
+    }
+    size_t length = std::fread(buffer, 1, size - 1, file);
+    std::fclose(file);
+    buffer[length] = '\0';
+    return length > 0;
+}
+
+} // namespace
+
+// LinuxProcessManager implementation
+LinuxProcessManager::LinuxProcessManager(std::shared_ptr<ISystemMonitor> monitor, ProcReadEngine engine)
+    : systemMonitor(monitor), readEngine(engine) {
+    long systemPageSize = sysconf(_SC_PAGESIZE);
+    if (systemPageSize > 0) {
+        pageSize = systemPageSize;
+    }
+}
+
+LinuxProcessManager::~LinuxProcessManager() {
+    shutdown();
+}
+
+bool LinuxProcessManager::initialize() {
+    if (initialized) {
+        return true;
+    }
+
+    reader = ProcReaderFactory::create(readEngine);
+    if (!reader) {
+        return false;
+    }
+    lastSamples.clear();
+    systemTicksInitialized = false;
+    initialized = true;
+
+    // Baseline pass so the first real sample has deltas
+    getAllProcesses();
+    return true;
+}
+
+void LinuxProcessManager::shutdown() {
+    if (initialized) {
+        reader.reset();
+        lastSamples.clear();
+        burstSamples.clear();
+        systemTicksInitialized = false;
+        hasLastScanTime = false;
+        hasBurstBaseline = false;
+        initialized = false;
+    }
+}
+
+void LinuxProcessManager::setProcRoot(const std::string& root) {
+    if (root.empty() || root == procRoot) {
+        return;
+    }
+    // Counters of another procfs are not comparable with the previous pass
+    procRoot = root;
+    lastSamples.clear();
+    burstSamples.clear();
+    systemTicksInitialized = false;
+    hasLastScanTime = false;
+    hasBurstBaseline = false;
+}
+
+void LinuxProcessManager::listPids() {
+    pids.clear();
+    DIR* directory = opendir(procRoot.c_str());
+    if (!directory) {
+        return;
+    }
+    while (struct dirent* entry = readdir(directory)) {
+        char* end = nullptr;
+        unsigned long pid = std::strtoul(entry->d_name, &end, 10);
+        if (end != entry->d_name && *end == '\0') {
+            pids.push_back(static_cast<DWORD>(pid));
+        }
+    }
+    closedir(directory);
+}
+
+void LinuxProcessManager::buildPaths() {
+    // Three files per process, in PID order
+    paths.resize(pids.size() * FILES_PER_PROCESS);
+    pathPointers.resize(paths.size());
+    results.resize(paths.size());
+    static const char* const FILE_NAMES[FILES_PER_PROCESS] = { "/stat", "/statm", "/io" };
+    for (size_t i = 0; i < pids.size(); i++) {
+        for (size_t f = 0; f < FILES_PER_PROCESS; f++) {
+            std::string& path = paths[i * FILES_PER_PROCESS + f];
+            path.assign(procRoot).append("/").append(std::to_string(pids[i])).append(FILE_NAMES[f]);
+            pathPointers[i * FILES_PER_PROCESS + f] = path.c_str();
+        }
+    }
+}
+
+void LinuxProcessManager::replaceFailedReader() {
+    // A reader that failed mid-batch already served that batch; results of
+    // earlier batches have been consumed, so it can be swapped out here
+    if (!reader->isUsable()) {
+        reader = std::make_unique<PreadProcReader>();
+    }
+}
+
+bool LinuxProcessManager::readSystemTicks(uint64_t& ticks) const {
+    // First line of /proc/stat: "cpu  user nice system idle iowait irq softirq steal ..."
+    char buffer[512];
+    if (!readSmallFile(procRoot + "/stat", buffer, sizeof(buffer)) || std::strncmp(buffer, "cpu ", 4) != 0) {
+        return false;
+    }
+    ticks = 0;
+    const char* cursor = buffer + 4;
+    for (int field = 0; field < 8; field++) {
+        char* end = nullptr;
+        ticks += std::strtoull(cursor, &end, 10);
+        if (end == cursor) break;
+        cursor = end;
+    }
+    return true;
+}
+
+uint64_t LinuxProcessManager::readTotalMemory() const {
+    char buffer[256];
+    if (!readSmallFile(procRoot + "/meminfo", buffer, sizeof(buffer))) {
+        return 0;
+    }
+    const char* total = std::strstr(buffer, "MemTotal:");
+    return total ? std::strtoull(total + 9, nullptr, 10) * 1024 : 0;
+}
+
+std::vector<ProcessInfo> LinuxProcessManager::getAllProcesses() {
+    std::vector<ProcessInfo> processes;
+    if (!initialized && !initialize()) {
+        return processes;
+    }
+
+    uint64_t totalMemory = readTotalMemory();
+    uint64_t systemTicks = 0;
+    bool haveSystemTicks = readSystemTicks(systemTicks);
+    uint64_t systemTickDelta = haveSystemTicks && systemTicksInitialized && systemTicks > lastSystemTicks
+        ? systemTicks - lastSystemTicks : 0;
+    auto scanTime = std::chrono::steady_clock::now();
+    double elapsedSeconds = hasLastScanTime && scanTime > lastScanTime
+        ? std::chrono::duration<double>(scanTime - lastScanTime).count() : 1.0;
+
+    listPids();
+    buildPaths();
+
+    std::unordered_map<DWORD, ProcessSample> currentSamples;
+    currentSamples.reserve(pids.size());
+    processes.reserve(pids.size());
+
+    // Whole processes per batch; buffers are only valid until the next batch
+    size_t processesPerBatch = std::max<size_t>(1, reader->maxBatch() / FILES_PER_PROCESS);
+    for (size_t first = 0; first < pids.size(); first += processesPerBatch) {
+        size_t count = std::min(processesPerBatch, pids.size() - first);
+        size_t fileOffset = first * FILES_PER_PROCESS;
+        replaceFailedReader();
+        reader->readBatch(pathPointers.data() + fileOffset, count * FILES_PER_PROCESS, results.data() + fileOffset);
+
+        for (size_t i = first; i < first + count; i++) {
+            const ProcReadResult* files = &results[i * FILES_PER_PROCESS];
+            ProcessSample sample;
+            std::string name;
+            DWORD ppid = 0;
+            if (!files[0].data || !parseStat(files[0].data, name, ppid, sample.cpuTicks, sample.startTime)) {
+                continue;   // Process exited between listing and reading
+            }
+
+            ProcessInfo procInfo(pids[i], ppid, name);
+            procInfo.setStartTime(sample.startTime);
+            auto lastIt = lastSamples.find(pids[i]);
+            bool samePid = lastIt != lastSamples.end() && lastIt->second.startTime == sample.startTime;
+
+            // CPU share of all CPU time since the previous pass
+            if (samePid && systemTickDelta > 0 && sample.cpuTicks > lastIt->second.cpuTicks) {
+                double cpuPercent = 100.0 * (double)(sample.cpuTicks - lastIt->second.cpuTicks) / (double)systemTickDelta;
+                procInfo.setCpuPercent(cpuPercent > 100.0 ? 100.0 : cpuPercent);
+            }
+
+            uint64_t residentPages = 0;
+            if (files[1].data && totalMemory > 0 && parseStatm(files[1].data, residentPages)) {
+                procInfo.setRamPercent(100.0 * (double)(residentPages * pageSize) / (double)totalMemory);
+            }
+
+            // io is only readable for our own processes unless running privileged
+            if (files[2].data && parseIo(files[2].data, sample.ioBytes)) {
+                sample.hasIoBytes = true;
+                procInfo.setDiskIoBytes(sample.ioBytes);
+                if (samePid && lastIt->second.hasIoBytes && sample.ioBytes >= lastIt->second.ioBytes) {
+                    // Same scale as the Windows collector: MB/s against a 1 GB/s baseline, capped at 50%
+                    double ioMBperSec = (double)(sample.ioBytes - lastIt->second.ioBytes) / (1024.0 * 1024.0 * elapsedSeconds);
+                    double diskActivityPercent = (ioMBperSec / 1000.0) * 100.0;
+                    procInfo.setDiskPercent(diskActivityPercent > 50.0 ? 50.0 : diskActivityPercent);
+                }
+            }
+
+            currentSamples[pids[i]] = sample;
+            processes.push_back(procInfo);
+        }
+    }
+
+    lastSamples.swap(currentSamples);
+    lastScanTime = scanTime;
+    hasLastScanTime = true;
+    if (haveSystemTicks) {
+        lastSystemTicks = systemTicks;
+        systemTicksInitialized = true;
+    }
+    return processes;
+}
+
+std::vector<ProcessInfo> LinuxProcessManager::sampleProcesses(const std::vector<DWORD>& targetPids) {
+    std::vector<ProcessInfo> processes;
+    if (!initialized && !initialize()) {
+        return processes;
+    }
+
+    // Own tick and clock baselines, so burst samples do not shorten the next full pass
+    uint64_t totalMemory = readTotalMemory();
+    uint64_t systemTicks = 0;
+    bool haveSystemTicks = readSystemTicks(systemTicks);
+    uint64_t systemTickDelta = haveSystemTicks && hasBurstBaseline && systemTicks > lastBurstSystemTicks
+        ? systemTicks - lastBurstSystemTicks : 0;
+    auto sampleTime = std::chrono::steady_clock::now();
+    double elapsedSeconds = hasBurstBaseline && sampleTime > lastBurstTime
+        ? std::chrono::duration<double>(sampleTime - lastBurstTime).count() : 0.0;
+
+    // A handful of PIDs fits one batch
+    pids.assign(targetPids.begin(), targetPids.end());
+    if (pids.size() * FILES_PER_PROCESS > reader->maxBatch()) {
+        pids.resize(reader->maxBatch() / FILES_PER_PROCESS);
+    }
+    buildPaths();
+    replaceFailedReader();
+    reader->readBatch(pathPointers.data(), paths.size(), results.data());
+
+    std::unordered_map<DWORD, ProcessSample> currentSamples;
+    for (size_t i = 0; i < pids.size(); i++) {
+        const ProcReadResult* files = &results[i * FILES_PER_PROCESS];
+        ProcessSample sample;
+        std::string name;
+        DWORD ppid = 0;
+        if (!files[0].data || !parseStat(files[0].data, name, ppid, sample.cpuTicks, sample.startTime)) {
+            continue;   // Exited
+        }
+
+        ProcessInfo procInfo(pids[i], ppid, "");
+        auto lastIt = burstSamples.find(pids[i]);
+        bool samePid = lastIt != burstSamples.end() && lastIt->second.startTime == sample.startTime;
+        if (samePid && systemTickDelta > 0 && sample.cpuTicks > lastIt->second.cpuTicks) {
+            double cpuPercent = 100.0 * (double)(sample.cpuTicks - lastIt->second.cpuTicks) / (double)systemTickDelta;
+            procInfo.setCpuPercent(cpuPercent > 100.0 ? 100.0 : cpuPercent);
+        }
+
+        uint64_t residentPages = 0;
+        if (files[1].data && totalMemory > 0 && parseStatm(files[1].data, residentPages)) {
+            procInfo.setRamPercent(100.0 * (double)(residentPages * pageSize) / (double)totalMemory);
+        }
+
+        if (files[2].data && parseIo(files[2].data, sample.ioBytes)) {
+            sample.hasIoBytes = true;
+            procInfo.setDiskIoBytes(sample.ioBytes);
+            if (samePid && lastIt->second.hasIoBytes && elapsedSeconds > 0.0 && sample.ioBytes >= lastIt->second.ioBytes) {
+                double ioMBperSec = (double)(sample.ioBytes - lastIt->second.ioBytes) / (1024.0 * 1024.0 * elapsedSeconds);
+                double diskActivityPercent = (ioMBperSec / 1000.0) * 100.0;
+                procInfo.setDiskPercent(diskActivityPercent > 50.0 ? 50.0 : diskActivityPercent);
+            }
+        }
+
+        currentSamples[pids[i]] = sample;
+        processes.push_back(procInfo);
+    }
+
+    burstSamples.swap(currentSamples);
+    lastBurstTime = sampleTime;
+    if (haveSystemTicks) {
+        lastBurstSystemTicks = systemTicks;
+        hasBurstBaseline = true;
+    }
+    return processes;
+}
+
+std::vector<ProcessInfo> LinuxProcessManager::getAggregatedProcessTree(const std::vector<ProcessInfo>& processes) {
+    ProcessTreeAggregator aggregator;
+    return aggregator.aggregate(processes);
+}
+
+#endif
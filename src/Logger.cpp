@@ -1,4 +1,5 @@
 #include "../include/Logger.h"
+#include "../include/TraceRecorder.h"
 #include <fstream>
 #include <iostream>
 #include <chrono>
@@ -38,6 +39,12 @@ void LoggerManager::logProcesses(const std::vector<ProcessInfo>& processes, cons
     }
 }
 
+void LoggerManager::logReport(const std::string& report) {
+    if (logger) {
+        logger->logReport(report);
+    }
+}
+
 bool LoggerManager::rotateIfNeeded() {
     if (logger) {
         return logger->rotateIfNeeded();
@@ -58,6 +65,13 @@ size_t LoggerManager::getQueueSize() const {
     return 0;
 }
 
+uint64_t LoggerManager::getDroppedCount() const {
+    if (logger) {
+        return logger->getDroppedCount();
+    }
+    return 0;
+}
+
 // AsyncFileLogger implementation
 AsyncFileLogger::AsyncFileLogger(const LogConfig& logConfig) : config(logConfig) {}
 
@@ -128,6 +142,7 @@ void AsyncFileLogger::debug(const std::string& message) {
         messageQueue.push(LogMessage(LogMessageType::DEBUG, message));
     } else if (running) {
         // Queue is full, log to console as fallback
+        droppedMessages++;
         std::cout << "[DEBUG] (Queue full) " << message << std::endl;
     }
 }
@@ -137,10 +152,21 @@ void AsyncFileLogger::logProcesses(const std::vector<ProcessInfo>& processes, co
         messageQueue.push(LogMessage(processes, systemUsage));
     } else if (running) {
         // Queue is full, log to console as fallback
+        droppedMessages++;
         std::cout << "[LOG] (Queue full) Process logging skipped. Queue size: " << messageQueue.size() << std::endl;
     }
 }
 
+void AsyncFileLogger::logReport(const std::string& report) {
+    if (running && messageQueue.size() < config.getQueueMaxSize()) {
+        messageQueue.push(LogMessage(LogMessageType::REPORT, report));
+    } else if (running) {
+        // Queue is full, log to console as fallback
+        droppedMessages++;
+        std::cout << "[LOG] (Queue full) Report skipped. Queue size: " << messageQueue.size() << std::endl;
+    }
+}
+
 bool AsyncFileLogger::rotateIfNeeded() {
     // For async logger, rotation is handled by worker thread
     return true;
@@ -148,6 +174,7 @@ bool AsyncFileLogger::rotateIfNeeded() {
 
 void AsyncFileLogger::workerThreadFunction() {
     std::cout << "Logger worker thread started." << std::endl;
+    TraceRecorder::instance().setThreadName("Logger worker");
     
     LogMessage message;
     while (running) {
@@ -182,18 +209,37 @@ void AsyncFileLogger::workerThreadFunction() {
 
 void AsyncFileLogger::processLogMessage(const LogMessage& message) {
     switch (message.type) {
-        case LogMessageType::DEBUG:
+        case LogMessageType::DEBUG: {
+            TraceScope trace("Log debug write", "logger");
             writeDebugMessage(message.content);
             break;
+        }
             
         case LogMessageType::PROCESS_INFO:
             // Check if rotation is needed before writing
             if (checkRotationNeeded()) {
+                TraceScope rotationTrace("Log rotation", "logger");
                 if (!performRotation()) {
                     std::cerr << "Warning: Log rotation failed, continuing with current log file." << std::endl;
                 }
             }
-            writeProcessMessage(message.processes, message.systemUsage);
+            {
+                TraceScope trace("Log process write", "logger");
+                writeProcessMessage(message.processes, message.systemUsage);
+            }
+            break;
+            
+        case LogMessageType::REPORT:
+            if (checkRotationNeeded()) {
+                TraceScope rotationTrace("Log rotation", "logger");
+                if (!performRotation()) {
+                    std::cerr << "Warning: Log rotation failed, continuing with current log file." << std::endl;
+                }
+            }
+            {
+                TraceScope trace("Log report write", "logger");
+                writeReportMessage(message.content);
+            }
             break;
             
         default:
@@ -216,6 +262,16 @@ void AsyncFileLogger::writeDebugMessage(const std::string& content) {
     std::cout << "[DEBUG] " << content << std::endl;
 }
 
+void AsyncFileLogger::writeReportMessage(const std::string& report) {
+    std::ofstream log(config.getLogPath(), std::ios::app);
+    if (!log.is_open()) {
+        std::cerr << "Error: Could not open log file for writing: " << config.getLogPath() << std::endl;
+        return;
+    }
+    log << report << "\n";
+    log.flush();
+}
+
 void AsyncFileLogger::writeProcessMessage(const std::vector<ProcessInfo>& processes, const SystemUsage& systemUsage) {
     std::ofstream log(config.getLogPath(), std::ios::app);
     if (!log.is_open()) {
@@ -223,7 +279,35 @@ void AsyncFileLogger::writeProcessMessage(const std::vector<ProcessInfo>& proces
         return;
     }
     
-    std::string formattedTime = getCurrentTimeString();
+    log << formatProcessBlock(processes, systemUsage, getCurrentTimeString());
+    log.flush();
+    
+    if (!processes.empty()) {
+        if (!g_suppressConsoleOutput) {
+            double totalProcessRam = 0.0;
+            for (const auto& process : processes) {
+                totalProcessRam += process.getRamPercent();
+            }
+            double unaccountedRam = systemUsage.getRamPercent() - totalProcessRam;
+            if (unaccountedRam < 0) unaccountedRam = 0.0;
+            
+            std::cout << "System thresholds exceeded - Logged " << processes.size() 
+                      << " active processes to " << config.getLogPath() 
+                      << " (Processes: " << std::fixed << std::setprecision(1) << totalProcessRam 
+                      << "% + System: " << std::fixed << std::setprecision(1) << unaccountedRam 
+                      << "% = Total: " << std::fixed << std::setprecision(1) << systemUsage.getRamPercent() 
+                      << "% RAM)" << std::endl;
+        }
+    } else {
+        if (!g_suppressConsoleOutput) {
+            std::cout << "System thresholds exceeded but no active processes found" << std::endl;
+        }
+    }
+}
+
+std::string AsyncFileLogger::formatProcessBlock(const std::vector<ProcessInfo>& processes, const SystemUsage& systemUsage,
+                                                const std::string& formattedTime) {
+    std::ostringstream log;
     
     // Calculate process usage totals
     double totalProcessCpu = 0.0;
@@ -262,7 +346,6 @@ void AsyncFileLogger::writeProcessMessage(const std::vector<ProcessInfo>& proces
         << "% + System/Kernel=" << std::fixed << std::setprecision(2) << unaccountedDisk 
         << "% = Total=" << std::fixed << std::setprecision(2) << systemUsage.getDiskPercent() << "%\n";
     
-    int processCount = 0;
     for (const auto& process : processes) {
         // Log all processes in the filtered list (filtering is done before calling this function)
         log << formattedTime << ", " 
@@ -272,7 +355,6 @@ void AsyncFileLogger::writeProcessMessage(const std::vector<ProcessInfo>& proces
             << "%] [RAM " << std::fixed << std::setprecision(2) << process.getRamPercent()
             << "%] [Disk " << std::fixed << std::setprecision(2) << process.getDiskPercent() 
             << "%]\n";
-        processCount++;
     }
     
     // Write resource totals for operator analysis
@@ -293,22 +375,7 @@ void AsyncFileLogger::writeProcessMessage(const std::vector<ProcessInfo>& proces
         << "%] [System Disk " << std::fixed << std::setprecision(2) << systemUsage.getDiskPercent() 
         << "%]===\n\n";
     
-    log.flush();
-    
-    if (processCount > 0) {
-        if (!g_suppressConsoleOutput) {
-            std::cout << "System thresholds exceeded - Logged " << processCount 
-                      << " active processes to " << config.getLogPath() 
-                      << " (Processes: " << std::fixed << std::setprecision(1) << totalProcessRam 
-                      << "% + System: " << std::fixed << std::setprecision(1) << unaccountedRam 
-                      << "% = Total: " << std::fixed << std::setprecision(1) << systemUsage.getRamPercent() 
-                      << "% RAM)" << std::endl;
-        }
-    } else {
-        if (!g_suppressConsoleOutput) {
-            std::cout << "System thresholds exceeded but no active processes found" << std::endl;
-        }
-    }
+    return log.str();
 }
 
 std::string AsyncFileLogger::getCurrentTimeString() const {
@@ -0,0 +1,290 @@
+#include "../include/MetricStore.h"
+#include <algorithm>
+
+namespace {
+
+const uint32_t SECONDS_PER_MINUTE = 60;
+const uint32_t SECONDS_PER_HOUR = 3600;
+
+// Approximate heap cost of one unordered_map entry (node plus bucket pointer)
+const size_t INDEX_ENTRY_BYTES = 48;
+
+uint32_t secondsPerBucket(MetricStore::Resolution resolution) {
+    switch (resolution) {
+        case MetricStore::Resolution::MINUTE: return SECONDS_PER_MINUTE;
+        case MetricStore::Resolution::HOUR: return SECONDS_PER_HOUR;
+        default: return 1;
+    }
+}
+
+template<typename Slot>
+size_t ringBytes(const std::vector<Slot>& ring) {
+    return ring.capacity() * sizeof(Slot);
+}
+
+} // namespace
+
+// Series implementation
+void MetricStore::Series::allocate(const Capacity& capacity) {
+    seconds.assign(capacity.seconds, SecondSlot());
+    minutes.assign(capacity.minutes, RollupSlot());
+    hours.assign(capacity.hours, RollupSlot());
+    lastSecond = EMPTY_BUCKET;
+}
+
+void MetricStore::Series::clear() {
+    std::fill(seconds.begin(), seconds.end(), SecondSlot());
+    std::fill(minutes.begin(), minutes.end(), RollupSlot());
+    std::fill(hours.begin(), hours.end(), RollupSlot());
+    lastSecond = EMPTY_BUCKET;
+}
+
+void MetricStore::Series::add(uint32_t second, const float values[METRIC_COUNT]) {
+    if (seconds.empty()) {
+        return;
+    }
+
+    // Raw second: the latest sample of the second wins; older data in the slot is overwritten
+    SecondSlot& raw = seconds[second % seconds.size()];
+    if (raw.bucket == EMPTY_BUCKET || raw.bucket <= second) {
+        raw.bucket = second;
+        std::copy(values, values + METRIC_COUNT, raw.value);
+    }
+    if (lastSecond == EMPTY_BUCKET || second > lastSecond) {
+        lastSecond = second;
+    }
+
+    // Rollups: a slot still holding an older bucket starts over; a sample older than the slot is dropped
+    auto roll = [values](std::vector<RollupSlot>& ring, uint32_t bucket) {
+        RollupSlot& slot = ring[bucket % ring.size()];
+        if (slot.bucket != EMPTY_BUCKET && slot.bucket > bucket) {
+            return;
+        }
+        if (slot.bucket != bucket) {
+            slot.bucket = bucket;
+            slot.count = 0;
+        }
+        slot.count++;
+        for (size_t m = 0; m < METRIC_COUNT; m++) {
+            if (slot.count == 1) {
+                slot.min[m] = slot.avg[m] = slot.max[m] = values[m];
+            } else {
+                slot.min[m] = std::min(slot.min[m], values[m]);
+                slot.max[m] = std::max(slot.max[m], values[m]);
+                slot.avg[m] += (values[m] - slot.avg[m]) / static_cast<float>(slot.count);
+            }
+        }
+    };
+    roll(minutes, second / SECONDS_PER_MINUTE);
+    roll(hours, second / SECONDS_PER_HOUR);
+}
+
+void MetricStore::Series::query(Resolution resolution, int64_t fromMs, int64_t toMs, std::vector<Point>& out) const {
+    size_t ringSize = resolution == Resolution::SECOND ? seconds.size()
+                    : resolution == Resolution::MINUTE ? minutes.size() : hours.size();
+    if (lastSecond == EMPTY_BUCKET || ringSize == 0 || toMs < fromMs || toMs < 0) {
+        return;
+    }
+
+    // Walk the bucket range the ring can still hold
+    uint32_t span = secondsPerBucket(resolution);
+    int64_t newest = std::min<int64_t>(toMs / 1000 / span, lastSecond / span);
+    int64_t oldest = std::max<int64_t>(std::max<int64_t>(fromMs, 0) / 1000 / span, newest - (int64_t)ringSize + 1);
+    for (int64_t bucket = oldest; bucket <= newest; bucket++) {
+        Point point;
+        point.timestampMs = bucket * span * 1000;
+        if (resolution == Resolution::SECOND) {
+            const SecondSlot& slot = seconds[static_cast<size_t>(bucket) % ringSize];
+            if (slot.bucket != static_cast<uint32_t>(bucket)) {
+                continue;
+            }
+            point.count = 1;
+            std::copy(slot.value, slot.value + METRIC_COUNT, point.min);
+            std::copy(slot.value, slot.value + METRIC_COUNT, point.avg);
+            std::copy(slot.value, slot.value + METRIC_COUNT, point.max);
+        } else {
+            const std::vector<RollupSlot>& ring = resolution == Resolution::MINUTE ? minutes : hours;
+            const RollupSlot& slot = ring[static_cast<size_t>(bucket) % ringSize];
+            if (slot.bucket != static_cast<uint32_t>(bucket)) {
+                continue;
+            }
+            point.count = slot.count;
+            std::copy(slot.min, slot.min + METRIC_COUNT, point.min);
+            std::copy(slot.avg, slot.avg + METRIC_COUNT, point.avg);
+            std::copy(slot.max, slot.max + METRIC_COUNT, point.max);
+        }
+        out.push_back(point);
+    }
+}
+
+// MetricStore implementation
+MetricStore::MetricStore() {
+    systemSeries.allocate(SYSTEM_CAPACITY);
+}
+
+void MetricStore::unlink(uint32_t index) {
+    ProcessSeries& entry = processSeries[index];
+    if (entry.previous != NO_SERIES) {
+        processSeries[entry.previous].next = entry.next;
+    } else {
+        mostRecent = entry.next;
+    }
+    if (entry.next != NO_SERIES) {
+        processSeries[entry.next].previous = entry.previous;
+    } else {
+        leastRecent = entry.previous;
+    }
+    entry.previous = entry.next = NO_SERIES;
+}
+
+void MetricStore::linkMostRecent(uint32_t index) {
+    ProcessSeries& entry = processSeries[index];
+    entry.previous = NO_SERIES;
+    entry.next = mostRecent;
+    if (mostRecent != NO_SERIES) {
+        processSeries[mostRecent].previous = index;
+    }
+    mostRecent = index;
+    if (leastRecent == NO_SERIES) {
+        leastRecent = index;
+    }
+}
+
+uint32_t MetricStore::acquireSeries(const ProcessKey& key) {
+    uint32_t index;
+    if (processSeries.size() < maxProcessSeries) {
+        index = static_cast<uint32_t>(processSeries.size());
+        processSeries.emplace_back();
+        processSeries[index].series.allocate(PROCESS_CAPACITY);
+    } else {
+        // Reuse the rings of the least recently updated series
+        index = leastRecent;
+        unlink(index);
+        processIndex.erase(processSeries[index].key);
+        processSeries[index].series.clear();
+        evictedCount++;
+    }
+    processSeries[index].key = key;
+    processIndex[key] = index;
+    linkMostRecent(index);
+    return index;
+}
+
+void MetricStore::setMaxProcessSeries(size_t count) {
+    if (count >= processSeries.size()) {
+        maxProcessSeries = count;
+        return;
+    }
+
+    // Keep the most recent series, renumbered from the front of the pool
+    std::vector<ProcessSeries> kept;
+    kept.reserve(count);
+    for (uint32_t index = mostRecent; index != NO_SERIES && kept.size() < count; index = processSeries[index].next) {
+        kept.push_back(std::move(processSeries[index]));
+    }
+    evictedCount += processIndex.size() - kept.size();
+    processSeries.swap(kept);
+    processSeries.shrink_to_fit();
+    processIndex.clear();
+    mostRecent = leastRecent = NO_SERIES;
+    for (uint32_t index = static_cast<uint32_t>(processSeries.size()); index-- > 0;) {
+        processIndex[processSeries[index].key] = index;
+        linkMostRecent(index);
+    }
+    maxProcessSeries = count;
+}
+
+void MetricStore::recordSystem(int64_t timestampMs, const SystemUsage& systemUsage) {
+    if (timestampMs < 0) {
+        return;
+    }
+    const float values[METRIC_COUNT] = {
+        static_cast<float>(systemUsage.getCpuPercent()),
+        static_cast<float>(systemUsage.getRamPercent()),
+        static_cast<float>(systemUsage.getDiskPercent())
+    };
+    systemSeries.add(static_cast<uint32_t>(timestampMs / 1000), values);
+}
+
+void MetricStore::recordProcesses(int64_t timestampMs, const std::vector<ProcessInfo>& processes) {
+    if (timestampMs < 0 || maxProcessSeries == 0) {
+        return;
+    }
+    uint32_t second = static_cast<uint32_t>(timestampMs / 1000);
+    for (const auto& process : processes) {
+        ProcessKey key = { process.getPid(), process.getStartTime() };
+        uint32_t index;
+        auto found = processIndex.find(key);
+        if (found != processIndex.end()) {
+            index = found->second;
+            if (index != mostRecent) {
+                unlink(index);
+                linkMostRecent(index);
+            }
+        } else {
+            index = acquireSeries(key);
+        }
+        const float values[METRIC_COUNT] = {
+            static_cast<float>(process.getCpuPercent()),
+            static_cast<float>(process.getRamPercent()),
+            static_cast<float>(process.getDiskPercent())
+        };
+        processSeries[index].series.add(second, values);
+    }
+}
+
+std::vector<MetricStore::Point> MetricStore::querySystem(Resolution resolution, int64_t fromMs, int64_t toMs) const {
+    std::vector<Point> points;
+    systemSeries.query(resolution, fromMs, toMs, points);
+    return points;
+}
+
+std::vector<MetricStore::Point> MetricStore::queryProcess(DWORD pid, ULONGLONG startTime, Resolution resolution,
+                                                          int64_t fromMs, int64_t toMs) const {
+    std::vector<Point> points;
+    auto found = processIndex.find(ProcessKey{ pid, startTime });
+    if (found != processIndex.end()) {
+        processSeries[found->second].series.query(resolution, fromMs, toMs, points);
+    }
+    return points;
+}
+
+MetricStore::Point MetricStore::summarize(const std::vector<Point>& points) {
+    Point summary;
+    double sums[METRIC_COUNT] = {};
+    for (const auto& point : points) {
+        for (size_t m = 0; m < METRIC_COUNT; m++) {
+            summary.min[m] = summary.count == 0 ? point.min[m] : std::min(summary.min[m], point.min[m]);
+            summary.max[m] = summary.count == 0 ? point.max[m] : std::max(summary.max[m], point.max[m]);
+            sums[m] += static_cast<double>(point.avg[m]) * point.count;
+        }
+        summary.count += point.count;
+    }
+    if (!points.empty()) {
+        summary.timestampMs = points.front().timestampMs;
+    }
+    for (size_t m = 0; m < METRIC_COUNT && summary.count > 0; m++) {
+        summary.avg[m] = static_cast<float>(sums[m] / summary.count);
+    }
+    return summary;
+}
+
+size_t MetricStore::getMemoryBytes() const {
+    size_t bytes = sizeof(MetricStore) + ringBytes(systemSeries.seconds) + ringBytes(systemSeries.minutes) +
+                   ringBytes(systemSeries.hours);
+    bytes += processSeries.capacity() * sizeof(ProcessSeries);
+    for (const auto& entry : processSeries) {
+        bytes += ringBytes(entry.series.seconds) + ringBytes(entry.series.minutes) + ringBytes(entry.series.hours);
+    }
+    bytes += processIndex.size() * INDEX_ENTRY_BYTES + processIndex.bucket_count() * sizeof(void*);
+    return bytes;
+}
+
+size_t MetricStore::estimateMemoryBytes(size_t processSeriesCount) {
+    size_t systemBytes = SYSTEM_CAPACITY.seconds * sizeof(SecondSlot) +
+                         (SYSTEM_CAPACITY.minutes + SYSTEM_CAPACITY.hours) * sizeof(RollupSlot);
+    size_t perProcess = sizeof(ProcessSeries) + INDEX_ENTRY_BYTES + sizeof(void*) +
+                        PROCESS_CAPACITY.seconds * sizeof(SecondSlot) +
+                        (PROCESS_CAPACITY.minutes + PROCESS_CAPACITY.hours) * sizeof(RollupSlot);
+    return sizeof(MetricStore) + systemBytes + processSeriesCount * perProcess;
+}
@@ -0,0 +1,369 @@
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+// Winsock 2 has to come before windows.h (pulled in by SystemMetrics.h)
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+#include "../include/MetricsExporter.h"
+#include "../include/TraceRecorder.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+#ifdef _WIN32
+typedef SOCKET NativeSocket;
+typedef WSAPOLLFD PollEntry;
+const NativeSocket NO_SOCKET = INVALID_SOCKET;
+
+int pollSockets(PollEntry* entries, size_t count, int timeoutMs) {
+    return WSAPoll(entries, static_cast<ULONG>(count), timeoutMs);
+}
+
+void closeSocket(NativeSocket socket) {
+    closesocket(socket);
+}
+
+bool setNonBlocking(NativeSocket socket) {
+    u_long enabled = 1;
+    return ioctlsocket(socket, FIONBIO, &enabled) == 0;
+}
+
+bool wouldBlock() {
+    return WSAGetLastError() == WSAEWOULDBLOCK;
+}
+
+int sendBytes(NativeSocket socket, const char* data, size_t length) {
+    return send(socket, data, static_cast<int>(length), 0);
+}
+#else
+typedef int NativeSocket;
+typedef pollfd PollEntry;
+const NativeSocket NO_SOCKET = -1;
+
+int pollSockets(PollEntry* entries, size_t count, int timeoutMs) {
+    return poll(entries, static_cast<nfds_t>(count), timeoutMs);
+}
+
+void closeSocket(NativeSocket socket) {
+    close(socket);
+}
+
+bool setNonBlocking(NativeSocket socket) {
+    int flags = fcntl(socket, F_GETFL, 0);
+    return flags >= 0 && fcntl(socket, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+bool wouldBlock() {
+    return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+}
+
+int sendBytes(NativeSocket socket, const char* data, size_t length) {
+    // A scraper that hung up must not raise SIGPIPE
+    return static_cast<int>(send(socket, data, length, MSG_NOSIGNAL));
+}
+#endif
+
+NativeSocket native(intptr_t socket) {
+    return static_cast<NativeSocket>(socket);
+}
+
+std::shared_ptr<const std::string> makeResponse(const char* status, const char* contentType, const std::string& body) {
+    std::string response = std::string("HTTP/1.1 ") + status + "\r\nContent-Type: " + contentType +
+                           "\r\nContent-Length: " + std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n";
+    response += body;
+    return std::make_shared<const std::string>(std::move(response));
+}
+
+// Label values escape backslash, double quote and newline
+void appendLabel(std::string& out, const std::string& value) {
+    for (char c : value) {
+        if (c == '\\' || c == '"') {
+            out.push_back('\\');
+            out.push_back(c);
+        } else if (c == '\n') {
+            out += "\\n";
+        } else {
+            out.push_back(c);
+        }
+    }
+}
+
+void appendNumber(std::string& out, double value) {
+    char text[32];
+    snprintf(text, sizeof(text), "%.2f", value);
+    out += text;
+}
+
+void appendHeader(std::string& out, const char* name, const char* help) {
+    out += "# HELP ";
+    out += name;
+    out += ' ';
+    out += help;
+    out += "\n# TYPE ";
+    out += name;
+    out += " gauge\n";
+}
+
+} // namespace
+
+MetricsExporter::~MetricsExporter() {
+    stop();
+}
+
+bool MetricsExporter::start(uint16_t requestedPort) {
+    if (running) {
+        return false;
+    }
+#ifdef _WIN32
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+        return false;
+    }
+#endif
+    NativeSocket listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (listener == NO_SOCKET) {
+#ifdef _WIN32
+        WSACleanup();
+#endif
+        return false;
+    }
+#ifndef _WIN32
+    int reuse = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+#endif
+
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(requestedPort);
+    socklen_t addressLength = sizeof(address);
+    if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listener, SOMAXCONN) != 0 || !setNonBlocking(listener) ||
+        getsockname(listener, reinterpret_cast<sockaddr*>(&address), &addressLength) != 0) {
+        closeSocket(listener);
+#ifdef _WIN32
+        WSACleanup();
+#endif
+        return false;
+    }
+
+    listenSocket = static_cast<intptr_t>(listener);
+    port = ntohs(address.sin_port);
+    running = true;
+    worker = std::thread(&MetricsExporter::serverThreadFunction, this);
+    return true;
+}
+
+void MetricsExporter::stop() {
+    if (!running) {
+        return;
+    }
+    running = false;
+    if (worker.joinable()) {
+        worker.join();
+    }
+    closeSocket(native(listenSocket));
+    listenSocket = -1;
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+void MetricsExporter::publish(const std::string& exposition) {
+    std::shared_ptr<const std::string> response =
+        makeResponse("200 OK", "text/plain; version=0.0.4; charset=utf-8", exposition);
+    std::lock_guard<std::mutex> lock(responseMutex);
+    metricsResponse = std::move(response);
+}
+
+std::shared_ptr<const std::string> MetricsExporter::respond(const std::string& request) {
+    size_t lineEnd = request.find("\r\n");
+    std::string requestLine = request.substr(0, lineEnd);
+    if (requestLine.compare(0, 4, "GET ") != 0) {
+        return makeResponse("405 Method Not Allowed", "text/plain", "Only GET is supported\n");
+    }
+    size_t pathEnd = requestLine.find(' ', 4);
+    std::string path = requestLine.substr(4, pathEnd == std::string::npos ? std::string::npos : pathEnd - 4);
+    if (path == "/metrics" || path.compare(0, 9, "/metrics?") == 0) {
+        std::lock_guard<std::mutex> lock(responseMutex);
+        if (metricsResponse) {
+            scrapeCount++;
+            return metricsResponse;
+        }
+        return makeResponse("503 Service Unavailable", "text/plain", "No sample collected yet\n");
+    }
+    if (path == "/") {
+        return makeResponse("200 OK", "text/html", "<html><body><a href=\"/metrics\">SystemMonitor metrics</a></body></html>\n");
+    }
+    return makeResponse("404 Not Found", "text/plain", "Not found\n");
+}
+
+void MetricsExporter::serverThreadFunction() {
+    TraceRecorder::instance().setThreadName("Metrics server");
+    std::vector<Client> clients;
+    std::vector<PollEntry> entries;
+
+    while (running) {
+        // Listener first, then one entry per client: reading the request or writing the response
+        entries.clear();
+        PollEntry entry;
+        std::memset(&entry, 0, sizeof(entry));
+        entry.fd = native(listenSocket);
+        entry.events = POLLIN;
+        entries.push_back(entry);
+        for (const auto& client : clients) {
+            entry.fd = native(client.socket);
+            entry.events = client.response ? POLLOUT : POLLIN;
+            entries.push_back(entry);
+        }
+        if (pollSockets(entries.data(), entries.size(), POLL_INTERVAL_MS) < 0) {
+            continue;
+        }
+
+        // Serve the connected clients
+        Clock::time_point now = Clock::now();
+        for (size_t i = 0; i < clients.size(); i++) {
+            Client& client = clients[i];
+            short revents = entries[i + 1].revents;
+            bool done = false;
+            if (revents & (POLLERR | POLLNVAL)) {
+                done = true;
+            } else if (!client.response && (revents & (POLLIN | POLLHUP))) {
+                char buffer[2048];
+                int received = static_cast<int>(recv(native(client.socket), buffer, sizeof(buffer), 0));
+                if (received > 0) {
+                    client.request.append(buffer, static_cast<size_t>(received));
+                    if (client.request.find("\r\n\r\n") != std::string::npos) {
+                        client.response = respond(client.request);
+                    } else if (client.request.size() > MAX_REQUEST_BYTES) {
+                        rejectedCount++;
+                        done = true;
+                    }
+                } else if (received == 0 || !wouldBlock()) {
+                    done = true;
+                }
+            }
+            if (!done && client.response && (revents & POLLOUT)) {
+                int sent = sendBytes(native(client.socket), client.response->data() + client.sent,
+                                     client.response->size() - client.sent);
+                if (sent > 0) {
+                    client.sent += static_cast<size_t>(sent);
+                    done = client.sent == client.response->size();
+                } else if (!wouldBlock()) {
+                    done = true;
+                }
+            }
+            if (!done && now - client.accepted > std::chrono::milliseconds(CLIENT_TIMEOUT_MS)) {
+                rejectedCount++;
+                done = true;
+            }
+            if (done) {
+                closeSocket(native(client.socket));
+                clients[i] = std::move(clients.back());
+                entries[i + 1] = entries.back();
+                clients.pop_back();
+                entries.pop_back();
+                i--;
+            }
+        }
+
+        // Accept every pending connection
+        if (entries[0].revents & POLLIN) {
+            while (true) {
+                NativeSocket accepted = accept(native(listenSocket), nullptr, nullptr);
+                if (accepted == NO_SOCKET) {
+                    break;
+                }
+                if (clients.size() >= MAX_CLIENTS || !setNonBlocking(accepted)) {
+                    closeSocket(accepted);
+                    rejectedCount++;
+                    continue;
+                }
+                Client client;
+                client.socket = static_cast<intptr_t>(accepted);
+                client.accepted = now;
+                clients.push_back(std::move(client));
+            }
+        }
+    }
+
+    for (const auto& client : clients) {
+        closeSocket(native(client.socket));
+    }
+}
+
+std::string MetricsExporter::render(int64_t timestampMs, const SystemUsage& systemUsage,
+                                    const std::vector<ProcessInfo>& processes, size_t topProcesses) {
+    std::string out;
+    out.reserve(512 + std::min(processes.size(), topProcesses) * 3 * 96);
+
+    appendHeader(out, "systemmonitor_cpu_percent", "System CPU usage in percent.");
+    out += "systemmonitor_cpu_percent ";
+    appendNumber(out, systemUsage.getCpuPercent());
+    out += '\n';
+    appendHeader(out, "systemmonitor_ram_percent", "System memory usage in percent.");
+    out += "systemmonitor_ram_percent ";
+    appendNumber(out, systemUsage.getRamPercent());
+    out += '\n';
+    appendHeader(out, "systemmonitor_disk_percent", "System disk activity in percent.");
+    out += "systemmonitor_disk_percent ";
+    appendNumber(out, systemUsage.getDiskPercent());
+    out += '\n';
+    appendHeader(out, "systemmonitor_processes", "Processes seen in the last sample.");
+    out += "systemmonitor_processes " + std::to_string(processes.size()) + "\n";
+    appendHeader(out, "systemmonitor_last_sample_timestamp_seconds", "Wall clock time of the last sample.");
+    out += "systemmonitor_last_sample_timestamp_seconds " + std::to_string(timestampMs / 1000) + "\n";
+
+    // Heaviest processes first, one family per metric
+    std::vector<const ProcessInfo*> top;
+    top.reserve(processes.size());
+    for (const auto& process : processes) {
+        top.push_back(&process);
+    }
+    size_t keep = std::min(top.size(), topProcesses);
+    std::partial_sort(top.begin(), top.begin() + static_cast<std::ptrdiff_t>(keep), top.end(),
+                      [](const ProcessInfo* a, const ProcessInfo* b) {
+                          return a->getCpuPercent() + a->getRamPercent() + a->getDiskPercent() >
+                                 b->getCpuPercent() + b->getRamPercent() + b->getDiskPercent();
+                      });
+    top.resize(keep);
+
+    struct Family {
+        const char* name;
+        const char* help;
+        double (ProcessInfo::*value)() const;
+    };
+    const Family families[] = {
+        { "systemmonitor_process_cpu_percent", "Process CPU usage in percent of the machine.", &ProcessInfo::getCpuPercent },
+        { "systemmonitor_process_ram_percent", "Process memory usage in percent of physical memory.", &ProcessInfo::getRamPercent },
+        { "systemmonitor_process_disk_percent", "Process disk activity in percent.", &ProcessInfo::getDiskPercent }
+    };
+    for (const auto& family : families) {
+        if (top.empty()) {
+            break;
+        }
+        appendHeader(out, family.name, family.help);
+        for (const ProcessInfo* process : top) {
+            out += family.name;
+            out += "{pid=\"" + std::to_string(process->getPid()) + "\",name=\"";
+            appendLabel(out, process->getName());
+            out += "\"} ";
+            appendNumber(out, (process->*family.value)());
+            out += '\n';
+        }
+    }
+    return out;
+}
@@ -0,0 +1,403 @@
+#include "../include/ProcReader.h"
+
+#ifdef __linux__
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define SYSTEMMONITOR_HAVE_IO_URING 1
+#endif
+
+// IProcReader implementation
+void IProcReader::preadFile(const char* path, size_t index, ProcReadResult& result) {
+    result = ProcReadResult();
+    syscallCount++;
+    int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        result.length = -errno;
+        return;
+    }
+
+    char* buffer = slot(index);
+    syscallCount++;
+    ssize_t length = ::pread(fd, buffer, SLOT_SIZE - 1, 0);
+    result.length = length < 0 ? -errno : static_cast<int>(length);
+    if (length >= 0) {
+        buffer[length] = '\0';
+        result.data = buffer;
+    }
+
+    syscallCount++;
+    ::close(fd);
+}
+
+// PreadProcReader implementation
+PreadProcReader::PreadProcReader() {
+    buffers.resize(BATCH_SIZE * SLOT_SIZE);
+}
+
+void PreadProcReader::readBatch(const char* const* paths, size_t count, ProcReadResult* results) {
+    for (size_t i = 0; i < count && i < BATCH_SIZE; i++) {
+        preadFile(paths[i], i, results[i]);
+    }
+}
+
+#ifdef SYSTEMMONITOR_HAVE_IO_URING
+
+// Mapped submission and completion rings
+struct UringProcReader::Ring {
+    int fd = -1;
+    void* sqMap = MAP_FAILED;
+    size_t sqMapSize = 0;
+    void* cqMap = MAP_FAILED;
+    size_t cqMapSize = 0;
+    io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+    size_t sqesSize = 0;
+
+    unsigned* sqHead = nullptr;
+    unsigned* sqTail = nullptr;
+    unsigned* sqArray = nullptr;
+    unsigned sqMask = 0;
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    io_uring_cqe* cqes = nullptr;
+    unsigned cqMask = 0;
+    unsigned pendingTail = 0;          // Prepared but not yet published entries end here
+
+    ~Ring() {
+        if (sqes != MAP_FAILED) munmap(sqes, sqesSize);
+        if (cqMap != MAP_FAILED && cqMap != sqMap) munmap(cqMap, cqMapSize);
+        if (sqMap != MAP_FAILED) munmap(sqMap, sqMapSize);
+        if (fd >= 0) close(fd);
+    }
+
+    io_uring_sqe* nextSqe(uint64_t userData) {
+        unsigned index = pendingTail & sqMask;
+        io_uring_sqe* sqe = &sqes[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqe->user_data = userData;
+        sqArray[index] = index;
+        pendingTail++;
+        return sqe;
+    }
+};
+
+namespace {
+
+int uringSetup(unsigned entries, io_uring_params* params) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int uringEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+int uringRegister(int fd, unsigned opcode, const void* arg, unsigned count) {
+    return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, count));
+}
+
+bool opcodeSupported(const io_uring_probe* probe, unsigned opcode) {
+    return opcode <= probe->last_op && opcode < probe->ops_len &&
+           (probe->ops[opcode].flags & IO_URING_OP_SUPPORTED) != 0;
+}
+
+} // namespace
+
+UringProcReader::UringProcReader() = default;
+
+UringProcReader::~UringProcReader() = default;
+
+bool UringProcReader::initialize() {
+    auto candidate = std::make_unique<Ring>();
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    candidate->fd = uringSetup(BATCH_SIZE, &params);
+    if (candidate->fd < 0) {
+        return false;
+    }
+
+    // Map the rings
+    candidate->sqMapSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    candidate->cqMapSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMap && candidate->cqMapSize > candidate->sqMapSize) {
+        candidate->sqMapSize = candidate->cqMapSize;
+    }
+    candidate->sqMap = mmap(nullptr, candidate->sqMapSize, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_POPULATE, candidate->fd, IORING_OFF_SQ_RING);
+    if (candidate->sqMap == MAP_FAILED) {
+        return false;
+    }
+    candidate->cqMap = singleMap ? candidate->sqMap
+        : mmap(nullptr, candidate->cqMapSize, PROT_READ | PROT_WRITE,
+               MAP_SHARED | MAP_POPULATE, candidate->fd, IORING_OFF_CQ_RING);
+    if (candidate->cqMap == MAP_FAILED) {
+        return false;
+    }
+    candidate->sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = mmap(nullptr, candidate->sqesSize, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, candidate->fd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        return false;
+    }
+    candidate->sqes = static_cast<io_uring_sqe*>(sqes);
+
+    char* sq = static_cast<char*>(candidate->sqMap);
+    char* cq = static_cast<char*>(candidate->cqMap);
+    candidate->sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    candidate->sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    candidate->sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    candidate->sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    candidate->cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    candidate->cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    candidate->cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    candidate->cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+    candidate->pendingTail = *candidate->sqTail;
+
+    // Open, fixed-buffer read and close must all be available (kernel 5.6+)
+    const unsigned probeOps = 256;
+    std::vector<char> probeBuffer(sizeof(io_uring_probe) + probeOps * sizeof(io_uring_probe_op), 0);
+    auto* probe = reinterpret_cast<io_uring_probe*>(probeBuffer.data());
+    if (uringRegister(candidate->fd, IORING_REGISTER_PROBE, probe, probeOps) < 0 ||
+        !opcodeSupported(probe, IORING_OP_OPENAT) ||
+        !opcodeSupported(probe, IORING_OP_READ_FIXED) ||
+        !opcodeSupported(probe, IORING_OP_CLOSE)) {
+        return false;
+    }
+
+    // Register the slot pool once; every read of every cycle lands in it
+    buffers.assign(BATCH_SIZE * SLOT_SIZE, 0);
+    struct iovec pool = { buffers.data(), buffers.size() };
+    if (uringRegister(candidate->fd, IORING_REGISTER_BUFFERS, &pool, 1) < 0) {
+        return false;
+    }
+
+    descriptors.assign(BATCH_SIZE, -1);
+    ring = std::move(candidate);
+    return true;
+}
+
+bool UringProcReader::submitAndWait(unsigned count, int* results) {
+    __atomic_store_n(ring->sqTail, ring->pendingTail, __ATOMIC_RELEASE);
+
+    unsigned submitted = 0;
+    unsigned completed = 0;
+    while (completed < count) {
+        unsigned toSubmit = count - submitted;
+        unsigned waitFor = count - completed;
+        syscallCount++;
+        int result = uringEnter(ring->fd, toSubmit, waitFor, IORING_ENTER_GETEVENTS);
+        if (result < 0) {
+            if (errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+                continue;
+            }
+            // Submitted entries still complete; collect them so the caller
+            // learns every descriptor that was opened
+            for (;;) {
+                completed += reapCompletions(count, results);
+                if (completed >= submitted) {
+                    break;
+                }
+                syscallCount++;
+                if (uringEnter(ring->fd, 0, submitted - completed, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) {
+                    completed += reapCompletions(count, results);
+                    break;
+                }
+            }
+            return false;
+        }
+        submitted += static_cast<unsigned>(result);
+        completed += reapCompletions(count, results);
+    }
+    return true;
+}
+
+unsigned UringProcReader::reapCompletions(unsigned count, int* results) {
+    unsigned reaped = 0;
+    unsigned head = *ring->cqHead;
+    unsigned tail = __atomic_load_n(ring->cqTail, __ATOMIC_ACQUIRE);
+    while (head != tail) {
+        const io_uring_cqe& cqe = ring->cqes[head & ring->cqMask];
+        if (cqe.user_data < count) {
+            results[cqe.user_data] = cqe.res;
+        }
+        head++;
+        reaped++;
+    }
+    __atomic_store_n(ring->cqHead, head, __ATOMIC_RELEASE);
+    return reaped;
+}
+
+void UringProcReader::fallBack(const char* const* paths, size_t count, ProcReadResult* results) {
+    // Unsubmitted entries may still sit in the submission ring; closing it discards them
+    ring.reset();
+    if (buffers.empty()) {
+        buffers.resize(BATCH_SIZE * SLOT_SIZE);
+    }
+    for (size_t i = 0; i < count; i++) {
+        preadFile(paths[i], i, results[i]);
+    }
+}
+
+void UringProcReader::readBatch(const char* const* paths, size_t count, ProcReadResult* results) {
+    if (count > BATCH_SIZE) {
+        count = BATCH_SIZE;
+    }
+    for (size_t i = 0; i < count; i++) {
+        results[i] = ProcReadResult();
+    }
+    if (!ring) {
+        fallBack(paths, count, results);
+        return;
+    }
+    if (count == 0) {
+        return;
+    }
+
+    int status[BATCH_SIZE];
+
+    // Phase 1: open every file
+    for (size_t i = 0; i < count; i++) {
+        io_uring_sqe* sqe = ring->nextSqe(i);
+        sqe->opcode = IORING_OP_OPENAT;
+        sqe->fd = AT_FDCWD;
+        sqe->addr = reinterpret_cast<uint64_t>(paths[i]);
+        sqe->open_flags = O_RDONLY | O_CLOEXEC;
+        status[i] = -ECANCELED;
+    }
+    if (!submitAndWait(static_cast<unsigned>(count), status)) {
+        for (size_t i = 0; i < count; i++) {
+            if (status[i] >= 0) {
+                syscallCount++;
+                ::close(status[i]);
+            }
+        }
+        fallBack(paths, count, results);
+        return;
+    }
+
+    // Phase 2: read the opened files into their registered slots
+    unsigned reads = 0;
+    int readStatus[BATCH_SIZE];
+    size_t readFile[BATCH_SIZE];
+    for (size_t i = 0; i < count; i++) {
+        descriptors[i] = status[i];
+        if (status[i] < 0) {
+            results[i].length = status[i];
+            continue;
+        }
+        io_uring_sqe* sqe = ring->nextSqe(reads);
+        sqe->opcode = IORING_OP_READ_FIXED;
+        sqe->fd = status[i];
+        sqe->addr = reinterpret_cast<uint64_t>(slot(i));
+        sqe->len = SLOT_SIZE - 1;
+        sqe->off = 0;
+        sqe->buf_index = 0;
+        readStatus[reads] = -ECANCELED;
+        readFile[reads++] = i;
+    }
+    if (reads > 0 && !submitAndWait(reads, readStatus)) {
+        for (size_t i = 0; i < count; i++) {
+            if (descriptors[i] >= 0) {
+                syscallCount++;
+                ::close(descriptors[i]);
+                descriptors[i] = -1;
+            }
+        }
+        fallBack(paths, count, results);
+        return;
+    }
+    for (unsigned r = 0; r < reads; r++) {
+        size_t i = readFile[r];
+        results[i].length = readStatus[r];
+        if (readStatus[r] >= 0) {
+            slot(i)[readStatus[r]] = '\0';
+            results[i].data = slot(i);
+        }
+    }
+
+    // Phase 3: close everything that was opened
+    unsigned closes = 0;
+    int closeStatus[BATCH_SIZE];
+    int closeFd[BATCH_SIZE];
+    for (size_t i = 0; i < count; i++) {
+        if (descriptors[i] < 0) {
+            continue;
+        }
+        io_uring_sqe* sqe = ring->nextSqe(closes);
+        sqe->opcode = IORING_OP_CLOSE;
+        sqe->fd = descriptors[i];
+        closeStatus[closes] = -ECANCELED;
+        closeFd[closes++] = descriptors[i];
+        descriptors[i] = -1;
+    }
+    if (closes > 0 && !submitAndWait(closes, closeStatus)) {
+        // The results are complete; close what the ring did not and retire it
+        for (unsigned c = 0; c < closes; c++) {
+            if (closeStatus[c] == -ECANCELED) {
+                syscallCount++;
+                ::close(closeFd[c]);
+            }
+        }
+        ring.reset();
+    }
+}
+
+#else
+
+// Built without io_uring headers: the engine is never available
+struct UringProcReader::Ring {};
+
+UringProcReader::UringProcReader() = default;
+
+UringProcReader::~UringProcReader() = default;
+
+bool UringProcReader::initialize() {
+    return false;
+}
+
+bool UringProcReader::submitAndWait(unsigned, int*) {
+    return false;
+}
+
+unsigned UringProcReader::reapCompletions(unsigned, int*) {
+    return 0;
+}
+
+void UringProcReader::fallBack(const char* const* paths, size_t count, ProcReadResult* results) {
+    if (buffers.empty()) {
+        buffers.resize(BATCH_SIZE * SLOT_SIZE);
+    }
+    for (size_t i = 0; i < count; i++) {
+        preadFile(paths[i], i, results[i]);
+    }
+}
+
+void UringProcReader::readBatch(const char* const* paths, size_t count, ProcReadResult* results) {
+    fallBack(paths, count < BATCH_SIZE ? count : BATCH_SIZE, results);
+}
+
+#endif
+
+// ProcReaderFactory implementation
+std::unique_ptr<IProcReader> ProcReaderFactory::create(ProcReadEngine engine) {
+    if (engine != ProcReadEngine::PREAD) {
+        auto uring = std::make_unique<UringProcReader>();
+        if (uring->initialize()) {
+            return uring;
+        }
+        if (engine == ProcReadEngine::IO_URING) {
+            return nullptr;
+        }
+    }
+    return std::make_unique<PreadProcReader>();
+}
+
+#endif
@@ -1,14 +1,21 @@
 #include "../include/ProcessManager.h"
 #include "../include/Logger.h"
-#include <psapi.h>
-#include <tlhelp32.h>
 #include <iostream>
 #include <functional>
 #include <set>
 #include <algorithm>
+#include <iterator>
 #include <cmath>
+
+#ifdef _WIN32
 #include <windows.h>
+#include <psapi.h>
+#include <tlhelp32.h>
+#elif defined(__linux__)
+#include "../include/LinuxProcessManager.h"
+#endif
 
+#ifdef _WIN32
 // WindowsProcessManager implementation
 WindowsProcessManager::WindowsProcessManager(std::shared_ptr<ISystemMonitor> monitor)
     : systemMonitor(monitor), initialized(false), systemTimesInitialized(false) {
@@ -25,17 +32,27 @@ bool WindowsProcessManager::initialize() {
 
     try {
         // Initialize the process manager
-        lastProcessTimes.clear();
-        lastIOBytes.clear();
+        lastSamples.clear();
         
         // Capture initial CPU times for baseline
-        lastProcessTimes = captureProcessCpuTimes();
+        for (const auto& entry : captureProcessCpuTimes()) {
+            ProcessSample& sample = lastSamples[entry.first];
+            sample.cpuTime = ((ULONGLONG)entry.second.dwHighDateTime << 32) | entry.second.dwLowDateTime;
+            sample.hasCpuTime = true;
+        }
+        lastScanTime = std::chrono::steady_clock::now();
+        hasLastScanTime = true;
         
         // Initialize system times
         if (GetSystemTimes(&lastSystemIdleTime, &lastSystemKernelTime, &lastSystemUserTime)) {
             systemTimesInitialized = true;
         }
         
+        // Worker threads for the per-process pass
+        if (!scanPool) {
+            setScanThreads(scanThreads);
+        }
+        
         initialized = true;
         return true;
     }
@@ -48,17 +65,21 @@ bool WindowsProcessManager::initialize() {
 
 void WindowsProcessManager::shutdown() {
     if (initialized) {
-        lastProcessTimes.clear();
-        lastIOBytes.clear();
+        lastSamples.clear();
+        burstBaselines.clear();
         systemTimesInitialized = false;
+        hasLastScanTime = false;
+        hasBurstBaseline = false;
         initialized = false;
     }
 }
 
 void WindowsProcessManager::clearCache() {
-    lastProcessTimes.clear();
-    lastIOBytes.clear();
+    lastSamples.clear();
+    burstBaselines.clear();
     systemTimesInitialized = false;
+    hasLastScanTime = false;
+    hasBurstBaseline = false;
 }
 
 std::string WindowsProcessManager::convertProcessNameToString(const TCHAR* name) const {
@@ -111,94 +132,77 @@ std::map<DWORD, FILETIME> WindowsProcessManager::captureProcessCpuTimes() const
     return processTimes;
 }
 
-bool WindowsProcessManager::calculateProcessMetrics(ProcessInfo& processInfo, HANDLE hProcess,
-                                                   const std::map<DWORD, FILETIME>& lastTimes,
-                                                   const std::map<DWORD, FILETIME>& currentTimes,
-                                                   DWORDLONG totalPhysicalMemory) {
+bool WindowsProcessManager::calculateProcessMetrics(ProcessInfo& processInfo, HANDLE hProcess, const ScanContext& context,
+                                                   const ProcessSample* previous, ProcessSample& sample) const {
     try {
-        // Get memory info
-        PROCESS_MEMORY_COUNTERS_EX pmc;
-        if (GetProcessMemoryInfo(hProcess, (PROCESS_MEMORY_COUNTERS*)&pmc, sizeof(pmc))) {
-            // Use WorkingSetSize instead of PrivateUsage for better correlation with system memory usage
-            // WorkingSetSize represents the physical memory currently used by the process
-            processInfo.setRamPercent(100.0 * (double)pmc.WorkingSetSize / (double)totalPhysicalMemory);
+        // Get CPU info; this cheap check runs for hot and cold processes alike
+        FILETIME createTime, exitTime, kernelTime, userTime;
+        if (GetProcessTimes(hProcess, &createTime, &exitTime, &kernelTime, &userTime)) {
+            ULONGLONG kernelULL = ((ULONGLONG)kernelTime.dwHighDateTime << 32) | kernelTime.dwLowDateTime;
+            ULONGLONG userULL = ((ULONGLONG)userTime.dwHighDateTime << 32) | userTime.dwLowDateTime;
+            sample.cpuTime = kernelULL + userULL;
+            sample.hasCpuTime = true;
+            processInfo.setStartTime(((ULONGLONG)createTime.dwHighDateTime << 32) | createTime.dwLowDateTime);
         }
         
-        // Get CPU info
-        DWORD pid = processInfo.getPid();
-        auto lastIt = lastTimes.find(pid);
-        auto currentIt = currentTimes.find(pid);
-        
-        if (lastIt != lastTimes.end() && currentIt != currentTimes.end()) {
-            FILETIME lastTime = lastIt->second;
-            FILETIME currentTime = currentIt->second;
-            
-            ULONGLONG lastULL = ((ULONGLONG)lastTime.dwHighDateTime << 32) | lastTime.dwLowDateTime;
-            ULONGLONG currentULL = ((ULONGLONG)currentTime.dwHighDateTime << 32) | currentTime.dwLowDateTime;
+        if (sample.hasCpuTime && previous && previous->hasCpuTime && sample.cpuTime > previous->cpuTime) {
+            ULONGLONG processDelta = sample.cpuTime - previous->cpuTime;
             
-            if (currentULL > lastULL) {
-                ULONGLONG processDelta = currentULL - lastULL;
+            if (context.systemTimeDelta > 0) {
+                // Calculate process CPU as percentage of actual system time used
+                double cpuPercent = 100.0 * (double)processDelta / (double)context.systemTimeDelta;
                 
-                // Get current system times and calculate system delta
-                FILETIME currentSystemIdle, currentSystemKernel, currentSystemUser;
-                if (GetSystemTimes(&currentSystemIdle, &currentSystemKernel, &currentSystemUser) && systemTimesInitialized) {
-                    
-                    // Convert system times to ULONGLONG for calculation
-                    ULONGLONG currentSysKernelULL = ((ULONGLONG)currentSystemKernel.dwHighDateTime << 32) | currentSystemKernel.dwLowDateTime;
-                    ULONGLONG currentSysUserULL = ((ULONGLONG)currentSystemUser.dwHighDateTime << 32) | currentSystemUser.dwLowDateTime;
-                    ULONGLONG currentSysIdleULL = ((ULONGLONG)currentSystemIdle.dwHighDateTime << 32) | currentSystemIdle.dwLowDateTime;
-                    
-                    ULONGLONG lastSysKernelULL = ((ULONGLONG)lastSystemKernelTime.dwHighDateTime << 32) | lastSystemKernelTime.dwLowDateTime;
-                    ULONGLONG lastSysUserULL = ((ULONGLONG)lastSystemUserTime.dwHighDateTime << 32) | lastSystemUserTime.dwLowDateTime;
-                    ULONGLONG lastSysIdleULL = ((ULONGLONG)lastSystemIdleTime.dwHighDateTime << 32) | lastSystemIdleTime.dwLowDateTime;
-                    
-                    // Calculate system time deltas
-                    ULONGLONG sysKernelDelta = currentSysKernelULL - lastSysKernelULL;
-                    ULONGLONG sysUserDelta = currentSysUserULL - lastSysUserULL;
-                    ULONGLONG sysIdleDelta = currentSysIdleULL - lastSysIdleULL;
-                    ULONGLONG sysTotalDelta = sysKernelDelta + sysUserDelta;
-                    
-                    if (sysTotalDelta > 0) {
-                        // Calculate process CPU as percentage of actual system time used
-                        double cpuPercent = 100.0 * (double)processDelta / (double)sysTotalDelta;
-                        
-                        // Cap at reasonable maximum
-                        if (cpuPercent > 100.0) cpuPercent = 100.0;
-                        
-                        processInfo.setCpuPercent(cpuPercent);
-                    }
-                } else {
-                    // Fallback calculation using actual time interval
-                    double timeIntervalMs = 1000.0; // Approximate interval between measurements
-                    double timeIntervalIn100ns = timeIntervalMs * 10000.0;
-                    double cpuPercent = 100.0 * (double)processDelta / timeIntervalIn100ns;
-                    
-                    // Normalize by number of cores for consistent display
-                    SYSTEM_INFO sysInfo;
-                    GetSystemInfo(&sysInfo);
-                    int numProcessors = sysInfo.dwNumberOfProcessors;
-                    cpuPercent = cpuPercent / numProcessors;
-                    
-                    if (cpuPercent > 100.0) cpuPercent = 100.0;
-                    processInfo.setCpuPercent(cpuPercent);
-                }
+                // Cap at reasonable maximum
+                if (cpuPercent > 100.0) cpuPercent = 100.0;
+                
+                processInfo.setCpuPercent(cpuPercent);
+            } else {
+                // Fallback calculation using actual time interval
+                double timeIntervalMs = context.elapsedSeconds * 1000.0; // Measured interval between passes
+                double timeIntervalIn100ns = timeIntervalMs * 10000.0;
+                double cpuPercent = 100.0 * (double)processDelta / timeIntervalIn100ns;
+                
+                // Normalize by number of cores for consistent display
+                cpuPercent = cpuPercent / context.processorCount;
+                
+                if (cpuPercent > 100.0) cpuPercent = 100.0;
+                processInfo.setCpuPercent(cpuPercent);
             }
         }
         
+        // Cold processes without a CPU jump keep their last memory and I/O values
+        TierState tierState = previous ? previous->tierState : TierState();
+        if (!tierPolicy.needsFullSample(tierState, previous != nullptr, processInfo.getCpuPercent())) {
+            sample.ramPercent = previous->ramPercent;
+            sample.ioBytes = previous->ioBytes;
+            sample.hasIoBytes = previous->hasIoBytes;
+            processInfo.setRamPercent(sample.ramPercent);
+            processInfo.setDiskIoBytes(sample.ioBytes);
+            sample.tierState = tierPolicy.advance(tierState, false, tierPolicy.isActive(processInfo.getCpuPercent(), 0.0));
+            return true;
+        }
+        sample.fullSampled = true;
+        
+        // Get memory info
+        PROCESS_MEMORY_COUNTERS_EX pmc;
+        if (GetProcessMemoryInfo(hProcess, (PROCESS_MEMORY_COUNTERS*)&pmc, sizeof(pmc))) {
+            // Use WorkingSetSize instead of PrivateUsage for better correlation with system memory usage
+            // WorkingSetSize represents the physical memory currently used by the process
+            sample.ramPercent = 100.0 * (double)pmc.WorkingSetSize / (double)context.totalPhysicalMemory;
+            processInfo.setRamPercent(sample.ramPercent);
+        }
+        
         // Get I/O info and calculate relative disk activity
         IO_COUNTERS ioCounters;
         if (GetProcessIoCounters(hProcess, &ioCounters)) {
             ULONGLONG totalIO = ioCounters.ReadTransferCount + ioCounters.WriteTransferCount;
             
             // Calculate disk I/O activity as a percentage using a more reasonable scale
-            DWORD pid = processInfo.getPid();
-            auto lastIOIt = lastIOBytes.find(pid);
-            
-            if (lastIOIt != lastIOBytes.end()) {
-                ULONGLONG ioDelta = totalIO - lastIOIt->second;
+            if (previous && previous->hasIoBytes) {
+                ULONGLONG ioDelta = totalIO - previous->ioBytes;
                 
-                // Use the same time interval as system calculation (approximately 1 second)
-                double timeElapsedSec = 1.0; // Approximate time between getAllProcesses() calls
+                // Measured time between passes; a cold process may not have been read for several cycles
+                double timeElapsedSec = context.elapsedSeconds * (1.0 + tierState.cyclesSinceFull);
                 
                 // Convert to MB/s and then to percentage relative to a reasonable baseline
                 // Scale to make individual process percentages add up to reasonable system totals
@@ -216,11 +220,14 @@ bool WindowsProcessManager::calculateProcessMetrics(ProcessInfo& processInfo, HA
                 processInfo.setDiskPercent(0.0);
             }
             
-            // Store current I/O bytes for next calculation
-            lastIOBytes[pid] = totalIO;
+            // Keep current I/O bytes for next calculation
+            sample.ioBytes = totalIO;
+            sample.hasIoBytes = true;
             processInfo.setDiskIoBytes(totalIO);
         }
         
+        sample.tierState = tierPolicy.advance(tierState, true,
+                                              tierPolicy.isActive(processInfo.getCpuPercent(), processInfo.getDiskPercent()));
         return true;
     }
     catch (...) {
@@ -228,6 +235,31 @@ bool WindowsProcessManager::calculateProcessMetrics(ProcessInfo& processInfo, HA
     }
 }
 
+void WindowsProcessManager::scanRange(std::vector<ProcessInfo>& processes, std::vector<ProcessSample>& samples,
+                                      const ScanContext& context, size_t begin, size_t end) const {
+    // Each index is owned by exactly one worker; the previous-pass samples are only read
+    for (size_t i = begin; i < end; i++) {
+        HANDLE hProcess = OpenProcess(PROCESS_QUERY_INFORMATION | PROCESS_VM_READ, FALSE, processes[i].getPid());
+        if (hProcess != NULL) {
+            auto lastIt = lastSamples.find(processes[i].getPid());
+            const ProcessSample* previous = lastIt != lastSamples.end() ? &lastIt->second : nullptr;
+            calculateProcessMetrics(processes[i], hProcess, context, previous, samples[i]);
+            CloseHandle(hProcess);
+        }
+    }
+}
+
+void WindowsProcessManager::setScanThreads(int threads) {
+    if (threads < 0) {
+        threads = 0;
+    }
+    if (scanPool && threads == scanThreads) {
+        return;
+    }
+    scanThreads = threads;
+    scanPool = std::make_unique<ThreadPool>(static_cast<size_t>(threads));
+}
+
 std::vector<ProcessInfo> WindowsProcessManager::getAllProcesses() {
     if (!initialized) {
         if (!initialize()) {
@@ -235,19 +267,42 @@ std::vector<ProcessInfo> WindowsProcessManager::getAllProcesses() {
         }
     }
 
+    return scanProcesses();
+}
+
+std::vector<ProcessInfo> WindowsProcessManager::scanProcesses() {
     std::vector<ProcessInfo> processes;
+    if (!initialized && !initialize()) {
+        return processes;
+    }
     
     try {
-        // Wait briefly and capture current CPU times for delta calculation
-        Sleep(100); // 100 ms delay for CPU usage calculation
-        std::map<DWORD, FILETIME> currentProcessTimes = captureProcessCpuTimes();
-        
         // Get system memory info
         MEMORYSTATUSEX memInfo = { sizeof(MEMORYSTATUSEX) };
         GlobalMemoryStatusEx(&memInfo);
-        DWORDLONG totalPhysMem = memInfo.ullTotalPhys;
         
-        // Take process snapshot
+        ScanContext context;
+        context.totalPhysicalMemory = memInfo.ullTotalPhys;
+        auto scanTime = std::chrono::steady_clock::now();
+        if (hasLastScanTime && scanTime > lastScanTime) {
+            context.elapsedSeconds = std::chrono::duration<double>(scanTime - lastScanTime).count();
+        }
+        SYSTEM_INFO sysInfo;
+        GetSystemInfo(&sysInfo);
+        context.processorCount = sysInfo.dwNumberOfProcessors > 0 ? sysInfo.dwNumberOfProcessors : 1;
+        
+        // One system time reading per pass, shared by every process
+        FILETIME currentSystemIdle, currentSystemKernel, currentSystemUser;
+        bool haveSystemTimes = GetSystemTimes(&currentSystemIdle, &currentSystemKernel, &currentSystemUser) != 0;
+        if (haveSystemTimes && systemTimesInitialized) {
+            ULONGLONG currentSysKernelULL = ((ULONGLONG)currentSystemKernel.dwHighDateTime << 32) | currentSystemKernel.dwLowDateTime;
+            ULONGLONG currentSysUserULL = ((ULONGLONG)currentSystemUser.dwHighDateTime << 32) | currentSystemUser.dwLowDateTime;
+            ULONGLONG lastSysKernelULL = ((ULONGLONG)lastSystemKernelTime.dwHighDateTime << 32) | lastSystemKernelTime.dwLowDateTime;
+            ULONGLONG lastSysUserULL = ((ULONGLONG)lastSystemUserTime.dwHighDateTime << 32) | lastSystemUserTime.dwLowDateTime;
+            context.systemTimeDelta = (currentSysKernelULL - lastSysKernelULL) + (currentSysUserULL - lastSysUserULL);
+        }
+        
+        // Take process snapshot; the process list doubles as the preallocated result slots
         HANDLE hProcessSnap = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
         if (hProcessSnap == INVALID_HANDLE_VALUE) {
             return processes;
@@ -258,29 +313,42 @@ std::vector<ProcessInfo> WindowsProcessManager::getAllProcesses() {
 
         if (Process32First(hProcessSnap, &pe32)) {
             do {
-                ProcessInfo procInfo(pe32.th32ProcessID, pe32.th32ParentProcessID, 
-                                   convertProcessNameToString(pe32.szExeFile));
-                
-                // Get process details
-                HANDLE hProcess = OpenProcess(PROCESS_QUERY_INFORMATION | PROCESS_VM_READ, FALSE, pe32.th32ProcessID);
-                if (hProcess != NULL) {
-                    calculateProcessMetrics(procInfo, hProcess, lastProcessTimes, currentProcessTimes, totalPhysMem);
-                    CloseHandle(hProcess);
-                }
-                
-                processes.push_back(procInfo);
-                
+                processes.emplace_back(pe32.th32ProcessID, pe32.th32ParentProcessID,
+                                       convertProcessNameToString(pe32.szExeFile));
             } while (Process32Next(hProcessSnap, &pe32));
         }
         
         CloseHandle(hProcessSnap);
         
-        // Update last times for next iteration
-        lastProcessTimes = currentProcessTimes;
+        // Read and compute every process in parallel chunks, each writing only its own slots
+        std::vector<ProcessSample> samples(processes.size());
+        scanPool->parallelFor(processes.size(), SCAN_CHUNK_SIZE, [&](size_t begin, size_t end) {
+            scanRange(processes, samples, context, begin, end);
+        });
+        
+        // Keep this pass as the baseline of the next one
+        std::unordered_map<DWORD, ProcessSample> currentSamples;
+        currentSamples.reserve(processes.size());
+        size_t hotProcesses = 0;
+        size_t fullSamples = 0;
+        for (size_t i = 0; i < processes.size(); i++) {
+            const ProcessSample& sample = samples[i];
+            if (!sample.hasCpuTime && !sample.hasIoBytes) {
+                continue;
+            }
+            currentSamples[processes[i].getPid()] = sample;
+            if (sample.tierState.tier == SamplingTier::HOT) hotProcesses++;
+            if (sample.fullSampled) fullSamples++;
+        }
+        lastSamples.swap(currentSamples);
+        lastHotProcesses = hotProcesses;
+        lastFullSamples = fullSamples;
+        
+        lastScanTime = scanTime;
+        hasLastScanTime = true;
         
         // Update system times for next iteration
-        FILETIME currentSystemIdle, currentSystemKernel, currentSystemUser;
-        if (GetSystemTimes(&currentSystemIdle, &currentSystemKernel, &currentSystemUser)) {
+        if (haveSystemTimes) {
             lastSystemIdleTime = currentSystemIdle;
             lastSystemKernelTime = currentSystemKernel;
             lastSystemUserTime = currentSystemUser;
@@ -296,10 +364,104 @@ std::vector<ProcessInfo> WindowsProcessManager::getAllProcesses() {
     }
 }
 
+std::vector<ProcessInfo> WindowsProcessManager::sampleProcesses(const std::vector<DWORD>& pids) {
+    std::vector<ProcessInfo> processes;
+    if (!initialized && !initialize()) {
+        return processes;
+    }
+    
+    try {
+        MEMORYSTATUSEX memInfo = { sizeof(MEMORYSTATUSEX) };
+        GlobalMemoryStatusEx(&memInfo);
+        
+        // Own system time and clock baselines, so burst samples do not shorten the next full pass
+        auto sampleTime = std::chrono::steady_clock::now();
+        double elapsedSeconds = hasBurstBaseline && sampleTime > lastBurstTime
+            ? std::chrono::duration<double>(sampleTime - lastBurstTime).count() : 0.0;
+        FILETIME systemIdle, systemKernel, systemUser;
+        ULONGLONG systemTime = 0;
+        if (GetSystemTimes(&systemIdle, &systemKernel, &systemUser)) {
+            systemTime = (((ULONGLONG)systemKernel.dwHighDateTime << 32) | systemKernel.dwLowDateTime) +
+                         (((ULONGLONG)systemUser.dwHighDateTime << 32) | systemUser.dwLowDateTime);
+        }
+        ULONGLONG systemTimeDelta = hasBurstBaseline && systemTime > lastBurstSystemTime
+            ? systemTime - lastBurstSystemTime : 0;
+        
+        std::unordered_map<DWORD, BurstBaseline> currentBaselines;
+        currentBaselines.reserve(pids.size());
+        processes.reserve(pids.size());
+        for (DWORD pid : pids) {
+            HANDLE hProcess = OpenProcess(PROCESS_QUERY_INFORMATION | PROCESS_VM_READ, FALSE, pid);
+            if (hProcess == NULL) {
+                continue;   // Exited or not accessible
+            }
+            
+            ProcessInfo processInfo(pid, 0, "");
+            BurstBaseline baseline;
+            auto lastIt = burstBaselines.find(pid);
+            const BurstBaseline* previous = lastIt != burstBaselines.end() ? &lastIt->second : nullptr;
+            
+            FILETIME createTime, exitTime, kernelTime, userTime;
+            if (GetProcessTimes(hProcess, &createTime, &exitTime, &kernelTime, &userTime)) {
+                baseline.cpuTime = (((ULONGLONG)kernelTime.dwHighDateTime << 32) | kernelTime.dwLowDateTime) +
+                                   (((ULONGLONG)userTime.dwHighDateTime << 32) | userTime.dwLowDateTime);
+                baseline.hasCpuTime = true;
+                if (previous && previous->hasCpuTime && systemTimeDelta > 0 && baseline.cpuTime > previous->cpuTime) {
+                    double cpuPercent = 100.0 * (double)(baseline.cpuTime - previous->cpuTime) / (double)systemTimeDelta;
+                    processInfo.setCpuPercent(cpuPercent > 100.0 ? 100.0 : cpuPercent);
+                }
+            }
+            
+            PROCESS_MEMORY_COUNTERS_EX pmc;
+            if (GetProcessMemoryInfo(hProcess, (PROCESS_MEMORY_COUNTERS*)&pmc, sizeof(pmc))) {
+                processInfo.setRamPercent(100.0 * (double)pmc.WorkingSetSize / (double)memInfo.ullTotalPhys);
+            }
+            
+            IO_COUNTERS ioCounters;
+            if (GetProcessIoCounters(hProcess, &ioCounters)) {
+                baseline.ioBytes = ioCounters.ReadTransferCount + ioCounters.WriteTransferCount;
+                baseline.hasIoBytes = true;
+                processInfo.setDiskIoBytes(baseline.ioBytes);
+                if (previous && previous->hasIoBytes && elapsedSeconds > 0.0 && baseline.ioBytes >= previous->ioBytes) {
+                    // Same scale as the full pass: MB/s against a 1 GB/s baseline, capped at 50%
+                    double ioMBperSec = (double)(baseline.ioBytes - previous->ioBytes) / (1024.0 * 1024.0 * elapsedSeconds);
+                    double diskActivityPercent = (ioMBperSec / 1000.0) * 100.0;
+                    processInfo.setDiskPercent(diskActivityPercent > 50.0 ? 50.0 : diskActivityPercent);
+                }
+            }
+            CloseHandle(hProcess);
+            
+            currentBaselines[pid] = baseline;
+            processes.push_back(processInfo);
+        }
+        
+        burstBaselines.swap(currentBaselines);
+        lastBurstSystemTime = systemTime;
+        lastBurstTime = sampleTime;
+        hasBurstBaseline = true;
+        return processes;
+        
+    } catch (...) {
+        return processes;
+    }
+}
+
 std::vector<ProcessInfo> WindowsProcessManager::getAggregatedProcessTree(const std::vector<ProcessInfo>& processes) {
     ProcessTreeAggregator aggregator;
     return aggregator.aggregate(processes);
 }
+#endif
+
+// Fallback for managers without a targeted read: one full pass, filtered
+std::vector<ProcessInfo> IProcessManager::sampleProcesses(const std::vector<DWORD>& pids) {
+    std::vector<ProcessInfo> selected;
+    for (const auto& process : getAllProcesses()) {
+        if (std::find(pids.begin(), pids.end(), process.getPid()) != pids.end()) {
+            selected.push_back(process);
+        }
+    }
+    return selected;
+}
 
 // ProcessTreeAggregator implementation
 void ProcessTreeAggregator::buildProcessTree(const std::vector<ProcessInfo>& processes) {
@@ -392,12 +554,19 @@ std::vector<ProcessInfo> ProcessFilter::filterByThresholds(const std::vector<Pro
 
 // ProcessManagerFactory implementation
 std::unique_ptr<IProcessManager> ProcessManagerFactory::createWindowsManager(std::shared_ptr<ISystemMonitor> monitor) {
+#ifdef _WIN32
     return std::make_unique<WindowsProcessManager>(monitor);
+#else
+    return nullptr;
+#endif
 }
 
 std::unique_ptr<IProcessManager> ProcessManagerFactory::createLinuxManager(std::shared_ptr<ISystemMonitor> monitor) {
-    // Stub for future Linux implementation
+#ifdef __linux__
+    return std::make_unique<LinuxProcessManager>(monitor);
+#else
     return nullptr;
+#endif
 }
 
 std::unique_ptr<IProcessManager> ProcessManagerFactory::createCrossPlatformManager(std::shared_ptr<ISystemMonitor> monitor) {
@@ -0,0 +1,25 @@
+#include "../include/ProcessTiers.h"
+#include <algorithm>
+
+bool ProcessTierPolicy::needsFullSample(const TierState& state, bool known, double cpuPercent) const {
+    if (!isEnabled() || !known || state.tier == SamplingTier::HOT) {
+        return true;
+    }
+    // Immediate promotion on a CPU time jump, otherwise wait for the cold cadence
+    return cpuPercent >= hotCpuPercent || state.cyclesSinceFull + 1 >= coldRefreshCycles;
+}
+
+TierState ProcessTierPolicy::advance(const TierState& state, bool fullSampled, bool active) const {
+    TierState next = state;
+    if (active) {
+        next.tier = SamplingTier::HOT;
+        next.quietCycles = 0;
+    } else {
+        next.quietCycles = static_cast<uint16_t>(std::min<int>(state.quietCycles + 1, UINT16_MAX));
+        if (next.quietCycles >= demoteAfterCycles) {
+            next.tier = SamplingTier::COLD;
+        }
+    }
+    next.cyclesSinceFull = fullSampled ? 0 : static_cast<uint16_t>(std::min<int>(state.cyclesSinceFull + 1, UINT16_MAX));
+    return next;
+}
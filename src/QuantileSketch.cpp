@@ -0,0 +1,431 @@
+#include "../include/QuantileSketch.h"
+#include "../include/HistoryArchive.h"
+#include "../include/TraceRecorder.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+
+namespace {
+
+const double GAMMA = (1.0 + QuantileSketch::RELATIVE_ACCURACY) / (1.0 - QuantileSketch::RELATIVE_ACCURACY);
+const double LOG_GAMMA = std::log(GAMMA);
+
+const char MAGIC[8] = { 'S', 'M', 'Q', 'S', 'K', '\x01', '\n', '\0' };
+const uint8_t HOUR_TAG = 'H';
+
+void putVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+void putDouble(std::string& out, double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    for (int shift = 0; shift < 64; shift += 8) {
+        out.push_back(static_cast<char>((bits >> shift) & 0xFF));
+    }
+}
+
+bool getVarint(const std::vector<uint8_t>& data, size_t& position, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (position >= data.size()) {
+            return false;
+        }
+        uint8_t byte = data[position++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool getDouble(const std::vector<uint8_t>& data, size_t& position, double& value) {
+    if (data.size() - position < 8) {
+        return false;
+    }
+    uint64_t bits = 0;
+    for (int shift = 0; shift < 64; shift += 8) {
+        bits |= static_cast<uint64_t>(data[position++]) << shift;
+    }
+    std::memcpy(&value, &bits, sizeof(value));
+    return true;
+}
+
+bool getText(const std::vector<uint8_t>& data, size_t& position, std::string& value) {
+    uint64_t length;
+    if (!getVarint(data, position, length) || data.size() - position < length) {
+        return false;
+    }
+    value.assign(reinterpret_cast<const char*>(data.data() + position), static_cast<size_t>(length));
+    position += static_cast<size_t>(length);
+    return true;
+}
+
+// Calls visit(hourStartMs, record) for each complete hour record of a sketch file
+template<typename Visitor>
+void readHours(const std::filesystem::path& path, Visitor visit) {
+    std::ifstream in(path, std::ios::binary);
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (data.size() < sizeof(MAGIC) || std::memcmp(data.data(), MAGIC, sizeof(MAGIC)) != 0) {
+        return;
+    }
+    size_t position = sizeof(MAGIC);
+    uint64_t length, hourSeconds;
+    while (position < data.size() && data[position] == HOUR_TAG) {
+        position++;
+        if (!getVarint(data, position, length) || data.size() - position < length) {
+            return;
+        }
+        std::vector<uint8_t> record(data.begin() + static_cast<std::ptrdiff_t>(position),
+                                    data.begin() + static_cast<std::ptrdiff_t>(position + length));
+        position += static_cast<size_t>(length);
+        size_t recordPosition = 0;
+        if (getVarint(record, recordPosition, hourSeconds)) {
+            visit(static_cast<int64_t>(hourSeconds) * 1000, record, recordPosition);
+        }
+    }
+}
+
+// "YYYY-MM-DD HH:00" of an hour start
+std::string formatHour(int64_t hourStartMs) {
+    int64_t seconds = hourStartMs / 1000;
+    std::string day = HistoryArchiveWriter::segmentName(static_cast<uint32_t>(seconds / 86400)).substr(8);
+    std::ostringstream text;
+    text << day.substr(0, 4) << "-" << day.substr(4, 2) << "-" << day.substr(6, 2) << " "
+         << std::setw(2) << std::setfill('0') << (seconds / 3600) % 24 << ":00";
+    return text.str();
+}
+
+} // namespace
+
+// QuantileSketch implementation
+void QuantileSketch::addToBucket(int32_t index, uint64_t amount) {
+    if (buckets.empty()) {
+        offset = index;
+        buckets.assign(1, 0);
+    } else if (index < offset) {
+        // Below the lowest bucket; past the size limit it joins the lowest bucket kept
+        size_t grow = static_cast<size_t>(offset - index);
+        if (buckets.size() + grow > MAX_BUCKETS) {
+            grow = MAX_BUCKETS - buckets.size();
+        }
+        buckets.insert(buckets.begin(), grow, 0);
+        offset -= static_cast<int32_t>(grow);
+        index = std::max(index, offset);
+    } else if (static_cast<size_t>(index - offset) >= buckets.size()) {
+        // Above the highest bucket; past the size limit the lowest buckets are folded together
+        int32_t lowest = index - static_cast<int32_t>(MAX_BUCKETS) + 1;
+        if (lowest > offset) {
+            size_t folded = std::min(static_cast<size_t>(lowest - offset), buckets.size());
+            uint32_t total = 0;
+            for (size_t i = 0; i < folded; i++) {
+                total += buckets[i];
+            }
+            buckets.erase(buckets.begin(), buckets.begin() + static_cast<std::ptrdiff_t>(folded));
+            if (buckets.empty()) {
+                buckets.assign(1, 0);
+            }
+            offset = lowest;
+            buckets[0] += total;
+        }
+        buckets.resize(static_cast<size_t>(index - offset) + 1, 0);
+    }
+    buckets[static_cast<size_t>(index - offset)] += static_cast<uint32_t>(amount);
+}
+
+void QuantileSketch::add(double value) {
+    value = std::max(value, 0.0);
+    if (count == 0) {
+        minValue = maxValue = value;
+    } else {
+        minValue = std::min(minValue, value);
+        maxValue = std::max(maxValue, value);
+    }
+    count++;
+    sum += value;
+    if (value < MIN_VALUE) {
+        zeroCount++;
+    } else {
+        addToBucket(static_cast<int32_t>(std::ceil(std::log(value) / LOG_GAMMA)), 1);
+    }
+}
+
+void QuantileSketch::merge(const QuantileSketch& other) {
+    if (other.count == 0) {
+        return;
+    }
+    if (count == 0) {
+        minValue = other.minValue;
+        maxValue = other.maxValue;
+    } else {
+        minValue = std::min(minValue, other.minValue);
+        maxValue = std::max(maxValue, other.maxValue);
+    }
+    count += other.count;
+    sum += other.sum;
+    zeroCount += other.zeroCount;
+    for (size_t i = 0; i < other.buckets.size(); i++) {
+        if (other.buckets[i] > 0) {
+            addToBucket(other.offset + static_cast<int32_t>(i), other.buckets[i]);
+        }
+    }
+}
+
+double QuantileSketch::quantile(double q) const {
+    if (count == 0) {
+        return 0.0;
+    }
+    double rank = std::min(std::max(q, 0.0), 1.0) * static_cast<double>(count - 1);
+    uint64_t seen = zeroCount;
+    if (rank < static_cast<double>(seen)) {
+        return minValue;
+    }
+    for (size_t i = 0; i < buckets.size(); i++) {
+        seen += buckets[i];
+        if (rank < static_cast<double>(seen)) {
+            double estimate = 2.0 * std::pow(GAMMA, offset + static_cast<int32_t>(i)) / (GAMMA + 1.0);
+            return std::min(std::max(estimate, minValue), maxValue);
+        }
+    }
+    return maxValue;
+}
+
+void QuantileSketch::serialize(std::string& out) const {
+    putVarint(out, zeroCount);
+    putDouble(out, minValue);
+    putDouble(out, maxValue);
+    putDouble(out, sum);
+    putVarint(out, (static_cast<uint64_t>(static_cast<int64_t>(offset)) << 1) ^
+                   static_cast<uint64_t>(static_cast<int64_t>(offset) >> 63));
+    putVarint(out, buckets.size());
+    for (uint32_t bucket : buckets) {
+        putVarint(out, bucket);
+    }
+}
+
+bool QuantileSketch::deserialize(const std::vector<uint8_t>& data, size_t& position) {
+    uint64_t zeros, encodedOffset, bucketCount, bucket;
+    if (!getVarint(data, position, zeros) || !getDouble(data, position, minValue) ||
+        !getDouble(data, position, maxValue) || !getDouble(data, position, sum) ||
+        !getVarint(data, position, encodedOffset) || !getVarint(data, position, bucketCount) ||
+        bucketCount > MAX_BUCKETS) {
+        return false;
+    }
+    zeroCount = zeros;
+    count = zeros;
+    offset = static_cast<int32_t>(static_cast<int64_t>(encodedOffset >> 1) ^ -static_cast<int64_t>(encodedOffset & 1));
+    buckets.assign(static_cast<size_t>(bucketCount), 0);
+    for (auto& entry : buckets) {
+        if (!getVarint(data, position, bucket)) {
+            return false;
+        }
+        entry = static_cast<uint32_t>(bucket);
+        count += bucket;
+    }
+    return true;
+}
+
+// PercentileStore implementation
+void PercentileStore::record(int64_t timestampMs, const SystemUsage& systemUsage,
+                             const std::vector<ProcessInfo>& processList) {
+    if (timestampMs < 0) {
+        return;
+    }
+    int64_t hour = timestampMs - timestampMs % (static_cast<int64_t>(HOUR_SECONDS) * 1000);
+    if (hourStartMs >= 0 && hour != hourStartMs && !flush()) {
+        LoggerManager::getInstance().debug("Cannot write percentile sketches to " + directory);
+    }
+    hourStartMs = hour;
+
+    system.cpu.add(systemUsage.getCpuPercent());
+    system.ram.add(systemUsage.getRamPercent());
+
+    // One value per name and cycle: the usage of all its instances together
+    for (auto& entry : cycleTotals) {
+        entry.second = { -1.0, 0.0 };
+    }
+    for (const auto& process : processList) {
+        auto& totals = cycleTotals[process.getName()];
+        if (totals.first < 0.0) {
+            totals = { 0.0, 0.0 };
+        }
+        totals.first += process.getCpuPercent();
+        totals.second += process.getRamPercent();
+    }
+    for (const auto& entry : cycleTotals) {
+        if (entry.second.first < 0.0) {
+            continue;
+        }
+        auto found = nameIndex.find(entry.first);
+        size_t index;
+        if (found != nameIndex.end()) {
+            index = found->second;
+        } else if (processes.size() < MAX_PROCESS_NAMES) {
+            index = processes.size();
+            processes.emplace_back();
+            processes[index].name = entry.first;
+            nameIndex[entry.first] = index;
+        } else {
+            continue;
+        }
+        processes[index].cpu.add(entry.second.first);
+        processes[index].ram.add(entry.second.second);
+    }
+
+    // Names seen this hour only; the totals map would otherwise keep every name ever seen
+    if (cycleTotals.size() > 2 * MAX_PROCESS_NAMES) {
+        cycleTotals.clear();
+    }
+}
+
+bool PercentileStore::flush() {
+    if (hourStartMs < 0 || system.cpu.getCount() == 0) {
+        return true;
+    }
+    TraceScope scope("Percentile flush", "history");
+    bool written = true;
+    if (!directory.empty()) {
+        std::string body;
+        putVarint(body, static_cast<uint64_t>(hourStartMs / 1000));
+        system.cpu.serialize(body);
+        system.ram.serialize(body);
+        putVarint(body, processes.size());
+        for (const auto& series : processes) {
+            putVarint(body, series.name.size());
+            body.append(series.name);
+            series.cpu.serialize(body);
+            series.ram.serialize(body);
+        }
+        std::string record(1, static_cast<char>(HOUR_TAG));
+        putVarint(record, body.size());
+        record.append(body);
+
+        std::filesystem::path path = std::filesystem::path(directory) /
+            (HistoryArchiveWriter::segmentName(static_cast<uint32_t>(hourStartMs / 1000 / 86400)) + ".qsk");
+        std::error_code error;
+        bool fresh = !std::filesystem::exists(path, error) || std::filesystem::file_size(path, error) < sizeof(MAGIC);
+        std::ofstream file(path, std::ios::binary | (fresh ? std::ios::trunc : std::ios::app));
+        if (fresh) {
+            file.write(MAGIC, sizeof(MAGIC));
+        }
+        file.write(record.data(), static_cast<std::streamsize>(record.size()));
+        file.flush();
+        written = file.good();
+        if (written) {
+            hoursWritten++;
+        }
+    }
+    system = PercentileSeries();
+    processes.clear();
+    nameIndex.clear();
+    cycleTotals.clear();
+    return written;
+}
+
+bool PercentileStore::load(const std::string& path, uint32_t hours, PercentileWindow& window) {
+    std::vector<std::filesystem::path> files;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(path, error)) {
+        std::string fileName = entry.path().filename().string();
+        if (fileName.compare(0, 8, "history-") == 0 && entry.path().extension() == ".qsk") {
+            files.push_back(entry.path());
+        }
+    }
+
+    // The window ends at the newest hour on disk, so copied archives can be queried too
+    int64_t newest = -1;
+    for (const auto& file : files) {
+        readHours(file, [&newest](int64_t hourMs, const std::vector<uint8_t>&, size_t) {
+            newest = std::max(newest, hourMs);
+        });
+    }
+    if (newest < 0 || hours == 0) {
+        return false;
+    }
+    window = PercentileWindow();
+    window.toMs = newest;
+    window.fromMs = newest - static_cast<int64_t>(hours - 1) * HOUR_SECONDS * 1000;
+
+    std::unordered_map<std::string, size_t> names;
+    std::vector<int64_t> hoursSeen;
+    for (const auto& file : files) {
+        readHours(file, [&](int64_t hourMs, const std::vector<uint8_t>& record, size_t position) {
+            if (hourMs < window.fromMs || hourMs > window.toMs) {
+                return;
+            }
+            PercentileSeries hourSystem;
+            uint64_t processCount;
+            if (!hourSystem.cpu.deserialize(record, position) || !hourSystem.ram.deserialize(record, position) ||
+                !getVarint(record, position, processCount)) {
+                return;
+            }
+            window.system.cpu.merge(hourSystem.cpu);
+            window.system.ram.merge(hourSystem.ram);
+            hoursSeen.push_back(hourMs);
+            PercentileSeries series;
+            for (uint64_t i = 0; i < processCount; i++) {
+                if (!getText(record, position, series.name) || !series.cpu.deserialize(record, position) ||
+                    !series.ram.deserialize(record, position)) {
+                    return;
+                }
+                auto found = names.find(series.name);
+                if (found == names.end()) {
+                    names[series.name] = window.processes.size();
+                    window.processes.push_back(series);
+                } else {
+                    window.processes[found->second].cpu.merge(series.cpu);
+                    window.processes[found->second].ram.merge(series.ram);
+                }
+            }
+        });
+    }
+    std::sort(hoursSeen.begin(), hoursSeen.end());
+    window.hourCount = static_cast<uint32_t>(std::unique(hoursSeen.begin(), hoursSeen.end()) - hoursSeen.begin());
+    return true;
+}
+
+std::string PercentileStore::formatTable(const PercentileWindow& window, size_t rows) {
+    std::ostringstream table;
+    uint32_t span = static_cast<uint32_t>((window.toMs - window.fromMs) / (HOUR_SECONDS * 1000)) + 1;
+    table << "Percentiles over " << span << " h: " << formatHour(window.fromMs) << " to "
+          << formatHour(window.toMs + HOUR_SECONDS * 1000) << " UTC (" << window.hourCount << " hours with data)\n\n";
+    table << std::left << std::setw(28) << "Series" << std::right << std::setw(9) << "Samples"
+          << std::setw(10) << "CPU p50" << std::setw(8) << "p95" << std::setw(8) << "p99"
+          << std::setw(10) << "RAM p50" << std::setw(8) << "p95" << std::setw(8) << "p99" << "\n";
+
+    auto printRow = [&table](const std::string& name, const PercentileSeries& series) {
+        table << std::left << std::setw(28) << (name.size() > 27 ? name.substr(0, 27) : name)
+              << std::right << std::setw(9) << series.cpu.getCount() << std::fixed << std::setprecision(2)
+              << std::setw(10) << series.cpu.quantile(0.50) << std::setw(8) << series.cpu.quantile(0.95)
+              << std::setw(8) << series.cpu.quantile(0.99)
+              << std::setw(10) << series.ram.quantile(0.50) << std::setw(8) << series.ram.quantile(0.95)
+              << std::setw(8) << series.ram.quantile(0.99) << "\n";
+    };
+    printRow("System", window.system);
+
+    std::vector<const PercentileSeries*> sorted;
+    for (const auto& series : window.processes) {
+        sorted.push_back(&series);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const PercentileSeries* a, const PercentileSeries* b) {
+        double cpuA = a->cpu.quantile(0.95), cpuB = b->cpu.quantile(0.95);
+        return cpuA != cpuB ? cpuA > cpuB : a->ram.quantile(0.95) > b->ram.quantile(0.95);
+    });
+    for (size_t i = 0; i < sorted.size() && i < rows; i++) {
+        printRow(sorted[i]->name, *sorted[i]);
+    }
+    if (sorted.size() > rows) {
+        table << "(" << sorted.size() - rows << " more processes)\n";
+    }
+    return table.str();
+}
@@ -0,0 +1,775 @@
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+// Winsock 2 has to come before windows.h (pulled in by SystemMetrics.h)
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <afunix.h>
+#else
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif
+#endif
+#include "../include/QueryServer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+#ifdef _WIN32
+typedef SOCKET NativeSocket;
+const NativeSocket NO_SOCKET = INVALID_SOCKET;
+
+void closeSocket(NativeSocket socket) {
+    closesocket(socket);
+}
+
+bool setNonBlocking(NativeSocket socket) {
+    u_long enabled = 1;
+    return ioctlsocket(socket, FIONBIO, &enabled) == 0;
+}
+
+bool wouldBlock() {
+    return WSAGetLastError() == WSAEWOULDBLOCK;
+}
+
+int sendBytes(NativeSocket socket, const char* data, size_t length) {
+    return send(socket, data, static_cast<int>(length), 0);
+}
+#else
+typedef int NativeSocket;
+const NativeSocket NO_SOCKET = -1;
+
+void closeSocket(NativeSocket socket) {
+    close(socket);
+}
+
+bool setNonBlocking(NativeSocket socket) {
+    int flags = fcntl(socket, F_GETFL, 0);
+    return flags >= 0 && fcntl(socket, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+bool wouldBlock() {
+    return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+}
+
+int sendBytes(NativeSocket socket, const char* data, size_t length) {
+    // A client that hung up must not raise SIGPIPE
+    return static_cast<int>(send(socket, data, length, MSG_NOSIGNAL));
+}
+#endif
+
+NativeSocket native(intptr_t socket) {
+    return static_cast<NativeSocket>(socket);
+}
+
+const uint64_t LISTEN_TOKEN = 0;            // Client ids start at 1
+const uint64_t WAKE_TOKEN = UINT64_MAX;
+
+struct Readiness {
+    uint64_t token;
+    bool readable;                          // Also set on hang-up and errors, so recv() reports them
+    bool writable;
+};
+
+uint16_t readU16(const uint8_t* data) {
+    return static_cast<uint16_t>(data[0] | (data[1] << 8));
+}
+
+uint32_t readU32(const uint8_t* data) {
+    return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+           (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+float roundPercent(double value) {
+    return static_cast<float>(std::round(value * 100.0) / 100.0);
+}
+
+// Builds one frame: uint32 length, uint8 type, uint32 request id, body
+class FrameBuilder {
+private:
+    std::string bytes;
+
+public:
+    FrameBuilder(QueryMessage type, uint32_t requestId, size_t bodyBytes = 0) {
+        bytes.reserve(9 + bodyBytes);
+        bytes.resize(4);
+        putU8(static_cast<uint8_t>(type));
+        putU32(requestId);
+    }
+
+    void putU8(uint8_t value) {
+        bytes.push_back(static_cast<char>(value));
+    }
+
+    void putU16(uint16_t value) {
+        putU8(static_cast<uint8_t>(value));
+        putU8(static_cast<uint8_t>(value >> 8));
+    }
+
+    void putU32(uint32_t value) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            putU8(static_cast<uint8_t>(value >> shift));
+        }
+    }
+
+    void putU64(uint64_t value) {
+        for (int shift = 0; shift < 64; shift += 8) {
+            putU8(static_cast<uint8_t>(value >> shift));
+        }
+    }
+
+    void putFloat(float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        putU32(bits);
+    }
+
+    void putName(const std::string& name) {
+        size_t length = std::min<size_t>(name.size(), 255);
+        putU8(static_cast<uint8_t>(length));
+        bytes.append(name, 0, length);
+    }
+
+    std::shared_ptr<const std::string> finish() {
+        uint32_t length = static_cast<uint32_t>(bytes.size() - 4);
+        for (int i = 0; i < 4; i++) {
+            bytes[i] = static_cast<char>(length >> (i * 8));
+        }
+        return std::make_shared<const std::string>(std::move(bytes));
+    }
+};
+
+std::shared_ptr<const std::string> rejection(uint32_t requestId, QueryError error, const std::string& message) {
+    FrameBuilder frame(QueryMessage::REJECTED, requestId, 3 + message.size());
+    frame.putU8(static_cast<uint8_t>(error));
+    frame.putU16(static_cast<uint16_t>(message.size()));
+    for (char c : message) {
+        frame.putU8(static_cast<uint8_t>(c));
+    }
+    return frame.finish();
+}
+
+std::shared_ptr<const std::string> emptyReply(QueryMessage type, uint32_t requestId) {
+    return FrameBuilder(type, requestId).finish();
+}
+
+} // namespace
+
+#ifdef __linux__
+// Readiness through epoll, woken early by an eventfd when the main loop hands over work
+class QueryServer::Poller {
+private:
+    int epollFd = -1;
+    int wakeFd = -1;
+
+public:
+    ~Poller() {
+        if (epollFd >= 0) close(epollFd);
+        if (wakeFd >= 0) close(wakeFd);
+    }
+
+    bool open() {
+        epollFd = epoll_create1(EPOLL_CLOEXEC);
+        wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (epollFd < 0 || wakeFd < 0) {
+            return false;
+        }
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.u64 = WAKE_TOKEN;
+        return epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event) == 0;
+    }
+
+    bool add(NativeSocket socket, uint64_t token, bool wantWrite) {
+        epoll_event event = {};
+        event.events = EPOLLIN | (wantWrite ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+        event.data.u64 = token;
+        return epoll_ctl(epollFd, EPOLL_CTL_ADD, socket, &event) == 0;
+    }
+
+    void update(NativeSocket socket, uint64_t token, bool wantWrite) {
+        epoll_event event = {};
+        event.events = EPOLLIN | (wantWrite ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+        event.data.u64 = token;
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, socket, &event);
+    }
+
+    void remove(NativeSocket socket) {
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, socket, nullptr);
+    }
+
+    void wait(std::vector<Readiness>& ready, int timeoutMs) {
+        ready.clear();
+        epoll_event events[64];
+        int count = epoll_wait(epollFd, events, 64, timeoutMs);
+        for (int i = 0; i < count; i++) {
+            if (events[i].data.u64 == WAKE_TOKEN) {
+                uint64_t drained;
+                ssize_t ignored = read(wakeFd, &drained, sizeof(drained));
+                (void)ignored;
+                continue;
+            }
+            ready.push_back({ events[i].data.u64, (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) != 0,
+                              (events[i].events & EPOLLOUT) != 0 });
+        }
+    }
+
+    // Safe from any thread
+    void wake() {
+        uint64_t one = 1;
+        ssize_t ignored = write(wakeFd, &one, sizeof(one));
+        (void)ignored;
+    }
+};
+#else
+// Readiness through poll()/WSAPoll; without a wake-up handle, handed-over work
+// waits for the next POLL_INTERVAL_MS tick
+class QueryServer::Poller {
+private:
+#ifdef _WIN32
+    typedef WSAPOLLFD PollEntry;
+#else
+    typedef pollfd PollEntry;
+#endif
+    std::vector<PollEntry> entries;
+    std::vector<uint64_t> tokens;
+
+    size_t find(NativeSocket socket) const {
+        for (size_t i = 0; i < entries.size(); i++) {
+            if (entries[i].fd == socket) return i;
+        }
+        return entries.size();
+    }
+
+public:
+    bool open() {
+        return true;
+    }
+
+    bool add(NativeSocket socket, uint64_t token, bool wantWrite) {
+        PollEntry entry = {};
+        entry.fd = socket;
+        entry.events = static_cast<short>(POLLIN | (wantWrite ? POLLOUT : 0));
+        entries.push_back(entry);
+        tokens.push_back(token);
+        return true;
+    }
+
+    void update(NativeSocket socket, uint64_t, bool wantWrite) {
+        size_t index = find(socket);
+        if (index < entries.size()) {
+            entries[index].events = static_cast<short>(POLLIN | (wantWrite ? POLLOUT : 0));
+        }
+    }
+
+    void remove(NativeSocket socket) {
+        size_t index = find(socket);
+        if (index < entries.size()) {
+            entries[index] = entries.back();
+            tokens[index] = tokens.back();
+            entries.pop_back();
+            tokens.pop_back();
+        }
+    }
+
+    void wait(std::vector<Readiness>& ready, int timeoutMs) {
+        ready.clear();
+#ifdef _WIN32
+        int count = WSAPoll(entries.data(), static_cast<ULONG>(entries.size()), timeoutMs);
+#else
+        int count = poll(entries.data(), static_cast<nfds_t>(entries.size()), timeoutMs);
+#endif
+        for (size_t i = 0; count > 0 && i < entries.size(); i++) {
+            short events = entries[i].revents;
+            if (events != 0) {
+                ready.push_back({ tokens[i], (events & (POLLIN | POLLHUP | POLLERR)) != 0, (events & POLLOUT) != 0 });
+            }
+        }
+    }
+
+    void wake() {
+    }
+};
+#endif
+
+QueryServer::QueryServer() = default;
+
+QueryServer::~QueryServer() {
+    stop();
+}
+
+bool QueryServer::start(const std::string& path) {
+    if (running) {
+        return false;
+    }
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size());
+
+#ifdef _WIN32
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+        return false;
+    }
+#else
+    // Replace the socket of a previous run, but never another kind of file
+    struct stat status;
+    if (lstat(path.c_str(), &status) == 0 && !S_ISSOCK(status.st_mode)) {
+        return false;
+    }
+#endif
+    std::remove(path.c_str());
+
+    NativeSocket listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    bool listening = listener != NO_SOCKET &&
+                     bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0 &&
+                     listen(listener, SOMAXCONN) == 0 && setNonBlocking(listener);
+    poller.reset(new Poller());
+    if (!listening || !poller->open() || !poller->add(listener, LISTEN_TOKEN, false)) {
+        if (listener != NO_SOCKET) {
+            closeSocket(listener);
+            std::remove(path.c_str());
+        }
+        poller.reset();
+#ifdef _WIN32
+        WSACleanup();
+#endif
+        return false;
+    }
+
+    socketPath = path;
+    listenSocket = static_cast<intptr_t>(listener);
+    running = true;
+    worker = std::thread(&QueryServer::serverThreadFunction, this);
+    return true;
+}
+
+void QueryServer::stop() {
+    if (!running) {
+        return;
+    }
+    running = false;
+    poller->wake();
+    if (worker.joinable()) {
+        worker.join();
+    }
+
+    while (!clients.empty()) {
+        closeClient(clients.begin()->first);
+    }
+    closeSocket(native(listenSocket));
+    listenSocket = -1;
+    std::remove(socketPath.c_str());
+    poller.reset();
+    current.reset();
+    {
+        std::lock_guard<std::mutex> lock(exchangeMutex);
+        publishedSnapshot.reset();
+        pendingHistory.clear();
+        historyReplies.clear();
+    }
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+void QueryServer::publish(int64_t timestampMs, const SystemUsage& systemUsage,
+                          const std::vector<ProcessInfo>& processes) {
+    if (!running) {
+        return;
+    }
+    // Only a copy here; sorting and diffing happen on the server thread
+    auto snapshot = std::make_shared<Snapshot>();
+    snapshot->timestampMs = timestampMs;
+    snapshot->usage[0] = roundPercent(systemUsage.getCpuPercent());
+    snapshot->usage[1] = roundPercent(systemUsage.getRamPercent());
+    snapshot->usage[2] = roundPercent(systemUsage.getDiskPercent());
+    snapshot->processes.reserve(processes.size());
+    for (const auto& process : processes) {
+        snapshot->processes.push_back({ static_cast<uint32_t>(process.getPid()), static_cast<uint32_t>(process.getPpid()),
+                                        process.getStartTime(),
+                                        { roundPercent(process.getCpuPercent()), roundPercent(process.getRamPercent()),
+                                          roundPercent(process.getDiskPercent()) },
+                                        process.getName() });
+    }
+    {
+        std::lock_guard<std::mutex> lock(exchangeMutex);
+        snapshot->cycle = ++publishCount;
+        publishedSnapshot = std::move(snapshot);
+    }
+    poller->wake();
+}
+
+void QueryServer::answerHistoryRequests(const MetricStore& metricStore, const std::vector<ProcessInfo>& processes,
+                                        int64_t nowMs) {
+    if (!running) {
+        return;
+    }
+    std::vector<HistoryRequest> requests;
+    {
+        std::lock_guard<std::mutex> lock(exchangeMutex);
+        requests.swap(pendingHistory);
+    }
+    if (requests.empty()) {
+        return;
+    }
+
+    std::vector<std::pair<uint64_t, std::shared_ptr<const std::string>>> replies;
+    replies.reserve(requests.size());
+    for (const auto& request : requests) {
+        const ProcessInfo* process = nullptr;
+        for (const auto& candidate : processes) {
+            if (candidate.getPid() == request.pid) {
+                process = &candidate;
+                break;
+            }
+        }
+        if (!process) {
+            replies.emplace_back(request.client, rejection(request.requestId, QueryError::UNKNOWN_PID,
+                                                           "pid " + std::to_string(request.pid) + " is not running"));
+            continue;
+        }
+
+        std::vector<MetricStore::Point> points =
+            metricStore.queryProcess(process->getPid(), process->getStartTime(), request.resolution,
+                                     nowMs - static_cast<int64_t>(request.seconds) * 1000, nowMs);
+        FrameBuilder frame(QueryMessage::HISTORY_RESULT, request.requestId, 9 + points.size() * 36);
+        frame.putU32(request.pid);
+        frame.putU8(static_cast<uint8_t>(request.resolution));
+        frame.putU32(static_cast<uint32_t>(points.size()));
+        for (const auto& point : points) {
+            frame.putU64(static_cast<uint64_t>(point.timestampMs));
+            frame.putU32(point.count);
+            for (size_t metric = 0; metric < MetricStore::METRIC_COUNT; metric++) {
+                frame.putFloat(point.avg[metric]);
+            }
+            for (size_t metric = 0; metric < MetricStore::METRIC_COUNT; metric++) {
+                frame.putFloat(point.max[metric]);
+            }
+        }
+        replies.emplace_back(request.client, frame.finish());
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(exchangeMutex);
+        for (auto& reply : replies) {
+            historyReplies.push_back(std::move(reply));
+        }
+    }
+    poller->wake();
+}
+
+void QueryServer::serverThreadFunction() {
+    std::vector<Readiness> ready;
+    std::vector<uint64_t> closing;
+    while (running) {
+        poller->wait(ready, POLL_INTERVAL_MS);
+        for (const auto& event : ready) {
+            if (event.token == LISTEN_TOKEN) {
+                acceptClients();
+                continue;
+            }
+            auto it = clients.find(event.token);
+            if (it == clients.end()) {
+                continue;
+            }
+            if (event.readable) {
+                readClient(it->first, it->second);
+            }
+            if (event.writable && !it->second.closing) {
+                flushClient(it->first, it->second);
+            }
+        }
+
+        // Work handed over by the main loop
+        std::shared_ptr<Snapshot> snapshot;
+        std::vector<std::pair<uint64_t, std::shared_ptr<const std::string>>> replies;
+        {
+            std::lock_guard<std::mutex> lock(exchangeMutex);
+            snapshot.swap(publishedSnapshot);
+            replies.swap(historyReplies);
+        }
+        if (snapshot) {
+            applySnapshot(std::move(snapshot));
+        }
+        for (auto& reply : replies) {
+            auto it = clients.find(reply.first);
+            if (it != clients.end()) {
+                enqueue(it->first, it->second, std::move(reply.second));
+            }
+        }
+
+        closing.clear();
+        for (const auto& entry : clients) {
+            if (entry.second.closing) {
+                closing.push_back(entry.first);
+            }
+        }
+        for (uint64_t id : closing) {
+            closeClient(id);
+        }
+    }
+}
+
+void QueryServer::acceptClients() {
+    for (;;) {
+        NativeSocket accepted = accept(native(listenSocket), nullptr, nullptr);
+        if (accepted == NO_SOCKET) {
+            return;
+        }
+        uint64_t id = nextClientId++;
+        if (clients.size() >= MAX_CLIENTS || !setNonBlocking(accepted) || !poller->add(accepted, id, false)) {
+            closeSocket(accepted);
+            droppedCount++;
+            continue;
+        }
+        clients[id].socket = static_cast<intptr_t>(accepted);
+    }
+}
+
+void QueryServer::readClient(uint64_t id, Client& client) {
+    // One read per wake-up; level-triggered readiness brings the client back, so
+    // a client that keeps sending cannot starve the others
+    char buffer[4096];
+    int received = static_cast<int>(recv(native(client.socket), buffer, sizeof(buffer), 0));
+    if (received == 0 || (received < 0 && !wouldBlock())) {
+        client.closing = true;
+        return;
+    }
+    if (received < 0) {
+        return;
+    }
+    client.input.append(buffer, static_cast<size_t>(received));
+
+    size_t offset = 0;
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(client.input.data());
+    while (!client.closing && client.input.size() - offset >= 4) {
+        uint32_t length = readU32(data + offset);
+        if (length < 5 || length > MAX_REQUEST_BYTES) {
+            droppedCount++;
+            client.closing = true;
+            return;
+        }
+        if (client.input.size() - offset - 4 < length) {
+            break;
+        }
+        handleRequest(id, client, data + offset + 4, length);
+        offset += 4 + length;
+    }
+    client.input.erase(0, offset);
+}
+
+void QueryServer::handleRequest(uint64_t id, Client& client, const uint8_t* frame, size_t length) {
+    requestCount++;
+    QueryMessage type = static_cast<QueryMessage>(frame[0]);
+    uint32_t requestId = readU32(frame + 1);
+    const uint8_t* body = frame + 5;
+    size_t bodyLength = length - 5;
+
+    switch (type) {
+    case QueryMessage::TOP: {
+        if (bodyLength != 3 || body[0] >= MetricStore::METRIC_COUNT) {
+            enqueue(id, client, rejection(requestId, QueryError::BAD_REQUEST, "TOP takes a metric and a count"));
+        } else if (!current) {
+            enqueue(id, client, rejection(requestId, QueryError::NOT_READY, "no cycle collected yet"));
+        } else {
+            enqueue(id, client, encodeTop(*current, requestId, body[0], readU16(body + 1)));
+        }
+        break;
+    }
+    case QueryMessage::HISTORY: {
+        if (bodyLength != 9 || body[4] > static_cast<uint8_t>(MetricStore::Resolution::HOUR)) {
+            enqueue(id, client, rejection(requestId, QueryError::BAD_REQUEST, "HISTORY takes a pid, a resolution and seconds"));
+            break;
+        }
+        HistoryRequest request = { id, requestId, readU32(body), static_cast<MetricStore::Resolution>(body[4]),
+                                   readU32(body + 5) };
+        bool queued = false;
+        {
+            std::lock_guard<std::mutex> lock(exchangeMutex);
+            if (pendingHistory.size() < MAX_PENDING_HISTORY) {
+                pendingHistory.push_back(request);
+                queued = true;
+            }
+        }
+        if (!queued) {
+            enqueue(id, client, rejection(requestId, QueryError::BUSY, "too many history requests waiting"));
+        }
+        break;
+    }
+    case QueryMessage::SUBSCRIBE:
+        enqueue(id, client, emptyReply(QueryMessage::SUBSCRIBED, requestId));
+        if (!client.subscribed && current) {
+            enqueue(id, client, encodeDelta(nullptr, *current));
+        }
+        client.subscribed = true;
+        break;
+    case QueryMessage::UNSUBSCRIBE:
+        client.subscribed = false;
+        enqueue(id, client, emptyReply(QueryMessage::UNSUBSCRIBED, requestId));
+        break;
+    default:
+        enqueue(id, client, rejection(requestId, QueryError::BAD_REQUEST, "unknown request type"));
+        break;
+    }
+}
+
+void QueryServer::applySnapshot(std::shared_ptr<Snapshot> snapshot) {
+    std::sort(snapshot->processes.begin(), snapshot->processes.end(),
+              [](const Entry& a, const Entry& b) { return a.pid < b.pid; });
+
+    // One encoded delta shared by every subscriber
+    std::shared_ptr<const std::string> delta;
+    for (auto& entry : clients) {
+        if (entry.second.subscribed && !entry.second.closing) {
+            if (!delta) {
+                delta = encodeDelta(current.get(), *snapshot);
+            }
+            enqueue(entry.first, entry.second, delta);
+        }
+    }
+    current = std::move(snapshot);
+}
+
+void QueryServer::enqueue(uint64_t id, Client& client, std::shared_ptr<const std::string> frame) {
+    if (client.closing) {
+        return;
+    }
+    if (client.queuedBytes + frame->size() > MAX_QUEUED_BYTES) {
+        droppedCount++;
+        client.closing = true;
+        return;
+    }
+    client.queuedBytes += frame->size();
+    client.output.push_back(std::move(frame));
+    flushClient(id, client);
+}
+
+void QueryServer::flushClient(uint64_t id, Client& client) {
+    while (!client.output.empty()) {
+        const std::string& front = *client.output.front();
+        int sent = sendBytes(native(client.socket), front.data() + client.sentOfFront, front.size() - client.sentOfFront);
+        if (sent <= 0) {
+            if (sent < 0 && !wouldBlock()) {
+                client.closing = true;
+            }
+            break;
+        }
+        client.sentOfFront += static_cast<size_t>(sent);
+        client.queuedBytes -= static_cast<size_t>(sent);
+        if (client.sentOfFront == front.size()) {
+            client.output.pop_front();
+            client.sentOfFront = 0;
+        }
+    }
+    bool wantWrite = !client.output.empty() && !client.closing;
+    if (wantWrite != client.wantWrite) {
+        client.wantWrite = wantWrite;
+        poller->update(native(client.socket), id, wantWrite);
+    }
+}
+
+void QueryServer::closeClient(uint64_t id) {
+    auto it = clients.find(id);
+    if (it == clients.end()) {
+        return;
+    }
+    poller->remove(native(it->second.socket));
+    closeSocket(native(it->second.socket));
+    clients.erase(it);
+}
+
+std::shared_ptr<const std::string> QueryServer::encodeTop(const Snapshot& snapshot, uint32_t requestId,
+                                                          size_t metric, size_t count) {
+    std::vector<const Entry*> top;
+    top.reserve(snapshot.processes.size());
+    for (const auto& entry : snapshot.processes) {
+        top.push_back(&entry);
+    }
+    size_t keep = std::min(top.size(), count);
+    std::partial_sort(top.begin(), top.begin() + static_cast<std::ptrdiff_t>(keep), top.end(),
+                      [metric](const Entry* a, const Entry* b) { return a->usage[metric] > b->usage[metric]; });
+
+    FrameBuilder frame(QueryMessage::TOP_RESULT, requestId, 10 + keep * 40);
+    frame.putU64(static_cast<uint64_t>(snapshot.timestampMs));
+    frame.putU16(static_cast<uint16_t>(keep));
+    for (size_t i = 0; i < keep; i++) {
+        frame.putU32(top[i]->pid);
+        frame.putU32(top[i]->ppid);
+        for (float value : top[i]->usage) {
+            frame.putFloat(value);
+        }
+        frame.putName(top[i]->name);
+    }
+    return frame.finish();
+}
+
+std::shared_ptr<const std::string> QueryServer::encodeDelta(const Snapshot* previous, const Snapshot& next) {
+    // Merge walk over both pid-sorted lists
+    std::vector<const Entry*> added;
+    std::vector<const Entry*> changed;
+    std::vector<uint32_t> removed;
+    static const std::vector<Entry> none;
+    const std::vector<Entry>& before = previous ? previous->processes : none;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < before.size() || j < next.processes.size()) {
+        if (j == next.processes.size() || (i < before.size() && before[i].pid < next.processes[j].pid)) {
+            removed.push_back(before[i++].pid);
+        } else if (i == before.size() || next.processes[j].pid < before[i].pid) {
+            added.push_back(&next.processes[j++]);
+        } else {
+            const Entry& old = before[i++];
+            const Entry& now = next.processes[j++];
+            if (old.startTime != now.startTime || old.ppid != now.ppid || old.name != now.name) {
+                added.push_back(&now);          // A reused pid replaces the old record
+            } else if (std::memcmp(old.usage, now.usage, sizeof(old.usage)) != 0) {
+                changed.push_back(&now);
+            }
+        }
+    }
+
+    FrameBuilder frame(QueryMessage::DELTA, 0, 40 + added.size() * 40 + changed.size() * 16 + removed.size() * 4);
+    frame.putU64(static_cast<uint64_t>(next.timestampMs));
+    frame.putU64(next.cycle);
+    for (float value : next.usage) {
+        frame.putFloat(value);
+    }
+    frame.putU32(static_cast<uint32_t>(added.size()));
+    for (const Entry* entry : added) {
+        frame.putU32(entry->pid);
+        frame.putU32(entry->ppid);
+        for (float value : entry->usage) {
+            frame.putFloat(value);
+        }
+        frame.putName(entry->name);
+    }
+    frame.putU32(static_cast<uint32_t>(changed.size()));
+    for (const Entry* entry : changed) {
+        frame.putU32(entry->pid);
+        for (float value : entry->usage) {
+            frame.putFloat(value);
+        }
+    }
+    frame.putU32(static_cast<uint32_t>(removed.size()));
+    for (uint32_t pid : removed) {
+        frame.putU32(pid);
+    }
+    return frame.finish();
+}
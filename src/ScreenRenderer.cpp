@@ -0,0 +1,321 @@
+#include "../include/ScreenRenderer.h"
+#include <cstdio>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <windows.h>
+#ifndef ENABLE_VIRTUAL_TERMINAL_PROCESSING
+#define ENABLE_VIRTUAL_TERMINAL_PROCESSING 0x0004
+#endif
+#else
+#include <unistd.h>
+#include <sys/ioctl.h>
+#endif
+
+namespace {
+
+void appendNumber(std::string& out, size_t value) {
+    char digits[24];
+    int length = std::snprintf(digits, sizeof(digits), "%zu", value);
+    out.append(digits, static_cast<size_t>(length));
+}
+
+// ESC[row;colH with 1-based coordinates
+void appendCursorMove(std::string& out, size_t row, size_t col) {
+    out += "\x1b[";
+    appendNumber(out, row + 1);
+    out += ';';
+    appendNumber(out, col + 1);
+    out += 'H';
+}
+
+// Maps a console attribute to an SGR foreground color
+void appendColor(std::string& out, uint8_t color) {
+    if (color == ScreenRenderer::COLOR_DEFAULT) {
+        out += "\x1b[0m";
+        return;
+    }
+    int ansi = ((color & 4) ? 1 : 0) | ((color & 2) ? 2 : 0) | ((color & 1) ? 4 : 0);
+    out += "\x1b[";
+    appendNumber(out, static_cast<size_t>(((color & 8) ? 90 : 30) + ansi));
+    out += 'm';
+}
+
+} // namespace
+
+ScreenRenderer::ScreenRenderer() = default;
+
+ScreenRenderer::~ScreenRenderer() {
+    shutdown();
+}
+
+bool ScreenRenderer::initialize() {
+#ifdef _WIN32
+    HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD mode = 0;
+    if (console != INVALID_HANDLE_VALUE && GetConsoleMode(console, &mode)) {
+        vtEnabled = (mode & ENABLE_VIRTUAL_TERMINAL_PROCESSING) != 0 ||
+                    SetConsoleMode(console, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING) != 0;
+    } else {
+        // Redirected output: escape sequences are the only option
+        vtEnabled = true;
+    }
+#else
+    vtEnabled = true;
+#endif
+    queryScreenSize();
+    initialized = true;
+    fullRedraw = true;
+    return true;
+}
+
+void ScreenRenderer::shutdown() {
+    if (!initialized) {
+        return;
+    }
+    initialized = false;
+
+    // Leave the cursor below the frame so later console output does not overwrite it
+    if (vtEnabled && frontCount > 0) {
+        output.clear();
+        output += "\x1b[0m";
+        appendCursorMove(output, frontCount, 0);
+        writeOutput(output.data(), output.size());
+    }
+}
+
+void ScreenRenderer::renderToMemory(int width, int height) {
+    memoryOnly = true;
+    vtEnabled = true;
+    initialized = true;
+    if (width != screenWidth || height != screenHeight) {
+        screenWidth = width;
+        screenHeight = height;
+        fullRedraw = true;
+    }
+}
+
+void ScreenRenderer::queryScreenSize() {
+    if (memoryOnly) {
+        return;
+    }
+    int width = screenWidth;
+    int height = screenHeight;
+#ifdef _WIN32
+    CONSOLE_SCREEN_BUFFER_INFO info;
+    if (GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &info)) {
+        width = info.srWindow.Right - info.srWindow.Left + 1;
+        height = info.srWindow.Bottom - info.srWindow.Top + 1;
+    }
+#else
+    struct winsize size;
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_col > 0 && size.ws_row > 0) {
+        width = size.ws_col;
+        height = size.ws_row;
+    }
+#endif
+    if (width != screenWidth || height != screenHeight) {
+        screenWidth = width;
+        screenHeight = height;
+        fullRedraw = true;
+    }
+}
+
+void ScreenRenderer::beginFrame() {
+    // Rows are reused between frames to keep their allocations
+    backCount = 0;
+}
+
+void ScreenRenderer::addLine(const std::string& text, uint8_t color) {
+    if (backCount == backRows.size()) {
+        backRows.emplace_back();
+    }
+    Row& row = backRows[backCount++];
+    row.text.clear();
+    row.colors.clear();
+    append(text, color);
+}
+
+void ScreenRenderer::append(const std::string& text, uint8_t color) {
+    if (backCount == 0) {
+        addLine();
+    }
+    Row& row = backRows[backCount - 1];
+    row.text += text;
+    row.colors.resize(row.text.size(), color);
+}
+
+void ScreenRenderer::diffRows() {
+    spans.clear();
+
+    // Never write the last column or row: the console would wrap or scroll
+    size_t maxWidth = screenWidth > 1 ? static_cast<size_t>(screenWidth - 1) : 1;
+    size_t maxRows = screenHeight > 1 ? static_cast<size_t>(screenHeight - 1) : 1;
+    size_t rowCount = std::min(std::max(backCount, frontCount), maxRows);
+
+    for (size_t r = 0; r < rowCount; ++r) {
+        const Row* current = r < backCount ? &backRows[r] : nullptr;
+        const Row* previous = r < frontCount ? &frontRows[r] : nullptr;
+        size_t currentLength = current ? std::min(current->text.size(), maxWidth) : 0;
+        size_t previousLength = previous ? std::min(previous->text.size(), maxWidth) : 0;
+
+        if (fullRedraw) {
+            if (currentLength > 0) {
+                spans.push_back({ static_cast<int>(r), 0, currentLength, false });
+            }
+            continue;
+        }
+
+        auto same = [&](size_t col) {
+            return current->text[col] == previous->text[col] && current->colors[col] == previous->colors[col];
+        };
+
+        size_t common = std::min(currentLength, previousLength);
+        size_t first = 0;
+        while (first < common && same(first)) first++;
+        size_t end = common;
+        while (end > first && same(end - 1)) end--;
+        bool clearToEnd = previousLength > currentLength;
+        if (currentLength > previousLength || clearToEnd) {
+            // New tail, or erase-to-end that must start after the last current character
+            end = currentLength;
+        }
+        if (first >= end && !clearToEnd) {
+            continue;
+        }
+        spans.push_back({ static_cast<int>(r), std::min(first, end), end, clearToEnd });
+    }
+}
+
+size_t ScreenRenderer::present() {
+    if (!initialized) {
+        initialize();
+    }
+    queryScreenSize();
+    diffRows();
+
+    if (vtEnabled) {
+        writeSpansVT();
+    } else {
+        writeSpansLegacy();
+    }
+
+    std::swap(frontRows, backRows);
+    std::swap(frontCount, backCount);
+    backCount = 0;
+    fullRedraw = false;
+    nextFrame = Clock::now() + frameBudget;
+    return lastBytesWritten;
+}
+
+void ScreenRenderer::writeSpansVT() {
+    output.clear();
+    if (fullRedraw) {
+        output += "\x1b[0m\x1b[H\x1b[2J";
+    }
+
+    uint8_t activeColor = COLOR_DEFAULT;
+    for (const auto& span : spans) {
+        const Row* row = static_cast<size_t>(span.row) < backCount ? &backRows[span.row] : nullptr;
+        appendCursorMove(output, static_cast<size_t>(span.row), span.begin);
+        for (size_t col = span.begin; row && col < span.end; ++col) {
+            if (row->colors[col] != activeColor) {
+                activeColor = row->colors[col];
+                appendColor(output, activeColor);
+            }
+            output += row->text[col];
+        }
+        if (span.clearToEnd) {
+            if (activeColor != COLOR_DEFAULT) {
+                activeColor = COLOR_DEFAULT;
+                appendColor(output, activeColor);
+            }
+            output += "\x1b[K";
+        }
+    }
+
+    if (!spans.empty() || fullRedraw) {
+        if (activeColor != COLOR_DEFAULT) {
+            appendColor(output, COLOR_DEFAULT);
+        }
+        // Park the cursor below the frame
+        appendCursorMove(output, std::min(backCount, static_cast<size_t>(screenHeight > 1 ? screenHeight - 1 : 0)), 0);
+    }
+
+    writeOutput(output.data(), output.size());
+    lastBytesWritten = output.size();
+}
+
+void ScreenRenderer::writeSpansLegacy() {
+    lastBytesWritten = 0;
+#ifdef _WIN32
+    HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+    CONSOLE_SCREEN_BUFFER_INFO info;
+    if (!GetConsoleScreenBufferInfo(console, &info)) {
+        return;
+    }
+    std::fflush(stdout);
+
+    DWORD written = 0;
+    if (fullRedraw) {
+        COORD origin = { 0, 0 };
+        DWORD cells = static_cast<DWORD>(info.dwSize.X) * info.dwSize.Y;
+        FillConsoleOutputCharacterA(console, ' ', cells, origin, &written);
+        FillConsoleOutputAttribute(console, info.wAttributes, cells, origin, &written);
+    }
+
+    for (const auto& span : spans) {
+        const Row* row = static_cast<size_t>(span.row) < backCount ? &backRows[span.row] : nullptr;
+        size_t col = span.begin;
+        while (row && col < span.end) {
+            // Write one run of equally colored characters
+            size_t runEnd = col;
+            while (runEnd < span.end && row->colors[runEnd] == row->colors[col]) runEnd++;
+            COORD position = { static_cast<SHORT>(col), static_cast<SHORT>(span.row) };
+            SetConsoleCursorPosition(console, position);
+            SetConsoleTextAttribute(console, row->colors[col]);
+            WriteConsoleA(console, row->text.data() + col, static_cast<DWORD>(runEnd - col), &written, nullptr);
+            lastBytesWritten += runEnd - col;
+            col = runEnd;
+        }
+        if (span.clearToEnd) {
+            const Row& previous = frontRows[span.row];
+            size_t previousEnd = std::min(previous.text.size(), static_cast<size_t>(screenWidth > 1 ? screenWidth - 1 : 1));
+            size_t from = span.end;
+            if (previousEnd > from) {
+                COORD position = { static_cast<SHORT>(from), static_cast<SHORT>(span.row) };
+                FillConsoleOutputCharacterA(console, ' ', static_cast<DWORD>(previousEnd - from), position, &written);
+                FillConsoleOutputAttribute(console, COLOR_DEFAULT, static_cast<DWORD>(previousEnd - from), position, &written);
+            }
+        }
+    }
+
+    SetConsoleTextAttribute(console, COLOR_DEFAULT);
+    COORD parked = { 0, static_cast<SHORT>(backCount) };
+    SetConsoleCursorPosition(console, parked);
+#endif
+}
+
+void ScreenRenderer::writeOutput(const char* data, size_t length) {
+    if (length == 0 || memoryOnly) {
+        return;
+    }
+    // Anything still buffered by std::cout/stdio must reach the console first
+    std::fflush(stdout);
+#ifdef _WIN32
+    HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD written = 0;
+    if (!WriteConsoleA(console, data, static_cast<DWORD>(length), &written, nullptr)) {
+        WriteFile(console, data, static_cast<DWORD>(length), &written, nullptr);
+    }
+#else
+    while (length > 0) {
+        ssize_t written = ::write(STDOUT_FILENO, data, length);
+        if (written <= 0) {
+            break;
+        }
+        data += written;
+        length -= static_cast<size_t>(written);
+    }
+#endif
+}
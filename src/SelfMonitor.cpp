@@ -0,0 +1,188 @@
+#include "../include/SelfMonitor.h"
+#include <sstream>
+#include <iomanip>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#include <tlhelp32.h>
+#elif defined(__linux__)
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <unistd.h>
+#endif
+
+SelfMonitor::SelfMonitor() {
+    unsigned int hardwareThreads = std::thread::hardware_concurrency();
+    processorCount = hardwareThreads > 0 ? hardwareThreads : 1;
+}
+
+void SelfMonitor::setQueueStats(size_t loggerDepth, uint64_t loggerDropped, size_t emailDepth, uint64_t emailDropped) {
+    stats.loggerQueueDepth = loggerDepth;
+    stats.loggerDropped = loggerDropped;
+    stats.emailQueueDepth = emailDepth;
+    stats.emailDropped = emailDropped;
+}
+
+#ifdef _WIN32
+bool SelfMonitor::readProcessCounters(uint64_t& cpuTimeUs, SelfStats& counters, bool refreshThreads) const {
+    HANDLE self = GetCurrentProcess();
+
+    FILETIME createTime, exitTime, kernelTime, userTime;
+    if (!GetProcessTimes(self, &createTime, &exitTime, &kernelTime, &userTime)) {
+        return false;
+    }
+    ULONGLONG kernelULL = ((ULONGLONG)kernelTime.dwHighDateTime << 32) | kernelTime.dwLowDateTime;
+    ULONGLONG userULL = ((ULONGLONG)userTime.dwHighDateTime << 32) | userTime.dwLowDateTime;
+    cpuTimeUs = (kernelULL + userULL) / 10;
+
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(self, &pmc, sizeof(pmc))) {
+        counters.rssBytes = pmc.WorkingSetSize;
+    }
+
+    DWORD handles = 0;
+    if (GetProcessHandleCount(self, &handles)) {
+        counters.handleCount = handles;
+    }
+
+    // The thread count is only available from a system-wide snapshot
+    if (refreshThreads) {
+        HANDLE hSnapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+        if (hSnapshot != INVALID_HANDLE_VALUE) {
+            PROCESSENTRY32 pe32;
+            pe32.dwSize = sizeof(PROCESSENTRY32);
+            DWORD selfPid = GetCurrentProcessId();
+            if (Process32First(hSnapshot, &pe32)) {
+                do {
+                    if (pe32.th32ProcessID == selfPid) {
+                        counters.threadCount = pe32.cntThreads;
+                        break;
+                    }
+                } while (Process32Next(hSnapshot, &pe32));
+            }
+            CloseHandle(hSnapshot);
+        }
+    }
+    return true;
+}
+#elif defined(__linux__)
+bool SelfMonitor::readProcessCounters(uint64_t& cpuTimeUs, SelfStats& counters, bool refreshThreads) const {
+    (void)refreshThreads;   // num_threads comes with the stat line
+
+    char buffer[1024];
+    FILE* file = std::fopen("/proc/self/stat", "r");
+    if (!file) {
+        return false;
+    }
+    size_t length = std::fread(buffer, 1, sizeof(buffer) - 1, file);
+    std::fclose(file);
+    buffer[length] = '\0';
+
+    // Fields after the command name: 14 utime, 15 stime, 20 num_threads, 24 rss
+    const char* cursor = std::strrchr(buffer, ')');
+    if (!cursor) {
+        return false;
+    }
+    cursor++;
+    uint64_t utime = 0, stime = 0, rssPages = 0;
+    for (int field = 3; field <= 24 && *cursor; field++) {
+        while (*cursor == ' ') cursor++;
+        switch (field) {
+            case 14: utime = std::strtoull(cursor, nullptr, 10); break;
+            case 15: stime = std::strtoull(cursor, nullptr, 10); break;
+            case 20: counters.threadCount = static_cast<uint32_t>(std::strtoul(cursor, nullptr, 10)); break;
+            case 24: rssPages = std::strtoull(cursor, nullptr, 10); break;
+            default: break;
+        }
+        while (*cursor && *cursor != ' ') cursor++;
+    }
+
+    long ticksPerSecond = sysconf(_SC_CLK_TCK);
+    long pageSize = sysconf(_SC_PAGESIZE);
+    cpuTimeUs = (utime + stime) * 1000000ull / static_cast<uint64_t>(ticksPerSecond > 0 ? ticksPerSecond : 100);
+    counters.rssBytes = rssPages * static_cast<uint64_t>(pageSize > 0 ? pageSize : 4096);
+
+    // Open descriptors, less ".", ".." and the one used for the listing
+    uint32_t descriptors = 0;
+    if (DIR* directory = opendir("/proc/self/fd")) {
+        while (struct dirent* entry = readdir(directory)) {
+            if (entry->d_name[0] != '.') {
+                descriptors++;
+            }
+        }
+        closedir(directory);
+    }
+    counters.handleCount = descriptors > 0 ? descriptors - 1 : 0;
+    return true;
+}
+#else
+bool SelfMonitor::readProcessCounters(uint64_t&, SelfStats&, bool) const {
+    return false;
+}
+#endif
+
+SelfMonitor::BudgetEvent SelfMonitor::sample(Clock::time_point now) {
+    bool refreshThreads = samplesSinceThreadCount == 0;
+    samplesSinceThreadCount = (samplesSinceThreadCount + 1) % THREAD_REFRESH_SAMPLES;
+
+    uint64_t cpuTimeUs = 0;
+    if (!readProcessCounters(cpuTimeUs, stats, refreshThreads)) {
+        return BudgetEvent::NONE;
+    }
+
+    // CPU share of the whole machine, the scale of the 1% budget
+    if (hasBaseline && now > lastSampleTime && cpuTimeUs >= lastCpuTime) {
+        double elapsedUs = std::chrono::duration<double, std::micro>(now - lastSampleTime).count();
+        stats.cpuPercent = 100.0 * (double)(cpuTimeUs - lastCpuTime) / (elapsedUs * processorCount);
+    }
+    lastCpuTime = cpuTimeUs;
+    lastSampleTime = now;
+    bool firstSample = !hasBaseline;
+    hasBaseline = true;
+
+    return firstSample ? BudgetEvent::NONE : evaluateBudget(stats);
+}
+
+bool SelfMonitor::exceedsBudget(const SelfStats& current) const {
+    return (cpuBudgetPercent > 0.0 && current.cpuPercent > cpuBudgetPercent) ||
+           (rssBudgetBytes > 0 && current.rssBytes > rssBudgetBytes);
+}
+
+SelfMonitor::BudgetEvent SelfMonitor::evaluateBudget(const SelfStats& current) {
+    if (exceedsBudget(current)) {
+        consecutiveUnder = 0;
+        if (!overBudget && ++consecutiveOver >= BUDGET_SAMPLES) {
+            overBudget = true;
+            return BudgetEvent::EXCEEDED;
+        }
+    } else {
+        consecutiveOver = 0;
+        if (overBudget && ++consecutiveUnder >= BUDGET_SAMPLES) {
+            overBudget = false;
+            return BudgetEvent::RECOVERED;
+        }
+    }
+    return BudgetEvent::NONE;
+}
+
+std::string SelfMonitor::formatSummary() const {
+    std::ostringstream summary;
+    summary << "Agent CPU " << std::fixed << std::setprecision(2) << stats.cpuPercent
+            << "% | RSS " << std::setprecision(1) << stats.rssBytes / (1024.0 * 1024.0) << " MB"
+            << " | Threads " << stats.threadCount
+#ifdef _WIN32
+            << " | Handles " << stats.handleCount
+#else
+            << " | FDs " << stats.handleCount
+#endif
+            << " | Log queue " << stats.loggerQueueDepth << " (dropped " << stats.loggerDropped << ")"
+            << " | Email queue " << stats.emailQueueDepth << " (dropped " << stats.emailDropped << ")";
+    if (overBudget) {
+        summary << " | OVER BUDGET";
+    }
+    return summary.str();
+}
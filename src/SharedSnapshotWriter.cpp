@@ -0,0 +1,173 @@
+#include "../include/SharedSnapshotWriter.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#ifndef _WIN32
+#include <sys/file.h>
+
+namespace {
+
+// Creates the segment exclusively and takes its ownership lock. An existing
+// segment that is sized but unlocked was left by a writer that died and is
+// replaced; an empty one is still being set up by the writer that created it.
+int createOwnedSegment(const std::string& objectName) {
+    for (int attempt = 0; attempt < 2; attempt++) {
+        int descriptor = shm_open(objectName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        if (descriptor >= 0) {
+            if (flock(descriptor, LOCK_EX | LOCK_NB) != 0) {
+                // Another writer opened it first and holds the lock
+                ::close(descriptor);
+                return -1;
+            }
+            return descriptor;
+        }
+        if (errno != EEXIST) {
+            return -1;
+        }
+
+        int existing = shm_open(objectName.c_str(), O_RDWR, 0);
+        if (existing < 0) {
+            continue;                   // Removed in the meantime; try to create it again
+        }
+        struct stat status;
+        bool abandoned = fstat(existing, &status) == 0 && status.st_size > 0 &&
+                         flock(existing, LOCK_EX | LOCK_NB) == 0;
+        if (abandoned) {
+            shm_unlink(objectName.c_str());
+        }
+        ::close(existing);
+        if (!abandoned) {
+            return -1;                  // A running writer owns it
+        }
+    }
+    return -1;
+}
+
+} // namespace
+#endif
+
+SharedSnapshotWriter::~SharedSnapshotWriter() {
+    stop();
+}
+
+bool SharedSnapshotWriter::start(const std::string& name, uint32_t capacity) {
+    stop();
+    objectName = sharedSnapshotObjectName(name);
+    size_t size = sharedSnapshotSegmentSize(capacity);
+    void* view = nullptr;
+
+#ifdef _WIN32
+    mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                 static_cast<DWORD>(static_cast<uint64_t>(size) >> 32),
+                                 static_cast<DWORD>(size & 0xFFFFFFFFu), objectName.c_str());
+    if (!mapping) return false;
+    if (GetLastError() == ERROR_ALREADY_EXISTS) {
+        // Opened another instance's mapping instead of creating one; named
+        // mappings disappear with their last handle, so it is in use
+        CloseHandle(mapping);
+        mapping = nullptr;
+        return false;
+    }
+    view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (!view) {
+        CloseHandle(mapping);
+        mapping = nullptr;
+        return false;
+    }
+#else
+    // A segment left by a crashed run is replaced; readers still mapping it keep their copy
+    descriptor = createOwnedSegment(objectName);
+    if (descriptor < 0) return false;
+    if (ftruncate(descriptor, static_cast<off_t>(size)) == 0) {
+        view = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    }
+    if (!view || view == MAP_FAILED) {
+        shm_unlink(objectName.c_str());
+        ::close(descriptor);
+        descriptor = -1;
+        return false;
+    }
+#endif
+
+    mappedSize = size;
+    std::memset(view, 0, size);
+    header = static_cast<SharedSnapshotHeader*>(view);
+    header->version = SHARED_SNAPSHOT_VERSION;
+    header->headerSize = sizeof(SharedSnapshotHeader);
+    header->recordSize = sizeof(SharedSnapshotProcess);
+    header->capacity = capacity;
+    header->sequence.store(0, std::memory_order_relaxed);
+    // The magic goes in last so a reader opening mid-setup rejects the segment
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic = SHARED_SNAPSHOT_MAGIC;
+
+    staging.clear();
+    staging.reserve(capacity);
+    publishCount = 0;
+    return true;
+}
+
+void SharedSnapshotWriter::stop() {
+    if (!header) return;
+#ifdef _WIN32
+    UnmapViewOfFile(header);
+    CloseHandle(mapping);
+    mapping = nullptr;
+#else
+    munmap(header, mappedSize);
+    // Unlink while still holding the lock, so a new writer never removes a fresh segment
+    shm_unlink(objectName.c_str());
+    ::close(descriptor);
+    descriptor = -1;
+#endif
+    header = nullptr;
+    mappedSize = 0;
+}
+
+void SharedSnapshotWriter::publish(int64_t timestampMs, const SystemUsage& systemUsage,
+                                   const std::vector<ProcessInfo>& processes) {
+    if (!header) return;
+
+    // Heaviest processes first, staged outside the seqlock window
+    std::vector<const ProcessInfo*> top;
+    top.reserve(processes.size());
+    for (const auto& process : processes) {
+        top.push_back(&process);
+    }
+    size_t keep = std::min(top.size(), static_cast<size_t>(header->capacity));
+    std::partial_sort(top.begin(), top.begin() + static_cast<std::ptrdiff_t>(keep), top.end(),
+                      [](const ProcessInfo* a, const ProcessInfo* b) {
+                          return a->getCpuPercent() + a->getRamPercent() + a->getDiskPercent() >
+                                 b->getCpuPercent() + b->getRamPercent() + b->getDiskPercent();
+                      });
+    staging.resize(keep);
+    for (size_t i = 0; i < keep; i++) {
+        SharedSnapshotProcess& record = staging[i];
+        record.pid = static_cast<uint32_t>(top[i]->getPid());
+        record.parentPid = static_cast<uint32_t>(top[i]->getPpid());
+        record.cpuPercent = top[i]->getCpuPercent();
+        record.ramPercent = top[i]->getRamPercent();
+        record.diskPercent = top[i]->getDiskPercent();
+        std::memset(record.name, 0, sizeof(record.name));
+        const std::string& name = top[i]->getName();
+        std::memcpy(record.name, name.data(), std::min(name.size(), sizeof(record.name) - 1));
+    }
+
+    uint64_t sequence = header->sequence.load(std::memory_order_relaxed);
+    header->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    header->timestampMs = timestampMs;
+    header->cycle = ++publishCount;
+    header->cpuPercent = systemUsage.getCpuPercent();
+    header->ramPercent = systemUsage.getRamPercent();
+    header->diskPercent = systemUsage.getDiskPercent();
+    header->totalProcesses = static_cast<uint32_t>(processes.size());
+    header->processCount = static_cast<uint32_t>(keep);
+    if (keep > 0) {
+        std::memcpy(reinterpret_cast<SharedSnapshotProcess*>(header + 1), staging.data(), keep * sizeof(SharedSnapshotProcess));
+    }
+
+    header->sequence.store(sequence + 2, std::memory_order_release);
+}
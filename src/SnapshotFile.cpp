@@ -0,0 +1,301 @@
+#include "../include/SnapshotFile.h"
+#include <cstring>
+#include <iterator>
+
+namespace {
+
+const char MAGIC[8] = { 'S', 'M', 'S', 'N', 'A', 'P', '\x01', '\n' };
+const uint8_t CYCLE_TAG = 'C';
+
+// Flags of one process record: which optional values follow
+const uint8_t HAS_CPU = 0x01;
+const uint8_t HAS_RAM = 0x02;
+const uint8_t HAS_DISK = 0x04;
+const uint8_t HAS_IO_BYTES = 0x08;
+const uint8_t HAS_START_TIME = 0x10;
+
+void putVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+void putSigned(std::string& out, int64_t value) {
+    putVarint(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+void putFloat(std::string& out, double value) {
+    float narrowed = static_cast<float>(value);
+    uint32_t bits;
+    std::memcpy(&bits, &narrowed, sizeof(bits));
+    for (int shift = 0; shift < 32; shift += 8) {
+        out.push_back(static_cast<char>((bits >> shift) & 0xFF));
+    }
+}
+
+// Bounds-checked decoding; every get fails once the data runs out
+class Decoder {
+private:
+    const std::vector<uint8_t>& data;
+    size_t& position;
+
+public:
+    Decoder(const std::vector<uint8_t>& bytes, size_t& offset) : data(bytes), position(offset) {}
+
+    bool getByte(uint8_t& value) {
+        if (position >= data.size()) {
+            return false;
+        }
+        value = data[position++];
+        return true;
+    }
+
+    bool getVarint(uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t byte;
+            if (!getByte(byte)) {
+                return false;
+            }
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool getSigned(int64_t& value) {
+        uint64_t encoded;
+        if (!getVarint(encoded)) {
+            return false;
+        }
+        value = static_cast<int64_t>(encoded >> 1) ^ -static_cast<int64_t>(encoded & 1);
+        return true;
+    }
+
+    bool getFloat(double& value) {
+        if (data.size() - position < 4) {
+            return false;
+        }
+        uint32_t bits = 0;
+        for (int shift = 0; shift < 32; shift += 8) {
+            bits |= static_cast<uint32_t>(data[position++]) << shift;
+        }
+        float narrowed;
+        std::memcpy(&narrowed, &bits, sizeof(narrowed));
+        value = narrowed;
+        return true;
+    }
+
+    bool getText(size_t length, std::string& value) {
+        if (data.size() - position < length) {
+            return false;
+        }
+        value.assign(reinterpret_cast<const char*>(data.data() + position), length);
+        position += length;
+        return true;
+    }
+};
+
+} // namespace
+
+// SnapshotWriter implementation
+SnapshotWriter::~SnapshotWriter() {
+    close();
+}
+
+bool SnapshotWriter::open(const std::string& path) {
+    close();
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+    filePath = path;
+    nameIds.clear();
+    lastTimestampMs = 0;
+    cycleCount = 0;
+    file.write(MAGIC, sizeof(MAGIC));
+    file.flush();
+    bytesWritten = sizeof(MAGIC);
+    return file.good();
+}
+
+void SnapshotWriter::close() {
+    if (file.is_open()) {
+        file.close();
+    }
+}
+
+bool SnapshotWriter::writeCycle(int64_t timestampMs, const SystemUsage& systemUsage,
+                                const std::vector<ProcessInfo>& processes) {
+    if (!file.is_open()) {
+        return false;
+    }
+
+    buffer.clear();
+    buffer.push_back(static_cast<char>(CYCLE_TAG));
+    putSigned(buffer, timestampMs - lastTimestampMs);
+    putFloat(buffer, systemUsage.getCpuPercent());
+    putFloat(buffer, systemUsage.getRamPercent());
+    putFloat(buffer, systemUsage.getDiskPercent());
+    putVarint(buffer, processes.size());
+
+    int64_t previousPid = 0;
+    for (const auto& process : processes) {
+        putSigned(buffer, static_cast<int64_t>(process.getPid()) - previousPid);
+        previousPid = process.getPid();
+        putVarint(buffer, process.getPpid());
+
+        // A name not seen before is written inline with the next free index
+        auto inserted = nameIds.emplace(process.getName(), static_cast<uint32_t>(nameIds.size()));
+        putVarint(buffer, inserted.first->second);
+        if (inserted.second) {
+            putVarint(buffer, process.getName().size());
+            buffer.append(process.getName());
+        }
+
+        uint8_t flags = (process.getCpuPercent() != 0.0 ? HAS_CPU : 0) |
+                        (process.getRamPercent() != 0.0 ? HAS_RAM : 0) |
+                        (process.getDiskPercent() != 0.0 ? HAS_DISK : 0) |
+                        (process.getDiskIoBytes() != 0 ? HAS_IO_BYTES : 0) |
+                        (process.getStartTime() != 0 ? HAS_START_TIME : 0);
+        buffer.push_back(static_cast<char>(flags));
+        if (flags & HAS_CPU) putFloat(buffer, process.getCpuPercent());
+        if (flags & HAS_RAM) putFloat(buffer, process.getRamPercent());
+        if (flags & HAS_DISK) putFloat(buffer, process.getDiskPercent());
+        if (flags & HAS_IO_BYTES) putVarint(buffer, process.getDiskIoBytes());
+        if (flags & HAS_START_TIME) putVarint(buffer, process.getStartTime());
+    }
+
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    file.flush();
+    if (!file.good()) {
+        return false;
+    }
+    lastTimestampMs = timestampMs;
+    bytesWritten += buffer.size();
+    cycleCount++;
+    return true;
+}
+
+// SnapshotReader implementation
+bool SnapshotReader::open(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    if (data.size() < sizeof(MAGIC) || std::memcmp(data.data(), MAGIC, sizeof(MAGIC)) != 0) {
+        data.clear();
+        return false;
+    }
+    position = sizeof(MAGIC);
+    names.clear();
+    current = SnapshotCycle();
+    firstTimestampMs = 0;
+    cycleCount = 0;
+    truncated = false;
+    return true;
+}
+
+bool SnapshotReader::next() {
+    if (position >= data.size()) {
+        return false;
+    }
+
+    // Decode from a copy of the position; a partial record ends the replay
+    size_t offset = position;
+    Decoder decoder(data, offset);
+    uint8_t tag = 0;
+    int64_t timestampDelta = 0;
+    double cpu = 0.0, ram = 0.0, disk = 0.0;
+    uint64_t processCount = 0;
+    if (!decoder.getByte(tag) || tag != CYCLE_TAG || !decoder.getSigned(timestampDelta) ||
+        !decoder.getFloat(cpu) || !decoder.getFloat(ram) || !decoder.getFloat(disk) ||
+        !decoder.getVarint(processCount) || processCount > data.size() - offset) {
+        truncated = true;
+        return false;
+    }
+
+    std::vector<ProcessInfo>& processes = current.processes;
+    processes.clear();
+    processes.reserve(static_cast<size_t>(processCount));
+    int64_t pid = 0;
+    for (uint64_t i = 0; i < processCount; i++) {
+        int64_t pidDelta = 0;
+        uint64_t ppid = 0, nameId = 0, nameLength = 0, ioBytes = 0, startTime = 0;
+        uint8_t flags = 0;
+        double cpuPercent = 0.0, ramPercent = 0.0, diskPercent = 0.0;
+        std::string name;
+        bool complete = decoder.getSigned(pidDelta) && decoder.getVarint(ppid) && decoder.getVarint(nameId) &&
+                        nameId <= names.size() &&
+                        (nameId < names.size() ||
+                         (decoder.getVarint(nameLength) && decoder.getText(static_cast<size_t>(nameLength), name))) &&
+                        decoder.getByte(flags) &&
+                        (!(flags & HAS_CPU) || decoder.getFloat(cpuPercent)) &&
+                        (!(flags & HAS_RAM) || decoder.getFloat(ramPercent)) &&
+                        (!(flags & HAS_DISK) || decoder.getFloat(diskPercent)) &&
+                        (!(flags & HAS_IO_BYTES) || decoder.getVarint(ioBytes)) &&
+                        (!(flags & HAS_START_TIME) || decoder.getVarint(startTime));
+        if (!complete) {
+            truncated = true;
+            return false;
+        }
+        if (nameId == names.size()) {
+            names.push_back(name);
+        }
+        pid += pidDelta;
+
+        ProcessInfo process(static_cast<DWORD>(pid), static_cast<DWORD>(ppid), names[static_cast<size_t>(nameId)]);
+        process.setCpuPercent(cpuPercent);
+        process.setRamPercent(ramPercent);
+        process.setDiskPercent(diskPercent);
+        process.setDiskIoBytes(ioBytes);
+        process.setStartTime(startTime);
+        processes.push_back(process);
+    }
+
+    current.timestampMs += timestampDelta;
+    current.systemUsage = SystemUsage(cpu, ram, disk);
+    if (cycleCount == 0) {
+        firstTimestampMs = current.timestampMs;
+    }
+    cycleCount++;
+    position = offset;
+    return true;
+}
+
+// ReplaySystemMonitor implementation
+ReplaySystemMonitor::ReplaySystemMonitor(std::shared_ptr<SnapshotReader> snapshotReader)
+    : reader(std::move(snapshotReader)) {
+}
+
+SystemUsage ReplaySystemMonitor::getSystemUsage() {
+    return reader->getCurrent().systemUsage;
+}
+
+SystemMetrics ReplaySystemMonitor::getCurrentMetrics() const {
+    const SystemUsage& usage = reader->getCurrent().systemUsage;
+    SystemMetrics metrics;
+    metrics.setCpuPercent(usage.getCpuPercent());
+    metrics.setRamPercent(usage.getRamPercent());
+    metrics.setDiskPercent(usage.getDiskPercent());
+    return metrics;
+}
+
+// ReplayProcessManager implementation
+ReplayProcessManager::ReplayProcessManager(std::shared_ptr<SnapshotReader> snapshotReader)
+    : reader(std::move(snapshotReader)) {
+}
+
+std::vector<ProcessInfo> ReplayProcessManager::getAllProcesses() {
+    return reader->getCurrent().processes;
+}
+
+std::vector<ProcessInfo> ReplayProcessManager::getAggregatedProcessTree(const std::vector<ProcessInfo>& processes) {
+    ProcessTreeAggregator aggregator;
+    return aggregator.aggregate(processes);
+}
@@ -0,0 +1,146 @@
+#include "../include/StageProfiler.h"
+#include <sstream>
+#include <iomanip>
+
+namespace {
+
+int highestBit(uint64_t value) {
+    int bit = 0;
+    while (value >>= 1) {
+        bit++;
+    }
+    return bit;
+}
+
+std::string formatMicros(uint64_t micros) {
+    std::ostringstream text;
+    if (micros < 1000) {
+        text << micros << "us";
+    } else if (micros < 1000000) {
+        text << std::fixed << std::setprecision(2) << micros / 1000.0 << "ms";
+    } else {
+        text << std::fixed << std::setprecision(2) << micros / 1000000.0 << "s";
+    }
+    return text.str();
+}
+
+} // namespace
+
+// LatencyHistogram implementation
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+size_t LatencyHistogram::bucketIndex(uint64_t micros) {
+    if (micros < LINEAR_LIMIT) {
+        return static_cast<size_t>(micros);
+    }
+    int exponent = highestBit(micros);
+    if (exponent >= MAX_EXPONENT) {
+        return BUCKET_COUNT - 1;
+    }
+    // Top SUB_BUCKET_BITS bits below the leading one pick the sub-bucket
+    uint64_t subBucket = (micros >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+    return static_cast<size_t>(LINEAR_LIMIT + (exponent - SUB_BUCKET_BITS - 1) * SUB_BUCKETS + subBucket);
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index) {
+    if (index < LINEAR_LIMIT) {
+        return index;
+    }
+    size_t offset = index - LINEAR_LIMIT;
+    int exponent = static_cast<int>(offset / SUB_BUCKETS) + SUB_BUCKET_BITS + 1;
+    uint64_t subBucket = offset % SUB_BUCKETS;
+    int shift = exponent - SUB_BUCKET_BITS;
+    return ((SUB_BUCKETS + subBucket + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t micros) {
+    buckets[bucketIndex(micros)].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(micros, std::memory_order_relaxed);
+
+    uint64_t currentMax = maxValue.load(std::memory_order_relaxed);
+    while (micros > currentMax &&
+           !maxValue.compare_exchange_weak(currentMax, micros, std::memory_order_relaxed)) {
+    }
+}
+
+void LatencyHistogram::reset() {
+    for (auto& bucket : buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count.store(0, std::memory_order_relaxed);
+    sum.store(0, std::memory_order_relaxed);
+    maxValue.store(0, std::memory_order_relaxed);
+}
+
+double LatencyHistogram::getMean() const {
+    uint64_t recorded = getCount();
+    return recorded > 0 ? (double)sum.load(std::memory_order_relaxed) / (double)recorded : 0.0;
+}
+
+uint64_t LatencyHistogram::getPercentile(double quantile) const {
+    uint64_t recorded = getCount();
+    if (recorded == 0) {
+        return 0;
+    }
+    uint64_t rank = static_cast<uint64_t>(quantile * (double)recorded + 0.5);
+    if (rank < 1) rank = 1;
+    if (rank > recorded) rank = recorded;
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        seen += buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            // Never report more than was actually recorded
+            uint64_t bound = bucketUpperBound(i);
+            uint64_t maximum = getMax();
+            return bound < maximum ? bound : maximum;
+        }
+    }
+    return getMax();
+}
+
+// StageProfiler implementation
+const char* StageProfiler::stageName(CycleStage stage) {
+    switch (stage) {
+        case CycleStage::SYSTEM_USAGE: return "System usage";
+        case CycleStage::PROCESS_COLLECTION: return "Process collection";
+        case CycleStage::AGGREGATION: return "Aggregation";
+        case CycleStage::ALERT_EVALUATION: return "Alert evaluation";
+        case CycleStage::DISPLAY: return "Display";
+        case CycleStage::FILTERING: return "Filtering";
+        case CycleStage::LOGGING: return "Logging";
+        case CycleStage::EMAIL: return "Email";
+        case CycleStage::HISTORY: return "History";
+        case CycleStage::EXPORT: return "Export";
+        case CycleStage::BURST_SAMPLE: return "Burst sample";
+        case CycleStage::CYCLE_TOTAL: return "Cycle total";
+        default: return "Unknown";
+    }
+}
+
+void StageProfiler::reset() {
+    for (auto& histogram : histograms) {
+        histogram.reset();
+    }
+}
+
+std::string StageProfiler::formatTable() const {
+    std::ostringstream table;
+    table << std::left << std::setw(20) << "Stage" << std::right << std::setw(10) << "Count"
+          << std::setw(12) << "p50" << std::setw(12) << "p99" << std::setw(12) << "Max" << "\n";
+    for (size_t i = 0; i < static_cast<size_t>(CycleStage::COUNT); i++) {
+        const LatencyHistogram& histogram = histograms[i];
+        if (histogram.getCount() == 0) {
+            continue;
+        }
+        table << std::left << std::setw(20) << stageName(static_cast<CycleStage>(i)) << std::right
+              << std::setw(10) << histogram.getCount()
+              << std::setw(12) << formatMicros(histogram.getPercentile(0.50))
+              << std::setw(12) << formatMicros(histogram.getPercentile(0.99))
+              << std::setw(12) << formatMicros(histogram.getMax()) << "\n";
+    }
+    return table.str();
+}
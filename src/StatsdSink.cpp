@@ -0,0 +1,333 @@
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+// Winsock 2 has to come before windows.h (pulled in by SystemMetrics.h)
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <netdb.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+#include "../include/StatsdSink.h"
+#include "../include/TraceRecorder.h"
+#include <algorithm>
+#include <cstdio>
+#include <unordered_map>
+
+namespace {
+
+#ifdef _WIN32
+typedef SOCKET NativeSocket;
+const NativeSocket NO_SOCKET = INVALID_SOCKET;
+
+void closeSocket(NativeSocket socket) {
+    closesocket(socket);
+}
+
+bool setNonBlocking(NativeSocket socket) {
+    u_long enabled = 1;
+    return ioctlsocket(socket, FIONBIO, &enabled) == 0;
+}
+#else
+typedef int NativeSocket;
+const NativeSocket NO_SOCKET = -1;
+
+void closeSocket(NativeSocket socket) {
+    close(socket);
+}
+
+bool setNonBlocking(NativeSocket socket) {
+    int flags = fcntl(socket, F_GETFL, 0);
+    return flags >= 0 && fcntl(socket, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+#endif
+
+NativeSocket native(intptr_t socket) {
+    return static_cast<NativeSocket>(socket);
+}
+
+// Splits "host:port" or "[v6]:port"
+bool splitAddress(const std::string& address, std::string& host, std::string& port) {
+    size_t colon = address.rfind(':');
+    if (colon == std::string::npos || colon + 1 == address.size()) {
+        return false;
+    }
+    host = address.substr(0, colon);
+    port = address.substr(colon + 1);
+    if (host.size() >= 2 && host.front() == '[' && host.back() == ']') {
+        host = host.substr(1, host.size() - 2);
+    }
+    return !host.empty();
+}
+
+void appendGauge(std::string& line, double value) {
+    char text[32];
+    snprintf(text, sizeof(text), ":%.2f|g", value);
+    line += text;
+}
+
+struct NameUsage {
+    double cpu = 0.0;
+    double ram = 0.0;
+    double disk = 0.0;
+};
+
+} // namespace
+
+StatsdSink::~StatsdSink() {
+    stop();
+}
+
+bool StatsdSink::start(const std::string& address) {
+    if (running || worker.joinable()) {
+        return false;
+    }
+    std::string host, port;
+    if (!splitAddress(address, host, port)) {
+        return false;
+    }
+#ifdef _WIN32
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+        return false;
+    }
+#endif
+
+    addrinfo hints = {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM;
+    addrinfo* resolved = nullptr;
+    NativeSocket sender = NO_SOCKET;
+    if (getaddrinfo(host.c_str(), port.c_str(), &hints, &resolved) == 0) {
+        for (addrinfo* candidate = resolved; candidate && sender == NO_SOCKET; candidate = candidate->ai_next) {
+            sender = socket(candidate->ai_family, candidate->ai_socktype, candidate->ai_protocol);
+            // Connected, so every send names no address and the kernel routes once
+            if (sender != NO_SOCKET &&
+                (connect(sender, candidate->ai_addr, static_cast<int>(candidate->ai_addrlen)) != 0 ||
+                 !setNonBlocking(sender))) {
+                closeSocket(sender);
+                sender = NO_SOCKET;
+            }
+        }
+        freeaddrinfo(resolved);
+    }
+    if (sender == NO_SOCKET) {
+#ifdef _WIN32
+        WSACleanup();
+#endif
+        return false;
+    }
+
+    udpSocket = static_cast<intptr_t>(sender);
+    running = true;
+    worker = std::thread(&StatsdSink::workerThreadFunction, this);
+    return true;
+}
+
+void StatsdSink::stop() {
+    if (!running) {
+        return;
+    }
+    running = false;
+    queue.shutdown();
+    if (worker.joinable()) {
+        worker.join();
+    }
+    closeSocket(native(udpSocket));
+    udpSocket = -1;
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+void StatsdSink::setMaxPacketBytes(size_t value) {
+    maxPacketBytes = std::max(MIN_PACKET_BYTES, std::min(value, MAX_PACKET_BYTES));
+}
+
+void StatsdSink::append(int64_t timestampMs, const SystemUsage& systemUsage, const std::vector<ProcessInfo>& processes) {
+    if (!running) {
+        return;
+    }
+    if (queue.size() >= QUEUE_LIMIT) {
+        droppedCycles++;
+        return;
+    }
+    Cycle cycle;
+    cycle.timestampMs = timestampMs;
+    cycle.systemUsage = systemUsage;
+    cycle.processes = processes;
+    queue.push(std::move(cycle));
+}
+
+void StatsdSink::workerThreadFunction() {
+    TraceRecorder::instance().setThreadName("StatsD sink");
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point nextFlush = Clock::now() + std::chrono::milliseconds(flushIntervalMs.load());
+    Cycle cycle;
+    for (;;) {
+        Clock::time_point now = Clock::now();
+        if (queue.popFor(cycle, nextFlush > now ? nextFlush - now : Clock::duration::zero())) {
+            writeCycle(cycle);
+        } else if (!running) {
+            break;
+        }
+        now = Clock::now();
+        if (now >= nextFlush) {
+            flush();
+            nextFlush = now + std::chrono::milliseconds(flushIntervalMs.load());
+        }
+    }
+    flush();
+}
+
+void StatsdSink::writeCycle(const Cycle& cycle) {
+    TraceScope scope("StatsD format", "export");
+    size_t limit = maxPacketBytes;
+    if (limit != packetBytes) {
+        closeDatagram();
+        packetBytes = limit;
+    }
+    StatsdFormat lineFormat = format;
+
+    std::string line;
+    auto systemGauge = [&](const char* name, double value) {
+        line = "systemmonitor.";
+        line += name;
+        appendGauge(line, value);
+        addLine(line);
+    };
+    systemGauge("cpu_percent", cycle.systemUsage.getCpuPercent());
+    systemGauge("ram_percent", cycle.systemUsage.getRamPercent());
+    systemGauge("disk_percent", cycle.systemUsage.getDiskPercent());
+    systemGauge("processes", static_cast<double>(cycle.processes.size()));
+
+    // Instances of a name are summed, which keeps the series count stable
+    std::unordered_map<std::string, NameUsage> byName;
+    byName.reserve(cycle.processes.size());
+    for (const auto& process : cycle.processes) {
+        NameUsage& usage = byName[process.getName()];
+        usage.cpu += process.getCpuPercent();
+        usage.ram += process.getRamPercent();
+        usage.disk += process.getDiskPercent();
+    }
+    std::vector<std::pair<const std::string*, const NameUsage*>> top;
+    top.reserve(byName.size());
+    for (const auto& entry : byName) {
+        top.emplace_back(&entry.first, &entry.second);
+    }
+    size_t keep = std::min(top.size(), topProcesses.load());
+    std::partial_sort(top.begin(), top.begin() + static_cast<std::ptrdiff_t>(keep), top.end(),
+                      [](const std::pair<const std::string*, const NameUsage*>& a,
+                         const std::pair<const std::string*, const NameUsage*>& b) {
+                          return a.second->cpu + a.second->ram + a.second->disk >
+                                 b.second->cpu + b.second->ram + b.second->disk;
+                      });
+
+    const char* metrics[] = { "cpu_percent", "ram_percent", "disk_percent" };
+    for (size_t i = 0; i < keep; i++) {
+        const NameUsage& usage = *top[i].second;
+        double values[] = { usage.cpu, usage.ram, usage.disk };
+        std::string name = sanitize(*top[i].first, lineFormat == StatsdFormat::DOGSTATSD);
+        for (size_t metric = 0; metric < 3; metric++) {
+            if (lineFormat == StatsdFormat::DOGSTATSD) {
+                line = "systemmonitor.process.";
+                line += metrics[metric];
+                appendGauge(line, values[metric]);
+                line += "|#process:";
+                line += name;
+            } else {
+                line = "systemmonitor.process.";
+                line += name;
+                line += '.';
+                line += metrics[metric];
+                appendGauge(line, values[metric]);
+            }
+            addLine(line);
+        }
+    }
+}
+
+void StatsdSink::addLine(const std::string& line) {
+    if (line.size() > packetBytes) {
+        droppedDatagrams++;             // Cannot fit any datagram; a server would truncate it
+        return;
+    }
+    if (!datagram.empty() && datagram.size() + 1 + line.size() > packetBytes) {
+        closeDatagram();
+    }
+    if (!datagram.empty()) {
+        datagram += '\n';
+    }
+    datagram += line;
+}
+
+void StatsdSink::closeDatagram() {
+    if (datagram.empty()) {
+        return;
+    }
+    if (pending.size() >= MAX_PENDING_DATAGRAMS) {
+        droppedDatagrams++;
+    } else {
+        pending.push_back(std::move(datagram));
+    }
+    datagram.clear();
+}
+
+void StatsdSink::flush() {
+    closeDatagram();
+    if (pending.empty()) {
+        return;
+    }
+    TraceScope scope("StatsD flush", "export");
+    size_t index = 0;
+#ifdef __linux__
+    // Up to SEND_BATCH datagrams per system call
+    mmsghdr messages[SEND_BATCH];
+    iovec vectors[SEND_BATCH];
+    while (index < pending.size()) {
+        unsigned int batch = static_cast<unsigned int>(std::min(SEND_BATCH, pending.size() - index));
+        for (unsigned int i = 0; i < batch; i++) {
+            vectors[i].iov_base = &pending[index + i][0];
+            vectors[i].iov_len = pending[index + i].size();
+            messages[i] = mmsghdr();
+            messages[i].msg_hdr.msg_iov = &vectors[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+        }
+        int sent = sendmmsg(native(udpSocket), messages, batch, MSG_DONTWAIT);
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent <= 0) {
+            break;                      // Socket buffer full or collector unreachable
+        }
+        sentDatagrams += static_cast<uint64_t>(sent);
+        index += static_cast<size_t>(sent);
+    }
+#else
+    while (index < pending.size()) {
+        if (send(native(udpSocket), pending[index].data(), static_cast<int>(pending[index].size()), 0) < 0) {
+            break;
+        }
+        sentDatagrams++;
+        index++;
+    }
+#endif
+    droppedDatagrams += pending.size() - index;
+    pending.clear();
+}
+
+std::string StatsdSink::sanitize(const std::string& name, bool tagValue) {
+    std::string out;
+    out.reserve(name.size());
+    for (char c : name) {
+        bool keep = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+                    c == '-' || c == '_' || (tagValue && c == '.');
+        out.push_back(keep ? c : '_');
+    }
+    return out.empty() ? "_" : out;
+}
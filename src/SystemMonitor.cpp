@@ -90,8 +90,7 @@ SystemUsage WindowsSystemMonitor::getSystemUsage() {
     }
 
     try {
-        // Get CPU usage
-        Sleep(100);  // Small delay for accurate measurement
+        // Get CPU usage over the time since the previous call (one sampling tick)
         CpuTimes now = getSystemCpuTimes();
         
         ULONGLONG idle = now.getIdleTime() - lastCpuTimes.getIdleTime();
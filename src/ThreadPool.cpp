@@ -0,0 +1,148 @@
+#include "../include/ThreadPool.h"
+#include <algorithm>
+
+ThreadPool::ThreadPool(size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = defaultThreadCount();
+    }
+    for (size_t i = 0; i < threadCount; i++) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+    for (size_t i = 1; i < threadCount; i++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (auto& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+size_t ThreadPool::defaultThreadCount() {
+    size_t hardwareThreads = std::thread::hardware_concurrency();
+    if (hardwareThreads == 0) {
+        hardwareThreads = 1;
+    }
+    return std::min(hardwareThreads, MAX_DEFAULT_THREADS);
+}
+
+bool ThreadPool::popLocal(size_t index, Chunk& chunk) {
+    WorkQueue& queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.chunks.empty()) {
+        return false;
+    }
+    chunk = queue.chunks.back();
+    queue.chunks.pop_back();
+    return true;
+}
+
+bool ThreadPool::steal(size_t thief, Chunk& chunk) {
+    // Start with the next queue so thieves spread over different victims
+    for (size_t offset = 1; offset < queues.size(); offset++) {
+        WorkQueue& queue = *queues[(thief + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.chunks.empty()) {
+            chunk = queue.chunks.front();
+            queue.chunks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::runChunks(size_t index) {
+    Chunk chunk;
+    while (popLocal(index, chunk) || steal(index, chunk)) {
+        try {
+            (*chunk.body)(chunk.begin, chunk.end);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            if (!firstError) {
+                firstError = std::current_exception();
+            }
+        }
+
+        if (pendingChunks.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            batchFinished.notify_all();
+        }
+    }
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    uint64_t seenBatch = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(stateMutex);
+            workAvailable.wait(lock, [&] { return stopping || batchId != seenBatch; });
+            if (stopping) {
+                return;
+            }
+            seenBatch = batchId;
+        }
+        runChunks(index);
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, size_t chunkSize, const RangeFunction& body) {
+    if (count == 0) {
+        return;
+    }
+    if (chunkSize == 0) {
+        chunkSize = 1;
+    }
+
+    // Nothing to share: run inline without touching the queues
+    if (queues.size() == 1 || count <= chunkSize) {
+        for (size_t begin = 0; begin < count; begin += chunkSize) {
+            body(begin, std::min(begin + chunkSize, count));
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> batchLock(batchMutex);
+
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        firstError = nullptr;
+    }
+
+    // Workers still draining the previous batch may pick chunks up as soon as they are queued
+    size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+    pendingChunks.store(chunkCount, std::memory_order_release);
+    for (size_t i = 0; i < chunkCount; i++) {
+        size_t begin = i * chunkSize;
+        Chunk chunk = { begin, std::min(begin + chunkSize, count), &body };
+        WorkQueue& queue = *queues[i % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.chunks.push_back(chunk);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        batchId++;
+    }
+    workAvailable.notify_all();
+
+    runChunks(0);
+
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(stateMutex);
+        batchFinished.wait(lock, [&] { return pendingChunks.load(std::memory_order_acquire) == 0; });
+        error = firstError;
+        firstError = nullptr;
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
@@ -0,0 +1,67 @@
+#include "../include/TickScheduler.h"
+#include <algorithm>
+
+TickScheduler::TickScheduler(std::chrono::milliseconds tickInterval)
+    : interval(std::max(tickInterval, std::chrono::milliseconds(MIN_INTERVAL_MS))) {
+}
+
+void TickScheduler::start(Clock::time_point now) {
+    nextDeadline = now;
+    lastDeadline = now;
+    started = true;
+    stats = TickStats();
+    std::lock_guard<std::mutex> lock(waitMutex);
+    interrupted = false;
+}
+
+void TickScheduler::setInterval(std::chrono::milliseconds tickInterval) {
+    tickInterval = std::max(tickInterval, std::chrono::milliseconds(MIN_INTERVAL_MS));
+    if (tickInterval == interval) {
+        return;
+    }
+    interval = tickInterval;
+    if (started && stats.ticks > 0) {
+        nextDeadline = lastDeadline + interval;
+    }
+}
+
+bool TickScheduler::waitForNextTick() {
+    if (!started) {
+        start();
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(waitMutex);
+        wakeCondition.wait_until(lock, nextDeadline, [this] { return interrupted; });
+        if (interrupted) {
+            return false;
+        }
+    }
+
+    // Coalesce overruns onto the latest deadline that has passed
+    Clock::time_point now = Clock::now();
+    Clock::time_point deadline = nextDeadline;
+    lastMissed = 0;
+    if (now - deadline >= interval) {
+        lastMissed = static_cast<uint64_t>((now - deadline) / interval);
+        deadline += interval * static_cast<int64_t>(lastMissed);
+    }
+    lastDeadline = deadline;
+    nextDeadline = deadline + interval;
+
+    auto jitter = std::chrono::duration_cast<std::chrono::microseconds>(now - deadline);
+    stats.ticks++;
+    stats.missedTicks += lastMissed;
+    stats.lastJitter = jitter;
+    stats.maxJitter = std::max(stats.maxJitter, jitter);
+    stats.meanJitterUs += (static_cast<double>(jitter.count()) - stats.meanJitterUs) / static_cast<double>(stats.ticks);
+    return true;
+}
+
+void TickScheduler::interrupt() {
+    {
+        std::lock_guard<std::mutex> lock(waitMutex);
+        interrupted = true;
+    }
+    wakeCondition.notify_all();
+}
@@ -0,0 +1,225 @@
+#include "../include/TraceRecorder.h"
+#include <thread>
+
+namespace {
+
+std::atomic<uint64_t> nextRecorderId{1};
+
+// Last buffer the calling thread used, so recording skips the registry lookup
+struct LocalBufferCache {
+    uint64_t recorderId = 0;
+    void* buffer = nullptr;
+};
+thread_local LocalBufferCache localCache;
+
+int64_t microsBetween(TraceRecorder::Clock::time_point from, TraceRecorder::Clock::time_point to) {
+    int64_t micros = std::chrono::duration_cast<std::chrono::microseconds>(to - from).count();
+    return micros > 0 ? micros : 0;
+}
+
+void writeEscaped(std::ofstream& out, const char* text) {
+    for (const char* c = text ? text : ""; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            out << '\\';
+        }
+        out << (static_cast<unsigned char>(*c) < 0x20 ? ' ' : *c);
+    }
+}
+
+} // namespace
+
+TraceRecorder::TraceRecorder(size_t eventsPerThread)
+    : capacity(eventsPerThread > 0 ? eventsPerThread : 1),
+      recorderId(nextRecorderId.fetch_add(1)) {
+}
+
+TraceRecorder::~TraceRecorder() {
+    stop();
+}
+
+TraceRecorder& TraceRecorder::instance() {
+    static TraceRecorder recorder;
+    return recorder;
+}
+
+TraceRecorder::ThreadBuffer* TraceRecorder::localBuffer() {
+    if (localCache.recorderId == recorderId) {
+        return static_cast<ThreadBuffer*>(localCache.buffer);
+    }
+
+    // First event of this thread (or the thread last recorded into another recorder)
+    static thread_local std::vector<std::pair<uint64_t, ThreadBuffer*>> owned;
+    ThreadBuffer* buffer = nullptr;
+    for (const auto& entry : owned) {
+        if (entry.first == recorderId) {
+            buffer = entry.second;
+            break;
+        }
+    }
+    if (!buffer) {
+        auto created = std::make_unique<ThreadBuffer>();
+        created->events.reset(new Event[capacity]);
+        buffer = created.get();
+        std::lock_guard<std::mutex> lock(registryMutex);
+        buffer->tid = static_cast<uint32_t>(buffers.size() + 1);
+        buffers.push_back(std::move(created));
+        owned.emplace_back(recorderId, buffer);
+    }
+    localCache.recorderId = recorderId;
+    localCache.buffer = buffer;
+    return buffer;
+}
+
+void TraceRecorder::push(const Event& event) {
+    ThreadBuffer* buffer = localBuffer();
+    size_t head = buffer->head.load(std::memory_order_relaxed);
+    size_t tail = buffer->tail.load(std::memory_order_acquire);
+    if (head - tail >= capacity) {
+        droppedEvents.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    buffer->events[head % capacity] = event;
+    buffer->head.store(head + 1, std::memory_order_release);
+}
+
+bool TraceRecorder::start(const std::string& path) {
+    std::lock_guard<std::mutex> lock(fileMutex);
+    if (enabled.load()) {
+        return false;
+    }
+    file.open(path, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+    filePath = path;
+    file << "{\"traceEvents\":[\n";
+    firstEvent = true;
+    writtenEvents = 0;
+    droppedEvents.store(0);
+
+    // Forget anything left from an earlier session
+    {
+        std::lock_guard<std::mutex> registryLock(registryMutex);
+        for (auto& buffer : buffers) {
+            buffer->tail.store(buffer->head.load(std::memory_order_acquire), std::memory_order_release);
+            buffer->nameWritten = false;
+        }
+    }
+
+    origin = Clock::now();
+    enabled.store(true);
+    return true;
+}
+
+void TraceRecorder::stop() {
+    if (!enabled.exchange(false)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(fileMutex);
+    flushLocked();
+    file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    file.close();
+}
+
+void TraceRecorder::setThreadName(const char* name) {
+    if (!isEnabled()) {
+        return;
+    }
+    ThreadBuffer* buffer = localBuffer();
+    std::lock_guard<std::mutex> lock(registryMutex);
+    buffer->threadName = name;
+}
+
+void TraceRecorder::complete(const char* name, const char* category, Clock::time_point begin, Clock::time_point end) {
+    if (!isEnabled()) {
+        return;
+    }
+    Event event;
+    event.name = name;
+    event.category = category;
+    event.timestampUs = microsBetween(origin, begin);
+    event.durationUs = microsBetween(begin, end);
+    event.phase = 'X';
+    push(event);
+}
+
+void TraceRecorder::counter(const char* name, int64_t value, Clock::time_point when) {
+    if (!isEnabled()) {
+        return;
+    }
+    Event event;
+    event.name = name;
+    event.category = "counter";
+    event.timestampUs = microsBetween(origin, when);
+    event.value = value;
+    event.phase = 'C';
+    push(event);
+}
+
+void TraceRecorder::flush() {
+    std::lock_guard<std::mutex> lock(fileMutex);
+    if (!file.is_open()) {
+        return;
+    }
+    flushLocked();
+    file.flush();
+}
+
+uint64_t TraceRecorder::getWrittenCount() {
+    std::lock_guard<std::mutex> lock(fileMutex);
+    return writtenEvents;
+}
+
+void TraceRecorder::writeThreadName(ThreadBuffer& buffer, const char* name) {
+    file << (firstEvent ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer.tid
+         << ",\"args\":{\"name\":\"";
+    writeEscaped(file, name);
+    file << "\"}}";
+    firstEvent = false;
+    buffer.nameWritten = true;
+}
+
+void TraceRecorder::writeEvent(const ThreadBuffer& buffer, const Event& event) {
+    file << (firstEvent ? "" : ",\n") << "{\"name\":\"";
+    writeEscaped(file, event.name);
+    file << "\",\"cat\":\"";
+    writeEscaped(file, event.category);
+    file << "\",\"ph\":\"" << event.phase << "\",\"ts\":" << event.timestampUs;
+    if (event.phase == 'C') {
+        file << ",\"pid\":1,\"tid\":" << buffer.tid << ",\"args\":{\"value\":" << event.value << "}}";
+    } else {
+        file << ",\"dur\":" << event.durationUs << ",\"pid\":1,\"tid\":" << buffer.tid << "}";
+    }
+    firstEvent = false;
+    writtenEvents++;
+}
+
+void TraceRecorder::flushLocked() {
+    if (!file.is_open()) {
+        return;
+    }
+
+    // Snapshot the registry; names are set under the same lock
+    std::vector<std::pair<ThreadBuffer*, const char*>> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        snapshot.reserve(buffers.size());
+        for (auto& buffer : buffers) {
+            snapshot.emplace_back(buffer.get(), buffer->threadName);
+        }
+    }
+
+    for (auto& entry : snapshot) {
+        ThreadBuffer& buffer = *entry.first;
+        if (entry.second && !buffer.nameWritten) {
+            writeThreadName(buffer, entry.second);
+        }
+
+        size_t head = buffer.head.load(std::memory_order_acquire);
+        size_t tail = buffer.tail.load(std::memory_order_relaxed);
+        for (size_t i = tail; i != head; i++) {
+            writeEvent(buffer, buffer.events[i % capacity]);
+        }
+        buffer.tail.store(head, std::memory_order_release);
+    }
+}
@@ -0,0 +1,104 @@
+#include "include/AlertEngine.h"
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+static void check(bool condition, const std::string& description) {
+    std::cout << (condition ? "✅ " : "❌ ") << description << std::endl;
+    if (!condition) failures++;
+}
+
+int main() {
+    std::cout << "=== SystemMonitor Alert Engine Test ===" << std::endl;
+
+    // Rule parsing
+    AlertRule javaRule;
+    std::string error;
+    check(AlertRule::parse("process:java ram > 20 clear 15 for 60s cooldown 30m", javaRule, error),
+          "Parses per-process rule");
+    check(javaRule.processName == "java" && javaRule.clearLevel == 15.0 &&
+          javaRule.durationSeconds == 60 && javaRule.cooldownSeconds == 1800,
+          "Per-process rule fields");
+
+    AlertRule badRule;
+    bool badParsed = AlertRule::parse("process:java ram < 20", badRule, error);
+    check(!badParsed, "Rejects invalid rule: " + error);
+
+    // Independent state machines
+    std::vector<AlertRule> rules = AlertEngine::createSystemRules(80.0, 80.0, 80.0, 10, 5, 60);
+    rules.push_back(javaRule);
+    AlertEngine engine(rules);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<ProcessInfo> processes;
+    processes.push_back(ProcessInfo(100, 0, "java.exe"));
+    processes[0].setRamPercent(25.0);
+
+    int cpuFired = 0, cpuRecovered = 0, javaFired = 0, javaRecovered = 0;
+    for (int second = 0; second <= 200; second += 5) {
+        SystemUsage usage(second < 50 ? 90.0 : 10.0, 10.0, 0.0);
+        if (second >= 100) processes[0].setRamPercent(17.0);  // Inside the hysteresis band
+        if (second >= 150) processes[0].setRamPercent(10.0);  // Below clear level
+
+        for (const auto& event : engine.evaluate(usage, processes, start + std::chrono::seconds(second))) {
+            bool isJava = engine.getRule(event.ruleIndex).scope == AlertScope::PROCESS;
+            if (event.type == AlertEventType::FIRED) {
+                (isJava ? javaFired : cpuFired)++;
+            } else {
+                (isJava ? javaRecovered : cpuRecovered)++;
+            }
+        }
+    }
+
+    check(cpuFired == 1 && cpuRecovered == 1, "System CPU rule fires and recovers once");
+    check(javaFired == 1 && javaRecovered == 1, "java RAM rule fires once and holds inside hysteresis band");
+    check(!engine.anyExceeded(), "No rule exceeded at the end");
+
+    // Rate-of-change rule: RAM climbing 3%/min stays below any level threshold but trips the slope rule
+    AlertRule leakRule;
+    check(AlertRule::parse("system ram rate > 2 smooth 30s for 2m", leakRule, error),
+          "Parses rate rule");
+    AlertEngine leakEngine(std::vector<AlertRule>{ leakRule });
+    std::vector<ProcessInfo> noProcesses;
+    int leakFired = 0;
+    for (int second = 0; second <= 600; second += 5) {
+        SystemUsage usage(10.0, 40.0 + second * 3.0 / 60.0, 0.0);
+        for (const auto& event : leakEngine.evaluate(usage, noProcesses, start + std::chrono::seconds(second))) {
+            if (event.type == AlertEventType::FIRED) leakFired++;
+        }
+    }
+    check(leakFired == 1, "RAM rate rule fires once on steady growth");
+
+    // Reconfiguration: an identical rule added next to a fired one starts fresh
+    AlertRule hotRule;
+    check(AlertRule::parse("system cpu > 50 for 10s", hotRule, error), "Parses duplicated rule");
+    AlertEngine reloadEngine(std::vector<AlertRule>{ hotRule });
+    int firstFired = 0, secondFired = 0, firstRecovered = 0, secondRecovered = 0;
+    auto countEvents = [&](double cpu, int fromSecond, int toSecond) {
+        for (int second = fromSecond; second <= toSecond; second += 5) {
+            SystemUsage usage(cpu, 10.0, 0.0);
+            for (const auto& event : reloadEngine.evaluate(usage, noProcesses, start + std::chrono::seconds(second))) {
+                bool first = event.ruleIndex == 0;
+                if (event.type == AlertEventType::FIRED) {
+                    (first ? firstFired : secondFired)++;
+                } else {
+                    (first ? firstRecovered : secondRecovered)++;
+                }
+            }
+        }
+    };
+    countEvents(90.0, 0, 20);
+    reloadEngine.setRules(std::vector<AlertRule>{ hotRule, hotRule });
+    countEvents(90.0, 25, 45);
+    check(firstFired == 1 && secondFired == 1, "Each copy of a duplicated rule keeps its own state");
+    reloadEngine.setRules(std::vector<AlertRule>{ hotRule, hotRule });
+    countEvents(10.0, 50, 60);
+    check(firstRecovered == 1 && secondRecovered == 1 && firstFired == 1 && secondFired == 1,
+          "Both copies recover once after another reconfiguration");
+
+    std::cout << std::endl << (failures == 0 ? "✅ Alert engine test PASSED" : "❌ Alert engine test FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -47,7 +47,7 @@ echo Building Essential Tests...
 echo.
 
 REM Build libcurl email test (requires libcurl)
-echo [1/3] Building libcurl email test...
+echo [1/24] Building libcurl email test...
 cl /EHsc /std:c++17 libcurl_email_test.cpp ^
    /I"%VCPKG_ROOT%\installed\%VCPKG_TARGET%\include" ^
    /link /LIBPATH:"%VCPKG_ROOT%\installed\%VCPKG_TARGET%\lib" ^
@@ -59,7 +59,7 @@ if %ERRORLEVEL% NEQ 0 (
 )
 
 REM Build integration status test (no external deps)
-echo [2/3] Building integration status test...
+echo [2/24] Building integration status test...
 cl /EHsc /std:c++17 integration_status.cpp
 
 if %ERRORLEVEL% NEQ 0 (
@@ -68,7 +68,7 @@ if %ERRORLEVEL% NEQ 0 (
 )
 
 REM Build configuration test (no external deps)
-echo [3/3] Building configuration test...
+echo [3/24] Building configuration test...
 cl /EHsc /std:c++17 config_email_test.cpp
 
 if %ERRORLEVEL% NEQ 0 (
@@ -76,6 +76,195 @@ if %ERRORLEVEL% NEQ 0 (
     goto :cleanup
 )
 
+REM Build alert engine test (no external deps)
+echo [4/24] Building alert engine test...
+cl /EHsc /std:c++17 /I..\.. alert_engine_test.cpp ..\..\src\AlertEngine.cpp
+
+if %ERRORLEVEL% NEQ 0 (
+    echo ❌ Alert engine test build failed!
+    goto :cleanup
+)
+
+REM Build configuration parser test (no external deps)
+echo [5/24] Building configuration parser test...
+cl /EHsc /std:c++17 /I..\.. config_parser_test.cpp ..\..\src\Configuration.cpp ..\..\src\ConfigRegistry.cpp ..\..\src\AlertEngine.cpp
+
+if %ERRORLEVEL% NEQ 0 (
+    echo ❌ Configuration parser test build failed!
+    goto :cleanup
+)
+
+REM Build process tier test (no external deps)
+echo [6/24] Building process tier test...
+cl /EHsc /std:c++17 /I..\.. process_tier_test.cpp ..\..\src\ProcessTiers.cpp
+
+if %ERRORLEVEL% NEQ 0 (
+    echo ❌ Process tier test build failed!
+    goto :cleanup
+)
+
+REM Build tick scheduler test (no external deps)
+echo [7/24] Building tick scheduler test...
+cl /EHsc /std:c++17 /I..\.. tick_scheduler_test.cpp ..\..\src\TickScheduler.cpp
+
+if %ERRORLEVEL% NEQ 0 (
+    echo ❌ Tick scheduler test build failed!
+    goto :cleanup
+)
+
+REM Build burst capture test (no external deps)
+echo [8/24] Building burst capture test...
+cl /EHsc /std:c++17 /I..\.. burst_capture_test.cpp ..\..\src\BurstCapture.cpp
+
+if %ERRORLEVEL% NEQ 0 (
+    echo ❌ Burst capture test build failed!
+    goto :cleanup
+)
+
+REM Build self monitor test (no external deps)
+echo [9/24] Building self monitor test...
+cl /EHsc /std:c++17 /I..\.. self_monitor_test.cpp ..\..\src\SelfMonitor.cpp
+
+if %ERRORLEVEL% NEQ 0 (
+    echo ❌ Self monitor test build failed!
+    goto :cleanup
+)
+
+REM Build stage profiler test (no external deps)
+echo [10/24] Building stage profiler test...
+cl /EHsc /std:c++17 /I..\.. stage_profiler_test.cpp ..\..\src\StageProfiler.cpp ..\..\src\TraceRecorder.cpp
+
+if %ERRORLEVEL% NEQ 0 (
+    echo ❌ Stage profiler test build failed!
+    goto :cleanup
+)
+
+REM Build trace recorder test (no external deps)
+echo [11/24] Building trace recorder test...
+cl /EHsc /std:c++17 /I..\.. trace_recorder_test.cpp ..\..\src\TraceRecorder.cpp ..\..\src\StageProfiler.cpp
+
+if %ERRORLEVEL% NEQ 0 (
+    echo ❌ Trace recorder test build failed!
+    goto :cleanup
+)
+
+REM Build snapshot file test (no external deps)
+echo [12/24] Building snapshot file test...
+cl /EHsc /std:c++17 /I..\.. snapshot_file_test.cpp ..\..\src\SnapshotFile.cpp ..\..\src\ProcessManager.cpp ..\..\src\ThreadPool.cpp ..\..\src\ProcessTiers.cpp ..\..\src\Logger.cpp ..\..\src\TraceRecorder.cpp psapi.lib advapi32.lib
+
+if %ERRORLEVEL% NEQ 0 (
+    echo ❌ Snapshot file test build failed!
+    goto :cleanup
+)
+
+REM Build metric store test (no external deps)
+echo [13/24] Building metric store test...
+cl /EHsc /std:c++17 /I..\.. metric_store_test.cpp ..\..\src\MetricStore.cpp
+
+if %ERRORLEVEL% NEQ 0 (
+    echo ❌ Metric store test build failed!
+    goto :cleanup
+)
+
+REM Build history archive test (no external deps)
+echo [14/24] Building history archive test...
+cl /EHsc /std:c++17 /I..\.. history_archive_test.cpp ..\..\src\HistoryArchive.cpp ..\..\src\Logger.cpp ..\..\src\TraceRecorder.cpp
+
+if %ERRORLEVEL% NEQ 0 (
+    echo ❌ History archive test build failed!
+    goto :cleanup
+)
+
+REM Build quantile sketch test (no external deps)
+echo [15/24] Building quantile sketch test...
+cl /EHsc /std:c++17 /I..\.. quantile_sketch_test.cpp ..\..\src\QuantileSketch.cpp ..\..\src\HistoryArchive.cpp ..\..\src\Logger.cpp ..\..\src\TraceRecorder.cpp
+
+if %ERRORLEVEL% NEQ 0 (
+    echo ❌ Quantile sketch test build failed!
+    goto :cleanup
+)
+
+REM Build metrics exporter test (links ws2_32)
+echo [16/24] Building metrics exporter test...
+cl /EHsc /std:c++17 /I..\.. metrics_exporter_test.cpp ..\..\src\MetricsExporter.cpp ..\..\src\TraceRecorder.cpp ws2_32.lib
+
+if %ERRORLEVEL% NEQ 0 (
+    echo ❌ Metrics exporter test build failed!
+    goto :cleanup
+)
+
+REM Build shared snapshot test (no external deps)
+echo [17/24] Building shared snapshot test...
+cl /EHsc /std:c++17 /I..\.. shared_snapshot_test.cpp ..\..\src\SharedSnapshotWriter.cpp
+
+if %ERRORLEVEL% NEQ 0 (
+    echo ❌ Shared snapshot test build failed!
+    goto :cleanup
+)
+
+REM Build query server test (links ws2_32)
+echo [18/24] Building query server test...
+cl /EHsc /std:c++17 /I..\.. query_server_test.cpp ..\..\src\QueryServer.cpp ..\..\src\MetricStore.cpp ws2_32.lib
+
+if %ERRORLEVEL% NEQ 0 (
+    echo ❌ Query server test build failed!
+    goto :cleanup
+)
+
+REM Build StatsD sink test (links ws2_32)
+echo [19/24] Building StatsD sink test...
+cl /EHsc /std:c++17 /I..\.. statsd_sink_test.cpp ..\..\src\StatsdSink.cpp ..\..\src\TraceRecorder.cpp ws2_32.lib
+
+if %ERRORLEVEL% NEQ 0 (
+    echo ❌ StatsD sink test build failed!
+    goto :cleanup
+)
+
+REM Build JSON Lines writer test (no external deps)
+echo [20/24] Building JSON Lines writer test...
+cl /EHsc /std:c++17 /I..\.. json_lines_writer_test.cpp ..\..\src\JsonLinesWriter.cpp ..\..\src\TraceRecorder.cpp
+
+if %ERRORLEVEL% NEQ 0 (
+    echo ❌ JSON Lines writer test build failed!
+    goto :cleanup
+)
+
+REM Build columnar export test (no external deps)
+echo [21/24] Building columnar export test...
+cl /EHsc /std:c++17 /I..\.. columnar_export_test.cpp ..\..\src\ColumnarExport.cpp ..\..\src\Logger.cpp ..\..\src\TraceRecorder.cpp
+
+if %ERRORLEVEL% NEQ 0 (
+    echo ❌ Columnar export test build failed!
+    goto :cleanup
+)
+
+REM Build config watcher test (no external deps)
+echo [22/24] Building config watcher test...
+cl /EHsc /std:c++17 /I..\.. config_watcher_test.cpp ..\..\src\ConfigWatcher.cpp ..\..\src\Configuration.cpp ..\..\src\ConfigRegistry.cpp ..\..\src\AlertEngine.cpp ..\..\src\Logger.cpp ..\..\src\TraceRecorder.cpp
+
+if %ERRORLEVEL% NEQ 0 (
+    echo ❌ Config watcher test build failed!
+    goto :cleanup
+)
+
+REM Build screen renderer test (no external deps)
+echo [23/24] Building screen renderer test...
+cl /EHsc /std:c++17 /I..\.. screen_renderer_test.cpp ..\..\src\ScreenRenderer.cpp
+
+if %ERRORLEVEL% NEQ 0 (
+    echo ❌ Screen renderer test build failed!
+    goto :cleanup
+)
+
+REM Build thread pool test (no external deps)
+echo [24/24] Building thread pool test...
+cl /EHsc /std:c++17 /I..\.. thread_pool_test.cpp ..\..\src\ThreadPool.cpp
+
+if %ERRORLEVEL% NEQ 0 (
+    echo ❌ Thread pool test build failed!
+    goto :cleanup
+)
+
 echo.
 echo ✅ All essential tests built successfully!
 echo.
@@ -83,6 +272,27 @@ echo Available test executables:
 echo   - libcurl_email_test.exe    (TLS Email Integration)
 echo   - integration_status.exe    (System Integration Status)
 echo   - config_email_test.exe     (Configuration Validation)
+echo   - alert_engine_test.exe     (Alert Rule Engine)
+echo   - config_parser_test.exe    (Configuration Parser)
+echo   - process_tier_test.exe     (Process Sampling Tiers)
+echo   - tick_scheduler_test.exe   (Deadline Tick Scheduler)
+echo   - burst_capture_test.exe    (Burst Capture)
+echo   - self_monitor_test.exe     (Agent Self Monitor)
+echo   - stage_profiler_test.exe   (Stage Latency Histograms)
+echo   - trace_recorder_test.exe   (Chrome Trace Export)
+echo   - snapshot_file_test.exe    (Snapshot File)
+echo   - metric_store_test.exe     (Metric Store)
+echo   - history_archive_test.exe  (History Archive)
+echo   - quantile_sketch_test.exe  (Quantile Sketch)
+echo   - metrics_exporter_test.exe (Metrics Exporter)
+echo   - shared_snapshot_test.exe  (Shared Snapshot)
+echo   - query_server_test.exe     (Query Server)
+echo   - statsd_sink_test.exe      (StatsD Sink)
+echo   - json_lines_writer_test.exe (JSON Lines Writer)
+echo   - columnar_export_test.exe  (Columnar Export)
+echo   - config_watcher_test.exe   (Config Watcher)
+echo   - screen_renderer_test.exe  (Screen Renderer)
+echo   - thread_pool_test.exe      (Thread Pool)
 echo.
 echo To run all tests: run_essential_tests.bat
 echo To run individual test: [test_name].exe
@@ -0,0 +1,72 @@
+#include "include/BurstCapture.h"
+#include <iostream>
+#include <string>
+
+static int failures = 0;
+
+static void check(bool condition, const std::string& description) {
+    std::cout << (condition ? "✅ " : "❌ ") << description << std::endl;
+    if (!condition) failures++;
+}
+
+static ProcessInfo makeProcess(DWORD pid, const std::string& name, double cpu, double ram) {
+    ProcessInfo process(pid, 1, name);
+    process.setCpuPercent(cpu);
+    process.setRamPercent(ram);
+    return process;
+}
+
+int main() {
+    std::cout << "=== SystemMonitor Burst Capture Test ===" << std::endl;
+    using namespace std::chrono;
+
+    BurstCapture burst(2, 200, 2);
+    check(!burst.onThresholdState(false), "No burst while below thresholds");
+    check(burst.onThresholdState(true), "First crossing starts a burst");
+    check(!burst.onThresholdState(true), "Staying above does not start another");
+
+    std::vector<ProcessInfo> processes = {
+        makeProcess(10, "idle.exe", 0.0, 0.5),
+        makeProcess(20, "spike.exe", 70.0, 2.0),
+        makeProcess(30, "leak.exe", 1.0, 30.0),
+        makeProcess(40, "busy.exe", 5.0, 1.0)
+    };
+    auto start = BurstCapture::Clock::now();
+    burst.begin(processes, "system cpu > 80", start);
+    check(burst.isActive(), "Burst is active after begin");
+    check(burst.getTargets().size() == 2 && burst.getTargets()[0].pid == 20 && burst.getTargets()[1].pid == 30,
+          "Top two offenders are followed");
+    check(burst.getBurstInterval() == milliseconds(200), "Burst interval taken from the settings");
+
+    // Samples arrive without names and in any order; exited targets are marked absent
+    for (int i = 0; i <= 30; i++) {
+        std::vector<ProcessInfo> sampled = { makeProcess(30, "", 1.0, 30.0 + i * 0.1) };
+        if (i < 5) {
+            sampled.push_back(makeProcess(20, "", 50.0 + i * 10.0, 2.0));
+        }
+        burst.record(SystemUsage(90.0, 60.0, 0.0), sampled, start + milliseconds(200 * i));
+    }
+    check(burst.getSamples().size() == 12, "Buffer is bounded by window / interval");
+    check(burst.getSamples()[1].points[0].present && burst.getSamples()[6].points[0].present == false,
+          "Exited process is recorded as absent");
+    check(!burst.isComplete(start + milliseconds(1800)), "Burst runs for its window");
+    check(burst.isComplete(start + seconds(2)), "Burst completes after its window");
+
+    burst.finish();
+    check(!burst.isActive(), "Burst ends on finish");
+    check(!burst.onThresholdState(true), "Still above after the burst does not restart it");
+    check(!burst.onThresholdState(false) && burst.onThresholdState(true), "A new crossing starts the next burst");
+
+    std::string report = burst.formatReport();
+    check(report.find("[system cpu > 80]") != std::string::npos, "Report names the trigger");
+    check(report.find("PEAK: spike.exe, 20, [CPU 90.00% at +0.800s]") != std::string::npos, "Report gives the CPU peak and its time");
+    check(report.find("===End burst===") != std::string::npos, "Report is terminated");
+
+    BurstCapture disabled(0, 200, 5);
+    check(!disabled.isEnabled() && !disabled.onThresholdState(true), "Window of 0 disables bursts");
+    BurstCapture clamped(10, 20, 5);
+    check(clamped.getIntervalMs() == BurstCapture::MIN_INTERVAL_MS, "Interval is clamped to 100 ms");
+
+    std::cout << std::endl << (failures == 0 ? "✅ Burst capture test PASSED" : "❌ Burst capture test FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,183 @@
+#include "include/ColumnarExport.h"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Console flag normally defined by main.cpp; the logger reads it
+bool g_suppressConsoleOutput = true;
+
+static int failures = 0;
+
+static void check(bool condition, const std::string& description) {
+    std::cout << (condition ? "✅ " : "❌ ") << description << std::endl;
+    if (!condition) failures++;
+}
+
+static ProcessInfo makeProcess(DWORD pid, const std::string& name, double cpu, double ram, double disk) {
+    ProcessInfo process(pid, 4, name);
+    process.setCpuPercent(cpu);
+    process.setRamPercent(ram);
+    process.setDiskPercent(disk);
+    return process;
+}
+
+// Queues one cycle, waiting for the worker instead of overrunning its queue
+static void appendPaced(ColumnarExportWriter& writer, int64_t timestampMs, const SystemUsage& usage,
+                        const std::vector<ProcessInfo>& processes) {
+    while (writer.getQueueSize() >= ColumnarExportWriter::QUEUE_LIMIT / 2) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    writer.append(timestampMs, usage, processes);
+}
+
+int main() {
+    std::cout << "=== SystemMonitor Columnar Export Test ===" << std::endl;
+    const std::string path = "columnar_export_test.smcol";
+    std::remove(path.c_str());
+
+    check(ColumnarBlockBuilder::toFixedPoint(12.345) == 1235 && ColumnarBlockBuilder::toFixedPoint(-1.0) == 0,
+          "Usage is stored in hundredths");
+
+    // Round trip of a small file, every column
+    {
+        ColumnarExportWriter writer;
+        writer.setBlockCycles(2);
+        check(writer.start(path), "Export file is created");
+        writer.append(1000, SystemUsage(50.0, 60.0, 1.5),
+                      { makeProcess(100, "java.exe", 30.25, 10.0, 0.5), makeProcess(7, "odd \"name\".exe", 0.0, 2.0, 0.0) });
+        writer.append(2005, SystemUsage(51.0, 61.0, 0.0), {});
+        writer.append(2990, SystemUsage(52.0, 62.0, 0.0), { makeProcess(100, "java.exe", 99.99, 10.5, 0.0) });
+        writer.stop();
+        check(writer.getBlockCount() == 2 && writer.getRowCount() == 3, "Cycles are sealed into blocks, the last one short");
+    }
+    {
+        ColumnarExportReader reader;
+        check(reader.open(path) && reader.getBlockCount() == 2 && reader.getRowCount() == 3 && !reader.isTruncated(),
+              "Reader finds the blocks from their footers");
+        ExportQuery all;
+        all.columns = 0xFFFFFFFF;
+        std::vector<ExportRow> rows;
+        check(reader.scan(all, rows) && rows.size() == 3, "Every row comes back");
+        check(rows.size() == 3 && rows[0].timestampMs == 1000 && rows[0].pid == 100 && rows[0].name == "java.exe" &&
+              rows[0].cpu == 30.25 && rows[0].ram == 10.0 && rows[0].disk == 0.5 && rows[0].systemDisk == 1.5 &&
+              rows[1].pid == 7 && rows[1].name == "odd \"name\".exe" && rows[1].ram == 2.0 &&
+              rows[2].timestampMs == 2990 && rows[2].cpu == 99.99 && rows[2].systemCpu == 52.0,
+              "Timestamps, PIDs, names and usage round-trip");
+
+        ExportQuery narrow;
+        narrow.columns = exportColumnBit(ExportColumn::PID);
+        rows.clear();
+        check(reader.scan(narrow, rows) && rows.size() == 3 && rows[0].pid == 100 && rows[0].name.empty() &&
+              rows[0].cpu == 0.0, "Only the requested columns are filled in");
+    }
+
+    // Two weeks at one cycle a minute; java is busy for one hour on day 9
+    std::remove(path.c_str());
+    const int64_t startMs = 1791331200000LL;
+    const int cycles = 14 * 24 * 60;
+    const int busyFrom = 9 * 24 * 60 + 600;
+    uint64_t expectedBusy = 0;
+    {
+        ColumnarExportWriter writer;
+        writer.setBlockCycles(600);
+        check(writer.start(path), "Export file restarts empty");
+        std::mt19937 random(7);
+        std::vector<ProcessInfo> processes;
+        for (int cycle = 0; cycle < cycles; cycle++) {
+            processes.clear();
+            bool busy = cycle >= busyFrom && cycle < busyFrom + 60;
+            processes.push_back(makeProcess(4242, "java.exe", busy ? 55.0 + random() % 40 : 5.0 + random() % 40,
+                                            20.0 + random() % 100 / 100.0, 0.1));
+            expectedBusy += busy ? 1 : 0;
+            for (DWORD pid = 1; pid <= 39; pid++) {
+                processes.push_back(makeProcess(1000 + pid * 4, "svc" + std::to_string(pid % 12) + ".exe",
+                                                random() % 3000 / 100.0, random() % 500 / 100.0, random() % 100 / 100.0));
+            }
+            appendPaced(writer, startMs + cycle * 60000LL + random() % 20, SystemUsage(40.0, 70.0, 5.0), processes);
+        }
+        writer.stop();
+        double bytesPerRow = static_cast<double>(writer.getBytesWritten()) / static_cast<double>(writer.getRowCount());
+        check(writer.getDroppedCount() == 0 && writer.getRowCount() == static_cast<uint64_t>(cycles) * 40,
+              "All rows are written");
+        check(bytesPerRow < 8.0, "Rows are compact (" + std::to_string(bytesPerRow) + " bytes per row)");
+    }
+    {
+        ColumnarExportReader reader;
+        check(reader.open(path) && reader.getBlockCount() == (cycles + 599) / 600, "Reader opens the two weeks");
+        uint64_t fileSize = std::filesystem::file_size(path);
+
+        ExportQuery busyJava;
+        busyJava.name = "java.exe";
+        busyJava.above = 50.0;
+        busyJava.columns = exportColumnBit(ExportColumn::CYCLE_TIME) | exportColumnBit(ExportColumn::CPU);
+        std::vector<ExportRow> rows;
+        auto begin = std::chrono::steady_clock::now();
+        bool scanned = reader.scan(busyJava, rows);
+        double scanMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        bool allBusy = true;
+        for (const auto& row : rows) {
+            allBusy = allBusy && row.cpu > 50.0 && row.timestampMs >= startMs + busyFrom * 60000LL &&
+                      row.timestampMs < startMs + (busyFrom + 60) * 60000LL;
+        }
+        check(scanned && rows.size() == expectedBusy && allBusy, "\"java.exe > 50% CPU\" finds exactly the busy hour");
+        check(reader.getLastBlocksSkipped() + 2 >= reader.getBlockCount(), "Blocks are skipped on CPU statistics (" +
+              std::to_string(reader.getLastBlocksSkipped()) + " of " + std::to_string(reader.getBlockCount()) + ")");
+        check(reader.getLastBytesRead() * 50 < fileSize, "Only the touched columns of the remaining blocks are read (" +
+              std::to_string(reader.getLastBytesRead()) + " of " + std::to_string(fileSize) + " bytes, " +
+              std::to_string(scanMs) + " ms)");
+
+        ExportQuery absent;
+        absent.name = "missing.exe";
+        rows.clear();
+        check(reader.scan(absent, rows) && rows.empty() && reader.getLastBlocksSkipped() == reader.getBlockCount(),
+              "A name missing from every dictionary skips every block");
+
+        ExportQuery oneDay;
+        oneDay.fromMs = startMs + 3 * 86400000LL;
+        oneDay.toMs = startMs + 4 * 86400000LL - 1;
+        oneDay.columns = exportColumnBit(ExportColumn::CYCLE_TIME);
+        rows.clear();
+        check(reader.scan(oneDay, rows) && rows.size() == 24 * 60 * 40, "A time range returns the rows of its cycles");
+
+        ExportQuery quietSystem;
+        quietSystem.usageColumn = ExportColumn::SYSTEM_CPU;
+        quietSystem.above = 40.0;
+        rows.clear();
+        check(reader.scan(quietSystem, rows) && rows.empty() && reader.getLastBytesRead() == 0,
+              "System columns take part in block skipping");
+    }
+
+    // A block cut short by a crash is dropped and cut before appending
+    {
+        uint64_t wholeSize = std::filesystem::file_size(path);
+        std::ofstream torn(path, std::ios::binary | std::ios::app);
+        torn.write("\x40\x00\x00\x00partial", 11);
+        torn.close();
+        ColumnarExportReader reader;
+        check(reader.open(path) && reader.isTruncated() && reader.getRowCount() == static_cast<uint64_t>(cycles) * 40,
+              "A torn last block is ignored by the reader");
+        ColumnarExportWriter writer;
+        check(writer.start(path) && std::filesystem::file_size(path) == wholeSize, "Reopening cuts the torn block");
+        writer.append(startMs + cycles * 60000LL, SystemUsage(1.0, 1.0, 1.0), { makeProcess(1, "late.exe", 1.0, 1.0, 1.0) });
+        writer.stop();
+        check(reader.open(path) && !reader.isTruncated() && reader.getRowCount() == static_cast<uint64_t>(cycles) * 40 + 1,
+              "Appending continues after the last whole block");
+    }
+
+    std::ofstream foreign(path, std::ios::binary | std::ios::trunc);
+    foreign << "not an export file";
+    foreign.close();
+    ColumnarExportWriter refused;
+    ColumnarExportReader unreadable;
+    check(!refused.start(path) && !unreadable.open(path), "Other files are neither read nor appended to");
+    std::remove(path.c_str());
+
+    std::cout << std::endl << (failures == 0 ? "✅ Columnar export test PASSED" : "❌ Columnar export test FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,105 @@
+#include "include/Configuration.h"
+#include "include/ConfigRegistry.h"
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstdio>
+
+static int failures = 0;
+
+static void check(bool condition, const std::string& description) {
+    std::cout << (condition ? "✅ " : "❌ ") << description << std::endl;
+    if (!condition) failures++;
+}
+
+int main() {
+    std::cout << "=== SystemMonitor Configuration Parser Test ===" << std::endl;
+
+    // Registry lookup
+    bool allKeysFound = true;
+    for (const ConfigKey* key = ConfigRegistry::begin(); key != ConfigRegistry::end(); ++key) {
+        allKeysFound = allKeysFound && ConfigRegistry::find(key->name) == key;
+    }
+    check(allKeysFound, "Every registered key is found through the perfect hash");
+    check(ConfigRegistry::find("cpu_threshold") == ConfigRegistry::find("CPU_THRESHOLD"), "Key lookup is case-insensitive");
+    check(ConfigRegistry::find("CPU_THRESHOLDS") == nullptr, "Unknown key is rejected");
+
+    // Parse errors are reported with line numbers
+    const std::string path = "config_parser_test.cfg";
+    {
+        std::ofstream file(path);
+        file << "# comment = ignored\n"
+             << "CPU_THRESHOLD=75\n"
+             << "MONITOR_INTERVAL=abc\n"
+             << "EMAIL_SMTP_PORT=70000\n"
+             << "UNKNOWN_KEY=1\n"
+             << "DISPLAY_MODE=compact\n"
+             << "EMAIL_RECIPIENTS=a@example.com, b@example.com\n"
+             << "ALERT_RULE=process:java ram > 20 clear 15 for 60s\n";
+    }
+
+    ConfigurationManager manager;
+    check(manager.loadFromFile(path), "Loads configuration file");
+    const auto& errors = manager.getParseErrors();
+    check(errors.size() == 3, "Reports three invalid lines");
+    check(errors.size() == 3 && errors[0].find(":3:") != std::string::npos &&
+          errors[1].find(":4:") != std::string::npos && errors[2].find(":5:") != std::string::npos,
+          "Errors carry line numbers");
+
+    const MonitorConfig& config = manager.getConfig();
+    check(config.getCpuThreshold() == 75.0, "Valid value applied");
+    check(config.getMonitorInterval() == 5000 && config.getEmailConfig().smtpPort == 587,
+          "Invalid values keep the previous setting");
+    check(config.getDisplayMode() == DisplayModeConfig::COMPACT, "Choice parsed case-insensitively");
+    check(config.getEmailConfig().recipients.size() == 2, "List parsed");
+    check(config.getAlertRules().size() == 1, "Alert rule parsed");
+
+    // Save/load round trip
+    check(manager.saveToFile(path), "Saves configuration file");
+    ConfigurationManager reloaded;
+    reloaded.loadFromFile(path);
+    check(reloaded.getParseErrors().empty(), "Saved file parses without errors");
+    check(reloaded.getConfig().getCpuThreshold() == 75.0 &&
+          reloaded.getConfig().getDisplayMode() == DisplayModeConfig::COMPACT &&
+          reloaded.getConfig().getEmailConfig().recipients == config.getEmailConfig().recipients &&
+          reloaded.getConfig().getAlertRules().size() == 1,
+          "Round trip preserves values");
+    check(reloaded.validateConfiguration(), "Round-tripped configuration validates");
+
+    // Rule timing left out is inherited from the email settings; an explicit 0 is kept
+    const EmailConfig& email = config.getEmailConfig();
+    const AlertRule inherited = config.getEffectiveAlertRules().back();
+    check(inherited.durationSeconds == 60 && inherited.recoveryDurationSeconds == email.recoveryDurationSeconds &&
+          inherited.cooldownSeconds == email.cooldownMinutes * 60, "Missing rule timings are inherited");
+    {
+        std::ofstream file(path);
+        file << "ALERT_RULE=system cpu > 90 for 0s cooldown 0\n";
+    }
+    ConfigurationManager zeroTiming;
+    zeroTiming.loadFromFile(path);
+    const AlertRule immediate = zeroTiming.getConfig().getEffectiveAlertRules().back();
+    check(immediate.durationSeconds == 0 && immediate.cooldownSeconds == 0 &&
+          immediate.recoveryDurationSeconds == zeroTiming.getConfig().getEmailConfig().recoveryDurationSeconds,
+          "Explicit zero timings are not replaced");
+    check(zeroTiming.getConfig().getAlertRules().front().toConfigString() == "system cpu > 90 for 0s cooldown 0s",
+          "Explicit zero timings are saved");
+    std::remove(path.c_str());
+
+    // Replay speed: "max" means unthrottled, the x suffix is optional
+    auto parseSpeed = [](const char* text) {
+        char program[] = "SystemMonitor";
+        char option[] = "--speed";
+        std::string speed = text;
+        char* argv[] = { program, option, &speed[0], nullptr };
+        ConfigurationManager speedManager;
+        speedManager.getConfig().setReplaySpeed(-1.0);
+        speedManager.parseCommandLine(3, argv);
+        return speedManager.getConfig().getReplaySpeed();
+    };
+    check(parseSpeed("max") == 0.0 && parseSpeed("MAX") == 0.0, "--speed max replays as fast as possible");
+    check(parseSpeed("100x") == 100.0 && parseSpeed("100") == 100.0, "--speed accepts 100x and 100");
+    check(parseSpeed("fast") == -1.0, "An invalid --speed keeps the previous setting");
+
+    std::cout << std::endl << (failures == 0 ? "✅ Configuration parser test PASSED" : "❌ Configuration parser test FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
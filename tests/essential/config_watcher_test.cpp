@@ -0,0 +1,118 @@
+#include "include/ConfigWatcher.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+// Console flag normally defined by main.cpp; the logger reads it
+bool g_suppressConsoleOutput = true;
+
+static int failures = 0;
+
+static void check(bool condition, const std::string& description) {
+    std::cout << (condition ? "✅ " : "❌ ") << description << std::endl;
+    if (!condition) failures++;
+}
+
+static void writeConfig(const std::string& path, const std::string& text) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << text;
+}
+
+// The threshold written for a generation, so a snapshot tells which generation it belongs to
+static std::string configFor(uint64_t generation) {
+    return "CPU_THRESHOLD=" + std::to_string(10 + generation) + "\nMONITOR_INTERVAL=2000\n";
+}
+
+static bool waitForGeneration(const ConfigWatcher& watcher, uint64_t generation) {
+    for (int i = 0; i < 500 && watcher.getGeneration() < generation; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return watcher.getGeneration() >= generation;
+}
+
+int main() {
+    std::cout << "=== SystemMonitor Config Watcher Test ===" << std::endl;
+    const std::string path = "config_watcher_test.cfg";
+    writeConfig(path, configFor(0));
+
+    // Collect warnings so the test can count how often each one is printed
+    std::ostringstream warnings;
+    std::streambuf* console = std::cerr.rdbuf(warnings.rdbuf());
+
+    ConfigurationManager initial;
+    check(initial.loadFromFile(path) && initial.getParseErrors().empty(), "Initial configuration loads");
+    char program[] = "SystemMonitor";
+    char option[] = "--interval";
+    char value[] = "3000";
+    char badOption[] = "--speed";
+    char badValue[] = "fast";
+    char* argv[] = { program, option, value, badOption, badValue, nullptr };
+    initial.parseCommandLine(5, argv);
+
+    ConfigWatcher watcher(path, initial.getConfig(), 5, argv);
+    uint64_t generation = 99;
+    check(watcher.getSnapshot(generation)->getCpuThreshold() == 10.0 && generation == 0,
+          "The initial snapshot is generation 0");
+    check(watcher.start(), "Watcher starts");
+
+    // A reader checks every snapshot against the generation returned with it
+    std::atomic<bool> reading{true};
+    std::atomic<uint64_t> reads{0};
+    std::atomic<uint64_t> mismatches{0};
+    std::thread reader([&]() {
+        while (reading.load()) {
+            uint64_t snapshotGeneration = 0;
+            std::shared_ptr<const MonitorConfig> snapshot = watcher.getSnapshot(snapshotGeneration);
+            if (snapshot->getCpuThreshold() != static_cast<double>(10 + snapshotGeneration)) {
+                mismatches++;
+            }
+            reads++;
+        }
+    });
+
+    bool allArrived = true;
+    for (uint64_t next = 1; next <= 5; next++) {
+        writeConfig(path, configFor(next));
+        allArrived = allArrived && waitForGeneration(watcher, next) && watcher.getGeneration() == next;
+    }
+    check(allArrived, "Every rewrite publishes one new generation");
+
+    uint64_t latest = 0;
+    std::shared_ptr<const MonitorConfig> snapshot = watcher.getSnapshot(latest);
+    check(latest == 5 && snapshot->getCpuThreshold() == 15.0, "The new snapshot and its generation arrive together");
+    check(snapshot->getMonitorInterval() == 3000, "Command line overrides survive a reload");
+
+    // Invalid edits are reported and ignored
+    writeConfig(path, "CPU_THRESHOLD=abc\n");
+    std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+    check(watcher.getGeneration() == 5 && watcher.getSnapshot()->getCpuThreshold() == 15.0,
+          "An invalid edit keeps the current snapshot");
+
+    writeConfig(path, configFor(6));
+    check(waitForGeneration(watcher, 6) && watcher.getSnapshot()->getCpuThreshold() == 16.0,
+          "A valid edit after an invalid one is picked up");
+
+    reading = false;
+    reader.join();
+    watcher.stop();
+    std::cerr.rdbuf(console);
+    check(reads > 0 && mismatches == 0, "No snapshot was seen with another generation (" +
+          std::to_string(reads.load()) + " reads)");
+
+    std::string text = warnings.str();
+    size_t first = text.find("Invalid replay speed");
+    check(first != std::string::npos && text.find("Invalid replay speed", first + 1) == std::string::npos,
+          "Command line warnings are printed once, not on every reload");
+
+    // A snapshot held across reloads stays valid
+    check(snapshot->getCpuThreshold() == 15.0, "A held snapshot is not changed by later reloads");
+    std::remove(path.c_str());
+
+    std::cout << std::endl << (failures == 0 ? "✅ Config watcher test PASSED" : "❌ Config watcher test FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,160 @@
+#include "include/HistoryArchive.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Console flag normally defined by main.cpp; the logger reads it
+bool g_suppressConsoleOutput = true;
+
+static int failures = 0;
+
+static void check(bool condition, const std::string& description) {
+    std::cout << (condition ? "✅ " : "❌ ") << description << std::endl;
+    if (!condition) failures++;
+}
+
+static ProcessInfo makeProcess(DWORD pid, const std::string& name, double cpu, double ram, double disk) {
+    ProcessInfo process(pid, 4, name);
+    process.setStartTime(1000 + pid);
+    process.setCpuPercent(cpu);
+    process.setRamPercent(ram);
+    process.setDiskPercent(disk);
+    return process;
+}
+
+// Queues one cycle, waiting for the worker instead of overrunning its queue
+static void appendPaced(HistoryArchiveWriter& writer, int64_t timestampMs, const SystemUsage& usage,
+                        const std::vector<ProcessInfo>& processes) {
+    while (writer.getQueueSize() >= HistoryArchiveWriter::QUEUE_LIMIT / 2) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    writer.append(timestampMs, usage, processes);
+}
+
+int main() {
+    std::cout << "=== SystemMonitor History Archive Test ===" << std::endl;
+    const std::string directory = "history_archive_test.d";
+    std::filesystem::remove_all(directory);
+    const int64_t dayStartMs = 1760054400000;     // 2025-10-10 00:00:00 UTC
+    std::mt19937 random(42);
+    std::uniform_real_distribution<double> noise(-1.0, 1.0);
+
+    // Chunk round trip: irregular timestamps, large jumps, repeated and noisy values
+    HistoryChunk chunk;
+    std::vector<ArchiveSample> expected;
+    uint32_t second = 1760054400;
+    for (int i = 0; i < 500; i++) {
+        second += (i % 50 == 49) ? 5000 : (i % 7 == 0 ? 2 : 1);
+        float values[HistoryChunk::VALUE_COUNT] = {
+            static_cast<float>(50.0 + 40.0 * noise(random)), i % 3 == 0 ? 12.5f : 12.75f, 0.0f
+        };
+        chunk.append(second, values);
+        ArchiveSample sample;
+        sample.timestampMs = static_cast<int64_t>(second) * 1000;
+        for (size_t v = 0; v < HistoryChunk::VALUE_COUNT; v++) {
+            sample.values[v] = HistoryChunk::quantize(values[v]);
+        }
+        expected.push_back(sample);
+    }
+    std::vector<ArchiveSample> decoded;
+    bool decodedAll = HistoryChunk::decode(chunk.getBytes().data(), chunk.getBytes().size(), chunk.getPointCount(), decoded);
+    bool identical = decodedAll && decoded.size() == expected.size();
+    for (size_t i = 0; identical && i < expected.size(); i++) {
+        identical = decoded[i].timestampMs == expected[i].timestampMs && decoded[i].values[0] == expected[i].values[0] &&
+                    decoded[i].values[1] == expected[i].values[1] && decoded[i].values[2] == expected[i].values[2];
+    }
+    check(identical, "Chunk decodes to the quantized points it was given");
+    check(std::fabs(HistoryChunk::quantize(37.1234) - 37.1234) <= 1.0 / 256, "Values keep 1/128 % precision");
+    decoded.clear();
+    check(!HistoryChunk::decode(chunk.getBytes().data(), chunk.getBytes().size() / 2, chunk.getPointCount(), decoded),
+          "A cut chunk fails to decode");
+
+    // Two hours and a bit of 1 s cycles: noisy system, 10 busy and 90 idle processes
+    std::filesystem::create_directories(directory);
+    std::ofstream(directory + "/history-20250101.dat") << "expired";
+    std::ofstream(directory + "/history-20250101.idx") << "expired";
+
+    HistoryArchiveWriter writer;
+    writer.setRetentionDays(31);
+    check(writer.start(directory), "Archive starts in a new directory");
+    const int cycles = 2 * 3600 + 600;
+    double cpu = 30.0;
+    std::vector<double> busy(10, 20.0);
+    std::vector<ProcessInfo> processes;
+    for (int i = 0; i < cycles; i++) {
+        cpu = std::min(100.0, std::max(0.0, cpu + noise(random)));
+        processes.clear();
+        for (DWORD p = 0; p < 10; p++) {
+            busy[p] = std::min(100.0, std::max(0.0, busy[p] + noise(random)));
+            processes.push_back(makeProcess(100 + p * 4, "busy.exe", busy[p], 2.0 + (i / 60) * 0.01, 0.0));
+        }
+        for (DWORD p = 0; p < 90; p++) {
+            processes.push_back(makeProcess(1000 + p * 4, "idle.exe", 0.0, 0.5, 0.0));
+        }
+        processes.push_back(makeProcess(9000, "tiny.exe", 0.0, 0.0, 0.0));    // 101st: not archived
+        appendPaced(writer, dayStartMs + i * 1000ll + 7, SystemUsage(cpu, 60.0 + (i / 300) * 0.1, 1.5), processes);
+    }
+    writer.stop();
+    double bytesPerPoint = static_cast<double>(writer.getBytesWritten()) / writer.getPointCount();
+    std::cout << "   " << writer.getPointCount() << " points, " << writer.getBytesWritten() << " bytes, "
+              << bytesPerPoint << " bytes/point" << std::endl;
+    check(writer.getPointCount() == static_cast<uint64_t>(cycles) * 101 && writer.getDroppedCount() == 0,
+          "Every cycle archives the system and the top 100 processes");
+    check(bytesPerPoint < 1.5, "Under 1.5 bytes per point");
+    check(!std::filesystem::exists(directory + "/history-20250101.dat") &&
+          !std::filesystem::exists(directory + "/history-20250101.idx"), "Days beyond the retention are removed");
+
+    HistoryArchiveReader reader;
+    check(reader.open(directory) && reader.getSeries().size() == 101 && reader.getChunkCount() == 3 * 101,
+          "Index lists every series, one chunk per series and block");
+    std::vector<ArchiveSample> system = reader.querySystem(dayStartMs, dayStartMs + cycles * 1000ll);
+    check(system.size() == static_cast<size_t>(cycles) && system.front().timestampMs == dayStartMs &&
+          system.back().timestampMs == dayStartMs + (cycles - 1) * 1000ll && system.back().values[0] == HistoryChunk::quantize(cpu),
+          "System series reads back across blocks");
+    std::vector<ArchiveSample> window = reader.queryProcess(100, 1100, dayStartMs + 3590 * 1000ll, dayStartMs + 3609 * 1000ll);
+    check(window.size() == 20 && window[10].timestampMs == dayStartMs + 3600 * 1000ll,
+          "Range queries span a block boundary");
+    check(reader.queryProcess(1000, 2000, dayStartMs, dayStartMs + cycles * 1000ll).back().values[1] == 0.5f &&
+          reader.queryProcess(9000, 10000, dayStartMs, dayStartMs + cycles * 1000ll).empty(),
+          "Idle processes are archived, those beyond the top 100 are not");
+
+    // A restart appends to the same day; a half-written index record is cut first
+    {
+        std::ofstream tail(directory + "/history-20251010.idx", std::ios::binary | std::ios::app);
+        tail.put(1);
+        tail.put(static_cast<char>(0x80));
+    }
+    HistoryArchiveReader damaged;
+    check(damaged.open(directory) && damaged.isTruncated() && damaged.getChunkCount() == 3 * 101,
+          "A torn index record is skipped");
+
+    HistoryArchiveWriter restarted;
+    restarted.setMaxProcesses(0);
+    restarted.start(directory);
+    for (int i = 0; i < 120; i++) {
+        appendPaced(restarted, dayStartMs + (cycles + 60 + i) * 1000ll, SystemUsage(10.0, 60.0, 1.5), {});
+    }
+    // The next UTC day starts a new pair of files
+    appendPaced(restarted, dayStartMs + 86400 * 1000ll, SystemUsage(20.0, 60.0, 1.5), {});
+    restarted.stop();
+
+    HistoryArchiveReader reopened;
+    check(reopened.open(directory) && !reopened.isTruncated() &&
+          reopened.querySystem(dayStartMs, dayStartMs + 86400 * 1000ll).size() == static_cast<size_t>(cycles) + 121,
+          "Samples from both runs and both days are read back");
+    check(std::filesystem::exists(directory + "/history-20251011.dat"), "Files are per UTC day");
+    check(HistoryArchiveWriter::segmentName(0) == "history-19700101" &&
+          HistoryArchiveWriter::segmentName(20744) == "history-20261018", "Day file names are UTC dates");
+
+    std::filesystem::remove_all(directory);
+
+    std::cout << std::endl << (failures == 0 ? "✅ History archive test PASSED" : "❌ History archive test FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,131 @@
+#include "include/JsonLinesWriter.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+static void check(bool condition, const std::string& description) {
+    std::cout << (condition ? "✅ " : "❌ ") << description << std::endl;
+    if (!condition) failures++;
+}
+
+static ProcessInfo makeProcess(DWORD pid, const std::string& name, double cpu, double ram, double disk,
+                               ULONGLONG startTime = 0) {
+    ProcessInfo process(pid, 4, name);
+    process.setCpuPercent(cpu);
+    process.setRamPercent(ram);
+    process.setDiskPercent(disk);
+    process.setStartTime(startTime);
+    return process;
+}
+
+// Structural check: strings closed, brackets balanced, nothing after the closing brace but the newline
+static bool isWellFormed(const std::string& line) {
+    if (line.size() < 3 || line.front() != '{' || line.back() != '\n') return false;
+    int depth = 0;
+    bool inString = false;
+    for (size_t i = 0; i + 1 < line.size(); i++) {
+        char c = line[i];
+        if (inString) {
+            if (c == '\\') i++;
+            else if (c == '"') inString = false;
+            else if (static_cast<unsigned char>(c) < 0x20) return false;
+        } else if (c == '"') {
+            inString = true;
+        } else if (c == '{' || c == '[') {
+            depth++;
+        } else if (c == '}' || c == ']') {
+            if (--depth < 0) return false;
+            if (depth == 0 && i + 2 != line.size()) return false;
+        }
+    }
+    return depth == 0 && !inString;
+}
+
+int main() {
+    std::cout << "=== SystemMonitor JSON Lines Writer Test ===" << std::endl;
+
+    std::string escaped;
+    JsonLinesWriter::appendEscaped(escaped, std::string("a\"b\\c\nd\x01") + "\xC3\xA9");
+    check(escaped == "a\\\"b\\\\c\\nd\\u0001\xC3\xA9", "Quotes, backslashes and control characters are escaped");
+
+    JsonLinesWriter writer;
+    std::vector<ProcessInfo> processes = {
+        makeProcess(4242, "java.exe", 30.0, 10.0, 0.5, 100),
+        makeProcess(17, "odd \"name\"\\.exe", 10.25, 51.0, 2.6, 200)
+    };
+    // 2026-10-18 12:00:00.123 UTC
+    std::string line = writer.format(1792324800123LL, SystemUsage(85.0, 72.5, 12.0), processes);
+    check(isWellFormed(line), "A cycle is one well-formed JSON object on one line");
+    check(line.rfind("{\"timestamp_ms\":1792324800123,\"time\":\"2026-10-18T12:00:00.123Z\",", 0) == 0,
+          "Timestamp is written as milliseconds and ISO 8601 UTC");
+    check(line.find("\"system\":{\"cpu\":85.00,\"ram\":72.50,\"disk\":12.00}") != std::string::npos,
+          "System usage has two decimals like the text log");
+    check(line.find("\"totals\":{\"cpu\":40.25,\"ram\":61.00,\"disk\":3.10}") != std::string::npos,
+          "Process totals match the TOTALS: line");
+    check(line.find("{\"pid\":4242,\"ppid\":4,\"name\":\"java.exe\",\"cpu\":30.00,\"ram\":10.00,\"disk\":0.50}") !=
+          std::string::npos, "Each logged process is an object");
+    check(line.find("\"name\":\"odd \\\"name\\\"\\\\.exe\"") != std::string::npos, "Process names are escaped");
+
+    check(writer.format(0, SystemUsage(0.0, 0.0, 0.0), {}) ==
+          "{\"timestamp_ms\":0,\"time\":\"1970-01-01T00:00:00.000Z\",\"system\":{\"cpu\":0.00,\"ram\":0.00,\"disk\":0.00},"
+          "\"totals\":{\"cpu\":0.00,\"ram\":0.00,\"disk\":0.00},\"processes\":[]}\n", "An idle cycle has an empty list");
+    check(writer.format(951782400000LL, SystemUsage(0.0, 0.0, 0.0), {}).find("\"2000-02-29T00:00:00.000Z\"") !=
+          std::string::npos, "Leap days convert");
+    SystemUsage unknown(0.0, 0.0, 0.0);
+    unknown.setCpuPercent(std::numeric_limits<double>::quiet_NaN());
+    check(writer.format(0, unknown, {}).find("\"cpu\":null") != std::string::npos, "Non-finite values become null");
+
+    // Names are cached per (PID, start time); a reused PID with a new name is re-escaped
+    JsonLinesWriter cached;
+    cached.format(0, SystemUsage(1.0, 1.0, 1.0), processes);
+    check(cached.getCachedNameCount() == 2, "Escaped names are cached per process");
+    std::string reused = cached.format(1, SystemUsage(1.0, 1.0, 1.0), { makeProcess(4242, "other.exe", 1.0, 1.0, 1.0, 100) });
+    check(reused.find("\"name\":\"other.exe\"") != std::string::npos, "A reused key with another name is re-escaped");
+    for (uint32_t i = 0; i < JsonLinesWriter::NAME_CACHE_SWEEP_CYCLES * 2; i++) {
+        cached.format(i, SystemUsage(1.0, 1.0, 1.0), { makeProcess(1, "idle", 0.0, 0.0, 0.0) });
+    }
+    check(cached.getCachedNameCount() == 1, "Exited processes leave the cache");
+
+    // Steady table: the line buffer is reused
+    std::vector<ProcessInfo> table;
+    for (DWORD pid = 1; pid <= 1000; pid++) {
+        table.push_back(makeProcess(pid, "worker-" + std::to_string(pid) + ".exe", pid % 100, 0.1, 0.0, pid));
+    }
+    const char* buffer = cached.format(0, SystemUsage(50.0, 50.0, 50.0), table).data();
+    bool reusedBuffer = true;
+    for (int i = 1; i <= 100; i++) {
+        reusedBuffer = reusedBuffer && cached.format(i, SystemUsage(50.0, 50.0, 50.0), table).data() == buffer;
+    }
+    check(reusedBuffer, "A steady table formats into the same buffer");
+
+    // File output appends whole lines
+    const std::string path = "json_lines_writer_test.jsonl";
+    std::remove(path.c_str());
+    JsonLinesWriter fileWriter;
+    check(fileWriter.open(path), "Output file opens");
+    check(fileWriter.write(1000, SystemUsage(1.0, 2.0, 3.0), processes) &&
+          fileWriter.write(2000, SystemUsage(1.0, 2.0, 3.0), processes), "Cycles are written");
+    fileWriter.close();
+    check(fileWriter.open(path) && fileWriter.write(3000, SystemUsage(1.0, 2.0, 3.0), {}), "Reopening appends");
+    fileWriter.close();
+    std::ifstream input(path);
+    std::string fileLine;
+    int lines = 0;
+    bool wellFormed = true;
+    while (std::getline(input, fileLine)) {
+        wellFormed = wellFormed && isWellFormed(fileLine + "\n");
+        lines++;
+    }
+    input.close();
+    std::remove(path.c_str());
+    check(lines == 3 && wellFormed, "The file holds one object per line");
+    check(fileWriter.getLineCount() == 3 && fileWriter.getFailedCount() == 0, "Written lines are counted");
+
+    std::cout << std::endl << (failures == 0 ? "✅ JSON Lines writer test PASSED" : "❌ JSON Lines writer test FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,101 @@
+#include "include/MetricStore.h"
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+static void check(bool condition, const std::string& description) {
+    std::cout << (condition ? "✅ " : "❌ ") << description << std::endl;
+    if (!condition) failures++;
+}
+
+static bool near(double a, double b) {
+    return std::fabs(a - b) < 1e-3;
+}
+
+static ProcessInfo makeProcess(DWORD pid, ULONGLONG startTime, double cpu) {
+    ProcessInfo process(pid, 4, "worker.exe");
+    process.setStartTime(startTime);
+    process.setCpuPercent(cpu);
+    process.setRamPercent(1.0);
+    return process;
+}
+
+int main() {
+    std::cout << "=== SystemMonitor Metric Store Test ===" << std::endl;
+    const int64_t base = 1760000400000;     // On a whole hour
+    using Resolution = MetricStore::Resolution;
+
+    // System rollups: one sample every 5 s for 3 minutes, CPU 0..35 in each minute
+    MetricStore store;
+    for (int i = 0; i < 36; i++) {
+        store.recordSystem(base + i * 5000, SystemUsage((i % 12) * 5.0, 50.0, 1.0));
+    }
+    std::vector<MetricStore::Point> minutes = store.querySystem(Resolution::MINUTE, base, base + 180000);
+    check(minutes.size() == 3, "One per-minute point per minute");
+    check(minutes.size() == 3 && minutes[1].timestampMs == base + 60000 && minutes[1].count == 12 &&
+          near(minutes[1].min[0], 0.0) && near(minutes[1].max[0], 55.0) && near(minutes[1].avg[0], 27.5) &&
+          near(minutes[1].avg[1], 50.0), "Minute rollup holds min, average and max");
+    std::vector<MetricStore::Point> hours = store.querySystem(Resolution::HOUR, base, base + 180000);
+    check(hours.size() == 1 && hours[0].count == 36 && near(hours[0].avg[0], 27.5), "Hour rollup covers every sample");
+    check(store.querySystem(Resolution::SECOND, base, base + 180000).size() == 36, "Raw seconds are kept");
+    check(store.querySystem(Resolution::MINUTE, base + 60000, base + 119999).size() == 1, "Queries honour the time range");
+
+    MetricStore::Point summary = MetricStore::summarize(minutes);
+    check(summary.count == 36 && near(summary.avg[0], 27.5) && near(summary.max[0], 55.0), "Points summarize with count weighting");
+
+    // Rings wrap: a process keeps its last 60 seconds of raw samples
+    store.recordProcesses(base, { makeProcess(100, 7, 1.0) });
+    for (int s = 1; s < 120; s++) {
+        store.recordProcesses(base + s * 1000, { makeProcess(100, 7, (double)s) });
+    }
+    std::vector<MetricStore::Point> raw = store.queryProcess(100, 7, Resolution::SECOND, base, base + 120000);
+    check(raw.size() == 60 && raw.front().timestampMs == base + 60000 && near(raw.back().avg[0], 119.0),
+          "Per-process raw ring keeps the newest 60 s");
+    check(store.queryProcess(100, 7, Resolution::MINUTE, base, base + 120000).size() == 2, "Per-process minute rollups");
+
+    // A reused PID with a new start time is a different series
+    store.recordProcesses(base + 120000, { makeProcess(100, 9, 80.0) });
+    check(store.getProcessSeriesCount() == 2 &&
+          store.queryProcess(100, 9, Resolution::SECOND, base, base + 121000).size() == 1,
+          "PID reuse starts a new series");
+
+    // LRU eviction beyond the cap
+    MetricStore small;
+    small.setMaxProcessSeries(3);
+    small.recordProcesses(base, { makeProcess(1, 1, 1.0), makeProcess(2, 1, 2.0), makeProcess(3, 1, 3.0) });
+    small.recordProcesses(base + 1000, { makeProcess(1, 1, 1.0), makeProcess(3, 1, 3.0) });
+    small.recordProcesses(base + 2000, { makeProcess(4, 1, 4.0) });
+    check(small.getProcessSeriesCount() == 3 && small.getEvictedCount() == 1 &&
+          small.queryProcess(2, 1, Resolution::SECOND, base, base + 3000).empty() &&
+          small.queryProcess(4, 1, Resolution::SECOND, base, base + 3000).size() == 1,
+          "Least recently updated series is evicted");
+    check(small.queryProcess(4, 1, Resolution::MINUTE, base, base + 3000)[0].count == 1,
+          "Evicted rings are reused from a clean state");
+    small.setMaxProcessSeries(1);
+    check(small.getProcessSeriesCount() == 1 && small.queryProcess(4, 1, Resolution::SECOND, base, base + 3000).size() == 1,
+          "Lowering the cap keeps the most recent series");
+    small.setMaxProcessSeries(0);
+    small.recordProcesses(base + 3000, { makeProcess(5, 1, 5.0) });
+    check(small.getProcessSeriesCount() == 0, "A cap of 0 keeps system history only");
+
+    // Memory is bounded: 5,000 processes over 24 h stay under 20 MB
+    MetricStore full;
+    std::vector<ProcessInfo> processes;
+    for (DWORD pid = 0; pid < 5000; pid++) {
+        processes.push_back(makeProcess(pid * 4, 1000 + pid, 0.5));
+    }
+    for (int hour = 0; hour < 24; hour++) {
+        full.recordProcesses(base + hour * 3600000ll, processes);
+    }
+    size_t estimate = MetricStore::estimateMemoryBytes(5000);
+    std::cout << "   " << full.getMemoryBytes() / 1024 << " KB used, " << estimate / 1024 << " KB estimated" << std::endl;
+    check(estimate < 20u * 1024 * 1024 && full.getMemoryBytes() < 20u * 1024 * 1024, "5,000 process series fit in 20 MB");
+    check(full.queryProcess(400, 1100, Resolution::HOUR, base, base + 24 * 3600000ll).size() == 24,
+          "24 hourly points per process");
+
+    std::cout << std::endl << (failures == 0 ? "✅ Metric store test PASSED" : "❌ Metric store test FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,134 @@
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+typedef SOCKET TestSocket;
+#define closeTestSocket closesocket
+#else
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+typedef int TestSocket;
+#define closeTestSocket close
+#endif
+#include "include/MetricsExporter.h"
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static int failures = 0;
+
+static void check(bool condition, const std::string& description) {
+    std::cout << (condition ? "✅ " : "❌ ") << description << std::endl;
+    if (!condition) failures++;
+}
+
+static TestSocket connectTo(uint16_t port) {
+    TestSocket client = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    connect(client, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    return client;
+}
+
+// Sends one request and reads the response until the server closes the connection
+static std::string fetch(uint16_t port, const std::string& request) {
+    TestSocket client = connectTo(port);
+    send(client, request.data(), static_cast<int>(request.size()), 0);
+    std::string response;
+    char buffer[4096];
+    int received;
+    while ((received = static_cast<int>(recv(client, buffer, sizeof(buffer), 0))) > 0) {
+        response.append(buffer, static_cast<size_t>(received));
+    }
+    closeTestSocket(client);
+    return response;
+}
+
+static ProcessInfo makeProcess(DWORD pid, const std::string& name, double cpu, double ram) {
+    ProcessInfo process(pid, 4, name);
+    process.setCpuPercent(cpu);
+    process.setRamPercent(ram);
+    return process;
+}
+
+int main() {
+    std::cout << "=== SystemMonitor Metrics Exporter Test ===" << std::endl;
+#ifdef _WIN32
+    WSADATA wsaData;
+    WSAStartup(MAKEWORD(2, 2), &wsaData);
+#endif
+
+    // Exposition format
+    std::vector<ProcessInfo> processes = {
+        makeProcess(4, "System", 0.1, 0.01),
+        makeProcess(1200, "java.exe", 85.0, 12.5),
+        makeProcess(1300, "odd \"name\"\\", 3.0, 1.0)
+    };
+    std::string exposition = MetricsExporter::render(1760000000123, SystemUsage(42.5, 61.25, 3.0), processes, 2);
+    check(exposition.find("# TYPE systemmonitor_cpu_percent gauge\nsystemmonitor_cpu_percent 42.50\n") != std::string::npos &&
+          exposition.find("systemmonitor_processes 3\n") != std::string::npos &&
+          exposition.find("systemmonitor_last_sample_timestamp_seconds 1760000000\n") != std::string::npos,
+          "System gauges in Prometheus text format");
+    check(exposition.find("systemmonitor_process_cpu_percent{pid=\"1200\",name=\"java.exe\"} 85.00\n") != std::string::npos &&
+          exposition.find("name=\"odd \\\"name\\\"\\\\\"} 3.00") != std::string::npos,
+          "Per-process series with escaped labels");
+    check(exposition.find("pid=\"4\"") == std::string::npos, "Only the top N processes are exported");
+
+    MetricsExporter exporter;
+    check(exporter.start(0) && exporter.getPort() != 0, "Server listens on a loopback port");
+    uint16_t port = exporter.getPort();
+    check(fetch(port, "GET /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n").compare(0, 12, "HTTP/1.1 503") == 0,
+          "Scrapes before the first cycle get 503");
+
+    exporter.publish(exposition);
+
+    // A client that connects and never sends must not hold up the others
+    TestSocket idle = connectTo(port);
+
+    std::vector<std::string> responses(32);
+    std::vector<std::thread> scrapers;
+    for (size_t i = 0; i < responses.size(); i++) {
+        scrapers.emplace_back([&responses, i, port]() {
+            responses[i] = fetch(port, "GET /metrics HTTP/1.1\r\nHost: localhost\r\nAccept: text/plain\r\n\r\n");
+        });
+    }
+    for (auto& scraper : scrapers) {
+        scraper.join();
+    }
+    bool allServed = true;
+    for (const auto& response : responses) {
+        size_t bodyStart = response.find("\r\n\r\n");
+        allServed = allServed && response.compare(0, 15, "HTTP/1.1 200 OK") == 0 && bodyStart != std::string::npos &&
+                    response.substr(bodyStart + 4) == exposition &&
+                    response.find("Content-Length: " + std::to_string(exposition.size())) != std::string::npos;
+    }
+    check(allServed, "32 concurrent scrapes get the published exposition");
+    check(exporter.getScrapeCount() == 32, "Scrapes are counted");
+    closeTestSocket(idle);
+
+    exporter.publish("systemmonitor_cpu_percent 1.00\n");
+    std::string next = fetch(port, "GET /metrics HTTP/1.1\r\n\r\n");
+    check(next.size() > 4 && next.substr(next.size() - 31) == "systemmonitor_cpu_percent 1.00\n",
+          "A new cycle replaces the served buffer");
+    check(fetch(port, "GET /other HTTP/1.1\r\n\r\n").compare(0, 12, "HTTP/1.1 404") == 0 &&
+          fetch(port, "POST /metrics HTTP/1.1\r\n\r\n").compare(0, 12, "HTTP/1.1 405") == 0,
+          "Other paths and methods are refused");
+
+    exporter.stop();
+    check(!exporter.isRunning(), "Server stops");
+
+#ifdef _WIN32
+    WSACleanup();
+#endif
+    std::cout << std::endl << (failures == 0 ? "✅ Metrics exporter test PASSED" : "❌ Metrics exporter test FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
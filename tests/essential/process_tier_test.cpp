@@ -0,0 +1,55 @@
+#include "include/ProcessTiers.h"
+#include <iostream>
+#include <string>
+
+static int failures = 0;
+
+static void check(bool condition, const std::string& description) {
+    std::cout << (condition ? "✅ " : "❌ ") << description << std::endl;
+    if (!condition) failures++;
+}
+
+int main() {
+    std::cout << "=== SystemMonitor Process Sampling Tier Test ===" << std::endl;
+
+    ProcessTierPolicy policy(0.5, 3, 10);
+    TierState state;
+
+    // New processes are sampled in full and start hot
+    check(policy.needsFullSample(state, false, 0.0), "Unknown process gets a full sample");
+    check(state.tier == SamplingTier::HOT, "New process starts hot");
+
+    // Quiet cycles demote
+    for (int cycle = 0; cycle < 3; cycle++) {
+        state = policy.advance(state, true, policy.isActive(0.0, 0.0));
+    }
+    check(state.tier == SamplingTier::COLD, "Three quiet cycles demote to cold");
+
+    // Cold processes skip full samples until the refresh cadence
+    int skipped = 0;
+    while (!policy.needsFullSample(state, true, 0.1) && skipped < 100) {
+        state = policy.advance(state, false, false);
+        skipped++;
+    }
+    check(skipped == 9, "Cold process is read in full every 10th cycle");
+    state = policy.advance(state, true, false);
+    check(state.cyclesSinceFull == 0 && state.tier == SamplingTier::COLD, "Full refresh keeps a quiet process cold");
+
+    // CPU jump promotes immediately
+    check(policy.needsFullSample(state, true, 5.0), "CPU jump forces a full sample");
+    state = policy.advance(state, true, policy.isActive(5.0, 0.0));
+    check(state.tier == SamplingTier::HOT && state.quietCycles == 0, "CPU jump promotes to hot");
+
+    // I/O activity keeps a process hot
+    state = policy.advance(state, true, policy.isActive(0.0, 0.2));
+    check(state.tier == SamplingTier::HOT, "Disk activity counts as active");
+
+    // A refresh cadence of one cycle disables tiering
+    ProcessTierPolicy everyCycle(0.5, 3, 1);
+    TierState cold;
+    cold.tier = SamplingTier::COLD;
+    check(!everyCycle.isEnabled() && everyCycle.needsFullSample(cold, true, 0.0), "PROCESS_COLD_REFRESH_CYCLES=1 samples everything");
+
+    std::cout << std::endl << (failures == 0 ? "✅ Process tier test PASSED" : "❌ Process tier test FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,134 @@
+#include "include/QuantileSketch.h"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Console flag normally defined by main.cpp; the logger reads it
+bool g_suppressConsoleOutput = true;
+
+static int failures = 0;
+
+static void check(bool condition, const std::string& description) {
+    std::cout << (condition ? "✅ " : "❌ ") << description << std::endl;
+    if (!condition) failures++;
+}
+
+static double exactQuantile(std::vector<double> values, double q) {
+    std::sort(values.begin(), values.end());
+    return values[static_cast<size_t>(q * (values.size() - 1))];
+}
+
+static bool withinAccuracy(double estimate, double exact) {
+    return std::fabs(estimate - exact) <= exact * QuantileSketch::RELATIVE_ACCURACY + 1e-9;
+}
+
+static ProcessInfo makeProcess(DWORD pid, const std::string& name, double cpu, double ram) {
+    ProcessInfo process(pid, 4, name);
+    process.setCpuPercent(cpu);
+    process.setRamPercent(ram);
+    return process;
+}
+
+int main() {
+    std::cout << "=== SystemMonitor Quantile Sketch Test ===" << std::endl;
+
+    // Accuracy on a skewed CPU-like distribution, with idle samples at zero
+    std::mt19937 random(7);
+    std::lognormal_distribution<double> usage(1.0, 1.2);
+    std::vector<double> values;
+    QuantileSketch sketch, firstHalf, secondHalf;
+    for (int i = 0; i < 20000; i++) {
+        double value = i % 5 == 0 ? 0.0 : std::min(100.0, usage(random));
+        values.push_back(value);
+        sketch.add(value);
+        (i < 10000 ? firstHalf : secondHalf).add(value);
+    }
+    bool accurate = true;
+    for (double q : { 0.5, 0.9, 0.95, 0.99 }) {
+        accurate = accurate && withinAccuracy(sketch.quantile(q), exactQuantile(values, q));
+    }
+    check(accurate, "p50/p90/p95/p99 within 1% of the exact values");
+    check(sketch.quantile(0.1) == 0.0 && sketch.quantile(1.0) == sketch.getMax() && sketch.getCount() == 20000,
+          "Idle samples count as zero; p100 is the maximum");
+    check(sketch.getBucketCount() < 1000, "Percent values need fewer than 1,000 buckets (" +
+          std::to_string(sketch.getBucketCount()) + ")");
+
+    // Merging hours gives the same answers as one sketch over both
+    firstHalf.merge(secondHalf);
+    check(firstHalf.getCount() == sketch.getCount() && firstHalf.quantile(0.95) == sketch.quantile(0.95) &&
+          firstHalf.quantile(0.5) == sketch.quantile(0.5), "Merged sketches equal a sketch of all samples");
+
+    std::string bytes;
+    sketch.serialize(bytes);
+    std::vector<uint8_t> data(bytes.begin(), bytes.end());
+    size_t position = 0;
+    QuantileSketch restored;
+    check(restored.deserialize(data, position) && position == data.size() &&
+          restored.quantile(0.99) == sketch.quantile(0.99) && restored.getCount() == sketch.getCount(),
+          "Sketches round-trip through their binary form (" + std::to_string(bytes.size()) + " bytes)");
+
+    // Past MAX_BUCKETS the lowest buckets collapse; high quantiles stay accurate
+    QuantileSketch wide;
+    std::vector<double> wideValues;
+    for (int i = 0; i < 5000; i++) {
+        double value = std::pow(10.0, -3.0 + i * 0.06);     // 1e-3 .. 1e297
+        wideValues.push_back(value);
+        wide.add(value);
+    }
+    check(wide.getBucketCount() == QuantileSketch::MAX_BUCKETS &&
+          withinAccuracy(wide.quantile(0.99), exactQuantile(wideValues, 0.99)),
+          "Bucket count is capped and high quantiles survive collapsing");
+
+    // Hourly store: two java.exe instances count as one name
+    const std::string directory = "quantile_sketch_test.d";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    PercentileStore store;
+    store.setDirectory(directory);
+    const int64_t base = 1760140800000 - 3600000;           // 2025-10-10 23:00 UTC
+    for (int second = 0; second < 3 * 3600; second++) {
+        double load = (second % 100) * 0.5;                 // 0 .. 49.5, uniform
+        store.record(base + second * 1000ll, SystemUsage(load, 60.0, 1.0),
+                     { makeProcess(10, "java.exe", load, 10.0), makeProcess(11, "java.exe", 5.0, 2.0),
+                       makeProcess(12, "svchost.exe", 0.0, 0.5) });
+    }
+    check(store.getHoursWritten() == 2 && store.getProcesses().size() == 2, "Finished hours are written as they end");
+    check(store.flush() && store.getHoursWritten() == 3, "The current hour is written on flush");
+    check(std::filesystem::exists(directory + "/history-20251010.qsk") &&
+          std::filesystem::exists(directory + "/history-20251011.qsk"), "Sketches go to the day's file");
+
+    {
+        std::ofstream torn(directory + "/history-20251011.qsk", std::ios::binary | std::ios::app);
+        torn.put('H');
+        torn.put(static_cast<char>(0x7F));
+    }
+    PercentileWindow window;
+    check(PercentileStore::load(directory, 2, window) && window.hourCount == 2 &&
+          window.system.cpu.getCount() == 7200 && window.fromMs == base + 3600000,
+          "The last two hours are merged across day files; a torn record is ignored");
+    const PercentileSeries* java = nullptr;
+    for (const auto& series : window.processes) {
+        if (series.name == "java.exe") java = &series;
+    }
+    check(java && java->cpu.getCount() == 7200 && withinAccuracy(java->cpu.quantile(0.5), 5.0 + 24.5) &&
+          withinAccuracy(java->ram.quantile(0.99), 12.0), "Instances of a name are summed per cycle");
+
+    std::string table = PercentileStore::formatTable(window, 1);
+    std::cout << table;
+    check(table.find("System") != std::string::npos && table.find("java.exe") != std::string::npos &&
+          table.find("svchost.exe") == std::string::npos && table.find("(1 more processes)") != std::string::npos,
+          "Table lists the system, then the busiest processes");
+    check(table.find("2025-10-11 00:00 to 2025-10-11 02:00 UTC") != std::string::npos, "Table names the UTC window");
+
+    PercentileWindow empty;
+    check(!PercentileStore::load(directory + "/missing", 24, empty), "A directory without sketches is reported");
+    std::filesystem::remove_all(directory);
+
+    std::cout << std::endl << (failures == 0 ? "✅ Quantile sketch test PASSED" : "❌ Quantile sketch test FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
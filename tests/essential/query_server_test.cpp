@@ -0,0 +1,291 @@
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <afunix.h>
+typedef SOCKET TestSocket;
+#define closeTestSocket closesocket
+#define pollTestSockets WSAPoll
+typedef WSAPOLLFD TestPollEntry;
+#else
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <unistd.h>
+typedef int TestSocket;
+#define closeTestSocket close
+#define pollTestSockets poll
+typedef pollfd TestPollEntry;
+#endif
+#include "include/QueryServer.h"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+static void check(bool condition, const std::string& description) {
+    std::cout << (condition ? "✅ " : "❌ ") << description << std::endl;
+    if (!condition) failures++;
+}
+
+static const char* SOCKET_PATH = "query_server_test.sock";
+
+static TestSocket connectClient() {
+    TestSocket client = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::strcpy(address.sun_path, SOCKET_PATH);
+    connect(client, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    return client;
+}
+
+static void sendFrame(TestSocket client, QueryMessage type, uint32_t requestId, const std::string& body = "") {
+    std::string frame;
+    uint32_t length = static_cast<uint32_t>(5 + body.size());
+    for (int i = 0; i < 4; i++) frame.push_back(static_cast<char>(length >> (i * 8)));
+    frame.push_back(static_cast<char>(type));
+    for (int i = 0; i < 4; i++) frame.push_back(static_cast<char>(requestId >> (i * 8)));
+    frame += body;
+    send(client, frame.data(), static_cast<int>(frame.size()), 0);
+}
+
+static bool waitReadable(TestSocket client, int timeoutMs) {
+    TestPollEntry entry = {};
+    entry.fd = client;
+    entry.events = POLLIN;
+    return pollTestSockets(&entry, 1, timeoutMs) > 0;
+}
+
+static bool readExact(TestSocket client, std::string& out, size_t length) {
+    out.resize(length);
+    size_t done = 0;
+    while (done < length) {
+        if (!waitReadable(client, 2000)) return false;
+        int received = static_cast<int>(recv(client, &out[done], static_cast<int>(length - done), 0));
+        if (received <= 0) return false;
+        done += static_cast<size_t>(received);
+    }
+    return true;
+}
+
+// Reads a little-endian protocol frame
+struct Frame {
+    QueryMessage type = QueryMessage::REJECTED;
+    uint32_t requestId = 0;
+    std::string body;
+    size_t position = 0;
+
+    uint8_t u8() { return static_cast<uint8_t>(body[position++]); }
+    uint16_t u16() { uint16_t value = u8(); return static_cast<uint16_t>(value | (u8() << 8)); }
+    uint32_t u32() { uint32_t value = 0; for (int i = 0; i < 4; i++) value |= static_cast<uint32_t>(u8()) << (i * 8); return value; }
+    uint64_t u64() { uint64_t value = 0; for (int i = 0; i < 8; i++) value |= static_cast<uint64_t>(u8()) << (i * 8); return value; }
+    float f32() { uint32_t bits = u32(); float value; std::memcpy(&value, &bits, sizeof(value)); return value; }
+    std::string name() { uint8_t length = u8(); std::string value = body.substr(position, length); position += length; return value; }
+};
+
+static bool readFrame(TestSocket client, Frame& frame) {
+    std::string header;
+    if (!readExact(client, header, 9)) return false;
+    frame.body = header;
+    frame.position = 0;
+    uint32_t length = frame.u32();
+    frame.type = static_cast<QueryMessage>(frame.u8());
+    frame.requestId = frame.u32();
+    frame.position = 0;
+    return readExact(client, frame.body, length - 5);
+}
+
+struct Usage {
+    std::string name;
+    float cpu = 0.0f;
+};
+
+// Applies a DELTA to a subscriber's view of the process table
+static void applyDelta(Frame& frame, std::map<uint32_t, Usage>& view, uint64_t& cycle) {
+    frame.u64();
+    cycle = frame.u64();
+    frame.f32(); frame.f32(); frame.f32();
+    for (uint32_t n = frame.u32(); n > 0; n--) {
+        uint32_t pid = frame.u32();
+        frame.u32();
+        float cpu = frame.f32();
+        frame.f32(); frame.f32();
+        view[pid] = { frame.name(), cpu };
+    }
+    for (uint32_t n = frame.u32(); n > 0; n--) {
+        uint32_t pid = frame.u32();
+        view[pid].cpu = frame.f32();
+        frame.f32(); frame.f32();
+    }
+    for (uint32_t n = frame.u32(); n > 0; n--) {
+        view.erase(frame.u32());
+    }
+}
+
+static ProcessInfo makeProcess(DWORD pid, const std::string& name, double cpu, double ram) {
+    ProcessInfo process(pid, 4, name);
+    process.setCpuPercent(cpu);
+    process.setRamPercent(ram);
+    return process;
+}
+
+static std::string topBody(uint8_t metric, uint16_t count) {
+    return std::string(1, static_cast<char>(metric)) + static_cast<char>(count & 0xFF) + static_cast<char>(count >> 8);
+}
+
+int main() {
+    std::cout << "=== SystemMonitor Query Server Test ===" << std::endl;
+#ifdef _WIN32
+    WSADATA wsaData;
+    WSAStartup(MAKEWORD(2, 2), &wsaData);
+#endif
+    std::remove(SOCKET_PATH);
+
+    QueryServer server;
+    check(server.start(SOCKET_PATH), "Server listens on the socket file");
+    TestSocket client = connectClient();
+    Frame frame;
+
+    sendFrame(client, QueryMessage::TOP, 7, topBody(0, 2));
+    check(readFrame(client, frame) && frame.type == QueryMessage::REJECTED && frame.requestId == 7 &&
+          frame.u8() == static_cast<uint8_t>(QueryError::NOT_READY), "Queries before the first cycle are refused");
+
+    std::vector<ProcessInfo> processes = {
+        makeProcess(100, "idle.exe", 0.0, 1.0),
+        makeProcess(200, "java.exe", 55.5, 12.0),
+        makeProcess(300, "chrome.exe", 20.25, 30.0)
+    };
+    server.publish(1000, SystemUsage(40.0, 50.0, 1.0), processes);
+    bool ranked = false;
+    for (int attempt = 0; attempt < 100 && !ranked; attempt++) {
+        sendFrame(client, QueryMessage::TOP, 8, topBody(0, 2));
+        if (readFrame(client, frame) && frame.type == QueryMessage::TOP_RESULT) {
+            frame.u64();
+            ranked = frame.u16() == 2 && frame.u32() == 200;
+            frame.u32();
+            ranked = ranked && frame.f32() == 55.5f;
+            frame.f32(); frame.f32();
+            ranked = ranked && frame.name() == "java.exe" && frame.u32() == 300;
+        }
+    }
+    check(ranked, "TOP returns the heaviest processes by the chosen metric");
+
+    sendFrame(client, QueryMessage::TOP, 9, topBody(1, 1));
+    check(readFrame(client, frame) && frame.type == QueryMessage::TOP_RESULT && (frame.u64(), frame.u16()) == 1 &&
+          frame.u32() == 300, "TOP by RAM ranks by RAM");
+
+    // Subscribers get the whole table, then one diff per cycle
+    std::map<uint32_t, Usage> view;
+    uint64_t cycle = 0;
+    sendFrame(client, QueryMessage::SUBSCRIBE, 10);
+    check(readFrame(client, frame) && frame.type == QueryMessage::SUBSCRIBED && frame.requestId == 10 &&
+          readFrame(client, frame) && frame.type == QueryMessage::DELTA, "SUBSCRIBE is acknowledged with a full table");
+    applyDelta(frame, view, cycle);
+    check(view.size() == 3 && view[200].name == "java.exe" && cycle == 1, "The first delta holds every process");
+
+    processes = {
+        makeProcess(100, "idle.exe", 0.0, 1.0),                 // Unchanged
+        makeProcess(200, "java.exe", 60.0, 12.0),               // Changed
+        makeProcess(400, "new.exe", 5.0, 2.0)                   // Started; 300 exited
+    };
+    server.publish(2000, SystemUsage(45.0, 50.0, 1.0), processes);
+    bool pushed = readFrame(client, frame) && frame.type == QueryMessage::DELTA && frame.requestId == 0;
+    check(pushed && frame.body.size() < 120, "Each cycle pushes a compact delta (" + std::to_string(frame.body.size()) + " bytes)");
+    applyDelta(frame, view, cycle);
+    check(view.size() == 3 && view.count(300) == 0 && view[400].name == "new.exe" && view[200].cpu == 60.0f && cycle == 2,
+          "Deltas carry new, changed and exited processes");
+
+    // History comes from the main loop's store
+    MetricStore store;
+    for (int second = 0; second < 10; second++) {
+        store.recordProcesses(1760000000000 + second * 1000, processes);
+    }
+    sendFrame(client, QueryMessage::HISTORY, 11,
+              std::string("\xC8\x00\x00\x00\x00\x3C\x00\x00\x00", 9));     // pid 200, seconds, 60 s
+    sendFrame(client, QueryMessage::HISTORY, 12,
+              std::string("\x39\x05\x00\x00\x00\x3C\x00\x00\x00", 9));     // pid 1337
+    bool answered = false;
+    for (int attempt = 0; attempt < 200 && !answered; attempt++) {
+        server.answerHistoryRequests(store, processes, 1760000009000);
+        answered = waitReadable(client, 10);
+    }
+    check(answered && readFrame(client, frame) && frame.type == QueryMessage::HISTORY_RESULT && frame.requestId == 11 &&
+          frame.u32() == 200 && frame.u8() == 0 && frame.u32() == 10 && (frame.u64(), frame.u32()) == 1 &&
+          frame.f32() == 60.0f, "HISTORY returns the pid's points from the store");
+    if (!waitReadable(client, 10)) {
+        server.answerHistoryRequests(store, processes, 1760000009000);
+    }
+    check(readFrame(client, frame) && frame.type == QueryMessage::REJECTED && frame.requestId == 12 &&
+          frame.u8() == static_cast<uint8_t>(QueryError::UNKNOWN_PID), "HISTORY of an unknown pid is refused");
+
+    sendFrame(client, QueryMessage::UNSUBSCRIBE, 13);
+    check(readFrame(client, frame) && frame.type == QueryMessage::UNSUBSCRIBED, "UNSUBSCRIBE stops the pushes");
+
+    // Many subscribers and one that never reads; every reader converges on the same table
+    TestSocket stalled = connectClient();
+    sendFrame(stalled, QueryMessage::SUBSCRIBE, 1);
+    std::vector<TestSocket> subscribers;
+    for (int i = 0; i < 20; i++) {
+        subscribers.push_back(connectClient());
+        sendFrame(subscribers.back(), QueryMessage::SUBSCRIBE, 1);
+    }
+    std::vector<std::map<uint32_t, Usage>> views(subscribers.size());
+    std::vector<uint64_t> cycles(subscribers.size(), 0);
+    for (size_t i = 0; i < subscribers.size(); i++) {
+        readFrame(subscribers[i], frame);
+        if (readFrame(subscribers[i], frame)) applyDelta(frame, views[i], cycles[i]);
+    }
+    for (int k = 3; k <= 52; k++) {
+        processes.clear();
+        for (int pid = k; pid < k + 30; pid++) {
+            processes.push_back(makeProcess(static_cast<DWORD>(pid), "p" + std::to_string(pid), (pid * k) % 100, 1.0));
+        }
+        server.publish(k * 1000, SystemUsage(k, 50.0, 1.0), processes);
+        for (size_t i = 0; i < subscribers.size(); i++) {
+            while (cycles[i] < static_cast<uint64_t>(k) && readFrame(subscribers[i], frame)) {
+                applyDelta(frame, views[i], cycles[i]);
+            }
+        }
+    }
+    bool converged = true;
+    for (size_t i = 0; i < subscribers.size(); i++) {
+        converged = converged && cycles[i] == 52 && views[i].size() == 30 && views[i].begin()->first == 52 &&
+                    views[i][60].cpu == static_cast<float>((60 * 52) % 100) && views[i][81].name == "p81";
+    }
+    check(converged, "20 subscribers rebuild the same table from deltas");
+
+    sendFrame(client, QueryMessage::TOP, 14, topBody(0, 1));
+    check(readFrame(client, frame) && frame.type == QueryMessage::TOP_RESULT, "Queries are served next to subscribers");
+
+    // A malformed frame closes only that connection
+    TestSocket broken = connectClient();
+    send(broken, "\xFF\xFF\xFF\xFF", 4, 0);
+    std::string ignored;
+    check(!readExact(broken, ignored, 1) && server.getDroppedCount() >= 1, "An oversized frame drops the client");
+    closeTestSocket(broken);
+
+    for (auto subscriber : subscribers) {
+        closeTestSocket(subscriber);
+    }
+    closeTestSocket(stalled);
+    closeTestSocket(client);
+    check(server.getRequestCount() >= 29, "Requests are counted (" + std::to_string(server.getRequestCount()) + ")");
+
+    server.stop();
+    TestSocket late = connectClient();
+    check(!server.isRunning() && !readExact(late, ignored, 1), "Server stops");
+    closeTestSocket(late);
+    check(std::fopen(SOCKET_PATH, "r") == nullptr, "The socket file is removed");
+
+#ifdef _WIN32
+    WSACleanup();
+#endif
+    std::cout << std::endl << (failures == 0 ? "✅ Query server test PASSED" : "❌ Query server test FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -11,7 +11,7 @@ echo 🔧 Running essential technology validation tests...
 echo.
 
 REM Test 1: Integration Status
-echo [TEST 1/3] System Integration Status
+echo [TEST 1/24] System Integration Status
 echo ----------------------------------------
 if exist integration_status.exe (
     integration_status.exe
@@ -26,7 +26,7 @@ echo ========================================
 echo.
 
 REM Test 2: Configuration Testing
-echo [TEST 2/3] Configuration Validation
+echo [TEST 2/24] Configuration Validation
 echo ----------------------------------------
 if exist config_email_test.exe (
     config_email_test.exe
@@ -40,8 +40,323 @@ echo.
 echo ========================================
 echo.
 
-REM Test 3: libcurl Email Integration (requires user confirmation)
-echo [TEST 3/3] libcurl TLS Email Integration
+REM Test 3: Alert Rule Engine
+echo [TEST 3/24] Alert Rule Engine
+echo ----------------------------------------
+if exist alert_engine_test.exe (
+    alert_engine_test.exe
+    echo.
+    echo ✅ Alert engine test completed
+) else (
+    echo ❌ alert_engine_test.exe not found. Run build_tests.bat first.
+)
+
+echo.
+echo ========================================
+echo.
+
+REM Test 4: Configuration Parser
+echo [TEST 4/24] Configuration Parser
+echo ----------------------------------------
+if exist config_parser_test.exe (
+    config_parser_test.exe
+    echo.
+    echo ✅ Configuration parser test completed
+) else (
+    echo ❌ config_parser_test.exe not found. Run build_tests.bat first.
+)
+
+echo.
+echo ========================================
+echo.
+
+REM Test 5: Process Sampling Tiers
+echo [TEST 5/24] Process Sampling Tiers
+echo ----------------------------------------
+if exist process_tier_test.exe (
+    process_tier_test.exe
+    echo.
+    echo ✅ Process tier test completed
+) else (
+    echo ❌ process_tier_test.exe not found. Run build_tests.bat first.
+)
+
+echo.
+echo ========================================
+echo.
+
+REM Test 6: Deadline Tick Scheduler
+echo [TEST 6/24] Deadline Tick Scheduler
+echo ----------------------------------------
+if exist tick_scheduler_test.exe (
+    tick_scheduler_test.exe
+    echo.
+    echo ✅ Tick scheduler test completed
+) else (
+    echo ❌ tick_scheduler_test.exe not found. Run build_tests.bat first.
+)
+
+echo.
+echo ========================================
+echo.
+
+REM Test 7: Burst Capture
+echo [TEST 7/24] Burst Capture
+echo ----------------------------------------
+if exist burst_capture_test.exe (
+    burst_capture_test.exe
+    echo.
+    echo ✅ Burst capture test completed
+) else (
+    echo ❌ burst_capture_test.exe not found. Run build_tests.bat first.
+)
+
+echo.
+echo ========================================
+echo.
+
+REM Test 8: Agent Self Monitor
+echo [TEST 8/24] Agent Self Monitor
+echo ----------------------------------------
+if exist self_monitor_test.exe (
+    self_monitor_test.exe
+    echo.
+    echo ✅ Self monitor test completed
+) else (
+    echo ❌ self_monitor_test.exe not found. Run build_tests.bat first.
+)
+
+echo.
+echo ========================================
+echo.
+
+REM Test 9: Stage Latency Histograms
+echo [TEST 9/24] Stage Latency Histograms
+echo ----------------------------------------
+if exist stage_profiler_test.exe (
+    stage_profiler_test.exe
+    echo.
+    echo ✅ Stage profiler test completed
+) else (
+    echo ❌ stage_profiler_test.exe not found. Run build_tests.bat first.
+)
+
+echo.
+echo ========================================
+echo.
+
+REM Test 10: Chrome Trace Export
+echo [TEST 10/24] Chrome Trace Export
+echo ----------------------------------------
+if exist trace_recorder_test.exe (
+    trace_recorder_test.exe
+    echo.
+    echo ✅ Trace recorder test completed
+) else (
+    echo ❌ trace_recorder_test.exe not found. Run build_tests.bat first.
+)
+
+echo.
+echo ========================================
+echo.
+
+REM Test 11: Snapshot File
+echo [TEST 11/24] Snapshot File
+echo ----------------------------------------
+if exist snapshot_file_test.exe (
+    snapshot_file_test.exe
+    echo.
+    echo ✅ Snapshot file test completed
+) else (
+    echo ❌ snapshot_file_test.exe not found. Run build_tests.bat first.
+)
+
+echo.
+echo ========================================
+echo.
+
+REM Test 12: Metric Store
+echo [TEST 12/24] Metric Store
+echo ----------------------------------------
+if exist metric_store_test.exe (
+    metric_store_test.exe
+    echo.
+    echo ✅ Metric store test completed
+) else (
+    echo ❌ metric_store_test.exe not found. Run build_tests.bat first.
+)
+
+echo.
+echo ========================================
+echo.
+
+REM Test 13: History Archive
+echo [TEST 13/24] History Archive
+echo ----------------------------------------
+if exist history_archive_test.exe (
+    history_archive_test.exe
+    echo.
+    echo ✅ History archive test completed
+) else (
+    echo ❌ history_archive_test.exe not found. Run build_tests.bat first.
+)
+
+echo.
+echo ========================================
+echo.
+
+REM Test 14: Quantile Sketch
+echo [TEST 14/24] Quantile Sketch
+echo ----------------------------------------
+if exist quantile_sketch_test.exe (
+    quantile_sketch_test.exe
+    echo.
+    echo ✅ Quantile sketch test completed
+) else (
+    echo ❌ quantile_sketch_test.exe not found. Run build_tests.bat first.
+)
+
+echo.
+echo ========================================
+echo.
+
+REM Test 15: Metrics Exporter
+echo [TEST 15/24] Metrics Exporter
+echo ----------------------------------------
+if exist metrics_exporter_test.exe (
+    metrics_exporter_test.exe
+    echo.
+    echo ✅ Metrics exporter test completed
+) else (
+    echo ❌ metrics_exporter_test.exe not found. Run build_tests.bat first.
+)
+
+echo.
+echo ========================================
+echo.
+
+REM Test 16: Shared Snapshot
+echo [TEST 16/24] Shared Snapshot
+echo ----------------------------------------
+if exist shared_snapshot_test.exe (
+    shared_snapshot_test.exe
+    echo.
+    echo ✅ Shared snapshot test completed
+) else (
+    echo ❌ shared_snapshot_test.exe not found. Run build_tests.bat first.
+)
+
+echo.
+echo ========================================
+echo.
+
+REM Test 17: Query Server
+echo [TEST 17/24] Query Server
+echo ----------------------------------------
+if exist query_server_test.exe (
+    query_server_test.exe
+    echo.
+    echo ✅ Query server test completed
+) else (
+    echo ❌ query_server_test.exe not found. Run build_tests.bat first.
+)
+
+echo.
+echo ========================================
+echo.
+
+REM Test 18: StatsD Sink
+echo [TEST 18/24] StatsD Sink
+echo ----------------------------------------
+if exist statsd_sink_test.exe (
+    statsd_sink_test.exe
+    echo.
+    echo ✅ StatsD sink test completed
+) else (
+    echo ❌ statsd_sink_test.exe not found. Run build_tests.bat first.
+)
+
+echo.
+echo ========================================
+echo.
+
+REM Test 19: JSON Lines Writer
+echo [TEST 19/24] JSON Lines Writer
+echo ----------------------------------------
+if exist json_lines_writer_test.exe (
+    json_lines_writer_test.exe
+    echo.
+    echo ✅ JSON Lines writer test completed
+) else (
+    echo ❌ json_lines_writer_test.exe not found. Run build_tests.bat first.
+)
+
+echo.
+echo ========================================
+echo.
+
+REM Test 20: Columnar Export
+echo [TEST 20/24] Columnar Export
+echo ----------------------------------------
+if exist columnar_export_test.exe (
+    columnar_export_test.exe
+    echo.
+    echo ✅ Columnar export test completed
+) else (
+    echo ❌ columnar_export_test.exe not found. Run build_tests.bat first.
+)
+
+echo.
+echo ========================================
+echo.
+
+REM Test 21: Config Watcher
+echo [TEST 21/24] Config Watcher
+echo ----------------------------------------
+if exist config_watcher_test.exe (
+    config_watcher_test.exe
+    echo.
+    echo ✅ Config watcher test completed
+) else (
+    echo ❌ config_watcher_test.exe not found. Run build_tests.bat first.
+)
+
+echo.
+echo ========================================
+echo.
+
+REM Test 22: Screen Renderer
+echo [TEST 22/24] Screen Renderer
+echo ----------------------------------------
+if exist screen_renderer_test.exe (
+    screen_renderer_test.exe
+    echo.
+    echo ✅ Screen renderer test completed
+) else (
+    echo ❌ screen_renderer_test.exe not found. Run build_tests.bat first.
+)
+
+echo.
+echo ========================================
+echo.
+
+REM Test 23: Thread Pool
+echo [TEST 23/24] Thread Pool
+echo ----------------------------------------
+if exist thread_pool_test.exe (
+    thread_pool_test.exe
+    echo.
+    echo ✅ Thread pool test completed
+) else (
+    echo ❌ thread_pool_test.exe not found. Run build_tests.bat first.
+)
+
+echo.
+echo ========================================
+echo.
+
+REM Test 24: libcurl Email Integration (requires user confirmation)
+echo [TEST 24/24] libcurl TLS Email Integration
 echo ----------------------------------------
 echo.
 echo ⚠️  WARNING: This test will send a real email!
@@ -69,6 +384,27 @@ echo 🎯 Essential Tests Summary:
 echo ----------------------------------------
 echo ✅ Integration Status - Validates system setup
 echo ✅ Configuration Test - Validates email config parsing
+echo ✅ Alert Engine Test - Validates per-rule alert state machines
+echo ✅ Config Parser Test - Validates configuration key registry
+echo ✅ Process Tier Test - Validates hot/cold sampling classification
+echo ✅ Tick Scheduler Test - Validates drift-free sampling deadlines
+echo ✅ Burst Capture Test - Validates high-resolution capture after a threshold crossing
+echo ✅ Agent Self Monitor Test - Validates the agent footprint sampling and budget alarm
+echo ✅ Stage Latency Histograms Test - Validates the per-stage cycle latency histograms
+echo ✅ Chrome Trace Export Test - Verifies the opt-in Chrome trace recorder used by `--trace`
+echo ✅ Snapshot File Test - Validates the --record file format and the replay collectors
+echo ✅ Metric Store Test - Validates the multi-resolution usage history
+echo ✅ History Archive Test - Validates the compressed on-disk usage history
+echo ✅ Quantile Sketch Test - Validates the percentile sketches and their hourly files
+echo ✅ Metrics Exporter Test - Verifies the /metrics text format and that concurrent scrapes share one rendered buffer
+echo ✅ Shared Snapshot Test - Verifies local readers get whole, consistent cycles without locks while the writer publishes
+echo ✅ Query Server Test - Verifies top-N, PID history and per-cycle delta subscriptions over the length-prefixed protocol
+echo ✅ StatsD Sink Test - Verifies gauge lines, datagram packing and drop-on-overflow against a local UDP listener
+echo ✅ JSON Lines Writer Test - Verifies the per-cycle JSON Lines output of --output jsonl
+echo ✅ Columnar Export Test - Verifies the columnar export file and its reader over two weeks of synthetic cycles
+echo ✅ Config Watcher Test - Verifies that a rewritten configuration file is republished with its generation
+echo ✅ Screen Renderer Test - Verifies the escape sequences the renderer writes between two frames
+echo ✅ Thread Pool Test - Verifies that parallelFor runs every chunk exactly once and reports failures
 if /i "%CONFIRM%"=="y" (
     echo ✅ Email Integration - Validates TLS email delivery
 ) else (
@@ -0,0 +1,97 @@
+#include "include/ScreenRenderer.h"
+#include <iostream>
+#include <string>
+
+static int failures = 0;
+
+static void check(bool condition, const std::string& description) {
+    std::cout << (condition ? "✅ " : "❌ ") << description << std::endl;
+    if (!condition) failures++;
+}
+
+// Escape sequences made readable for failure output
+static std::string visible(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+        if (c == '\x1b') out += "ESC";
+        else out += c;
+    }
+    return out;
+}
+
+static void expectOutput(const ScreenRenderer& renderer, const std::string& expected, const std::string& description) {
+    bool matches = renderer.getLastOutput() == expected;
+    check(matches, matches ? description : description + " (got \"" + visible(renderer.getLastOutput()) + "\")");
+}
+
+static void frame(ScreenRenderer& renderer, const std::string& cpu, const std::string& ram, const std::string& disk) {
+    renderer.beginFrame();
+    renderer.addLine("CPU: " + cpu);
+    renderer.addLine("RAM: " + ram);
+    if (!disk.empty()) {
+        renderer.addLine("Disk: " + disk);
+    }
+    renderer.present();
+}
+
+int main() {
+    std::cout << "=== SystemMonitor Screen Renderer Test ===" << std::endl;
+
+    ScreenRenderer renderer;
+    renderer.renderToMemory(40, 10);
+
+    frame(renderer, "10%", "20%", "5%");
+    const std::string& first = renderer.getLastOutput();
+    check(first.rfind("\x1b[0m\x1b[H\x1b[2J", 0) == 0, "The first frame clears the screen");
+    check(first.find("\x1b[1;1HCPU: 10%") != std::string::npos && first.find("\x1b[2;1HRAM: 20%") != std::string::npos &&
+          first.find("\x1b[3;1HDisk: 5%") != std::string::npos, "The first frame writes every row");
+
+    frame(renderer, "10%", "20%", "5%");
+    expectOutput(renderer, "", "An unchanged frame writes nothing");
+
+    // One changed cell: move there, write it, park the cursor below the frame
+    frame(renderer, "18%", "20%", "5%");
+    expectOutput(renderer, "\x1b[1;7H8\x1b[4;1H", "A changed cell is the only thing written");
+
+    // Shorter row: the new text, then erase to the end of the line
+    frame(renderer, "18%", "2%", "5%");
+    expectOutput(renderer, "\x1b[2;7H%\x1b[K\x1b[4;1H", "A shortened row is cleared to the end of the line");
+
+    // Same text in another color: SGR around the span, back to the default before parking
+    renderer.beginFrame();
+    renderer.addLine("CPU: ");
+    renderer.append("18%", 12);
+    renderer.addLine("RAM: 2%");
+    renderer.addLine("Disk: 5%");
+    renderer.present();
+    expectOutput(renderer, "\x1b[1;6H\x1b[91m18%\x1b[0m\x1b[4;1H", "A color change rewrites the cells with their color");
+
+    // Back to the default color, and a row that disappears is erased
+    frame(renderer, "18%", "2%", "");
+    expectOutput(renderer, "\x1b[1;6H18%\x1b[3;1H\x1b[K\x1b[3;1H", "A removed row is erased");
+
+    // Resize: clear and redraw everything
+    renderer.renderToMemory(60, 20);
+    frame(renderer, "18%", "2%", "");
+    const std::string& resized = renderer.getLastOutput();
+    check(resized.rfind("\x1b[0m\x1b[H\x1b[2J", 0) == 0 && resized.find("\x1b[1;1HCPU: 18%") != std::string::npos &&
+          resized.find("\x1b[2;1HRAM: 2%") != std::string::npos, "A resize redraws the full frame");
+
+    // Never write into the last column or row
+    renderer.renderToMemory(10, 3);
+    renderer.beginFrame();
+    renderer.addLine("0123456789AB");
+    renderer.addLine("second");
+    renderer.addLine("third");
+    renderer.present();
+    const std::string& narrow = renderer.getLastOutput();
+    check(narrow.find("012345678\x1b") != std::string::npos && narrow.find('9') == std::string::npos &&
+          narrow.find("third") == std::string::npos, "Rows are cut to the window");
+
+    renderer.invalidate();
+    frame(renderer, "18%", "2%", "");
+    check(renderer.getLastOutput().rfind("\x1b[0m\x1b[H\x1b[2J", 0) == 0, "invalidate() forces a full redraw");
+
+    std::cout << std::endl << (failures == 0 ? "✅ Screen renderer test PASSED" : "❌ Screen renderer test FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,58 @@
+#include "include/SelfMonitor.h"
+#include <iostream>
+#include <string>
+
+static int failures = 0;
+
+static void check(bool condition, const std::string& description) {
+    std::cout << (condition ? "✅ " : "❌ ") << description << std::endl;
+    if (!condition) failures++;
+}
+
+static SelfStats makeStats(double cpu, uint64_t rssMb) {
+    SelfStats stats;
+    stats.cpuPercent = cpu;
+    stats.rssBytes = rssMb * 1024 * 1024;
+    return stats;
+}
+
+int main() {
+    std::cout << "=== SystemMonitor Self Monitor Test ===" << std::endl;
+    using BudgetEvent = SelfMonitor::BudgetEvent;
+
+    SelfMonitor monitor;
+    monitor.setBudget(1.0, 50ull * 1024 * 1024);
+    check(!monitor.exceedsBudget(makeStats(0.5, 20)), "Within budget");
+    check(monitor.exceedsBudget(makeStats(1.5, 20)), "CPU over budget");
+    check(monitor.exceedsBudget(makeStats(0.5, 60)), "RSS over budget");
+
+    // One slow cycle does not raise the alarm
+    check(monitor.evaluateBudget(makeStats(5.0, 20)) == BudgetEvent::NONE, "Single spike is ignored");
+    check(monitor.evaluateBudget(makeStats(0.2, 20)) == BudgetEvent::NONE, "Spike followed by a quiet cycle");
+
+    BudgetEvent event = BudgetEvent::NONE;
+    for (int i = 0; i < SelfMonitor::BUDGET_SAMPLES; i++) {
+        event = monitor.evaluateBudget(makeStats(2.0, 20));
+    }
+    check(event == BudgetEvent::EXCEEDED && monitor.isOverBudget(), "Alarm fires after consecutive samples over budget");
+    check(monitor.evaluateBudget(makeStats(2.0, 20)) == BudgetEvent::NONE, "Alarm fires once");
+
+    for (int i = 0; i < SelfMonitor::BUDGET_SAMPLES; i++) {
+        event = monitor.evaluateBudget(makeStats(0.1, 20));
+    }
+    check(event == BudgetEvent::RECOVERED && !monitor.isOverBudget(), "Alarm clears after consecutive samples within budget");
+
+    monitor.setBudget(0.0, 0);
+    check(!monitor.exceedsBudget(makeStats(90.0, 4096)), "Zero budget disables the checks");
+
+    // Live sample of this process
+    monitor.setQueueStats(3, 1, 0, 0);
+    monitor.sample();
+    monitor.sample();
+    check(monitor.getStats().rssBytes > 0, "Resident memory is read");
+    check(monitor.getStats().threadCount >= 1, "Thread count is read");
+    check(monitor.formatSummary().find("Log queue 3 (dropped 1)") != std::string::npos, "Summary carries the queue figures");
+
+    std::cout << std::endl << (failures == 0 ? "✅ Self monitor test PASSED" : "❌ Self monitor test FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,131 @@
+#include "include/SharedSnapshotWriter.h"
+#include "include/SharedSnapshotReader.h"
+#include <atomic>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static int failures = 0;
+
+static void check(bool condition, const std::string& description) {
+    std::cout << (condition ? "✅ " : "❌ ") << description << std::endl;
+    if (!condition) failures++;
+}
+
+static ProcessInfo makeProcess(DWORD pid, const std::string& name, double cpu, double ram) {
+    ProcessInfo process(pid, 4, name);
+    process.setCpuPercent(cpu);
+    process.setRamPercent(ram);
+    return process;
+}
+
+// Every field of cycle k carries k, so any mix of two cycles is detectable
+static bool isConsistent(const SharedSnapshot& snapshot) {
+    double k = snapshot.cpuPercent;
+    if (snapshot.ramPercent != k || snapshot.timestampMs != static_cast<int64_t>(k) ||
+        snapshot.totalProcesses != static_cast<uint32_t>(k) % 50 + 10) {
+        return false;
+    }
+    for (const auto& process : snapshot.processes) {
+        if (process.ramPercent != k) return false;
+    }
+    return true;
+}
+
+int main() {
+    std::cout << "=== SystemMonitor Shared Snapshot Test ===" << std::endl;
+    const std::string name = "SystemMonitorSnapshotTest";
+
+    SharedSnapshotReader reader;
+    check(!reader.open(name), "Opening a missing segment fails");
+
+    SharedSnapshotWriter writer;
+    check(writer.start(name, 4), "Writer creates the segment");
+    check(reader.open(name) && reader.getCapacity() == 4, "Reader maps the segment and checks its layout");
+
+    SharedSnapshotWriter second;
+    check(!second.start(name, 8), "A second writer does not take over a running writer's segment");
+    SharedSnapshotReader stillThere;
+    check(stillThere.open(name) && stillThere.getCapacity() == 4, "The running writer's segment is left in place");
+
+    SharedSnapshot snapshot;
+    check(!reader.read(snapshot), "Nothing to read before the first cycle");
+
+    std::vector<ProcessInfo> processes = {
+        makeProcess(4, "System", 0.1, 0.01),
+        makeProcess(1200, "java.exe", 85.0, 12.5),
+        makeProcess(1300, "a-process-name-that-is-longer-than-the-record-name-field.exe", 3.0, 1.0),
+        makeProcess(1400, "svchost.exe", 1.0, 0.5),
+        makeProcess(1500, "chrome.exe", 20.0, 8.0),
+        makeProcess(1600, "idle.exe", 0.0, 0.0)
+    };
+    writer.publish(1760000000123, SystemUsage(42.5, 61.25, 3.0), processes);
+    check(reader.hasUpdate() && reader.read(snapshot) && !reader.hasUpdate(), "A published cycle is seen once");
+    check(snapshot.cycle == 1 && snapshot.timestampMs == 1760000000123 && snapshot.cpuPercent == 42.5 &&
+          snapshot.ramPercent == 61.25 && snapshot.totalProcesses == 6, "System values round-trip");
+    check(snapshot.processes.size() == 4 && snapshot.processes[0].pid == 1200 && snapshot.processes[1].pid == 1500 &&
+          std::string(snapshot.processes[0].name) == "java.exe", "Only the heaviest processes are kept, heaviest first");
+    check(std::string(snapshot.processes[2].name).size() == SHARED_SNAPSHOT_NAME_BYTES - 1,
+          "Long names are truncated and terminated");
+
+    // One writer, several readers, no locks: every successful read is a whole cycle
+    const int cycles = 200000;
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+    std::atomic<long> reads{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; r++) {
+        readers.emplace_back([&]() {
+            SharedSnapshotReader local;
+            SharedSnapshot copy;
+            if (!local.open(name)) {
+                torn++;
+                return;
+            }
+            uint64_t lastCycle = 0;
+            while (!done) {
+                if (local.read(copy) && copy.cycle > 1) {      // Cycle 1 is the sample above
+                    if (!isConsistent(copy) || copy.cycle < lastCycle) torn++;
+                    lastCycle = copy.cycle;
+                    reads++;
+                }
+            }
+        });
+    }
+    std::vector<ProcessInfo> batch;
+    for (int k = 1; k <= cycles; k++) {
+        batch.clear();
+        for (int i = 0; i < k % 50 + 10; i++) {
+            batch.push_back(makeProcess(static_cast<DWORD>(i), "p", 0.0, k));
+        }
+        writer.publish(k, SystemUsage(k, k, 0.0), batch);
+    }
+    done = true;
+    for (auto& thread : readers) {
+        thread.join();
+    }
+    check(torn == 0 && reads > 0, "Concurrent readers never see a torn snapshot (" + std::to_string(reads.load()) + " reads)");
+
+    check(reader.read(snapshot) && snapshot.cycle == cycles + 1 && snapshot.cpuPercent == cycles,
+          "The reader ends on the last cycle");
+
+    writer.stop();
+    SharedSnapshotReader late;
+    check(!late.open(name), "The segment is removed when the writer stops");
+    check(reader.read(snapshot) && snapshot.cycle == cycles + 1, "An open mapping keeps the last snapshot");
+
+#ifndef _WIN32
+    // A segment left behind by a crashed writer is sized but unlocked
+    int stale = shm_open(sharedSnapshotObjectName(name).c_str(), O_CREAT | O_RDWR, 0644);
+    bool staleCreated = stale >= 0 && ftruncate(stale, 4096) == 0;
+    if (stale >= 0) ::close(stale);
+    SharedSnapshotWriter restarted;
+    check(staleCreated && restarted.start(name, 2) && late.open(name) && late.getCapacity() == 2,
+          "A segment left by a crashed writer is replaced");
+    restarted.stop();
+#endif
+
+    std::cout << std::endl << (failures == 0 ? "✅ Shared snapshot test PASSED" : "❌ Shared snapshot test FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,131 @@
+#include "include/SnapshotFile.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Console flag normally defined by main.cpp; the logger reads it
+bool g_suppressConsoleOutput = true;
+
+static int failures = 0;
+
+static void check(bool condition, const std::string& description) {
+    std::cout << (condition ? "✅ " : "❌ ") << description << std::endl;
+    if (!condition) failures++;
+}
+
+static ProcessInfo makeProcess(DWORD pid, DWORD ppid, const std::string& name, double cpu, double ram,
+                               double disk, ULONGLONG ioBytes) {
+    ProcessInfo process(pid, ppid, name);
+    process.setCpuPercent(cpu);
+    process.setRamPercent(ram);
+    process.setDiskPercent(disk);
+    process.setDiskIoBytes(ioBytes);
+    return process;
+}
+
+static bool sameProcess(const ProcessInfo& a, const ProcessInfo& b) {
+    return a.getPid() == b.getPid() && a.getPpid() == b.getPpid() && a.getName() == b.getName() &&
+           (float)a.getCpuPercent() == (float)b.getCpuPercent() && (float)a.getRamPercent() == (float)b.getRamPercent() &&
+           (float)a.getDiskPercent() == (float)b.getDiskPercent() && a.getDiskIoBytes() == b.getDiskIoBytes() &&
+           a.getStartTime() == b.getStartTime();
+}
+
+int main() {
+    std::cout << "=== SystemMonitor Snapshot File Test ===" << std::endl;
+    const std::string path = "snapshot_file_test.snap";
+
+    // Three cycles: PIDs out of order, an exited and a new process, repeated names
+    std::vector<std::vector<ProcessInfo>> cycles = {
+        { makeProcess(4, 0, "System", 0.5, 0.01, 0.0, 0),
+          makeProcess(1200, 4, "java.exe", 85.25, 12.5, 3.0, 1ull << 40),
+          makeProcess(800, 1200, "java.exe", 0.0, 0.0, 0.0, 0) },
+        { makeProcess(4, 0, "System", 0.4, 0.01, 0.0, 0),
+          makeProcess(1200, 4, "java.exe", 91.0, 12.6, 0.0, 4096) },
+        { makeProcess(4, 0, "System", 0.3, 0.01, 0.0, 0),
+          makeProcess(1204, 4, "sqlservr.exe", 2.0, 30.0, 7.5, 65536),
+          makeProcess(1200, 4, "java.exe", 40.0, 12.6, 0.0, 0) }
+    };
+    const int64_t startMs = 1760000000000;
+    cycles[2][1].setStartTime(133900000000000000ull);
+
+    SnapshotWriter writer;
+    check(writer.open(path), "Recording is created");
+    for (size_t i = 0; i < cycles.size(); i++) {
+        writer.writeCycle(startMs + (int64_t)i * 5000, SystemUsage(50.0 + i, 60.0, 1.5), cycles[i]);
+    }
+    writer.close();
+    check(writer.getCycleCount() == 3, "Every cycle is counted");
+
+    // Names are stored once
+    std::string bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    check(bytes.size() == writer.getBytesWritten() && bytes.find("java.exe") == bytes.rfind("java.exe"),
+          "Each process name is written once (" + std::to_string(bytes.size()) + " bytes for 3 cycles)");
+
+    SnapshotReader reader;
+    check(reader.open(path), "Recording is readable");
+    bool identical = true;
+    for (size_t i = 0; i < cycles.size(); i++) {
+        if (!reader.next()) {
+            identical = false;
+            break;
+        }
+        const SnapshotCycle& cycle = reader.getCurrent();
+        identical = identical && cycle.timestampMs == startMs + (int64_t)i * 5000 &&
+                    cycle.systemUsage.getCpuPercent() == 50.0 + i && cycle.processes.size() == cycles[i].size();
+        for (size_t p = 0; identical && p < cycles[i].size(); p++) {
+            identical = sameProcess(cycle.processes[p], cycles[i][p]);
+        }
+    }
+    check(identical, "Cycles read back as written (timestamps, usage, processes in order)");
+    check(!reader.next() && !reader.isTruncated(), "Replay ends after the last cycle");
+    check(reader.getFirstTimestampMs() == startMs && reader.getCycleCount() == 3, "Replay tracks the recorded span");
+
+    // Replay collectors serve the current cycle
+    auto shared = std::make_shared<SnapshotReader>();
+    shared->open(path);
+    ReplaySystemMonitor replayMonitor(shared);
+    ReplayProcessManager replayManager(shared);
+    shared->next();
+    shared->next();
+    check(replayMonitor.initialize() && replayMonitor.getSystemUsage().getCpuPercent() == 51.0 &&
+          replayManager.getAllProcesses().size() == 2, "Replay collectors return the current cycle");
+    check(replayManager.getAggregatedProcessTree(replayManager.getAllProcesses()).size() == 1,
+          "Replayed processes aggregate into their tree");
+
+    // A recording cut off inside a cycle is read up to its last complete cycle
+    std::vector<char> content;
+    {
+        std::ifstream full(path, std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(full), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream cut(path, std::ios::binary | std::ios::trunc);
+        cut.write(content.data(), (std::streamsize)content.size() - 6);
+    }
+    SnapshotReader truncatedReader;
+    truncatedReader.open(path);
+    size_t complete = 0;
+    while (truncatedReader.next()) {
+        complete++;
+    }
+    check(complete == 2 && truncatedReader.isTruncated(), "Interrupted recording replays its complete cycles");
+
+    {
+        std::ofstream other(path, std::ios::trunc);
+        other << "DEBUG: not a recording\n";
+    }
+    SnapshotReader rejected;
+    check(!rejected.open(path), "Files without the snapshot header are rejected");
+
+    std::remove(path.c_str());
+
+    std::cout << std::endl << (failures == 0 ? "✅ Snapshot file test PASSED" : "❌ Snapshot file test FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
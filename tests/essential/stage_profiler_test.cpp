@@ -0,0 +1,67 @@
+#include "include/StageProfiler.h"
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static int failures = 0;
+
+static void check(bool condition, const std::string& description) {
+    std::cout << (condition ? "✅ " : "❌ ") << description << std::endl;
+    if (!condition) failures++;
+}
+
+int main() {
+    std::cout << "=== SystemMonitor Stage Profiler Test ===" << std::endl;
+
+    // Every value lands in a bucket whose bound is within 3.2% above it
+    bool bounded = true;
+    for (uint64_t value = 1; value < (1ull << 30); value = value * 3 / 2 + 1) {
+        uint64_t bound = LatencyHistogram::bucketUpperBound(LatencyHistogram::bucketIndex(value));
+        if (bound < value || (double)(bound - value) / (double)value > 0.032) {
+            bounded = false;
+        }
+    }
+    check(bounded, "Bucket bounds stay within 3.2% of the value");
+    check(LatencyHistogram::bucketIndex(~0ull) == LatencyHistogram::BUCKET_COUNT - 1, "Huge values land in the last bucket");
+
+    LatencyHistogram histogram;
+    for (uint64_t i = 1; i <= 1000; i++) {
+        histogram.record(i * 10);          // 10 us .. 10 ms
+    }
+    double p50 = (double)histogram.getPercentile(0.50);
+    double p99 = (double)histogram.getPercentile(0.99);
+    check(p50 >= 5000 && p50 <= 5000 * 1.032, "p50 within histogram precision");
+    check(p99 >= 9900 && p99 <= 9900 * 1.032, "p99 within histogram precision");
+    check(histogram.getMax() == 10000, "Max is exact");
+    check(histogram.getCount() == 1000 && histogram.getMean() == 5005.0, "Count and mean are exact");
+
+    // Concurrent recording loses nothing
+    LatencyHistogram shared;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&shared, t] {
+            for (uint64_t i = 0; i < 100000; i++) {
+                shared.record(i % 5000 + t);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    check(shared.getCount() == 400000 && shared.getMax() == 5002, "Concurrent records are all counted");
+
+    // Scoped timers and the stage table
+    StageProfiler profiler;
+    {
+        ScopedStageTimer timer(profiler, CycleStage::PROCESS_COLLECTION);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    check(profiler.get(CycleStage::PROCESS_COLLECTION).getMax() >= 20000, "Scoped timer records its scope");
+    std::string table = profiler.formatTable();
+    check(table.find("Process collection") != std::string::npos && table.find("Aggregation") == std::string::npos,
+          "Table lists only timed stages");
+
+    std::cout << std::endl << (failures == 0 ? "✅ Stage profiler test PASSED" : "❌ Stage profiler test FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,173 @@
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+typedef SOCKET TestSocket;
+#define closeTestSocket closesocket
+#else
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+typedef int TestSocket;
+#define closeTestSocket close
+#endif
+#include "include/StatsdSink.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+static void check(bool condition, const std::string& description) {
+    std::cout << (condition ? "✅ " : "❌ ") << description << std::endl;
+    if (!condition) failures++;
+}
+
+static ProcessInfo makeProcess(DWORD pid, const std::string& name, double cpu, double ram) {
+    ProcessInfo process(pid, 4, name);
+    process.setCpuPercent(cpu);
+    process.setRamPercent(ram);
+    return process;
+}
+
+// Local collector on an ephemeral loopback port
+static TestSocket openListener(uint16_t& port) {
+    TestSocket listener = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    socklen_t length = sizeof(address);
+    getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length);
+    port = ntohs(address.sin_port);
+#ifdef _WIN32
+    DWORD timeoutMs = 2000;
+    setsockopt(listener, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeoutMs), sizeof(timeoutMs));
+#else
+    timeval timeout = { 2, 0 };
+    setsockopt(listener, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+#endif
+    return listener;
+}
+
+// Datagrams until `lines` lines arrived or the listener times out
+static std::vector<std::string> receive(TestSocket listener, size_t lines) {
+    std::vector<std::string> datagrams;
+    size_t seen = 0;
+    char buffer[65536];
+    while (seen < lines) {
+        int received = static_cast<int>(recv(listener, buffer, sizeof(buffer), 0));
+        if (received <= 0) break;
+        datagrams.emplace_back(buffer, static_cast<size_t>(received));
+        seen += 1 + static_cast<size_t>(std::count(datagrams.back().begin(), datagrams.back().end(), '\n'));
+    }
+    return datagrams;
+}
+
+static bool contains(const std::vector<std::string>& datagrams, const std::string& line) {
+    for (const auto& datagram : datagrams) {
+        if (("\n" + datagram + "\n").find("\n" + line + "\n") != std::string::npos) return true;
+    }
+    return false;
+}
+
+int main() {
+    std::cout << "=== SystemMonitor StatsD Sink Test ===" << std::endl;
+#ifdef _WIN32
+    WSADATA wsaData;
+    WSAStartup(MAKEWORD(2, 2), &wsaData);
+#endif
+    check(StatsdSink::sanitize("odd name (x86).exe", false) == "odd_name__x86__exe" &&
+          StatsdSink::sanitize("java.exe", true) == "java.exe", "Names are sanitized for metric names and tags");
+
+    uint16_t port = 0;
+    TestSocket listener = openListener(port);
+    const std::string address = "127.0.0.1:" + std::to_string(port);
+
+    // Plain StatsD, one cycle
+    {
+        StatsdSink sink;
+        sink.setFlushIntervalMs(50);
+        sink.setTopProcesses(2);
+        check(!sink.start("no-port") && sink.start(address), "Sink connects to host:port");
+        sink.append(1000, SystemUsage(42.5, 61.25, 3.0),
+                    { makeProcess(10, "java.exe", 30.0, 10.0), makeProcess(11, "java.exe", 20.0, 2.5),
+                      makeProcess(12, "svchost.exe", 1.0, 0.5), makeProcess(13, "chrome.exe", 5.0, 8.0) });
+        std::vector<std::string> datagrams = receive(listener, 4 + 2 * 3);
+        check(contains(datagrams, "systemmonitor.cpu_percent:42.50|g") &&
+              contains(datagrams, "systemmonitor.processes:4.00|g"), "System gauges are sent");
+        check(contains(datagrams, "systemmonitor.process.java_exe.cpu_percent:50.00|g") &&
+              contains(datagrams, "systemmonitor.process.chrome_exe.ram_percent:8.00|g") &&
+              !contains(datagrams, "systemmonitor.process.svchost_exe.cpu_percent:1.00|g"),
+              "Busiest names are sent with instances summed");
+        check(datagrams.size() == 1, "One cycle fits one datagram");
+        sink.stop();
+        check(sink.getSentCount() == 1 && sink.getDroppedDatagrams() == 0, "Sent datagrams are counted");
+    }
+
+    // DogStatsD, small packets, many cycles
+    {
+        StatsdSink sink;
+        sink.setFormat(StatsdFormat::DOGSTATSD);
+        sink.setFlushIntervalMs(20);
+        sink.setMaxPacketBytes(100);        // Raised to the 512-byte minimum
+        sink.setTopProcesses(50);
+        check(sink.start(address), "Sink restarts with another format");
+        std::vector<ProcessInfo> processes;
+        for (DWORD pid = 1; pid <= 50; pid++) {
+            processes.push_back(makeProcess(pid, "worker-" + std::to_string(pid) + ".exe", pid, 1.0));
+        }
+        for (int cycle = 0; cycle < 5; cycle++) {
+            sink.append(cycle * 1000, SystemUsage(10.0, 20.0, 0.0), processes);
+        }
+        std::vector<std::string> datagrams = receive(listener, 5 * (4 + 50 * 3));
+        bool packed = !datagrams.empty();
+        size_t lines = 0;
+        for (const auto& datagram : datagrams) {
+            packed = packed && datagram.size() <= StatsdSink::MIN_PACKET_BYTES && datagram.back() != '\n';
+            lines += 1 + static_cast<size_t>(std::count(datagram.begin(), datagram.end(), '\n'));
+        }
+        check(packed && lines == 5 * (4 + 50 * 3), "Lines are packed into datagrams within the packet size (" +
+              std::to_string(datagrams.size()) + " datagrams)");
+        check(contains(datagrams, "systemmonitor.process.cpu_percent:50.00|g|#process:worker-50.exe"),
+              "DogStatsD lines carry the process as a tag");
+        sink.stop();
+    }
+
+    // Overload: the caller is never held up; overflow is counted
+    {
+        StatsdSink sink;
+        sink.setFlushIntervalMs(60000);
+        sink.setTopProcesses(1000);
+        check(sink.start(address), "Sink starts for the overload run");
+        std::vector<ProcessInfo> processes;
+        for (DWORD pid = 1; pid <= 1000; pid++) {
+            processes.push_back(makeProcess(pid, "p" + std::to_string(pid), 1.0, 1.0));
+        }
+        auto begin = std::chrono::steady_clock::now();
+        for (int cycle = 0; cycle < 400; cycle++) {
+            sink.append(cycle, SystemUsage(1.0, 1.0, 1.0), processes);
+        }
+        double appendMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        sink.stop();
+        check(sink.getDroppedCycles() + sink.getDroppedDatagrams() > 0, "Overflow is dropped and counted (" +
+              std::to_string(sink.getDroppedCycles()) + " cycles, " + std::to_string(sink.getDroppedDatagrams()) +
+              " datagrams)");
+        check(appendMs < 2000.0, "Appending never waits on the network");
+    }
+
+    closeTestSocket(listener);
+#ifdef _WIN32
+    WSACleanup();
+#endif
+    std::cout << std::endl << (failures == 0 ? "✅ StatsD sink test PASSED" : "❌ StatsD sink test FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,127 @@
+#include "include/ThreadPool.h"
+#include <atomic>
+#include <iostream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+static int failures = 0;
+
+static void check(bool condition, const std::string& description) {
+    std::cout << (condition ? "✅ " : "❌ ") << description << std::endl;
+    if (!condition) failures++;
+}
+
+// Runs one loop and reports whether every index of [0, count) was visited exactly once
+static bool visitsEachIndexOnce(ThreadPool& pool, size_t count, size_t chunkSize) {
+    std::vector<std::atomic<int>> visits(count);
+    for (auto& visit : visits) {
+        visit = 0;
+    }
+    std::atomic<bool> outOfRange{false};
+    pool.parallelFor(count, chunkSize, [&](size_t begin, size_t end) {
+        if (begin >= end || end > count || end - begin > chunkSize) {
+            outOfRange = true;
+            return;
+        }
+        for (size_t i = begin; i < end; i++) {
+            visits[i]++;
+        }
+    });
+    bool once = !outOfRange;
+    for (const auto& visit : visits) {
+        once = once && visit == 1;
+    }
+    return once;
+}
+
+int main() {
+    std::cout << "=== SystemMonitor Thread Pool Test ===" << std::endl;
+
+    // Coverage: uneven last chunks, chunks of one, a single chunk
+    for (size_t threads : { size_t(1), size_t(2), size_t(8) }) {
+        ThreadPool pool(threads);
+        bool covered = pool.size() == threads &&
+                       visitsEachIndexOnce(pool, 1000, 7) && visitsEachIndexOnce(pool, 10, 3) &&
+                       visitsEachIndexOnce(pool, 37, 1) && visitsEachIndexOnce(pool, 5, 64);
+        check(covered, "Every index is visited exactly once with " + std::to_string(threads) + " thread(s)");
+    }
+
+    // A pool of one owns no threads: the body runs inline on the caller
+    {
+        ThreadPool single(1);
+        std::set<std::thread::id> callers;
+        single.parallelFor(100, 3, [&](size_t, size_t) { callers.insert(std::this_thread::get_id()); });
+        check(callers.size() == 1 && *callers.begin() == std::this_thread::get_id(),
+              "A pool of size 1 runs the loop on the calling thread");
+    }
+
+    // Exceptions: rethrown on the caller once every chunk has finished; the pool stays usable
+    {
+        ThreadPool pool(8);
+        std::atomic<size_t> ranItems{0};
+        std::string message;
+        try {
+            pool.parallelFor(1000, 10, [&](size_t begin, size_t end) {
+                ranItems += end - begin;
+                if (begin <= 500 && 500 < end) {
+                    throw std::runtime_error("chunk 500 failed");
+                }
+            });
+        } catch (const std::runtime_error& error) {
+            message = error.what();
+        }
+        check(message == "chunk 500 failed", "The exception thrown by body is rethrown");
+        check(ranItems == 1000, "The other chunks still run");
+
+        std::atomic<int> thrown{0};
+        message.clear();
+        try {
+            pool.parallelFor(1000, 10, [&](size_t begin, size_t) {
+                if (begin % 100 == 0) {
+                    thrown++;
+                    throw std::runtime_error("chunk " + std::to_string(begin));
+                }
+            });
+        } catch (const std::runtime_error& error) {
+            message = error.what();
+        }
+        check(thrown == 10 && message.rfind("chunk ", 0) == 0, "Only one of several exceptions is rethrown");
+        check(visitsEachIndexOnce(pool, 1000, 7), "A failed loop leaves the pool usable");
+    }
+
+    // Back-to-back loops: workers still leaving one batch may take chunks of the
+    // next; each chunk must still run its own loop's body, before that loop returns
+    {
+        ThreadPool pool(8);
+        std::atomic<uint64_t> activeCall{0};
+        bool allCovered = true;
+        std::atomic<int> strayChunks{0};
+        for (uint64_t call = 1; call <= 2000; call++) {
+            activeCall = call;
+            size_t count = 16 + call % 48;
+            std::vector<std::atomic<int>> visits(count);
+            for (auto& visit : visits) {
+                visit = 0;
+            }
+            pool.parallelFor(count, 1 + call % 5, [&, call](size_t begin, size_t end) {
+                if (activeCall.load() != call) {
+                    strayChunks++;
+                }
+                for (size_t i = begin; i < end; i++) {
+                    visits[i]++;
+                }
+            });
+            activeCall = 0;
+            for (const auto& visit : visits) {
+                allCovered = allCovered && visit == 1;
+            }
+        }
+        check(allCovered && strayChunks == 0, "2000 back-to-back loops neither lose nor mix up chunks");
+    }
+
+    std::cout << std::endl << (failures == 0 ? "✅ Thread pool test PASSED" : "❌ Thread pool test FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
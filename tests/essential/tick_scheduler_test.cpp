@@ -0,0 +1,57 @@
+#include "include/TickScheduler.h"
+#include <iostream>
+#include <string>
+#include <thread>
+
+static int failures = 0;
+
+static void check(bool condition, const std::string& description) {
+    std::cout << (condition ? "✅ " : "❌ ") << description << std::endl;
+    if (!condition) failures++;
+}
+
+int main() {
+    std::cout << "=== SystemMonitor Tick Scheduler Test ===" << std::endl;
+    using namespace std::chrono;
+
+    // Work inside the period does not shift the grid
+    TickScheduler scheduler(milliseconds(100));
+    auto start = TickScheduler::Clock::now();
+    scheduler.start(start);
+    for (int tick = 0; tick < 6; tick++) {
+        scheduler.waitForNextTick();
+        std::this_thread::sleep_for(milliseconds(40));   // Simulated collection
+    }
+    auto elapsed = duration_cast<milliseconds>(scheduler.getLastDeadline() - start).count();
+    check(elapsed == 500, "Six ticks land on the 100 ms grid despite 40 ms of work each");
+    check(scheduler.getStats().missedTicks == 0, "No ticks missed without overload");
+
+    // An overrun is coalesced into one late tick
+    std::this_thread::sleep_for(milliseconds(250));
+    scheduler.waitForNextTick();
+    check(scheduler.getLastMissed() == 1, "250 ms overrun skips one deadline");
+    check(scheduler.getStats().lastJitter >= milliseconds(40), "Late tick reports its jitter");
+    auto afterOverrun = scheduler.getLastDeadline();
+    scheduler.waitForNextTick();
+    check(scheduler.getLastDeadline() - afterOverrun == milliseconds(100), "Grid continues after the coalesced tick");
+
+    // Sub-second minimum
+    TickScheduler tooFast(milliseconds(10));
+    check(tooFast.getInterval() == milliseconds(TickScheduler::MIN_INTERVAL_MS), "Interval is clamped to 100 ms");
+
+    // Interrupt releases a waiting thread
+    TickScheduler slow(milliseconds(60000));
+    slow.start();
+    slow.waitForNextTick();   // First tick is immediate
+    std::thread stopper([&] {
+        std::this_thread::sleep_for(milliseconds(50));
+        slow.interrupt();
+    });
+    auto waitStart = TickScheduler::Clock::now();
+    bool ticked = slow.waitForNextTick();
+    stopper.join();
+    check(!ticked && TickScheduler::Clock::now() - waitStart < seconds(5), "interrupt() ends the wait");
+
+    std::cout << std::endl << (failures == 0 ? "✅ Tick scheduler test PASSED" : "❌ Tick scheduler test FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
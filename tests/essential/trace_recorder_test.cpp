@@ -0,0 +1,102 @@
+#include "include/TraceRecorder.h"
+#include "include/StageProfiler.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static int failures = 0;
+
+static void check(bool condition, const std::string& description) {
+    std::cout << (condition ? "✅ " : "❌ ") << description << std::endl;
+    if (!condition) failures++;
+}
+
+static std::string readFile(const std::string& path) {
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+static size_t countOccurrences(const std::string& text, const std::string& pattern) {
+    size_t count = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) {
+        count++;
+    }
+    return count;
+}
+
+int main() {
+    std::cout << "=== SystemMonitor Trace Recorder Test ===" << std::endl;
+    const std::string tracePath = "trace_recorder_test.json";
+
+    // Nothing is recorded before start()
+    TraceRecorder recorder(64);
+    {
+        TraceScope scope("Before start", "test", recorder);
+    }
+    check(recorder.start(tracePath), "Trace file is created");
+    check(!recorder.start(tracePath), "A running trace cannot be restarted");
+
+    // Spans and counters from the main thread and two workers
+    recorder.setThreadName("Main loop");
+    {
+        TraceScope scope("Collection", "cycle", recorder);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    recorder.counter("Log queue", 3);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 2; t++) {
+        workers.emplace_back([&recorder] {
+            recorder.setThreadName("Worker");
+            for (int i = 0; i < 20; i++) {
+                TraceScope scope("Work item", "worker", recorder);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    recorder.flush();
+    check(recorder.getWrittenCount() == 42, "Flush writes every recorded event");
+
+    // A full ring drops instead of blocking
+    for (int i = 0; i < 100; i++) {
+        TraceScope scope("Overflow", "test", recorder);
+    }
+    check(recorder.getDroppedCount() == 36, "Events beyond the ring capacity are dropped and counted");
+    recorder.stop();
+    check(!recorder.isEnabled(), "Stop ends recording");
+
+    std::string trace = readFile(tracePath);
+    check(trace.rfind("{\"traceEvents\":[", 0) == 0 && trace.find("]") != std::string::npos &&
+          trace.find("\"displayTimeUnit\":\"ms\"}") != std::string::npos, "Output is a complete trace document");
+    check(trace.find("Before start") == std::string::npos, "Events before start are ignored");
+    check(countOccurrences(trace, "\"name\":\"thread_name\"") == 3, "Each recording thread is named once");
+    check(countOccurrences(trace, "\"name\":\"Work item\"") == 40, "Worker spans are all present");
+    check(trace.find("\"name\":\"Log queue\",\"cat\":\"counter\",\"ph\":\"C\"") != std::string::npos &&
+          trace.find("\"args\":{\"value\":3}") != std::string::npos, "Counter samples are written");
+    size_t collection = trace.find("\"name\":\"Collection\"");
+    size_t duration = trace.find("\"dur\":", collection);
+    check(collection != std::string::npos && std::stoll(trace.substr(duration + 6)) >= 5000, "Span duration covers the scope");
+
+    // Stage timers show up on the process-wide recorder
+    TraceRecorder& global = TraceRecorder::instance();
+    global.start(tracePath);
+    StageProfiler profiler;
+    {
+        ScopedStageTimer timer(profiler, CycleStage::AGGREGATION);
+    }
+    global.stop();
+    trace = readFile(tracePath);
+    check(trace.find("\"name\":\"Aggregation\",\"cat\":\"cycle\"") != std::string::npos, "Stage timers emit trace spans");
+
+    std::remove(tracePath.c_str());
+
+    std::cout << std::endl << (failures == 0 ? "✅ Trace recorder test PASSED" : "❌ Trace recorder test FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
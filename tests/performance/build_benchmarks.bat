@@ -0,0 +1,48 @@
+@echo off
+REM Performance Benchmarks Build Script for SystemMonitor
+REM Builds the standalone scaling and throughput benchmarks
+
+echo ====================================================
+echo  SystemMonitor Performance Benchmarks - Build Script
+echo ====================================================
+
+if not defined VS_BUILD_TOOLS_PATH (
+    set "VS_BUILD_TOOLS_PATH=C:\Program Files (x86)\Microsoft Visual Studio\2022\BuildTools"
+)
+
+if not exist "%VS_BUILD_TOOLS_PATH%\VC\Auxiliary\Build\vcvars64.bat" (
+    echo ERROR: Visual Studio BuildTools not found at %VS_BUILD_TOOLS_PATH%
+    pause
+    exit /b 1
+)
+
+echo Setting up Visual Studio x64 environment...
+call "%VS_BUILD_TOOLS_PATH%\VC\Auxiliary\Build\vcvars64.bat"
+
+echo.
+echo Building Performance Benchmarks...
+echo.
+
+REM Build process scan scaling benchmark (no external deps)
+echo [1/1] Building process scan benchmark...
+cl /EHsc /std:c++17 /O2 /I..\.. process_scan_bench.cpp ..\..\src\ProcessManager.cpp ..\..\src\ThreadPool.cpp ..\..\src\ProcessTiers.cpp ..\..\src\Logger.cpp ..\..\src\TraceRecorder.cpp ^
+   /link psapi.lib advapi32.lib
+
+if %ERRORLEVEL% NEQ 0 (
+    echo ❌ Process scan benchmark build failed!
+    goto :cleanup
+)
+
+echo.
+echo ✅ All benchmarks built successfully!
+echo.
+echo Available benchmark executables:
+echo   - process_scan_bench.exe    (Parallel Process Scan Scaling)
+echo.
+
+:cleanup
+echo Cleaning up object files...
+del /q *.obj 2>nul
+
+echo.
+pause
@@ -0,0 +1,321 @@
+#include "include/ProcessManager.h"
+#include "include/Logger.h"
+#include "include/Configuration.h"
+#include "include/EmailNotifier.h"
+#include "include/JsonLinesWriter.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <ctime>
+#include <random>
+#include <thread>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+// Microbenchmarks of the core data paths (SystemMonitorBench target).
+//
+// Each case runs a warm-up call and then repeats until it has used the time
+// budget, reporting median, best and mean time per call. Process-table
+// cases run over synthetic tables of 100 to 100,000 entries with a
+// realistic parent/child mix. Results go to the console and to a JSON file
+// so runs from different commits can be diffed.
+
+// Console flag normally defined by main.cpp; the logger reads it
+bool g_suppressConsoleOutput = true;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const size_t TABLE_SIZES[] = { 100, 1000, 10000, 100000 };
+
+const char* const PROCESS_NAMES[] = {
+    "svchost.exe", "chrome.exe", "java.exe", "explorer.exe", "sqlservr.exe", "node.exe",
+    "python.exe", "msedge.exe", "Code.exe", "dwm.exe", "lsass.exe", "services.exe",
+    "RuntimeBroker.exe", "conhost.exe", "w3wp.exe", "MsMpEng.exe"
+};
+
+struct BenchResult {
+    std::string name;
+    size_t size = 0;                // Items per call (table rows, queue messages, log entries)
+    size_t iterations = 0;
+    double medianNs = 0.0;
+    double bestNs = 0.0;
+    double meanNs = 0.0;
+};
+
+volatile size_t benchSink = 0;
+
+// Repeats fn until minTime has elapsed (at least 3 and at most 10000 calls)
+template<typename Fn>
+BenchResult runCase(const std::string& name, size_t size, std::chrono::milliseconds minTime, Fn fn) {
+    benchSink = benchSink + fn();   // Warm-up
+
+    std::vector<double> samples;
+    Clock::time_point caseStart = Clock::now();
+    while (samples.size() < 3 || (Clock::now() - caseStart < minTime && samples.size() < 10000)) {
+        Clock::time_point start = Clock::now();
+        benchSink = benchSink + fn();
+        samples.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count());
+    }
+
+    BenchResult result;
+    result.name = name;
+    result.size = size;
+    result.iterations = samples.size();
+    double total = 0.0;
+    for (double sample : samples) {
+        total += sample;
+    }
+    result.meanNs = total / (double)samples.size();
+    std::sort(samples.begin(), samples.end());
+    result.medianNs = samples[samples.size() / 2];
+    result.bestNs = samples.front();
+    return result;
+}
+
+// Deterministic process table: about a fifth roots, the rest children of earlier processes
+std::vector<ProcessInfo> makeProcessTable(size_t count) {
+    std::mt19937 random(12345u + static_cast<unsigned>(count));
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    const size_t nameCount = sizeof(PROCESS_NAMES) / sizeof(PROCESS_NAMES[0]);
+
+    std::vector<ProcessInfo> processes;
+    processes.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        DWORD pid = static_cast<DWORD>(4 + i * 4);
+        DWORD ppid = 0;
+        if (i > 0 && unit(random) > 0.2) {
+            ppid = processes[random() % i].getPid();
+        }
+        ProcessInfo process(pid, ppid, PROCESS_NAMES[random() % nameCount]);
+        double activity = unit(random);
+        process.setCpuPercent(activity > 0.9 ? unit(random) * 25.0 : unit(random) * 0.2);
+        process.setRamPercent(unit(random) * (activity > 0.8 ? 4.0 : 0.3));
+        process.setDiskPercent(activity > 0.95 ? unit(random) * 10.0 : 0.0);
+        processes.push_back(process);
+    }
+    return processes;
+}
+
+std::string formatNs(double ns) {
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(2);
+    if (ns < 1000.0) {
+        text << ns << " ns";
+    } else if (ns < 1000000.0) {
+        text << ns / 1000.0 << " us";
+    } else {
+        text << ns / 1000000.0 << " ms";
+    }
+    return text.str();
+}
+
+void printResult(const BenchResult& result) {
+    std::cout << std::left << std::setw(28) << result.name << std::right
+              << std::setw(9) << result.size
+              << std::setw(8) << result.iterations
+              << std::setw(14) << formatNs(result.medianNs)
+              << std::setw(14) << formatNs(result.bestNs)
+              << std::setw(14) << formatNs(result.medianNs / (double)(result.size > 0 ? result.size : 1))
+              << std::endl;
+}
+
+std::string isoTimestamp() {
+    std::time_t now = std::time(nullptr);
+    std::tm tm{};
+#ifdef _WIN32
+    gmtime_s(&tm, &now);
+#else
+    gmtime_r(&now, &tm);
+#endif
+    char text[32];
+    std::strftime(text, sizeof(text), "%Y-%m-%dT%H:%M:%SZ", &tm);
+    return text;
+}
+
+bool writeJson(const std::string& path, const std::string& label, const std::vector<BenchResult>& results) {
+    std::ofstream out(path);
+    if (!out.is_open()) {
+        return false;
+    }
+    out << "{\n  \"benchmark\": \"SystemMonitorBench\",\n"
+        << "  \"label\": \"" << label << "\",\n"
+        << "  \"timestamp\": \"" << isoTimestamp() << "\",\n"
+#ifdef NDEBUG
+        << "  \"build\": \"release\",\n"
+#else
+        << "  \"build\": \"debug\",\n"
+#endif
+        << "  \"results\": [\n";
+    out << std::fixed << std::setprecision(1);
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& result = results[i];
+        out << "    {\"name\": \"" << result.name << "\", \"size\": " << result.size
+            << ", \"iterations\": " << result.iterations
+            << ", \"median_ns\": " << result.medianNs
+            << ", \"best_ns\": " << result.bestNs
+            << ", \"mean_ns\": " << result.meanNs
+            << ", \"ns_per_item\": " << result.medianNs / (double)(result.size > 0 ? result.size : 1)
+            << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+    return out.good();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string jsonPath = "core_bench.json";
+    std::string label;
+    std::string filter;
+    size_t maxSize = 100000;
+    int minTimeMs = 200;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--json" && i + 1 < argc) {
+            jsonPath = argv[++i];
+        } else if (arg == "--label" && i + 1 < argc) {
+            label = argv[++i];
+        } else if (arg == "--filter" && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (arg == "--max-size" && i + 1 < argc) {
+            maxSize = static_cast<size_t>(std::max(1, std::atoi(argv[++i])));
+        } else if (arg == "--min-time" && i + 1 < argc) {
+            minTimeMs = std::max(1, std::atoi(argv[++i]));
+        } else {
+            std::cout << "Usage: SystemMonitorBench [--json FILE] [--label TEXT] [--filter TEXT] [--max-size N] [--min-time MS]" << std::endl;
+            return 1;
+        }
+    }
+    std::chrono::milliseconds minTime(minTimeMs);
+
+    std::cout << "=== SystemMonitor Core Benchmarks ===" << std::endl;
+    std::cout << std::left << std::setw(28) << "case" << std::right << std::setw(9) << "size" << std::setw(8) << "iters"
+              << std::setw(14) << "median" << std::setw(14) << "best" << std::setw(14) << "per item" << std::endl;
+
+    std::vector<BenchResult> results;
+    auto selected = [&filter](const std::string& name) {
+        return filter.empty() || name.find(filter) != std::string::npos;
+    };
+    auto add = [&results](const BenchResult& result) {
+        printResult(result);
+        results.push_back(result);
+    };
+
+    // Process-table paths
+    for (size_t size : TABLE_SIZES) {
+        if (size > maxSize) {
+            continue;
+        }
+        std::vector<ProcessInfo> table = makeProcessTable(size);
+
+        if (selected("aggregate")) {
+            add(runCase("aggregate", size, minTime, [&table] {
+                ProcessTreeAggregator aggregator;
+                return aggregator.aggregate(table).size();
+            }));
+        }
+        if (selected("filter_thresholds")) {
+            add(runCase("filter_thresholds", size, minTime, [&table] {
+                return ProcessFilter::filterByThresholds(table, 1.0, 1.0, 1.0).size();
+            }));
+        }
+        if (selected("logger_format")) {
+            SystemUsage usage(85.0, 72.5, 12.0);
+            add(runCase("logger_format", size, minTime, [&table, &usage] {
+                return AsyncFileLogger::formatProcessBlock(table, usage, "18-10-2026 12:00:00").size();
+            }));
+        }
+        if (selected("jsonl_format")) {
+            // Same table as logger_format; the writer keeps its buffer and name cache across calls
+            SystemUsage usage(85.0, 72.5, 12.0);
+            JsonLinesWriter writer;
+            add(runCase("jsonl_format", size, minTime, [&table, &usage, &writer] {
+                return writer.format(1792324800000LL, usage, table).size();
+            }));
+        }
+        if (selected("email_alert_body")) {
+            // One log line per process, as collected while a rule fires
+            std::vector<std::string> logs;
+            logs.reserve(table.size());
+            std::istringstream block(AsyncFileLogger::formatProcessBlock(table, SystemUsage(85.0, 72.5, 12.0),
+                                                                         "18-10-2026 12:00:00"));
+            std::string line;
+            while (logs.size() < table.size() && std::getline(block, line)) {
+                logs.push_back(line);
+            }
+            EmailNotifier notifier;
+            add(runCase("email_alert_body", logs.size(), minTime, [&notifier, &logs] {
+                return notifier.generateAlertEmail(logs).size();
+            }));
+            add(runCase("email_recovery_body", logs.size(), minTime, [&notifier, &logs] {
+                return notifier.generateRecoveryEmail(logs, logs).size();
+            }));
+        }
+    }
+
+    // Logger queue: one producer and one consumer moving debug messages
+    if (selected("blocking_queue")) {
+        const size_t messages = 100000;
+        add(runCase("blocking_queue_spsc", messages, minTime, [messages] {
+            BlockingQueue<LogMessage> queue;
+            std::thread consumer([&queue, messages] {
+                LogMessage message;
+                for (size_t i = 0; i < messages && queue.pop(message); i++) {
+                }
+            });
+            for (size_t i = 0; i < messages; i++) {
+                queue.push(LogMessage(LogMessageType::DEBUG, "Sampling cycle overran"));
+            }
+            consumer.join();
+            return queue.size();
+        }));
+        add(runCase("blocking_queue_push_pop", messages, minTime, [messages] {
+            BlockingQueue<LogMessage> queue;
+            LogMessage message;
+            size_t popped = 0;
+            for (size_t i = 0; i < messages; i++) {
+                queue.push(LogMessage(LogMessageType::DEBUG, "Sampling cycle overran"));
+                popped += queue.pop(message) ? 1 : 0;
+            }
+            return popped;
+        }));
+    }
+
+    // Configuration file parsing, using the file the application would write
+    if (selected("config_parse")) {
+        std::string configText;
+        {
+            ConfigurationManager writer;
+            const char* tempPath = "core_bench_config.tmp";
+            if (writer.saveToFile(tempPath)) {
+                std::ifstream in(tempPath);
+                std::stringstream content;
+                content << in.rdbuf();
+                configText = content.str();
+            }
+            std::remove(tempPath);
+        }
+        size_t lines = static_cast<size_t>(std::count(configText.begin(), configText.end(), '\n'));
+        add(runCase("config_parse", lines, minTime, [&configText] {
+            ConfigurationManager manager;
+            std::istringstream input(configText);
+            manager.loadFromStream(input, "SystemMonitor.cfg");
+            return manager.getParseErrors().size();
+        }));
+    }
+
+    if (writeJson(jsonPath, label, results)) {
+        std::cout << std::endl << "Results written to " << jsonPath << std::endl;
+    } else {
+        std::cout << std::endl << "Could not write " << jsonPath << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,134 @@
+#include "include/LinuxProcessManager.h"
+#include "procfs_fixture.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <unistd.h>
+
+// Collection and aggregation at scale over a synthetic procfs (Linux).
+//
+// Generates a fixture tree, points LinuxProcessManager at it through
+// setProcRoot() and runs one baseline pass plus --steps timed passes, each
+// after the fixture advanced one second. Every pass is also checked against
+// the fixture: same PIDs, parents and names, and CPU shares equal to what
+// the fixture's tick counters imply (new and reused PIDs report 0). The
+// exit code is non-zero on any mismatch, so the run doubles as a
+// deterministic regression test.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    return values.empty() ? 0.0 : values[values.size() / 2];
+}
+
+// Mismatches between one collector pass and the fixture
+size_t verifyPass(const ProcfsFixture& fixture, const std::vector<ProcessInfo>& processes) {
+    size_t mismatches = processes.size() == fixture.getProcesses().size() ? 0 : 1;
+    for (const auto& process : processes) {
+        const ProcfsFixture::Process* expected = fixture.find(process.getPid());
+        if (!expected || expected->ppid != process.getPpid() || expected->name != process.getName() ||
+            std::fabs(fixture.expectedCpuPercent(*expected) - process.getCpuPercent()) > 1e-9) {
+            if (mismatches < 5) {
+                std::cout << "  mismatch: pid " << process.getPid() << " (" << process.getName() << ") cpu "
+                          << process.getCpuPercent() << "%" << std::endl;
+            }
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    ProcfsFixture::Options options;
+    options.processes = 50000;
+    options.maxDepth = 64;
+    int steps = 5;
+    std::string root = "/tmp/systemmonitor_procfs_" + std::to_string(getpid());
+    bool keep = false;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--processes" && i + 1 < argc) {
+            options.processes = static_cast<size_t>(std::max(1, std::atoi(argv[++i])));
+        } else if (arg == "--depth" && i + 1 < argc) {
+            options.maxDepth = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--churn" && i + 1 < argc) {
+            options.churn = std::atof(argv[++i]);
+        } else if (arg == "--steps" && i + 1 < argc) {
+            steps = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--root" && i + 1 < argc) {
+            root = argv[++i];
+        } else if (arg == "--keep") {
+            keep = true;
+        } else {
+            std::cout << "Usage: procfs_collect_bench [--processes N] [--depth N] [--churn SHARE] [--steps N] [--root DIR] [--keep]" << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << "=== SystemMonitor Synthetic procfs Collection Benchmark ===" << std::endl;
+    Clock::time_point start = Clock::now();
+    ProcfsFixture fixture(options);
+    if (!fixture.write(root)) {
+        std::cout << "Cannot write the fixture under " << root << std::endl;
+        return 1;
+    }
+    std::cout << "Fixture: " << fixture.getProcesses().size() << " processes, depth " << fixture.getDepth()
+              << ", written in " << std::fixed << std::setprecision(0) << elapsedMs(start) << " ms to " << root << std::endl;
+
+    LinuxProcessManager manager(nullptr);
+    manager.setProcRoot(root);
+    size_t mismatches = 0;
+    if (!manager.initialize()) {   // Baseline pass
+        std::cout << "Collector failed to initialize" << std::endl;
+        return 1;
+    }
+
+    std::vector<double> collectMs;
+    std::vector<double> aggregateMs;
+    size_t roots = 0;
+    for (int step = 0; step < steps; step++) {
+        fixture.step(1.0);
+        fixture.write(root);
+
+        start = Clock::now();
+        std::vector<ProcessInfo> processes = manager.getAllProcesses();
+        collectMs.push_back(elapsedMs(start));
+
+        start = Clock::now();
+        std::vector<ProcessInfo> aggregated = manager.getAggregatedProcessTree(processes);
+        aggregateMs.push_back(elapsedMs(start));
+        roots = aggregated.size();
+
+        mismatches += verifyPass(fixture, processes);
+    }
+
+    std::cout << std::setprecision(2)
+              << "Collection:  median " << median(collectMs) << " ms, best "
+              << *std::min_element(collectMs.begin(), collectMs.end()) << " ms (" << manager.getReadEngineName() << ")\n"
+              << "Aggregation: median " << median(aggregateMs) << " ms, best "
+              << *std::min_element(aggregateMs.begin(), aggregateMs.end()) << " ms, " << roots << " top-level entries"
+              << std::endl;
+
+    if (!keep) {
+        std::error_code error;
+        std::filesystem::remove_all(root, error);
+    }
+
+    std::cout << (mismatches == 0 ? "✅ Collector output matches the fixture" : "❌ Collector output differs from the fixture")
+              << std::endl;
+    return mismatches == 0 ? 0 : 1;
+}
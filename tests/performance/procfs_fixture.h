@@ -0,0 +1,339 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+#include <unistd.h>
+
+// Synthetic procfs tree for collector benchmarks and regression checks.
+//
+// Builds a process table of any size and shape (init at PID 1, a tree of
+// bounded depth below it) and writes it as [root]/stat, [root]/meminfo and
+// [root]/[pid]/{stat,statm,io} in the kernel's formats. step() advances
+// time: CPU and I/O counters grow at per-process rates, a share of the
+// processes exits (children are re-parented to init) and the same number is
+// spawned, optionally reusing the freed PIDs with a new start time. write()
+// brings the tree on disk up to date in place, replacing each file by
+// rename, so a collector can read it while it changes.
+//
+// Everything is derived from the seed, so two runs with the same options
+// produce the same trees, and expectedCpuPercent() gives the value the
+// collector must report for the last step.
+class ProcfsFixture {
+public:
+    static constexpr uint64_t TICKS_PER_SECOND = 100;   // USER_HZ
+
+    struct Options {
+        size_t processes = 1000;        // Including init
+        int maxDepth = 8;               // Levels below init
+        double activeShare = 0.1;       // Processes that use CPU and I/O
+        double churn = 0.01;            // Share of processes replaced per step
+        double pidReuse = 0.5;          // Share of spawned processes that take a freed PID
+        uint32_t cpus = 8;
+        uint64_t memTotalKb = 16ull * 1024 * 1024;
+        uint32_t seed = 1;
+    };
+
+    struct Process {
+        uint32_t pid = 0;
+        uint32_t ppid = 0;
+        int depth = 0;
+        std::string name;
+        uint64_t startTime = 0;         // Ticks since boot
+        uint64_t utime = 0;
+        uint64_t stime = 0;
+        uint64_t rssPages = 0;
+        uint64_t readBytes = 0;
+        uint64_t writeBytes = 0;
+        double cpuShare = 0.0;          // Share of one CPU
+        uint64_t ioBytesPerSecond = 0;
+        uint64_t previousTicks = 0;     // utime + stime before the last step
+        bool spawnedThisStep = false;
+        bool dirty = true;              // Needs its directory written
+    };
+
+private:
+    Options options;
+    std::mt19937 random;
+    std::vector<Process> processes;
+    std::unordered_map<uint32_t, size_t> indexByPid;
+    std::vector<uint32_t> freedPids;
+    std::vector<uint32_t> removedPids;  // Directories to delete on the next write
+    uint32_t nextPid = 2;
+    uint64_t uptimeTicks = 1000 * TICKS_PER_SECOND;
+    uint64_t busyTicks = 0;
+    uint64_t idleTicks = 0;
+    uint64_t lastSystemTickDelta = 0;
+    long pageSize = 4096;
+
+    double unit() { return std::uniform_real_distribution<double>(0.0, 1.0)(random); }
+
+    static const char* pickName(uint32_t value) {
+        static const char* const NAMES[] = {
+            "systemd", "sshd", "bash", "java", "postgres", "nginx", "python3", "node",
+            "containerd-shim", "kworker/0:1", "chrome (renderer)", "Web Content", "redis-server",
+            "dockerd", "cron", "rsyslogd"
+        };
+        return NAMES[value % (sizeof(NAMES) / sizeof(NAMES[0]))];
+    }
+
+    uint32_t allocatePid() {
+        if (!freedPids.empty() && unit() < options.pidReuse) {
+            size_t slot = random() % freedPids.size();
+            uint32_t pid = freedPids[slot];
+            freedPids[slot] = freedPids.back();
+            freedPids.pop_back();
+            return pid;
+        }
+        while (indexByPid.count(nextPid)) {
+            nextPid++;
+        }
+        return nextPid++;
+    }
+
+    void spawn(uint32_t parentPid, int depth) {
+        Process process;
+        process.pid = allocatePid();
+        process.ppid = parentPid;
+        process.depth = depth;
+        process.name = pickName(static_cast<uint32_t>(random()));
+        process.startTime = uptimeTicks;
+        process.rssPages = 64 + random() % 4096;
+        if (unit() < options.activeShare) {
+            process.cpuShare = 0.01 + unit() * 0.9;
+            process.ioBytesPerSecond = static_cast<uint64_t>(unit() * 50.0 * 1024 * 1024);
+            process.rssPages += random() % 65536;
+        }
+        process.spawnedThisStep = true;
+        indexByPid[process.pid] = processes.size();
+        processes.push_back(process);
+    }
+
+    // Parent for a new process: half the time one of the newest (deep chains), otherwise any
+    size_t pickParent() {
+        size_t count = processes.size();
+        size_t index = unit() < 0.5 ? count - 1 - random() % std::min<size_t>(count, 8) : random() % count;
+        while (processes[index].depth >= options.maxDepth) {
+            index = indexByPid[processes[index].ppid];
+        }
+        return index;
+    }
+
+    void exitProcess(size_t index) {
+        uint32_t pid = processes[index].pid;
+        for (auto& process : processes) {
+            if (process.ppid == pid) {
+                process.ppid = 1;
+                process.depth = 1;
+                process.dirty = true;
+            }
+        }
+        removedPids.push_back(pid);
+        freedPids.push_back(pid);
+        indexByPid.erase(pid);
+        if (index != processes.size() - 1) {
+            processes[index] = processes.back();
+            indexByPid[processes[index].pid] = index;
+        }
+        processes.pop_back();
+    }
+
+    static bool replaceFile(const std::string& path, const std::string& content) {
+        std::string temporary = path + ".tmp";
+        {
+            std::ofstream out(temporary, std::ios::trunc);
+            if (!out.is_open()) {
+                return false;
+            }
+            out << content;
+        }
+        std::error_code error;
+        std::filesystem::rename(temporary, path, error);
+        return !error;
+    }
+
+    std::string formatStat(const Process& process) const {
+        // Fields 1-52 of proc(5); only 4, 14, 15, 22 and 24 matter to the collectors
+        char buffer[512];
+        std::snprintf(buffer, sizeof(buffer),
+                      "%u (%s) %c %u %u %u 0 -1 4194304 100 0 0 0 %llu %llu 0 0 20 0 1 0 %llu %llu %llu "
+                      "18446744073709551615 1 1 0 0 0 0 0 0 0 0 0 0 17 %u 0 0 0 0 0 0 0 0 0 0 0 0 0\n",
+                      process.pid, process.name.c_str(), process.cpuShare > 0.0 ? 'R' : 'S', process.ppid,
+                      process.pid, process.pid,
+                      (unsigned long long)process.utime, (unsigned long long)process.stime,
+                      (unsigned long long)process.startTime,
+                      (unsigned long long)(process.rssPages * 4 * pageSize),
+                      (unsigned long long)process.rssPages, process.pid % options.cpus);
+        return buffer;
+    }
+
+public:
+    explicit ProcfsFixture(const Options& fixtureOptions)
+        : options(fixtureOptions), random(fixtureOptions.seed) {
+        long systemPageSize = sysconf(_SC_PAGESIZE);
+        if (systemPageSize > 0) {
+            pageSize = systemPageSize;
+        }
+        if (options.processes < 1) {
+            options.processes = 1;
+        }
+        if (options.cpus < 1) {
+            options.cpus = 1;
+        }
+        if (options.maxDepth < 1) {
+            options.maxDepth = 1;
+        }
+
+        Process init;
+        init.pid = 1;
+        init.name = "systemd";
+        init.startTime = 1;
+        init.rssPages = 3000;
+        indexByPid[1] = 0;
+        processes.push_back(init);
+        while (processes.size() < options.processes) {
+            size_t parent = pickParent();
+            spawn(processes[parent].pid, processes[parent].depth + 1);
+        }
+        for (auto& process : processes) {
+            process.spawnedThisStep = false;
+        }
+        idleTicks = uptimeTicks * options.cpus;
+    }
+
+    // Advances the clock; CPU counters stay within the machine's capacity
+    void step(double seconds) {
+        uint64_t elapsed = static_cast<uint64_t>(seconds * TICKS_PER_SECOND);
+        uptimeTicks += elapsed;
+        uint64_t capacity = elapsed * options.cpus;
+
+        // Churn first, so spawned processes start with fresh counters
+        for (auto& process : processes) {
+            process.spawnedThisStep = false;
+        }
+        size_t replaced = static_cast<size_t>(options.churn * (double)processes.size());
+        for (size_t i = 0; i < replaced && processes.size() > 1; i++) {
+            exitProcess(1 + random() % (processes.size() - 1));
+        }
+        for (size_t i = 0; i < replaced; i++) {
+            size_t parent = pickParent();
+            spawn(processes[parent].pid, processes[parent].depth + 1);
+        }
+
+        uint64_t used = 0;
+        for (auto& process : processes) {
+            process.previousTicks = process.utime + process.stime;
+            if (process.spawnedThisStep) {
+                process.dirty = true;
+                continue;
+            }
+            uint64_t ticks = static_cast<uint64_t>(process.cpuShare * (double)elapsed);
+            if (used + ticks > capacity) {
+                ticks = capacity - used;
+            }
+            used += ticks;
+            process.utime += ticks - ticks / 5;
+            process.stime += ticks / 5;
+            uint64_t io = static_cast<uint64_t>((double)process.ioBytesPerSecond * seconds);
+            process.readBytes += io / 2;
+            process.writeBytes += io - io / 2;
+            process.dirty = process.dirty || ticks > 0 || io > 0;
+        }
+        busyTicks += used;
+        idleTicks += capacity - used;
+        lastSystemTickDelta = capacity;
+    }
+
+    // Writes the system files and every changed process directory
+    bool write(const std::string& root) {
+        std::error_code error;
+        std::filesystem::create_directories(root, error);
+        if (error) {
+            return false;
+        }
+
+        for (uint32_t pid : removedPids) {
+            if (!indexByPid.count(pid)) {
+                std::filesystem::remove_all(root + "/" + std::to_string(pid), error);
+            }
+        }
+        removedPids.clear();
+
+        char buffer[512];
+        uint64_t user = busyTicks - busyTicks / 5;
+        std::snprintf(buffer, sizeof(buffer), "cpu  %llu 0 %llu %llu 0 0 0 0 0 0\n",
+                      (unsigned long long)user, (unsigned long long)(busyTicks / 5), (unsigned long long)idleTicks);
+        std::string stat = buffer;
+        std::snprintf(buffer, sizeof(buffer), "btime 1700000000\nprocesses %u\n", nextPid);
+        stat += buffer;
+        if (!replaceFile(root + "/stat", stat)) {
+            return false;
+        }
+
+        uint64_t usedKb = 0;
+        for (const auto& process : processes) {
+            usedKb += process.rssPages * static_cast<uint64_t>(pageSize) / 1024;
+        }
+        uint64_t freeKb = usedKb < options.memTotalKb ? options.memTotalKb - usedKb : 0;
+        std::snprintf(buffer, sizeof(buffer), "MemTotal:       %llu kB\nMemFree:        %llu kB\nMemAvailable:   %llu kB\n",
+                      (unsigned long long)options.memTotalKb, (unsigned long long)freeKb, (unsigned long long)freeKb);
+        if (!replaceFile(root + "/meminfo", buffer)) {
+            return false;
+        }
+
+        for (auto& process : processes) {
+            if (!process.dirty) {
+                continue;
+            }
+            std::string directory = root + "/" + std::to_string(process.pid);
+            std::filesystem::create_directory(directory, error);
+            std::snprintf(buffer, sizeof(buffer), "%llu %llu 512 100 0 2048 0\n",
+                          (unsigned long long)(process.rssPages * 4), (unsigned long long)process.rssPages);
+            std::string statm = buffer;
+            std::snprintf(buffer, sizeof(buffer),
+                          "rchar: %llu\nwchar: %llu\nsyscr: 0\nsyscw: 0\nread_bytes: %llu\nwrite_bytes: %llu\n"
+                          "cancelled_write_bytes: 0\n",
+                          (unsigned long long)process.readBytes, (unsigned long long)process.writeBytes,
+                          (unsigned long long)process.readBytes, (unsigned long long)process.writeBytes);
+            if (!replaceFile(directory + "/stat", formatStat(process)) ||
+                !replaceFile(directory + "/statm", statm) ||
+                !replaceFile(directory + "/io", buffer)) {
+                return false;
+            }
+            process.dirty = false;
+        }
+        return true;
+    }
+
+    // CPU share the collector must report for the last step (0 for new or reused PIDs)
+    double expectedCpuPercent(const Process& process) const {
+        if (process.spawnedThisStep || lastSystemTickDelta == 0) {
+            return 0.0;
+        }
+        uint64_t ticks = process.utime + process.stime - process.previousTicks;
+        double percent = 100.0 * (double)ticks / (double)lastSystemTickDelta;
+        return percent > 100.0 ? 100.0 : percent;
+    }
+
+    const std::vector<Process>& getProcesses() const { return processes; }
+    const Process* find(uint32_t pid) const {
+        auto it = indexByPid.find(pid);
+        return it != indexByPid.end() ? &processes[it->second] : nullptr;
+    }
+    uint64_t getMemTotalBytes() const { return options.memTotalKb * 1024; }
+    long getPageSize() const { return pageSize; }
+    int getDepth() const {
+        int depth = 0;
+        for (const auto& process : processes) {
+            depth = std::max(depth, process.depth);
+        }
+        return depth;
+    }
+};
@@ -0,0 +1,75 @@
+#include "procfs_fixture.h"
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+
+// Writes a synthetic /proc tree for PROC_ROOT (Linux).
+//
+// Without --steps the tree is written once. With --steps N the generator
+// keeps running and advances the counters every --interval ms, N times
+// (0 = until interrupted), so an agent pointed at the directory sees CPU,
+// I/O, process churn and PID reuse as on a live host.
+
+int main(int argc, char* argv[]) {
+    ProcfsFixture::Options options;
+    std::string root;
+    int steps = -1;
+    int intervalMs = 1000;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--root" && i + 1 < argc) {
+            root = argv[++i];
+        } else if (arg == "--processes" && i + 1 < argc) {
+            options.processes = static_cast<size_t>(std::max(1, std::atoi(argv[++i])));
+        } else if (arg == "--depth" && i + 1 < argc) {
+            options.maxDepth = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--active" && i + 1 < argc) {
+            options.activeShare = std::atof(argv[++i]);
+        } else if (arg == "--churn" && i + 1 < argc) {
+            options.churn = std::atof(argv[++i]);
+        } else if (arg == "--pid-reuse" && i + 1 < argc) {
+            options.pidReuse = std::atof(argv[++i]);
+        } else if (arg == "--cpus" && i + 1 < argc) {
+            options.cpus = static_cast<uint32_t>(std::max(1, std::atoi(argv[++i])));
+        } else if (arg == "--seed" && i + 1 < argc) {
+            options.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--steps" && i + 1 < argc) {
+            steps = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--interval" && i + 1 < argc) {
+            intervalMs = std::max(10, std::atoi(argv[++i]));
+        } else {
+            root.clear();
+            break;
+        }
+    }
+    if (root.empty()) {
+        std::cout << "Usage: procfs_gen --root DIR [--processes N] [--depth N] [--active SHARE] [--churn SHARE]\n"
+                  << "                  [--pid-reuse SHARE] [--cpus N] [--seed N] [--steps N] [--interval MS]" << std::endl;
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    ProcfsFixture fixture(options);
+    if (!fixture.write(root)) {
+        std::cerr << "Cannot write the tree under " << root << std::endl;
+        return 1;
+    }
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Wrote " << fixture.getProcesses().size() << " processes (depth " << fixture.getDepth() << ") to "
+              << root << " in " << (int)elapsedMs << " ms" << std::endl;
+
+    auto deadline = std::chrono::steady_clock::now();
+    for (int step = 1; steps >= 0 && (steps == 0 || step <= steps); step++) {
+        deadline += std::chrono::milliseconds(intervalMs);
+        std::this_thread::sleep_until(deadline);
+        fixture.step(intervalMs / 1000.0);
+        if (!fixture.write(root)) {
+            std::cerr << "Cannot update the tree under " << root << std::endl;
+            return 1;
+        }
+        std::cout << "Step " << step << ": " << fixture.getProcesses().size() << " processes" << std::endl;
+    }
+    return 0;
+}